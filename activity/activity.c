@@ -0,0 +1,188 @@
+/**
+ * @file activity.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for the input activity detector.
+ * 
+ * @details [
+ * 		init_activity() - set the levels and the tail of the chain
+ * 		
+ * 		activity_update() - decide whether the chain runs on a block
+ * 		
+ * 		activity_update_q15() - the same for a block of Q15 input
+ * 		
+ * 		report_activity() - print the blocks bypassed
+ * ]
+ * 
+ * Between songs the chain runs at full cost on nothing but the adc noise floor. The detector 
+ * tracks the peak of each input block. Once the input has stayed under the close level for as 
+ * long as the chain rings on (the lowpass, the eq filters, the delay line), nothing the chain
+ * puts out depends on anything but silence, so the caller can play silence and skip it. On the
+ * first block over the open level the chain is reset to silence and runs on that block, so the
+ * onset isn't lost. The open level sits above the close level, so noise around one level
+ * doesn't start and stop the chain every block.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "fast_math.h"
+#include "arena.h"
+#include "fixed.h"
+#include "trace.h"
+#include "activity.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [initialize the activity detector, with the chain running]
+ * 
+ * @param A [arena the struct is allocated from]
+ * @param open_db [peak level in dB that counts as an onset]
+ * @param close_db [peak level in dB under which the input counts as silent, no more than open_db]
+ * @param tail [samples the chain rings on after its input goes silent, -1 if it's not known]
+ * @return [pointer to the activity struct, NULL if it doesn't fit in the arena]
+ */
+ACTIVITY_T * init_activity(ARENA_T * A, float open_db, float close_db, int tail) {
+
+	// set up struct for the detector ------------------------------------------
+	ACTIVITY_T * X = (ACTIVITY_T *)arena_alloc(A, sizeof(ACTIVITY_T));	// allocate struct
+	if(X == NULL) return NULL;											// errcheck alloc
+
+	X->open = db_to_gain(open_db);
+	X->close = db_to_gain(close_db);
+	X->open_q15 = float_to_q15_one(X->open);
+	X->close_q15 = float_to_q15_one(X->close);
+	X->tail = tail;
+	X->active = 1;
+
+	return X;
+
+}
+
+
+/**
+ * @brief [move the detector on by a block, given how its peak compares to the levels]
+ * 
+ * @param X [pointer to the activity struct]
+ * @param over_open [1 if the block's peak reached the open level]
+ * @param over_close [1 if the block's peak reached the close level]
+ * @param n [number of samples]
+ * @return [ACTIVITY_BYPASS, ACTIVITY_RUN or ACTIVITY_RESUME]
+ */
+static int activity_step(ACTIVITY_T * X, int over_open, int over_close, int n) {
+
+	X->blocks++;
+
+
+	// BYPASSED ----------------------------------------------------------------
+	if(!X->active) {
+
+		if(!over_open) {
+			X->bypassed++;
+			return ACTIVITY_BYPASS;
+		}
+
+		X->active = 1;
+		X->quiet = 0;
+		X->onsets++;
+		TRACE_INSTANT("onset", n);
+		return ACTIVITY_RESUME;
+
+	}
+
+
+	// RUNNING -----------------------------------------------------------------
+	if(over_close || X->tail < 0) {
+		X->quiet = 0;
+		return ACTIVITY_RUN;
+	}
+
+	// the outputs of this block only depend on the tail before it, all of it silent
+	if(X->quiet >= X->tail) {
+		X->active = 0;
+		X->bypassed++;
+		TRACE_INSTANT("bypass", X->quiet);
+		return ACTIVITY_BYPASS;
+	}
+
+	X->quiet += n;
+	return ACTIVITY_RUN;
+
+}
+
+
+/**
+ * @brief [look at a block of input and decide whether the chain has to run on it]
+ * 
+ * @param X [pointer to the activity struct]
+ * @param input [n input samples]
+ * @param n [number of samples]
+ * @return [ACTIVITY_BYPASS, ACTIVITY_RUN or ACTIVITY_RESUME]
+ */
+int activity_update(ACTIVITY_T * X, const float * input, int n) {
+
+	int i;
+	float peak = 0.0f;
+
+	for(i = 0; i < n; i++) peak = fmaxf(peak, fabsf(input[i]));
+
+	return activity_step(X, peak >= X->open, peak >= X->close, n);
+
+}
+
+
+/**
+ * @brief [activity_update() for Q15 input, in the fixed point chain]
+ * 
+ * @param X [pointer to the activity struct]
+ * @param input [n Q15 input samples]
+ * @param n [number of samples]
+ * @return [ACTIVITY_BYPASS, ACTIVITY_RUN or ACTIVITY_RESUME]
+ */
+int activity_update_q15(ACTIVITY_T * X, const q15_t * input, int n) {
+
+	int i;
+	int32_t x, peak = 0;
+
+	for(i = 0; i < n; i++) {
+		x = (input[i] < 0) ? -(int32_t)input[i] : input[i];
+		if(x > peak) peak = x;
+	}
+
+	return activity_step(X, peak >= X->open_q15, peak >= X->close_q15, n);
+
+}
+
+
+/**
+ * @brief [print how much of the time the chain was bypassed]
+ * 
+ * @param X [pointer to the activity struct]
+ * @param print [prints one line, UART_putstr on the board]
+ */
+void report_activity(const ACTIVITY_T * X, void (*print)(const char *)) {
+
+	char line[128];
+
+	if(X->tail < 0) {
+		print("activity: the chain has no known tail, never bypassed\r\n");
+		return;
+	}
+
+	snprintf(line, sizeof(line), "activity: %s, %lu of %lu blocks bypassed, %lu onsets, tail %d samples\r\n", 
+		X->active ? "running" : "bypassed", (unsigned long)X->bypassed, (unsigned long)X->blocks, 
+		(unsigned long)X->onsets, X->tail);
+	print(line);
+
+}
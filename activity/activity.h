@@ -0,0 +1,127 @@
+/**
+ * @file activity.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for 
+ * the input activity detector, which decides when the chain can be skipped through silence.
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef ACTIVITY_H
+#define ACTIVITY_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "fixed.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define ACTIVITY_OPEN_DB		-48.0f	// peak level that counts as an onset, about 8 adc codes
+#define ACTIVITY_CLOSE_DB		-54.0f	// peak level under which the input counts as silent
+
+// what to do with a block, from activity_update()
+#define ACTIVITY_BYPASS			0		// skip the chain, play silence
+#define ACTIVITY_RUN			1		// run the chain
+#define ACTIVITY_RESUME			2		// reset the chain back to silence, then run it
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [structure containing the levels and the state of the activity detector]
+ * 
+ */
+typedef struct activity_struct {
+	float open;					// peak level that counts as an onset
+	float close;				// peak level under which the input counts as silent
+	int32_t open_q15;			// the same levels for Q15 input
+	int32_t close_q15;
+	int tail;					// samples the chain rings on after its input goes silent, -1 to never bypass
+	int quiet;					// samples in a row under the close level
+	int active;					// 1 while the chain is running
+	uint32_t blocks;			// blocks looked at
+	uint32_t bypassed;			// blocks skipped
+	uint32_t onsets;			// times the chain started again
+} ACTIVITY_T;
+
+
+/**
+ * @brief [initialize the activity detector, with the chain running]
+ * 
+ * @param A [arena the struct is allocated from]
+ * @param open_db [peak level in dB that counts as an onset]
+ * @param close_db [peak level in dB under which the input counts as silent, no more than open_db]
+ * @param tail [samples the chain rings on after its input goes silent, -1 if it's not known]
+ * @return [pointer to the activity struct, NULL if it doesn't fit in the arena]
+ */
+ACTIVITY_T * init_activity(
+	ARENA_T * A,		// arena to allocate from
+	float open_db,		// onset level in dB
+	float close_db,		// silence level in dB
+	int tail			// tail of the chain in samples
+);
+
+
+/**
+ * @brief [look at a block of input and decide whether the chain has to run on it]
+ * @details [a running chain is bypassed once the input has been under the close level for
+ * the whole tail before this block, and this block is too: everything the chain would put 
+ * out has come from silent input. a bypassed chain starts again on the first block with a
+ * peak over the open level, so the onset itself is processed]
+ * 
+ * @param X [pointer to the activity struct]
+ * @param input [n input samples]
+ * @param n [number of samples]
+ * @return [ACTIVITY_BYPASS, ACTIVITY_RUN or ACTIVITY_RESUME]
+ */
+int activity_update(
+	ACTIVITY_T * X,			// pointer to activity struct
+	const float * input,	// input samples
+	int n					// number of samples
+);
+
+
+/**
+ * @brief [activity_update() for Q15 input, in the fixed point chain]
+ * 
+ * @param X [pointer to the activity struct]
+ * @param input [n Q15 input samples]
+ * @param n [number of samples]
+ * @return [ACTIVITY_BYPASS, ACTIVITY_RUN or ACTIVITY_RESUME]
+ */
+int activity_update_q15(
+	ACTIVITY_T * X,			// pointer to activity struct
+	const q15_t * input,	// input samples
+	int n					// number of samples
+);
+
+
+/**
+ * @brief [print how much of the time the chain was bypassed]
+ * 
+ * @param X [pointer to the activity struct]
+ * @param print [prints one line, UART_putstr on the board]
+ */
+void report_activity(
+	const ACTIVITY_T * X,			// pointer to activity struct
+	void (*print)(const char *)		// prints one line
+);
+
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * @file arena.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for the linear arena allocator.
+ * 
+ * @details [
+ * 		init_arena() - set up an arena over a fixed block of memory
+ * 		
+ * 		arena_set_fallback() - chain a bigger arena behind this one for when it's full
+ * 		
+ * 		arena_alloc() - allocate zeroed memory with the default alignment
+ * 		
+ * 		arena_alloc_aligned() - allocate zeroed memory with a given alignment (SIMD, DMA)
+ * 		
+ * 		arena_set_tag() - charge the following allocations to an owner for the report
+ * 		
+ * 		arena_mark() / arena_release() - free everything allocated after a point
+ * 		
+ * 		reset_arena() - free everything, used to reconfigure the effects
+ * 		
+ * 		report_arena() - bytes used per owner against the budget
+ * ]
+ * 
+ * Every init_* routine used to make several malloc calls, and returned NULL part way through
+ * when one failed, leaking everything allocated before it. With all effect state coming out of 
+ * one fixed block, an init that runs out of room leaves nothing behind that a reset doesn't clean
+ * up, the heap never fragments, and an allocation is a pointer bump so init time doesn't depend 
+ * on the state of the heap. The budget is fixed at compile time, so a config that doesn't fit 
+ * fails at startup with the report saying who used what, instead of corrupting memory later.
+ * 
+ * On the STM32F407 the effect state goes in an arena over the 64 KB of core-coupled memory, with
+ * the SRAM arena as its fallback. CCM is only on the cpu's data bus, so the FIR state and delay 
+ * lines read every sample don't compete with the ADC/DAC DMA for SRAM, and whatever doesn't fit 
+ * in CCM still gets allocated. CCM can't be reached by DMA, so DMA buffers come from the SRAM arena.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+
+#include "arena.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [initialize an arena over a block of memory]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param base [start of the memory block]
+ * @param size [size of the block in bytes]
+ */
+void init_arena(ARENA_T * A, void * base, size_t size) {
+
+	A->base = (uint8_t *)base;
+	A->size = size;
+	A->peak = 0;
+	A->fallback = NULL;
+	reset_arena(A);
+
+}
+
+
+/**
+ * @brief [allocations that don't fit in A are taken from fallback instead]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param fallback [arena to use when A is full, NULL for none]
+ */
+void arena_set_fallback(ARENA_T * A, ARENA_T * fallback) {
+
+	A->fallback = fallback;
+
+}
+
+
+/**
+ * @brief [allocate zeroed memory from the arena, aligned to ARENA_ALIGN]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param bytes [number of bytes to allocate]
+ * @return [pointer to the memory, NULL if it doesn't fit in the budget]
+ */
+void * arena_alloc(ARENA_T * A, size_t bytes) {
+
+	return arena_alloc_aligned(A, bytes, ARENA_ALIGN);
+
+}
+
+
+/**
+ * @brief [allocate zeroed memory from the arena with a given alignment]
+ * @details [the padding needed to reach the alignment is charged to the active owner as well]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param bytes [number of bytes to allocate]
+ * @param align [alignment in bytes, a power of 2]
+ * @return [pointer to the memory, NULL if it doesn't fit in the budget]
+ */
+void * arena_alloc_aligned(ARENA_T * A, size_t bytes, size_t align) {
+
+	uintptr_t start, end;
+
+	// round the next free address up to the alignment
+	start = ((uintptr_t)(A->base + A->used) + (align - 1)) & ~((uintptr_t)align - 1);
+	end = start + bytes;
+
+	// over budget, try the fallback, otherwise remember the first request that didn't fit for the report
+	if(end > (uintptr_t)(A->base + A->size)) {
+		if(A->fallback != NULL) return arena_alloc_aligned(A->fallback, bytes, align);
+		if(A->failed == 0) A->failed = bytes;
+		return NULL;
+	}
+
+	A->tags[A->tag].bytes += end - (uintptr_t)(A->base + A->used);
+	A->used = end - (uintptr_t)A->base;
+	if(A->used > A->peak) A->peak = A->used;
+
+	// memory handed out is always zeroed, whatever was there before a reset
+	memset((void *)start, 0, bytes);
+
+	return (void *)start;
+
+}
+
+
+/**
+ * @brief [charge the following allocations to the named owner in the usage report]
+ * @details [tags with the same name are combined. once all the tags are used up,
+ * new names are charged to the last one]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param name [owner name]
+ */
+void arena_set_tag(ARENA_T * A, const char * name) {
+
+	int i;
+
+	if(A->fallback != NULL) arena_set_tag(A->fallback, name);
+
+	for(i = 0; i < A->num_tags; i++) {
+		if(strcmp(A->tags[i].name, name) == 0) {
+			A->tag = i;
+			return;
+		}
+	}
+
+	if(A->num_tags < ARENA_MAX_TAGS) {
+		A->tags[A->num_tags].name = name;
+		A->tags[A->num_tags].bytes = 0;
+		A->tag = A->num_tags++;
+	}
+
+}
+
+
+/**
+ * @brief [current fill level of the arena, to hand back to arena_release()]
+ * 
+ * @param A [pointer to the arena struct]
+ * @return [mark]
+ */
+size_t arena_mark(ARENA_T * A) {
+
+	return A->used;
+
+}
+
+
+/**
+ * @brief [free everything allocated after the mark was taken]
+ * @details [the per owner totals are not rolled back, the report shows what each owner
+ * allocated since the last reset]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param mark [value from arena_mark()]
+ */
+void arena_release(ARENA_T * A, size_t mark) {
+
+	if(mark < A->used) A->used = mark;
+
+}
+
+
+/**
+ * @brief [free everything in the arena, used when the effects are reconfigured]
+ * 
+ * @param A [pointer to the arena struct]
+ */
+void reset_arena(ARENA_T * A) {
+
+	if(A->fallback != NULL) reset_arena(A->fallback);
+	A->used = 0;
+	A->failed = 0;
+	A->num_tags = 1;
+	A->tag = 0;
+	A->tags[0].name = "other";
+	A->tags[0].bytes = 0;
+
+}
+
+
+/**
+ * @brief [write the bytes used per owner against the budget, one line at a time]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param print [function that writes one line]
+ */
+void report_arena(ARENA_T * A, void (*print)(const char * line)) {
+
+	int i;
+	char line[80];
+
+	for(i = 0; i < A->num_tags; i++) {
+		if(A->tags[i].bytes == 0) continue;
+		snprintf(line, sizeof(line), "  %-12s %8lu bytes\r\n", A->tags[i].name, (unsigned long)A->tags[i].bytes);
+		print(line);
+	}
+
+	snprintf(line, sizeof(line), "  %-12s %8lu of %lu bytes (peak %lu)\r\n", "total", 
+		(unsigned long)A->used, (unsigned long)A->size, (unsigned long)A->peak);
+	print(line);
+
+	if(A->failed) {
+		snprintf(line, sizeof(line), "  out of memory allocating %lu bytes\r\n", (unsigned long)A->failed);
+		print(line);
+	}
+
+}
@@ -0,0 +1,189 @@
+/**
+ * @file arena.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for 
+ * the linear arena allocator that all effect state is allocated from.
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef ARENA_H
+#define ARENA_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#ifndef ARENA_BUDGET
+#define ARENA_BUDGET		(104 * 1024)	// bytes of SRAM set aside for effect state
+#endif
+
+#ifndef ARENA_ALIGN
+#define ARENA_ALIGN			8				// default alignment, enough for doubles and DMA
+#endif
+
+#define ARENA_MAX_TAGS		16				// most owners the usage report keeps track of
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [bytes allocated by one owner (effect) of the arena]
+ * 
+ */
+typedef struct arena_tag {
+	const char * name;		// owner name, from arena_set_tag()
+	size_t bytes;			// bytes allocated while this tag was active, including padding
+} ARENA_TAG_T;
+
+
+/**
+ * @brief [structure containing the fields for the arena allocator]
+ * @details [memory is handed out from the front of one fixed block and never freed
+ * on its own. reset_arena() (or arena_release() back to a mark) gives it all back at once.
+ * an arena over a small fast region (CCM) can fall back to a bigger one (SRAM) when it's full]
+ * 
+ */
+typedef struct arena_struct {
+	struct arena_struct * fallback;			// arena to allocate from when this one is full, NULL for none
+	uint8_t * base;							// start of the memory block
+	size_t size;							// size of the block, the budget
+	size_t used;							// bytes handed out so far
+	size_t peak;							// most bytes ever in use
+	size_t failed;							// size of the first request that didn't fit, 0 if none
+	int tag;								// index of the active tag
+	int num_tags;							// number of tags in use
+	ARENA_TAG_T tags[ARENA_MAX_TAGS];		// bytes used per owner
+} ARENA_T;
+
+
+/**
+ * @brief [initialize an arena over a block of memory]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param base [start of the memory block]
+ * @param size [size of the block in bytes]
+ */
+void init_arena(
+	ARENA_T * A,		// pointer to arena struct
+	void * base,		// start of the memory block
+	size_t size			// size of the memory block in bytes
+);
+
+
+/**
+ * @brief [allocations that don't fit in A are taken from fallback instead]
+ * @details [tags set on A are set on the fallback too, and resetting A resets the fallback, 
+ * so the pair can be used as one arena. marks only cover A itself]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param fallback [arena to use when A is full, NULL for none]
+ */
+void arena_set_fallback(
+	ARENA_T * A,		// pointer to arena struct
+	ARENA_T * fallback	// arena to use when A is full
+);
+
+
+/**
+ * @brief [allocate zeroed memory from the arena, aligned to ARENA_ALIGN]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param bytes [number of bytes to allocate]
+ * @return [pointer to the memory, NULL if it doesn't fit in the budget]
+ */
+void * arena_alloc(
+	ARENA_T * A,		// pointer to arena struct
+	size_t bytes		// number of bytes
+);
+
+
+/**
+ * @brief [allocate zeroed memory from the arena with a given alignment]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param bytes [number of bytes to allocate]
+ * @param align [alignment in bytes, a power of 2 (e.g. 16/32 for SIMD)]
+ * @return [pointer to the memory, NULL if it doesn't fit in the budget]
+ */
+void * arena_alloc_aligned(
+	ARENA_T * A,		// pointer to arena struct
+	size_t bytes,		// number of bytes
+	size_t align		// alignment, power of 2
+);
+
+
+/**
+ * @brief [charge the following allocations to the named owner in the usage report]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param name [owner name, the string has to stay around (use a literal)]
+ */
+void arena_set_tag(
+	ARENA_T * A,		// pointer to arena struct
+	const char * name	// owner name
+);
+
+
+/**
+ * @brief [current fill level of the arena, to hand back to arena_release()]
+ * 
+ * @param A [pointer to the arena struct]
+ * @return [mark]
+ */
+size_t arena_mark(
+	ARENA_T * A			// pointer to arena struct
+);
+
+
+/**
+ * @brief [free everything allocated after the mark was taken]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param mark [value from arena_mark()]
+ */
+void arena_release(
+	ARENA_T * A,		// pointer to arena struct
+	size_t mark			// value from arena_mark()
+);
+
+
+/**
+ * @brief [free everything in the arena, used when the effects are reconfigured]
+ * 
+ * @param A [pointer to the arena struct]
+ */
+void reset_arena(
+	ARENA_T * A			// pointer to arena struct
+);
+
+
+/**
+ * @brief [write the bytes used per owner against the budget, one line at a time]
+ * 
+ * @param A [pointer to the arena struct]
+ * @param print [function that writes one line (UART_putstr on the board, fputs to stdout on the host)]
+ */
+void report_arena(
+	ARENA_T * A,						// pointer to arena struct
+	void (*print)(const char * line)	// writes one line of the report
+);
+
+
+#endif
@@ -0,0 +1,360 @@
+/**
+ * @file batch.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for rendering presets over recordings on a pool of threads.
+ *
+ * @details [
+ * 		init_batch() - build the preset x file job grid and the pool
+ *
+ * 		run_batch() - render every job
+ *
+ * 		write_batch_summary() - every job and its timing as csv
+ *
+ * 		report_batch() - totals, speedup and per worker counts
+ *
+ * 		close_batch() - give back the scratch arenas
+ * ]
+ *
+ * Re-rendering the gui presets over a corpus of DI recordings is presets x files independent renders
+ * (see render.c). The jobs are sorted longest file first and dealt out round robin to the workers'
+ * queues. A worker runs its own queue from the head, and once it is empty steals from the tail of the
+ * others, so the long jobs start first, every worker keeps its own share without touching anyone
+ * else's lock, and the short jobs at the end fill in around whichever worker is running late.
+ *
+ * Each worker owns an arena for the whole render: the files, the converters, the lowpass and the
+ * chain are planned in it, and it is reset for the next job, so the workers share no effect state.
+ * What is shared is the design cache and the fir wisdom, which are filled in while a chain is planned
+ * and only read while it runs, so planning takes plan_lock. Planning is a few milliseconds against a
+ * render of seconds, and the first job to plan a filter times it for all the rest. The workers read
+ * different parts of the corpus at once, the mappings keep that to the page cache (see wav.c).
+ *
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "arena.h"
+#include "wav.h"
+#include "render.h"
+#include "batch.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [seconds on the monotonic clock]
+ */
+static double batch_now(void) {
+
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + 1e-9 * t.tv_nsec;
+
+}
+
+
+/**
+ * @brief [longest input first, then the grid order]
+ */
+static int batch_longest_first(const void * a, const void * b) {
+
+	const BATCH_JOB_T * x = (const BATCH_JOB_T *)a;
+	const BATCH_JOB_T * y = (const BATCH_JOB_T *)b;
+
+	if(x->bytes != y->bytes) return (x->bytes > y->bytes) ? -1 : 1;
+	if(x->input != y->input) return strcmp(x->input, y->input);
+	return x->preset - y->preset;
+
+}
+
+
+/**
+ * @brief [build the job grid and the pool]
+ *
+ * @param A [arena the jobs and workers are allocated from]
+ * @param files [recordings to render]
+ * @param num_files [number of recordings]
+ * @param presets [preset numbers, 1 to RENDER_NUM_PRESETS]
+ * @param num_presets [number of presets]
+ * @param out_dir [directory the outputs are written to]
+ * @param num_workers [threads, 1 to BATCH_MAX_WORKERS]
+ * @param opts [how each job is rendered]
+ * @return [pointer to the batch, NULL for a bad preset or output name, or if it doesn't fit]
+ */
+BATCH_T * init_batch(ARENA_T * A, const char * const * files, int num_files, const int * presets, int num_presets,
+	const char * out_dir, int num_workers, const RENDER_OPTS_T * opts) {
+
+	int f, p, i, len;
+	const char * name;
+	const char * dot;
+	struct stat st;
+	BATCH_JOB_T * J;
+	BATCH_WORKER_T * W;
+
+	if(num_files < 1 || num_presets < 1 || num_workers < 1 || num_workers > BATCH_MAX_WORKERS) return NULL;
+
+	BATCH_T * B = (BATCH_T *)arena_alloc(A, sizeof(BATCH_T));
+	if(B == NULL) return NULL;
+
+	B->num_jobs = num_files * num_presets;
+	B->num_workers = num_workers;
+	B->opts = *opts;
+	B->jobs = (BATCH_JOB_T *)arena_alloc(A, sizeof(BATCH_JOB_T) * B->num_jobs);
+	B->workers = (BATCH_WORKER_T *)arena_alloc(A, sizeof(BATCH_WORKER_T) * num_workers);
+	if(B->jobs == NULL || B->workers == NULL) return NULL;
+
+	// the grid, each output named after its input and preset
+	for(f = 0; f < num_files; f++) {
+
+		name = strrchr(files[f], '/');
+		name = (name == NULL) ? files[f] : name + 1;
+		dot = strrchr(name, '.');
+		len = (dot == NULL) ? (int)strlen(name) : (int)(dot - name);
+
+		for(p = 0; p < num_presets; p++) {
+			if(presets[p] < 1 || presets[p] > RENDER_NUM_PRESETS) return NULL;
+			J = &(B->jobs[(f * num_presets) + p]);
+			J->preset = presets[p] - 1;
+			J->input = files[f];
+			J->bytes = (stat(files[f], &st) == 0) ? (int64_t)st.st_size : 0;
+			J->worker = -1;
+			if(snprintf(J->output, BATCH_PATH, "%s/%.*s_p%02d.wav", out_dir, len, name, presets[p]) >= BATCH_PATH) return NULL;
+		}
+
+	}
+	qsort(B->jobs, B->num_jobs, sizeof(BATCH_JOB_T), batch_longest_first);
+
+	// deal the jobs round robin, every worker gets the same mix of long and short ones
+	for(i = 0; i < num_workers; i++) {
+		W = &(B->workers[i]);
+		W->B = B;
+		W->id = i;
+		W->queue.jobs = (int *)arena_alloc(A, sizeof(int) * (B->num_jobs / num_workers + 1));
+		if(W->queue.jobs == NULL) return NULL;
+	}
+	for(i = 0; i < B->num_jobs; i++) {
+		W = &(B->workers[i % num_workers]);
+		W->queue.jobs[W->queue.tail++] = i;
+	}
+
+	// the scratch arenas last, so nothing is left to free if the rest didn't fit
+	for(i = 0; i < num_workers; i++) {
+		W = &(B->workers[i]);
+		pthread_mutex_init(&(W->queue.lock), NULL);
+		W->pool = (uint8_t *)malloc(RENDER_ARENA_BYTES);
+		if(W->pool == NULL) { close_batch(B); return NULL; }
+		init_arena(&(W->arena), W->pool, RENDER_ARENA_BYTES);
+	}
+	pthread_mutex_init(&(B->plan_lock), NULL);
+
+	return B;
+
+}
+
+
+/**
+ * @brief [the next job for a worker, its own or one stolen from another]
+ *
+ * @param W [pointer to the worker]
+ * @return [job index, -1 once every queue is empty]
+ */
+static int batch_next(BATCH_WORKER_T * W) {
+
+	int i, job = -1;
+	BATCH_T * B = W->B;
+	BATCH_QUEUE_T * Q = &(W->queue);
+
+	pthread_mutex_lock(&(Q->lock));
+	if(Q->head < Q->tail) job = Q->jobs[Q->head++];
+	pthread_mutex_unlock(&(Q->lock));
+	if(job >= 0) return job;
+
+	// the last job of the next worker along that has any left
+	for(i = 1; i < B->num_workers && job < 0; i++) {
+		Q = &(B->workers[(W->id + i) % B->num_workers].queue);
+		pthread_mutex_lock(&(Q->lock));
+		if(Q->head < Q->tail) job = Q->jobs[--Q->tail];
+		pthread_mutex_unlock(&(Q->lock));
+	}
+	if(job >= 0) W->stolen++;
+
+	return job;
+
+}
+
+
+/**
+ * @brief [render one job in the worker's arena]
+ *
+ * @param W [pointer to the worker]
+ * @param J [pointer to the job]
+ */
+static void batch_job(BATCH_WORKER_T * W, BATCH_JOB_T * J) {
+
+	int format;
+	double start = batch_now();
+	WAV_T in, out;
+	RENDER_T * R = NULL;
+	BATCH_T * B = W->B;
+
+	reset_arena(&(W->arena));
+	J->worker = W->id;
+	J->failed = 1;
+
+	if(open_wav(&in, J->input) == 0) {
+
+		pthread_mutex_lock(&(B->plan_lock));
+		R = init_render(&(W->arena), &in, &(render_presets[J->preset].fx), 1, &(B->opts));
+		pthread_mutex_unlock(&(B->plan_lock));
+
+		format = (B->opts.format < 0) ? in.format : B->opts.format;
+		if(R != NULL && create_wav(&out, &(W->arena), J->output, R->out_rate, R->stereo ? 2 : 1, format) == 0) {
+			J->failed = run_render(R, &out);
+			if(close_wav(&out) != 0) J->failed = 1;
+			J->frames = R->frames;
+			J->audio = (double)R->frames / R->out_rate;
+		}
+		close_wav(&in);
+
+	}
+
+	J->seconds = batch_now() - start;
+	W->busy += J->seconds;
+	W->jobs++;
+
+}
+
+
+/**
+ * @brief [a worker thread, runs jobs until there are none left anywhere]
+ */
+static void * batch_worker(void * arg) {
+
+	int job;
+	BATCH_WORKER_T * W = (BATCH_WORKER_T *)arg;
+
+	while((job = batch_next(W)) >= 0) batch_job(W, &(W->B->jobs[job]));
+
+	return NULL;
+
+}
+
+
+/**
+ * @brief [run every job on the pool and wait for them all]
+ *
+ * @param B [pointer to the batch]
+ * @return [number of jobs that failed]
+ */
+int run_batch(BATCH_T * B) {
+
+	int i;
+	double start = batch_now();
+
+	// a worker that can't be started leaves its queue to be stolen
+	for(i = 1; i < B->num_workers; i++) {
+		B->workers[i].started = (pthread_create(&(B->workers[i].thread), NULL, batch_worker, &(B->workers[i])) == 0);
+	}
+	batch_worker(&(B->workers[0]));
+	for(i = 1; i < B->num_workers; i++) {
+		if(B->workers[i].started) pthread_join(B->workers[i].thread, NULL);
+	}
+
+	B->seconds = batch_now() - start;
+	B->failed = 0;
+	for(i = 0; i < B->num_jobs; i++) B->failed += B->jobs[i].failed;
+
+	return B->failed;
+
+}
+
+
+/**
+ * @brief [write every job and its timing to a csv file]
+ *
+ * @param B [pointer to a batch that has run]
+ * @param path [file name]
+ * @return [0 on success, 1 if it couldn't be written]
+ */
+int write_batch_summary(const BATCH_T * B, const char * path) {
+
+	int i;
+	const BATCH_JOB_T * J;
+	FILE * f = fopen(path, "w");
+
+	if(f == NULL) return 1;
+
+	fprintf(f, "preset,name,input,output,frames,audio_s,wall_s,realtime,worker,status\n");
+	for(i = 0; i < B->num_jobs; i++) {
+		J = &(B->jobs[i]);
+		fprintf(f, "%d,%s,%s,%s,%lld,%.3f,%.3f,%.1f,%d,%s\n", render_presets[J->preset].number, render_presets[J->preset].name,
+			J->input, J->output, (long long)J->frames, J->audio, J->seconds, (J->seconds > 0) ? J->audio / J->seconds : 0.0,
+			J->worker, J->failed ? "failed" : "ok");
+	}
+
+	return (fclose(f) != 0);
+
+}
+
+
+/**
+ * @brief [print the totals, the speedup over one core and what each worker did]
+ *
+ * @param B [pointer to a batch that has run]
+ * @param print [prints one line]
+ */
+void report_batch(const BATCH_T * B, void (*print)(const char *)) {
+
+	int i;
+	char line[128];
+	double audio = 0, busy = 0;
+	const BATCH_WORKER_T * W;
+
+	for(i = 0; i < B->num_jobs; i++) audio += B->jobs[i].audio;
+	for(i = 0; i < B->num_workers; i++) busy += B->workers[i].busy;
+
+	// the time in jobs over the wall clock is the speedup over running them one after another
+	snprintf(line, sizeof(line), "%d jobs (%d failed) on %d workers: %.1f s of audio in %.2f s, %.1fx real time\r\n",
+		B->num_jobs, B->failed, B->num_workers, audio, B->seconds, (B->seconds > 0) ? audio / B->seconds : 0.0);
+	print(line);
+	snprintf(line, sizeof(line), "  %.2f s in jobs, %.2fx over one worker, %.0f%% of linear\r\n",
+		busy, (B->seconds > 0) ? busy / B->seconds : 0.0, (B->seconds > 0) ? 100.0 * busy / (B->seconds * B->num_workers) : 0.0);
+	print(line);
+
+	for(i = 0; i < B->num_workers; i++) {
+		W = &(B->workers[i]);
+		snprintf(line, sizeof(line), "  worker %2d: %3d jobs, %3d stolen, busy %.2f s\r\n", W->id, W->jobs, W->stolen, W->busy);
+		print(line);
+	}
+
+}
+
+
+/**
+ * @brief [give back the scratch arenas]
+ *
+ * @param B [pointer to the batch]
+ */
+void close_batch(BATCH_T * B) {
+
+	int i;
+
+	for(i = 0; i < B->num_workers; i++) {
+		free(B->workers[i].pool);
+		B->workers[i].pool = NULL;
+	}
+
+}
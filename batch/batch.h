@@ -0,0 +1,182 @@
+/**
+ * @file batch.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for rendering a grid of
+ * presets over a set of recordings on every core of a host.
+ *
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef BATCH_H
+#define BATCH_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include "arena.h"
+#include "render.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define BATCH_MAX_WORKERS	64		// most threads
+#define BATCH_PATH			512		// longest output file name
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [one preset rendered over one file]
+ *
+ */
+typedef struct batch_job_struct {
+	int preset;					// index into render_presets[]
+	const char * input;			// file to render
+	char output[BATCH_PATH];	// file written, <out_dir>/<input name>_pNN.wav
+	int64_t bytes;				// size of the input, the longest jobs are handed out first
+	int64_t frames;				// output frames written
+	double audio;				// seconds of audio written
+	double seconds;				// wall clock time of the whole job, opening the files to closing them
+	int worker;					// worker that ran it
+	int failed;					// 0, or 1 if it couldn't be read, planned or written
+} BATCH_JOB_T;
+
+
+/**
+ * @brief [jobs waiting for one worker]
+ * @details [the worker takes jobs from the head, a worker that has run out steals from the tail,
+ * so the owner and a thief only meet over the last job]
+ *
+ */
+typedef struct batch_queue_struct {
+	pthread_mutex_t lock;		// held for a take or a steal
+	int * jobs;					// job indices
+	int head;					// next job the owner takes
+	int tail;					// one past the job a thief takes
+} BATCH_QUEUE_T;
+
+
+/**
+ * @brief [one thread of the pool]
+ * @details [each worker has its own arena, every job's files, converters, lowpass and chain are
+ * planned in it and it is reset for the next job]
+ *
+ */
+typedef struct batch_worker_struct {
+	struct batch_struct * B;	// batch it works for
+	int id;						// index in the pool
+	pthread_t thread;			// the thread, worker 0 runs on the caller's
+	int started;				// the thread was started
+	BATCH_QUEUE_T queue;		// jobs dealt to it
+	uint8_t * pool;				// RENDER_ARENA_BYTES of scratch
+	ARENA_T arena;				// over the pool
+	int jobs;					// jobs run
+	int stolen;					// of those, taken from another worker
+	double busy;				// seconds spent in jobs
+} BATCH_WORKER_T;
+
+
+/**
+ * @brief [structure containing the job grid and the pool]
+ *
+ */
+typedef struct batch_struct {
+	BATCH_JOB_T * jobs;				// presets x files
+	int num_jobs;					// number of jobs
+	int num_workers;				// threads in the pool
+	BATCH_WORKER_T * workers;		// the pool
+	RENDER_OPTS_T opts;				// how each job is rendered
+	pthread_mutex_t plan_lock;		// the design cache and the fir wisdom are shared, planning is one at a time
+	double seconds;					// wall clock time of run_batch()
+	int failed;						// jobs that failed
+} BATCH_T;
+
+
+/**
+ * @brief [build the job grid and the pool]
+ * @details [the pool's scratch arenas are malloc'd here, RENDER_ARENA_BYTES each, and given back
+ * by close_batch()]
+ *
+ * @param A [arena the jobs and workers are allocated from]
+ * @param files [recordings to render]
+ * @param num_files [number of recordings]
+ * @param presets [preset numbers, 1 to RENDER_NUM_PRESETS]
+ * @param num_presets [number of presets]
+ * @param out_dir [directory the outputs are written to]
+ * @param num_workers [threads, 1 to BATCH_MAX_WORKERS]
+ * @param opts [how each job is rendered]
+ * @return [pointer to the batch, NULL for a bad preset or output name, or if it doesn't fit]
+ */
+BATCH_T * init_batch(
+	ARENA_T * A,						// arena to allocate from
+	const char * const * files,			// recordings
+	int num_files,						// number of recordings
+	const int * presets,				// preset numbers
+	int num_presets,					// number of presets
+	const char * out_dir,				// where the outputs go
+	int num_workers,					// threads
+	const RENDER_OPTS_T * opts			// how to render
+);
+
+
+/**
+ * @brief [run every job on the pool and wait for them all]
+ *
+ * @param B [pointer to the batch]
+ * @return [number of jobs that failed]
+ */
+int run_batch(
+	BATCH_T * B				// pointer to batch
+);
+
+
+/**
+ * @brief [write every job and its timing to a csv file]
+ *
+ * @param B [pointer to a batch that has run]
+ * @param path [file name]
+ * @return [0 on success, 1 if it couldn't be written]
+ */
+int write_batch_summary(
+	const BATCH_T * B,		// pointer to batch
+	const char * path		// file name
+);
+
+
+/**
+ * @brief [print the totals, the speedup over one core and what each worker did]
+ *
+ * @param B [pointer to a batch that has run]
+ * @param print [prints one line]
+ */
+void report_batch(
+	const BATCH_T * B,				// pointer to batch
+	void (*print)(const char *)		// prints one line
+);
+
+
+/**
+ * @brief [give back the scratch arenas]
+ *
+ * @param B [pointer to the batch]
+ */
+void close_batch(
+	BATCH_T * B				// pointer to batch
+);
+
+
+#endif
@@ -11,6 +11,10 @@
  * 		init_rms() - initialize rms struct for calculations
  * 		
  * 		calc_rms() - do the rms calculation on a block of samples
+ * 		
+ * 		reset_rms() - clear the history back to silence
+ * 		
+ * 		init_rms_q31(), calc_rms_q31() - the same on Q15 samples with an exact integer running sum
  * ]
  * 
  */
@@ -19,8 +23,9 @@
 // INCLUDE --------------------------------------------------
 
 #include <stdio.h>
-#include <stdlib.h>
-#include <math.h>
+#include "fast_math.h"
+#include "arena.h"
+#include "fixed.h"
  
 #include "calc_rms.h"
 
@@ -32,41 +37,28 @@
 /**
  * @brief [initialize struct for rms calculations]
  * @details [contains circular buffer variables for the previous mean-square
- * values and the output array holding the rms values]
+ * values]
  * 
+ * @param A [arena the struct and history are allocated from]
  * @param window_size [number of samples to average over to calculate the rms values]
- * @param block_size [number of samples to work on from input buffer]
  * 
- * @return [pointer to the rms struct]
+ * @return [pointer to the rms struct, NULL if it doesn't fit in the arena]
  */
-RMS_T * init_rms(int window_size, int block_size) {
-
-	int i, j;
+RMS_T * init_rms(ARENA_T * A, int window_size) {
 
 	// set up struct for rms calculation ----------------------------------
-	RMS_T * V = (RMS_T *)malloc(sizeof(RMS_T));	// allocate struct
-	if(V == NULL) return NULL;					// errcheck malloc
+	RMS_T * V = (RMS_T *)arena_alloc(A, sizeof(RMS_T));	// allocate struct
+	if(V == NULL) return NULL;							// errcheck alloc
 
 	V->window_size = window_size;	// number of samples to average over
-	V->block_size = block_size;		// number of input and output samples
 	V->old_s = 0.0;					// sum of previous square values
 	V->index = 0;					// index through previous square values
 
 
 	// initialize history of old window_size square samples ---------------
-	V->history = (float *)malloc(sizeof(float) * (window_size - 1));	// sizeof window to average over - 1
+	// arena memory comes back zeroed, so the history starts out silent
+	V->history = (float *)arena_alloc(A, sizeof(float) * (window_size - 1));	// sizeof window to average over - 1
 	if(V->history == NULL) return NULL;
-	for(i = 0; i < (window_size - 1); i++) {
-		V->history[i] = 0.0;
-	}
-
-
-	// initialize output array --------------------------------------------
-	V->output = (float *)malloc(sizeof(float) * block_size);	// sizeof window to average over
-	if(V->output == NULL) return NULL;
-	for(j = 0; j < block_size; j++) {
-		V->output[j] = 0.0;
-	}
 
 
 	// return pointer to the struct ---------------------------------------
@@ -80,23 +72,25 @@ RMS_T * init_rms(int window_size, int block_size) {
  * @details [Using a circular buffer to contain the last window_size samples,
  * a running total is kept of the square, so there is no need to re-calculate
  * the new average by going through every old sample, instead there is only one new
- * sample to calculate]
+ * sample to calculate. input and output can be the same buffer]
  * 
  * @param V [struct containing fields necessary for rms calculation]
- * @param input [buffer containing input samples to work on]
+ * @param input [buffer containing n input samples to work on]
+ * @param output [buffer for the n rms values]
+ * @param n [number of samples to work on]
  */
-void calc_rms(RMS_T * V, float * input) {
+void calc_rms(RMS_T * V, const float * input, float * output, int n) {
 
 	int i;
 	float new_s;
 
-	for(i = 0; i < V->block_size; i++) {
+	for(i = 0; i < n; i++) {
 
 		// new square value 
 		new_s = (input[i] * input[i]);
 
 		// y[n] = sqrt( previous window_size samples squared / window_size)
-		V->output[i] = /*0.6667 */ (sqrt((V->old_s + new_s) / V->window_size)) /*- 1.0*/;
+		output[i] = /*0.6667 */ (fast_sqrtf((V->old_s + new_s) / V->window_size)) /*- 1.0*/;
 
 		// subtract oldest value out of running square
 		V->old_s -= V->history[V->index];
@@ -117,4 +111,77 @@ void calc_rms(RMS_T * V, float * input) {
 
 	}
 
-}
\ No newline at end of file
+}
+
+
+/**
+ * @brief [clear the history back to silence]
+ * 
+ * @param V [struct containing fields necessary for rms calculation]
+ */
+void reset_rms(RMS_T * V) {
+
+	int i;
+
+	for(i = 0; i < V->window_size - 1; i++) V->history[i] = 0.0;
+	V->old_s = 0.0;
+	V->index = 0;
+
+}
+
+
+/**
+ * @brief [initialize struct for fixed point rms calculations]
+ * 
+ * @param A [arena the struct and history are allocated from]
+ * @param window_size [number of samples to average over to calculate the rms values]
+ * @return [pointer to the rms struct, NULL if it doesn't fit in the arena]
+ */
+RMS_Q31_T * init_rms_q31(ARENA_T * A, int window_size) {
+
+	RMS_Q31_T * V = (RMS_Q31_T *)arena_alloc(A, sizeof(RMS_Q31_T));	// allocate struct
+	if(V == NULL) return NULL;										// errcheck alloc
+
+	V->window_size = window_size;
+	V->old_s = 0;
+	V->index = 0;
+
+	// arena memory comes back zeroed, so the history starts out silent
+	V->history = (q31_t *)arena_alloc(A, sizeof(q31_t) * (window_size - 1));
+	if(V->history == NULL) return NULL;
+
+	return V;
+
+}
+
+
+/**
+ * @brief [rms value of the last window_size Q15 input samples, in Q15]
+ * @details [the mean square is Q30, so its square root is the Q15 rms. the root is the one 
+ * step done in float, the hardware sqrt is faster than an integer one]
+ * 
+ * @param V [struct containing fields necessary for rms calculation]
+ * @param input [buffer containing n Q15 input samples to work on]
+ * @param output [buffer for the n Q15 rms values]
+ * @param n [number of samples to work on]
+ */
+void calc_rms_q31(RMS_Q31_T * V, const q15_t * input, q15_t * output, int n) {
+
+	int i;
+	int32_t rms;
+	q31_t new_s;
+
+	for(i = 0; i < n; i++) {
+
+		new_s = (q31_t)input[i] * input[i];
+
+		rms = (int32_t)(fast_sqrtf((float)((V->old_s + new_s) / V->window_size)) + 0.5f);
+		output[i] = (q15_t)((rms > Q15_MAX) ? Q15_MAX : rms);
+
+		V->old_s += new_s - V->history[V->index];
+		V->history[V->index] = new_s;
+		V->index = (V->index == (V->window_size - 2)) ? 0 : (V->index + 1);
+
+	}
+
+}
@@ -23,6 +23,9 @@
 
 #include <stdint.h>
 
+#include "arena.h"
+#include "fixed.h"
+
 // ---------------------------------------------------------
 
 
@@ -34,27 +37,39 @@
  */
 typedef struct rms_struct {  
 	int window_size;    // number of samples to average over  		
-	int block_size;  	// number of input and output samples
 	float old_s; 		// sum of previous square values
 	float * history;   	// buffer containing previous square values
 	int index;			// index through previous square values, will point to oldest sample
-	float * output;  	// buffer for output rms values
 } RMS_T;
 
 
+/**
+ * @brief [structure containing the fields for the fixed point rms calculation]
+ * @details [the squares are Q30 and the running sum is a 64 bit integer, so unlike the float
+ * running sum it never drifts from adding and subtracting the same values]
+ * 
+ */
+typedef struct rms_q31_struct {
+	int window_size;	// number of samples to average over
+	int64_t old_s;		// sum of previous Q30 square values, exact
+	q31_t * history;	// buffer containing previous Q30 square values
+	int index;			// index through the history
+} RMS_Q31_T;
+
+
 /**
  * @brief [initialize struct for rms calculations]
  * @details [contains circular buffer variables for the previous mean-square
- * values and the output array holding the rms values]
+ * values]
  * 
+ * @param A [arena the struct and history are allocated from]
  * @param window_size [number of samples to average over to calculate the rms values]
- * @param block_size [number of samples to work on from input buffer]
  * 
- * @return [pointer to the rms struct]
+ * @return [pointer to the rms struct, NULL if it doesn't fit in the arena]
  */
 RMS_T * init_rms(
-	int window_size, 	// number of samples to average over			   
-	int block_size		// number of input and output samples
+	ARENA_T * A,		// arena to allocate from
+	int window_size 	// number of samples to average over			   
 );
 
 
@@ -63,15 +78,59 @@ RMS_T * init_rms(
  * @details [Using a circular buffer to contain the last window_size samples
  * a running total is kept of the mean-square, so there is no need to re-calculate
  * the new average by going through every old sample, instead there is only one new
- * sample to calculate]
+ * sample to calculate. input and output can be the same buffer]
  * 
  * @param R [struct containing fields necessary for rms calculation]
- * @param input [buffer containing input samples to work on]
+ * @param input [buffer containing n input samples to work on]
+ * @param output [buffer for the n rms values]
+ * @param n [number of samples to work on]
  */
 void calc_rms(
-	RMS_T * R,			// pointer to rms struct
-	float * input		// buffer containing input samples to work on
+	RMS_T * R,				// pointer to rms struct
+	const float * input,	// buffer containing input samples to work on
+	float * output,			// buffer for rms values
+	int n					// number of samples to work on
+);
+
+
+/**
+ * @brief [clear the history back to silence]
+ * 
+ * @param R [struct containing fields necessary for rms calculation]
+ */
+void reset_rms(
+	RMS_T * R				// pointer to rms struct
+);
+
+
+/**
+ * @brief [initialize struct for fixed point rms calculations]
+ * 
+ * @param A [arena the struct and history are allocated from]
+ * @param window_size [number of samples to average over to calculate the rms values]
+ * @return [pointer to the rms struct, NULL if it doesn't fit in the arena]
+ */
+RMS_Q31_T * init_rms_q31(
+	ARENA_T * A,			// arena to allocate from
+	int window_size			// number of samples to average over
+);
+
+
+/**
+ * @brief [rms value of the last window_size Q15 input samples, in Q15]
+ * @details [same window as calc_rms(). input and output can be the same buffer]
+ * 
+ * @param R [struct containing fields necessary for rms calculation]
+ * @param input [buffer containing n Q15 input samples to work on]
+ * @param output [buffer for the n Q15 rms values]
+ * @param n [number of samples to work on]
+ */
+void calc_rms_q31(
+	RMS_Q31_T * R,			// pointer to rms struct
+	const q15_t * input,	// buffer containing input samples to work on
+	q15_t * output,			// buffer for rms values
+	int n					// number of samples to work on
 );
 
 
-#endif
\ No newline at end of file
+#endif
@@ -10,18 +10,24 @@
  * @details [
  * 		init_compressor() - initialize compressor struct that holds the data for the compressor calculation
  * 		
- * 		calc_compressor() - do the compressor calculation on a block on samples
+ * 		calc_compressor() - rms detection and compression in one pass over a block of samples, feeding the energy index
+ * 		
+ * 		reset_compressor() - clear the rms detection back to silence
  * ]
  * 
+ * The compressor squares every input sample for its own running mean-square, so it also feeds
+ * those squares into an energy index as it goes. Other level detectors (meters, a gate) can query
+ * the index for their own windows without another pass over the input.
+ * 
  */
 
 
 // INCLUDE ----------------------------------------------------
 
 #include <stdio.h>
-#include <stdlib.h>
 #include <math.h>
-#include "ece486.h"
+#include "fast_math.h"
+#include "arena.h"
  
 #include "compressor.h"
 
@@ -33,30 +39,41 @@
 /**
  * @brief [initialize compressor structure necessary for compressor calculation]
  * 
+ * @param A [arena the compressor, its rms detection and energy index are allocated from]
  * @param threshold_db [level in db to pass for compressor to kick in]
  * @param ratio [amount to compress by once the threshold is passed]
- * @param block_size [amount of samples to work on]
- * @return [pointer to the compressor struct]
+ * @param window_size [number of samples the rms detection averages over]
+ * @param block_size [number of samples in a block, the granularity of the energy index]
+ * @return [pointer to the compressor struct, NULL if it doesn't fit in the arena]
  */
- COMP_T * init_compressor(float threshold_db, float ratio, int block_size) {
-
- 	int i;
+ COMP_T * init_compressor(ARENA_T * A, float threshold_db, float ratio, int window_size, int block_size) {
 
  	// initialize compressor struct ----------------------------------------
- 	COMP_T * C = (COMP_T *)malloc(sizeof(COMP_T));
+ 	COMP_T * C = (COMP_T *)arena_alloc(A, sizeof(COMP_T));
  	if(C == NULL) return NULL;
 
 	// dB = 20log10(RMS)
- 	C->threshold_rms = pow(10, (threshold_db / 20.0));
+ 	C->threshold_rms = db_to_gain(threshold_db);
+
+ 	// mean-square threshold. this is the largest mean-square value whose sqrt is still not 
+ 	// above threshold_rms, so comparing the mean-square against it gives exactly the same 
+ 	// decision as comparing sqrt(mean-square) against threshold_rms
+ 	C->threshold_ms = C->threshold_rms * C->threshold_rms;
+ 	while(sqrtf(C->threshold_ms) > C->threshold_rms) {
+ 		C->threshold_ms = nextafterf(C->threshold_ms, 0.0);
+ 	}
+ 	while(sqrtf(nextafterf(C->threshold_ms, INFINITY)) <= C->threshold_rms) {
+ 		C->threshold_ms = nextafterf(C->threshold_ms, INFINITY);
+ 	}
  	C->ratio = ratio;
- 	C->block_size = block_size;
 
- 	// initialize compressor output buffer
- 	C->output = (float *)malloc(sizeof(float) * block_size);
- 	if(C->output == NULL) return NULL;
- 	for(i = 0; i < block_size; i++) {
- 		C->output[i] = 0.0;
- 	}
+ 	// initialize rms detection --------------------------------------------
+ 	C->V = init_rms(A, window_size);
+ 	if(C->V == NULL) return NULL;
+
+ 	// exact windows at every block boundary, up to the rms window
+ 	C->E = init_energy_index(A, (window_size > block_size) ? window_size : block_size, block_size);
+ 	if(C->E == NULL) return NULL;
 
 
  	// return pointer to comp struct ---------------------------------------
@@ -67,23 +84,82 @@
 
 /**
  * @brief [compresses the input signal once the rms level passes the threshold entered into the initialize function]
+ * @details [rms detection and compression are done in a single pass over the input. the rms value 
+ * for each sample is used as soon as it is calculated, and the sqrt is dropped by comparing the 
+ * running mean-square against the mean-square threshold, which gives the same decision 
+ * (see init_compressor). the squares are summed up to each granularity boundary of the energy
+ * index and added to it there. input and output can be the same buffer]
  * 
  * @param C [pointer to the compressor struct]
- * @param rms_vals [the rms values of the input, to check and see if the input needs to be compressed]
- * @param input [buffer containing samples to work on]
+ * @param input [buffer containing n samples to work on]
+ * @param output [buffer for n compressed samples]
+ * @param n [number of samples to work on]
  */
- void calc_compressor(COMP_T * C, float * rms_vals, float * input) {
+ void calc_compressor(COMP_T * C, const float * input, float * output, int n) {
+
+ 	int i, run;
+ 	float x, new_s, mean_s, energy;
+ 	RMS_T * V = C->V;
+ 	ENERGY_T * E = C->E;
+
+ 	// the block is walked in runs that end on the energy index's boundaries
+ 	while(n > 0) {
+
+ 		run = E->granularity - E->partial_count;
+ 		if(run > n) run = n;
+ 		energy = 0.0;
+
+ 		for(i = 0; i < run; i++) {
+
+ 			x = input[i];
+
+ 			// DETECT -----------------------------------------------------------------------------------------
+ 			// same running mean-square as calc_rms
+ 			new_s = (x * x);
+ 			mean_s = (V->old_s + new_s) / V->window_size;
+
+ 			V->old_s -= V->history[V->index];
+ 			V->old_s += new_s;
+ 			V->history[V->index] = new_s;
+ 			energy += new_s;
 
- 	int i;
+ 			if(V->index == (V->window_size - 2)) {	
+ 				V->index = 0;
+ 			} else {
+ 				V->index++;
+ 			}
+
+
+ 			// COMPRESS ---------------------------------------------------------------------------------------
+ 			// for every sample, compress if rms value breaches threshold
+ 			if(mean_s > C->threshold_ms) {
+ 				// output[i] = 20 * log10((C->threshold_rms + ((x - C->threshold_rms) / C->ratio)));
+ 				output[i] = x * 0.5;
+ 			} else {
+ 				output[i] = x;
+ 			}
 
- 	// for every sample, compress if rms value breaches threshold -----------------------------------------
- 	for(i = 0; i < C->block_size; i++) {
- 		if(rms_vals[i] > C->threshold_rms) {
- 			// C->output[i] = 20 * log10((C->threshold_rms + ((input[i] - C->threshold_rms) / C->ratio)));
- 			C->output[i] = input[i] * 0.5;
- 		} else {
- 			C->output[i] = input[i];
  		}
+
+ 		// same squares, summed in the same order as update_energy_index()
+ 		energy_index_add(E, energy, run);
+ 		input += run;
+ 		output += run;
+ 		n -= run;
+
  	}
 
- }
\ No newline at end of file
+ }
+
+
+/**
+ * @brief [clear the rms detection back to silence]
+ * 
+ * @param C [pointer to the compressor struct]
+ */
+void reset_compressor(COMP_T * C) {
+
+	reset_rms(C->V);
+	reset_energy_index(C->E);
+
+}
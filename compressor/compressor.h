@@ -22,6 +22,10 @@
 
 #include <stdint.h>
 
+#include "arena.h"
+#include "calc_rms.h"
+#include "energy_index.h"
+
 // -------------------------------------------------------------------
 
 
@@ -33,9 +37,10 @@
  */
 typedef struct comp_struct {
 	float threshold_rms;	// rms level to pass for compressor to kick in
+	float threshold_ms;		// mean-square level to pass for compressor to kick in
 	float ratio;			// amount to compress by
-	float * output;			// buffer containing output (compressed samples)
-	int block_size;
+	RMS_T * V;				// rms detection of the input
+	ENERGY_T * E;			// energy of the input for other level detectors, one entry per block
 } COMP_T;
 
 
@@ -43,31 +48,50 @@ typedef struct comp_struct {
  * @brief [initialize compressor structure necessary for compressor calculation]
  * @details [long description]
  * 
+ * @param A [arena the compressor, its rms detection and energy index are allocated from]
  * @param threshold_db [level in db to pass for compressor to kick in]
  * @param ratio [amount to compress by once the threshold is passed]
- * @param block_size [amount of samples to work on]
- * @return [pointer to the compressor struct]
+ * @param window_size [number of samples the rms detection averages over]
+ * @param block_size [number of samples in a block, the granularity of the energy index]
+ * @return [pointer to the compressor struct, NULL if it doesn't fit in the arena]
  */
 COMP_T * init_compressor(
+	ARENA_T * A,			// arena to allocate from
 	float threshold_dB,		// level in dB 
 	float ratio,			// amount to compress by
-	int block_size			// number of samples to work on
+	int window_size,		// number of samples to average over for rms detection
+	int block_size			// number of samples in a block
 );
 
 
 /**
  * @brief [compresses the input signal once the rms level passes the threshold entered into the initialize function]
- * @details [long description]
+ * @details [rms detection and compression in one pass, the squares go into the energy index
+ * on the way. n can be any length. input and output can be the same buffer]
  * 
  * @param C [pointer to the compressor struct]
- * @param rms_vals [the rms values of the input, to check and see if the input needs to be compressed]
- * @param input [buffer containing samples to work on]
+ * @param input [buffer containing n samples to work on]
+ * @param output [buffer for n compressed samples]
+ * @param n [number of samples to work on]
  */
 void calc_compressor(
 	COMP_T * C,				// pointer to comp struct
-	float * rms_vals,		// block_size number of rms values from rms routine
-	float * input			// buffer containing input samples from adc
+	const float * input,	// buffer containing input samples
+	float * output,			// buffer for compressed samples
+	int n					// number of samples to work on
 );	
 
 
-#endif
\ No newline at end of file
+/**
+ * @brief [clear the rms detection back to silence]
+ * @details [the output is the input times a gain, so silence in is silence out and the
+ * compressor has no tail to wait for]
+ * 
+ * @param C [pointer to the compressor struct]
+ */
+void reset_compressor(
+	COMP_T * C				// pointer to comp struct
+);
+
+
+#endif
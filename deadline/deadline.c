@@ -0,0 +1,230 @@
+/**
+ * @file deadline.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for the block deadline monitor.
+ * 
+ * @details [
+ * 		init_deadline() - set up the monitor for an io struct
+ * 		
+ * 		deadline_done() - check a finished block against its deadline
+ * 		
+ * 		deadline_stats() - snapshot of the counters
+ * 		
+ * 		deadline_safe() - no misses, no dropped blocks, and enough slack left
+ * 		
+ * 		report_deadline() - print the counters and the response time histogram
+ * ]
+ * 
+ * The adc and dac DMA run in lock step (see dma_io.c). When the adc finishes half k the dac
+ * has just finished playing half k, and comes back around to it one block period later. A
+ * block that isn't written by then doesn't stop anything, the dac just plays the old half 
+ * again, so the glitch is only visible here: a response time past the period is a missed 
+ * deadline. Blocks the loop never picked up come from the io struct's overrun counter, adc
+ * overruns and DMA errors from its error counter, and samples the dac DMA didn't deliver in
+ * time from its underrun counter.
+ * 
+ * Everything is in the struct, a fixed histogram of the response time in steps of 
+ * DEADLINE_BIN_PERCENT of the block period, so it can run for the whole gig. Run a chain 
+ * through its worst case settings for a while and check deadline_safe() before taking it on stage.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "dma_io.h"
+#include "profiler.h"
+#include "trace.h"
+#include "deadline.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [initialize the deadline monitor for an io struct]
+ * 
+ * @param A [arena the struct is allocated from]
+ * @param IO [io the blocks come from, NULL to only use deadline_record()]
+ * @param block_size [samples per block]
+ * @param FS [sampling frequency]
+ * @return [pointer to the deadline struct, NULL if it doesn't fit in the arena]
+ */
+DEADLINE_T * init_deadline(ARENA_T * A, DMA_IO_T * IO, int block_size, int FS) {
+
+	// set up struct for the monitor --------------------------------------------
+	DEADLINE_T * D = (DEADLINE_T *)arena_alloc(A, sizeof(DEADLINE_T));	// allocate struct
+	if(D == NULL) return NULL;											// errcheck alloc
+
+	D->IO = IO;
+	D->period = (uint32_t)(((uint64_t)profile_ticks_per_sec() * block_size) / FS);
+
+	profile_start_clock();
+	reset_deadline(D);
+
+	return D;
+
+}
+
+
+/**
+ * @brief [a block has been written to the dac half, check it against its deadline]
+ * 
+ * @param D [pointer to the deadline struct]
+ */
+void deadline_done(DEADLINE_T * D) {
+
+	deadline_record(D, D->IO->release, profile_now());
+
+}
+
+
+/**
+ * @brief [record one block from its release and finish times]
+ * 
+ * @param D [pointer to the deadline struct]
+ * @param release [tick the block was released]
+ * @param finish [tick the block was finished]
+ */
+void deadline_record(DEADLINE_T * D, uint32_t release, uint32_t finish) {
+
+	uint32_t response = finish - release;	// unsigned, so a wrap of the counter comes out right
+	int32_t slack = (int32_t)(D->period - response);
+	uint32_t bin;
+
+	if(response < D->min_response) D->min_response = response;
+	if(response > D->max_response) D->max_response = response;
+	if(slack < D->min_slack) D->min_slack = slack;
+
+	// everything past the deadline goes in the last bin
+	if(response > D->period) {
+		D->missed++;
+		TRACE_INSTANT("deadline missed", slack);
+		bin = DEADLINE_BINS - 1;
+	} else {
+		bin = (uint32_t)(((uint64_t)response * 100) / ((uint64_t)D->period * DEADLINE_BIN_PERCENT));
+		if(bin > DEADLINE_BINS - 2) bin = DEADLINE_BINS - 2;	// exactly on the deadline
+	}
+	D->hist[bin]++;
+
+	D->blocks++;
+
+}
+
+
+/**
+ * @brief [clear the counters and the histogram]
+ * 
+ * @param D [pointer to the deadline struct]
+ */
+void reset_deadline(DEADLINE_T * D) {
+
+	D->blocks = 0;
+	D->missed = 0;
+	D->min_response = UINT32_MAX;
+	D->max_response = 0;
+	D->min_slack = INT32_MAX;
+	memset(D->hist, 0, sizeof(D->hist));
+
+	// the io counters keep going, count from here
+	D->overruns_base = (D->IO != NULL) ? D->IO->overruns : 0;
+	D->errors_base = (D->IO != NULL) ? D->IO->errors : 0;
+	D->underruns_base = (D->IO != NULL) ? D->IO->underruns : 0;
+
+}
+
+
+/**
+ * @brief [take a snapshot of the counters]
+ * 
+ * @param D [pointer to the deadline struct]
+ * @param S [filled in with the snapshot]
+ */
+void deadline_stats(const DEADLINE_T * D, DEADLINE_STATS_T * S) {
+
+	memset(S, 0, sizeof(DEADLINE_STATS_T));
+
+	S->blocks = D->blocks;
+	S->missed = D->missed;
+	if(D->IO != NULL) {
+		S->overruns = D->IO->overruns - D->overruns_base;
+		S->errors = D->IO->errors - D->errors_base;
+		S->underruns = D->IO->underruns - D->underruns_base;
+	}
+	if(S->blocks == 0) return;
+
+	S->min_response = D->min_response;
+	S->max_response = D->max_response;
+	S->jitter = D->max_response - D->min_response;
+	S->min_slack = D->min_slack;
+	S->worst_percent = (int)(((uint64_t)D->max_response * 100) / D->period);
+
+}
+
+
+/**
+ * @brief [is the chain safe to play on]
+ * 
+ * @param D [pointer to the deadline struct]
+ * @param margin_percent [part of the block period that has to be left over, in percent]
+ * @return [1 if safe, 0 if not, or if no blocks have been recorded]
+ */
+int deadline_safe(const DEADLINE_T * D, int margin_percent) {
+
+	DEADLINE_STATS_T S;
+
+	deadline_stats(D, &S);
+
+	if(S.blocks == 0) return 0;
+	if(S.missed > 0 || S.overruns > 0 || S.errors > 0 || S.underruns > 0) return 0;
+	return (S.worst_percent <= 100 - margin_percent);
+
+}
+
+
+/**
+ * @brief [print the counters and the response time histogram]
+ * 
+ * @param D [pointer to the deadline struct]
+ * @param print [prints one line, UART_putstr on the board]
+ */
+void report_deadline(const DEADLINE_T * D, void (*print)(const char *)) {
+
+	int i;
+	char line[128];
+	DEADLINE_STATS_T S;
+
+	deadline_stats(D, &S);
+
+	snprintf(line, sizeof(line), "deadline: %lu blocks, %lu missed, %lu dropped, %lu adc/DMA errors, %lu dac underruns\r\n",
+		(unsigned long)S.blocks, (unsigned long)S.missed, (unsigned long)S.overruns, (unsigned long)S.errors, (unsigned long)S.underruns);
+	print(line);
+	if(S.blocks == 0) return;
+
+	snprintf(line, sizeof(line), "  response %lu to %lu ticks (jitter %lu), worst %d%% of %lu, least slack %ld\r\n",
+		(unsigned long)S.min_response, (unsigned long)S.max_response, (unsigned long)S.jitter,
+		S.worst_percent, (unsigned long)D->period, (long)S.min_slack);
+	print(line);
+
+	// only the bins with blocks in them
+	for(i = 0; i < DEADLINE_BINS; i++) {
+		if(D->hist[i] == 0) continue;
+		if(i == DEADLINE_BINS - 1) {
+			snprintf(line, sizeof(line), "  %9s %lu\r\n", "late", (unsigned long)D->hist[i]);
+		} else {
+			snprintf(line, sizeof(line), "  %3d-%3d%% %lu\r\n", i * DEADLINE_BIN_PERCENT, 
+				(i + 1) * DEADLINE_BIN_PERCENT, (unsigned long)D->hist[i]);
+		}
+		print(line);
+	}
+
+}
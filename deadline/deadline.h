@@ -0,0 +1,174 @@
+/**
+ * @file deadline.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for 
+ * the block deadline monitor: how close each block comes to the dac catching up with it.
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "dma_io.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define DEADLINE_BIN_PERCENT	5		// width of a histogram bin, in percent of the block period
+#define DEADLINE_BINS			21		// 20 bins up to the deadline, the last one is every missed block
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [structure containing the deadline counters and the response time histogram]
+ * @details [a block is released when the adc DMA finishes its half, and has to be written into
+ * the matching dac half within one block period, before the dac comes back around to it. the
+ * response time is from the release to the end of processing, the slack is what's left of the
+ * period. times are in ticks of profile_now()]
+ * 
+ */
+typedef struct deadline_struct {
+	DMA_IO_T * IO;					// io the blocks come from, for the release time and DMA counters
+	uint32_t period;				// ticks in one block period
+	uint32_t blocks;				// blocks finished
+	uint32_t missed;				// blocks finished after the deadline (the dac played a stale half)
+	uint32_t min_response;			// fastest block
+	uint32_t max_response;			// slowest block
+	int32_t min_slack;				// least time left before a deadline, negative once one is missed
+	uint32_t hist[DEADLINE_BINS];	// blocks in each DEADLINE_BIN_PERCENT of the period
+	int overruns_base;				// IO->overruns at the last reset
+	int errors_base;				// IO->errors at the last reset
+	int underruns_base;				// IO->underruns at the last reset
+} DEADLINE_T;
+
+
+/**
+ * @brief [snapshot of the deadline monitor, returned by deadline_stats()]
+ * 
+ */
+typedef struct deadline_stats_struct {
+	uint32_t blocks;			// blocks finished
+	uint32_t missed;			// blocks past the deadline (the dac played the old half again)
+	uint32_t overruns;			// adc blocks dropped before the loop picked them up
+	uint32_t errors;			// adc overruns and DMA errors from the hal
+	uint32_t underruns;			// dac DMA underruns from the hal
+	uint32_t min_response;		// fastest block, in ticks
+	uint32_t max_response;		// slowest block, in ticks
+	uint32_t jitter;			// max_response - min_response
+	int32_t min_slack;			// least time left before a deadline, in ticks
+	int worst_percent;			// slowest block in percent of the block period
+} DEADLINE_STATS_T;
+
+
+/**
+ * @brief [initialize the deadline monitor for an io struct]
+ * 
+ * @param A [arena the struct is allocated from]
+ * @param IO [io the blocks come from, NULL to only use deadline_record()]
+ * @param block_size [samples per block]
+ * @param FS [sampling frequency]
+ * @return [pointer to the deadline struct, NULL if it doesn't fit in the arena]
+ */
+DEADLINE_T * init_deadline(
+	ARENA_T * A,		// arena to allocate from
+	DMA_IO_T * IO,		// io the blocks come from
+	int block_size,		// samples per block
+	int FS				// sampling frequency
+);
+
+
+/**
+ * @brief [a block has been written to the dac half, check it against its deadline]
+ * @details [call at the end of processing, in the loop or in the DMA interrupt]
+ * 
+ * @param D [pointer to the deadline struct]
+ */
+void deadline_done(
+	DEADLINE_T * D		// pointer to deadline struct
+);
+
+
+/**
+ * @brief [record one block from its release and finish times]
+ * 
+ * @param D [pointer to the deadline struct]
+ * @param release [tick the block was released]
+ * @param finish [tick the block was finished]
+ */
+void deadline_record(
+	DEADLINE_T * D,			// pointer to deadline struct
+	uint32_t release,		// tick the block was released
+	uint32_t finish			// tick the block was finished
+);
+
+
+/**
+ * @brief [clear the counters and the histogram]
+ * 
+ * @param D [pointer to the deadline struct]
+ */
+void reset_deadline(
+	DEADLINE_T * D		// pointer to deadline struct
+);
+
+
+/**
+ * @brief [take a snapshot of the counters]
+ * @details [can be read while blocks are being recorded from the DMA interrupt]
+ * 
+ * @param D [pointer to the deadline struct]
+ * @param S [filled in with the snapshot]
+ */
+void deadline_stats(
+	const DEADLINE_T * D,		// pointer to deadline struct
+	DEADLINE_STATS_T * S		// snapshot of the counters
+);
+
+
+/**
+ * @brief [is the chain safe to play on]
+ * @details [no missed deadlines, no dropped blocks, no adc or dac DMA faults, and the slowest
+ * block left at least margin_percent of the period to spare]
+ * 
+ * @param D [pointer to the deadline struct]
+ * @param margin_percent [part of the block period that has to be left over, in percent]
+ * @return [1 if safe, 0 if not, or if no blocks have been recorded]
+ */
+int deadline_safe(
+	const DEADLINE_T * D,		// pointer to deadline struct
+	int margin_percent			// slack to require, in percent of the period
+);
+
+
+/**
+ * @brief [print the counters and the response time histogram]
+ * 
+ * @param D [pointer to the deadline struct]
+ * @param print [prints one line, UART_putstr on the board]
+ */
+void report_deadline(
+	const DEADLINE_T * D,			// pointer to deadline struct
+	void (*print)(const char *)		// prints one line
+);
+
+
+#endif
@@ -11,8 +11,21 @@
  * 		init_delay() - initialize delay structure for delay calculation
  * 		
  * 		calc_delay() - do the delay calculation
+ * 		
+ * 		calc_delay_N_T() - the same compiled for a block size N and input_toggle T, picked by init_delay()
+ * 		
+ * 		reset_delay() - silence the delay line
+ * 		
+ * 		init_delay_q15(), calc_delay_q15(), reset_delay_q15() - the same in Q15, for GAPE_FIXED
  * ]
  * 
+ * The generic loop reloads the struct fields and checks for the end of the history on every 
+ * sample, and can't assume the history and the output don't overlap, so it runs one sample at 
+ * a time. The kernels are the same loop compiled once for each latency profile block size and 
+ * input_toggle: the toggle is a constant, the struct fields are in registers, and the block is 
+ * split where it wraps around the history so each run is a straight loop the compiler can 
+ * vectorize (and, with the size known, unroll). The kernel table has to follow the block sizes 
+ * in latency.c, a block size without a kernel still works, on the generic loop.
  * 
  */
 
@@ -20,8 +33,9 @@
 // INCLUDE ------------------------------------------------------------
 
 #include <stdio.h>
-#include <stdlib.h>
-
+#include <string.h>
+#include "arena.h"
+#include "fixed.h"
 #include "delay.h"
 
 // --------------------------------------------------------------------
@@ -29,20 +43,96 @@
 
 
 
+/**
+ * @brief [delay a block of n samples, the body of every kernel]
+ * @details [inlined into each kernel with n and input_toggle constants. each run reads a 
+ * stretch of the history then overwrites it with the input, up to the end of the history
+ * or the block]
+ * 
+ * @param D [pointer to delay_struct]
+ * @param input [buffer containing n samples to work on]
+ * @param output [buffer for n output samples]
+ * @param n [number of samples]
+ * @param input_toggle [1 is delay and input, 0 is just the delay]
+ */
+static inline __attribute__((always_inline)) void delay_block(DELAY_T * D, const float * input, float * output, const int n, const int input_toggle) {
+
+	int i, run;
+	int done = 0;
+	int index = D->index;
+	const int sample_delay = D->sample_delay;
+	const float gain = D->delay_gain;
+	float * __restrict history = D->history;	// its own arena allocation, never the input or output
+	float x, h;
+
+	while(done < n) {
+
+		run = sample_delay - index;
+		if(run > n - done) run = n - done;
+
+		for(i = 0; i < run; i++) {
+			x = input[done + i];
+			h = history[index + i];
+			history[index + i] = x;
+			output[done + i] = input_toggle ? (x + gain * h) : (gain * h);
+		}
+
+		done += run;
+		index += run;
+		if(index == sample_delay) index = 0;
+
+	}
+
+	D->index = index;
+
+}
+
+
+// one kernel per block size and input_toggle --------------------------
+#define DELAY_KERNEL(N, T) \
+	static void calc_delay_##N##_##T(DELAY_T * D, const float * input, float * output) { \
+		delay_block(D, input, output, N, T); \
+	}
+
+// the latency profile block sizes (latency.c)
+#define DELAY_KERNEL_SIZES(X) X(8) X(16) X(32) X(64) X(100) X(128) X(256)
+
+#define DELAY_KERNELS(N) DELAY_KERNEL(N, 0) DELAY_KERNEL(N, 1)
+DELAY_KERNEL_SIZES(DELAY_KERNELS)
+
+typedef struct {
+	int block_size;
+	void (*kernel[2])(DELAY_T * D, const float * input, float * output);	// by input_toggle
+} DELAY_KERNEL_T;
+
+#define DELAY_KERNEL_ENTRY(N) { N, { calc_delay_##N##_0, calc_delay_##N##_1 } },
+static const DELAY_KERNEL_T delay_kernels[] = {
+	DELAY_KERNEL_SIZES(DELAY_KERNEL_ENTRY)
+};
+
+#define DELAY_NUM_KERNELS (int)(sizeof(delay_kernels) / sizeof(delay_kernels[0]))
+
+// ---------------------------------------------------------------------
+
+
+
+
 /**
  * @brief [initialize delay struct]
  * 
+ * @param A [arena the struct and history are allocated from]
  * @param delay_units [0 for samples, 1 for seconds]
  * @param FS [Sampling frequency used to figure out the sample delay]
  * @param time_delay [amount of delay in seconds]
  * @param delay_gain [volume of delayed signal in percentage of original signal]
+ * @param input_toggle [1 is to output the delay and the input, 0 is to output just the delay]
  * @param block_size [amount of samples to work on]
- * @return [pointer to the delay_struct]
+ * @return [pointer to the delay_struct, NULL for a delay under one sample or if it doesn't fit in the arena]
  */
-DELAY_T * init_delay(int delay_units, int FS, float delay, float delay_gain, int block_size) {
+DELAY_T * init_delay(ARENA_T * A, int delay_units, int FS, float delay, float delay_gain, int input_toggle, int block_size) {
 
 	// initialize variables --------------------------------------------
-	int i, j;								// incremental counters		
+	int i;
 	int index = 0;							// index through history array
 	int delay_samples;
 	// if delay entered is in time, then figure out the delay in samples
@@ -56,31 +146,31 @@ DELAY_T * init_delay(int delay_units, int FS, float delay, float delay_gain, int
 	// from here on, delay will be in samples, either from the previous 
 	// converion, or because it was entered in as such
 
+	// under a sample rounds down to no history at all, and a run of the kernels never advances
+	if(delay_samples < 1) return NULL;
+
 
 	// set up struct for delay function --------------------------------
-	DELAY_T * D = (DELAY_T *)malloc(sizeof(DELAY_T));	// allocate struct
-	if(D == NULL) return NULL;							// errcheck malloc call
+	DELAY_T * D = (DELAY_T *)arena_alloc(A, sizeof(DELAY_T));	// allocate struct
+	if(D == NULL) return NULL;									// errcheck alloc call
 	
 	D->sample_delay = delay_samples;	// amount to delay by in samples
 	D->block_size = block_size;
 	D->delay_gain = delay_gain;
+	D->input_toggle = input_toggle;
 	D->index = index;
 
-
-	// initialize array of history of old samples ----------------------
-	D->history = (float *)malloc(sizeof(float) * delay_samples);	// sizeof delay
-	if(D->history == NULL) return NULL;
-	for(i = 0; i < delay_samples; i++) {
-		D->history[i] = 0.0;
+	// the kernel compiled for this block size, if there is one
+	D->kernel = NULL;
+	for(i = 0; i < DELAY_NUM_KERNELS; i++) {
+		if(delay_kernels[i].block_size == block_size) D->kernel = delay_kernels[i].kernel[input_toggle ? 1 : 0];
 	}
 
 
-	// initialize output array -----------------------------------------
-	D->output = (float *)malloc(sizeof(float) * block_size);
-	if(D->output == NULL) return NULL;
-	for(j = 0; j < block_size; j++) {
-		D->output[j] = 0.0;
-	}
+	// initialize array of history of old samples ----------------------
+	// arena memory comes back zeroed, so the delay line starts out silent
+	D->history = (float *)arena_alloc(A, sizeof(float) * delay_samples);	// sizeof delay
+	if(D->history == NULL) return NULL;
 
 
 	// return pointer to the struct ------------------------------------
@@ -90,32 +180,44 @@ DELAY_T * init_delay(int delay_units, int FS, float delay, float delay_gain, int
 
 
 /**
- * @brief [calculates a block_size of delayed samples for output]
+ * @brief [calculates n delayed samples for output]
+ * @details [input and output can be the same buffer, each input sample is read 
+ * before the output sample in the same position is written]
  * 
- * @param input_toggle [1 is to output the delay and the input, 0 is to output just the delay]
  * @param D [pointer to delay_struct]
- * @param input [buffer containing samples to work on of size block_size]
+ * @param input [buffer containing n samples to work on]
+ * @param output [buffer for n output samples]
+ * @param n [number of samples to work on]
  */
-void calc_delay(int input_toggle, DELAY_T * D, float * input) {
+void calc_delay(DELAY_T * D, const float * input, float * output, int n) {
 
 	int i;
+	float x;
+
+	// full block on the kernel for the block size
+	if(n == D->block_size && D->kernel != NULL) {
+		D->kernel(D, input, output);
+		return;
+	}
 
 	// calculate block of output
-	for(i = 0; i < D->block_size; i++) {
+	for(i = 0; i < n; i++) {
+
+		x = input[i];
 
 		// output is either current input and delayed signal or just delayed signal
-		if(input_toggle) {	// used for delay effect, want input signal and delayed signal
+		if(D->input_toggle) {	// used for delay effect, want input signal and delayed signal
 			// y[n] = x[n] + (G * x[n - D])
 			// output is input plus scaled sample from sample_delay samples ago
-			D->output[i] = input[i] + (D->delay_gain * (D->history[D->index])); 
+			output[i] = x + (D->delay_gain * (D->history[D->index])); 
 		} else {	// used for eq, need to delay signal to keep each band signal in phase with each other
 			// this is just the delayed sample from sample_delay samples ago
 			// y[n] = G * x[n - D]
-			D->output[i] = (D->delay_gain * (D->history[D->index]));
+			output[i] = (D->delay_gain * (D->history[D->index]));
 		}
 
 		// place new sample in history array
-		D->history[D->index] = input[i];
+		D->history[D->index] = x;
 
 		// reset index if at the end of history buffer
 		if(D->index == (D->sample_delay - 1)) {
@@ -127,4 +229,98 @@ void calc_delay(int input_toggle, DELAY_T * D, float * input) {
 		
 	}
 
-}
\ No newline at end of file
+}
+
+
+/**
+ * @brief [silence the delay line]
+ * @details [same state as after init, as if only zeros had gone through]
+ * 
+ * @param D [pointer to delay_struct]
+ */
+void reset_delay(DELAY_T * D) {
+
+	int i;
+
+	for(i = 0; i < D->sample_delay; i++) D->history[i] = 0.0;
+	D->index = 0;
+
+}
+
+
+/**
+ * @brief [initialize the Q15 delay struct]
+ * 
+ * @param A [arena the struct and history are allocated from]
+ * @param FS [sampling frequency]
+ * @param time_delay [amount of delay in seconds]
+ * @param delay_gain [volume of delayed signal in percentage of original signal]
+ * @param input_toggle [1 is to output the delay and the input, 0 is to output just the delay]
+ * @param block_size [amount of samples to work on]
+ * @return [pointer to the delay struct, NULL for a delay under one sample or if it doesn't fit in the arena]
+ */
+DELAY_Q15_T * init_delay_q15(ARENA_T * A, int delay_units, int FS, float delay, float delay_gain, int input_toggle, int block_size) {
+
+	int delay_samples = delay_units ? (int)(FS * delay) : (int)delay;
+
+	if(delay_samples < 1) return NULL;		// no history to wrap around, as for init_delay()
+
+	DELAY_Q15_T * D = (DELAY_Q15_T *)arena_alloc(A, sizeof(DELAY_Q15_T));	// allocate struct
+	if(D == NULL) return NULL;												// errcheck alloc call
+
+	D->sample_delay = delay_samples;
+	D->block_size = block_size;
+	D->delay_gain = (int32_t)(delay_gain * 16384.0f + 0.5f);
+	D->input_toggle = input_toggle;
+	D->index = 0;
+
+	// arena memory comes back zeroed, so the delay line starts out silent
+	D->history = (q15_t *)arena_alloc(A, sizeof(q15_t) * delay_samples);
+	if(D->history == NULL) return NULL;
+
+	return D;
+
+}
+
+
+/**
+ * @brief [calculates n delayed Q15 samples for output, saturating]
+ * 
+ * @param D [pointer to the Q15 delay struct]
+ * @param input [buffer containing n Q15 samples to work on]
+ * @param output [buffer for n Q15 output samples]
+ * @param n [number of samples to work on]
+ */
+void calc_delay_q15(DELAY_Q15_T * D, const q15_t * input, q15_t * output, int n) {
+
+	int i;
+	int32_t x, y;
+
+	for(i = 0; i < n; i++) {
+
+		x = input[i];
+
+		// G * x[n - D], Q15 times Q14 rounded back to Q15, then the input on top
+		y = ((D->delay_gain * D->history[D->index]) + (1 << 13)) >> 14;
+		if(D->input_toggle) y += x;
+		output[i] = (q15_t)__SSAT(y, 16);
+
+		D->history[D->index] = (q15_t)x;
+		D->index = (D->index == (D->sample_delay - 1)) ? 0 : (D->index + 1);
+
+	}
+
+}
+
+
+/**
+ * @brief [silence the Q15 delay line]
+ * 
+ * @param D [pointer to the Q15 delay struct]
+ */
+void reset_delay_q15(DELAY_Q15_T * D) {
+
+	memset(D->history, 0, sizeof(q15_t) * D->sample_delay);
+	D->index = 0;
+
+}
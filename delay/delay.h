@@ -22,6 +22,9 @@
 
 #include <stdint.h>
 
+#include "arena.h"
+#include "fixed.h"
+
 // ------------------------------------------------------
 
 
@@ -36,41 +39,129 @@ typedef struct delay_struct {
 	int sample_delay;		// amount of delay in number of samples
 	int block_size;			// amount of samples to work on
 	float delay_gain;		// scaled volume of original input
+	int input_toggle;		// 1 is delay and input, 0 is just the delay
 	int index;				// index through circular buffer of old values
 	float * history;		// array holding old samples for delay
-	float * output;			// array for output
+
+	// loop compiled for this block_size and input_toggle, NULL runs the generic loop
+	void (*kernel)(struct delay_struct * D, const float * input, float * output);
 } DELAY_T;
 
 
+/**
+ * @brief [structure containing the fields for the Q15 delay]
+ * @details [the history is Q15, half the memory of the float delay line]
+ * 
+ */
+typedef struct delay_q15_struct {
+	int sample_delay;		// amount of delay in number of samples
+	int block_size;			// amount of samples to work on
+	int32_t delay_gain;		// Q14 volume of the delayed signal, so a gain of 1.0 is exact
+	int input_toggle;		// 1 is delay and input, 0 is just the delay
+	int index;				// index through circular buffer of old values
+	q15_t * history;		// array holding old samples for delay
+} DELAY_Q15_T;
+
+
 /**
  * @brief [initialize the delay struct]
  * 
+ * @param A [arena the struct and history are allocated from]
  * @param FS [sampling frequency]
  * @param time_delay [amount of delay in seconds]
  * @param delay_gain [volume of delayed signal in percentage of original signal]
+ * @param input_toggle [1 is to output the delay and the input, 0 is to output just the delay]
  * @param block_size [amount of samples to work on]
- * @return [description]
+ * @return [pointer to the delay struct, NULL for a delay under one sample or if it doesn't fit in the arena]
  */
 DELAY_T * init_delay(
+	ARENA_T * A,		// arena to allocate from
 	int delay_units,	// 0 is delay in samples, 1 is delay in seconds
 	int FS,				// sampling frequency
 	float time_delay,	// amount of delay 
 	float delay_gain,	// volume of delayed signal
+	int input_toggle,	// 0 is just delay signal, 1 is add delayed signal back to input
 	int block_size		// amount of samples to work on
 );
 
 
 /**
- * @brief [calculates a block_size of delayed samples for output]
+ * @brief [calculates n delayed samples for output]
+ * @details [input and output can be the same buffer. a full block (n == block_size) runs on the
+ * kernel picked at init if there is one for the block size]
  * 
  * @param D [pointer to delay_struct]
- * @param input [buffer containing samples to work on of size block_size]
+ * @param input [buffer containing n samples to work on]
+ * @param output [buffer for n output samples]
+ * @param n [number of samples to work on]
  */
 void calc_delay(
+	DELAY_T * D,			// pointer to struct 
+	const float * input,	// buffer of input samples to work on
+	float * output,			// buffer for output samples
+	int n					// number of samples to work on
+);
+
+
+/**
+ * @brief [silence the delay line]
+ * @details [same state as after init, as if only zeros had gone through]
+ * 
+ * @param D [pointer to delay_struct]
+ */
+void reset_delay(
+	DELAY_T * D				// pointer to struct
+);
+
+
+/**
+ * @brief [initialize the Q15 delay struct]
+ * @details [same parameters as init_delay(), delay_gain has to be in 0 to 2]
+ * 
+ * @param A [arena the struct and history are allocated from]
+ * @param FS [sampling frequency]
+ * @param time_delay [amount of delay in seconds]
+ * @param delay_gain [volume of delayed signal in percentage of original signal]
+ * @param input_toggle [1 is to output the delay and the input, 0 is to output just the delay]
+ * @param block_size [amount of samples to work on]
+ * @return [pointer to the delay struct, NULL for a delay under one sample or if it doesn't fit in the arena]
+ */
+DELAY_Q15_T * init_delay_q15(
+	ARENA_T * A,		// arena to allocate from
+	int delay_units,	// 0 is delay in samples, 1 is delay in seconds
+	int FS,				// sampling frequency
+	float time_delay,	// amount of delay 
+	float delay_gain,	// volume of delayed signal
 	int input_toggle,	// 0 is just delay signal, 1 is add delayed signal back to input
-	DELAY_T * D,		// pointer to struct 
-	float * input		// buffer of input samples to work on
+	int block_size		// amount of samples to work on
+);
+
+
+/**
+ * @brief [calculates n delayed Q15 samples for output, saturating]
+ * @details [input and output can be the same buffer]
+ * 
+ * @param D [pointer to the Q15 delay struct]
+ * @param input [buffer containing n Q15 samples to work on]
+ * @param output [buffer for n Q15 output samples]
+ * @param n [number of samples to work on]
+ */
+void calc_delay_q15(
+	DELAY_Q15_T * D,		// pointer to struct 
+	const q15_t * input,	// buffer of input samples to work on
+	q15_t * output,			// buffer for output samples
+	int n					// number of samples to work on
+);
+
+
+/**
+ * @brief [silence the Q15 delay line]
+ * 
+ * @param D [pointer to the Q15 delay struct]
+ */
+void reset_delay_q15(
+	DELAY_Q15_T * D			// pointer to struct
 );
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,449 @@
+/**
+ * @file design.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the filter design routines and the cache of FIR designs.
+ * 
+ * @details [
+ * 		design_fir() - coefficients for a spec, from the cache or designed into it
+ * 		
+ * 		design_input_lowpass() - the lowpass ahead of the effect chain at a rate
+ * 		
+ * 		design_lowpass() - Kaiser windowed sinc lowpass
+ * 		
+ * 		design_halfband() - Kaiser windowed half-band lowpass
+ * 		
+ * 		design_polyphase() - Kaiser windowed sinc lowpass in polyphase order, for resampling
+ * 		
+ * 		design_kaiser_order() - length and window shape for an attenuation and transition width
+ * 		
+ * 		design_biquad() - RBJ cookbook biquads
+ * 		
+ * 		design_forget(), report_design() - empty and report on the cache
+ * ]
+ * 
+ * The windowed sinc is worked out in double, one half of the taps mirrored onto the other so the
+ * filter is exactly symmetric (which the folded fir kernel checks for). A 301 tap filter is 151 
+ * sines and Bessel functions, a few milliseconds on the board with its software double, well under 
+ * a millisecond on a host. The eq asks for the same two filters every time the chain is planned, 
+ * so the designs are cached by spec in static memory and only worked out once per boot.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "arena.h"
+#include "design.h"
+
+#include "fir_lowpass.h"
+
+// ----------------------------------------------------------
+
+
+// one remembered design, its coefficients are in design_pool
+typedef struct {
+	DESIGN_SPEC_T spec;
+	float * coefs;
+} DESIGN_CACHE_T;
+
+static float design_pool[DESIGN_CACHE_FLOATS];
+static DESIGN_CACHE_T design_cache[DESIGN_CACHE_SIZE];
+static int design_count = 0;		// designs in the cache
+static int design_used = 0;			// floats of the pool in use
+static int design_hits = 0;
+static int design_misses = 0;
+
+
+
+
+/**
+ * @brief [modified Bessel function of the first kind, order 0]
+ * @details [power series, the terms fall off fast for the betas a filter uses]
+ * 
+ * @param x [argument]
+ * @return [I0(x)]
+ */
+static double bessel_i0(double x) {
+
+	int k;
+	double term = 1.0;
+	double sum = 1.0;
+
+	for(k = 1; k < 50 && term > 1e-17 * sum; k++) {
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+
+	return sum;
+
+}
+
+
+/**
+ * @brief [Kaiser window times sinc, for one tap]
+ * 
+ * @param i [tap index]
+ * @param num_taps [number of coefficients]
+ * @param wc [cutoff as a fraction of the Nyquist frequency]
+ * @param beta [window shape]
+ * @param i0_beta [I0(beta), the window normalization]
+ * @return [unnormalized tap]
+ */
+static double kaiser_sinc(int i, int num_taps, double wc, double beta, double i0_beta) {
+
+	double M = num_taps - 1;
+	double n = i - (M / 2.0);
+	double r = (M > 0) ? ((2.0 * i / M) - 1.0) : 0.0;
+	double window = bessel_i0(beta * sqrt(1.0 - (r * r))) / i0_beta;
+	double sinc = (n == 0.0) ? wc : (sin(M_PI * wc * n) / (M_PI * n));
+
+	return sinc * window;
+
+}
+
+
+/**
+ * @brief [Kaiser windowed sinc lowpass, normalized to a DC gain of 1 (MATLAB fir1)]
+ * 
+ * @param h [buffer for num_taps coefficients]
+ * @param num_taps [number of coefficients]
+ * @param cutoff [-6 dB frequency in Hz]
+ * @param FS [sampling frequency]
+ * @param beta [Kaiser window shape]
+ */
+void design_lowpass(float * h, int num_taps, float cutoff, int FS, float beta) {
+
+	int i;
+	double tap;
+	double dc = 0.0;
+	double wc = 2.0 * cutoff / FS;
+	double i0_beta = bessel_i0(beta);
+
+	// first half and the center, the second half is the mirror image
+	for(i = 0; i < (num_taps + 1) / 2; i++) {
+		tap = kaiser_sinc(i, num_taps, wc, beta, i0_beta);
+		dc += ((num_taps & 1) && (i == num_taps / 2)) ? tap : (2.0 * tap);
+		h[i] = (float)tap;
+	}
+
+	for(i = 0; i < (num_taps + 1) / 2; i++) {
+		h[i] = (float)(h[i] / dc);
+		h[num_taps - 1 - i] = h[i];
+	}
+
+}
+
+
+/**
+ * @brief [Kaiser windowed half-band lowpass]
+ * @details [the center is 0.5 and the other taps are scaled so the DC gain is 1]
+ * 
+ * @param h [buffer for num_taps coefficients]
+ * @param num_taps [number of coefficients, 4k + 3]
+ * @param beta [Kaiser window shape]
+ * @return [0 on success, 1 if num_taps isn't 4k + 3]
+ */
+int design_halfband(float * h, int num_taps, float beta) {
+
+	int i;
+	int center = num_taps / 2;
+	double tap;
+	double sides = 0.0;
+	double i0_beta = bessel_i0(beta);
+
+	if(num_taps < 3 || (num_taps % 4) != 3) return 1;
+
+	// the even distances from the center are the zeros of the sinc
+	for(i = 0; i < center; i++) {
+		tap = ((center - i) % 2 == 0) ? 0.0 : kaiser_sinc(i, num_taps, 0.5, beta, i0_beta);
+		sides += 2.0 * tap;
+		h[i] = (float)tap;
+	}
+
+	for(i = 0; i < center; i++) {
+		h[i] = (float)(h[i] * (0.5 / sides));
+		h[num_taps - 1 - i] = h[i];
+	}
+	h[center] = 0.5f;
+
+	return 0;
+
+}
+
+
+/**
+ * @brief [Kaiser windowed sinc lowpass split into the phases of a polyphase filter]
+ * @details [every tap is worked out where it goes, so no prototype has to be held on the side.
+ * the prototype isn't symmetric per phase, so there is no mirroring]
+ * 
+ * @param phases [buffer for (num_phases + 1) * num_taps coefficients]
+ * @param num_phases [phases per input sample]
+ * @param num_taps [taps per phase]
+ * @param cutoff [-6 dB frequency as a fraction of the input rate, under 0.5]
+ * @param beta [Kaiser window shape]
+ */
+void design_polyphase(float * phases, int num_phases, int num_taps, float cutoff, float beta) {
+
+	int j, m;
+	int length = (num_phases * num_taps) + 1;
+	double tap;
+	double dc = 0.0;
+	double wc = 2.0 * cutoff / num_phases;		// at num_phases times the input rate
+	double i0_beta = bessel_i0(beta);
+
+	// tap m of phase j multiplies the m-th oldest input, prototype tap j + (num_taps - 1 - m) * num_phases
+	for(j = 0; j <= num_phases; j++) {
+		for(m = 0; m < num_taps; m++) {
+			tap = kaiser_sinc(j + ((num_taps - 1 - m) * num_phases), length, wc, beta, i0_beta);
+			if(j < num_phases) dc += tap;
+			phases[(j * num_taps) + m] = (float)tap;
+		}
+	}
+
+	// the phases between them cover the prototype once, each one gets 1 / num_phases of its DC gain
+	for(j = 0; j < (num_phases + 1) * num_taps; j++) phases[j] = (float)(phases[j] * (num_phases / dc));
+
+}
+
+
+/**
+ * @brief [Kaiser's estimate of the length and window for a lowpass spec]
+ * 
+ * @param atten_db [stopband attenuation in dB]
+ * @param transition [transition width in Hz]
+ * @param FS [sampling frequency]
+ * @param beta [set to the window shape for the attenuation]
+ * @return [number of coefficients, odd]
+ */
+int design_kaiser_order(float atten_db, float transition, int FS, float * beta) {
+
+	int num_taps;
+	double A = atten_db;
+	double dw = 2.0 * M_PI * transition / FS;
+
+	if(A > 50.0) {
+		*beta = (float)(0.1102 * (A - 8.7));
+	} else if(A >= 21.0) {
+		*beta = (float)((0.5842 * pow(A - 21.0, 0.4)) + (0.07886 * (A - 21.0)));
+	} else {
+		*beta = 0.0f;
+	}
+
+	num_taps = (int)ceil((A - 8.0) / (2.285 * dw)) + 1;
+	if(num_taps < 3) num_taps = 3;
+
+	return num_taps | 1;
+
+}
+
+
+/**
+ * @brief [one biquad from the RBJ audio eq cookbook]
+ * 
+ * @param coefs [buffer for the 5 coefficients]
+ * @param type [BIQUAD_LOWPASS through BIQUAD_HIGHSHELF]
+ * @param f0 [center or corner frequency in Hz]
+ * @param Q [quality factor]
+ * @param gain_db [gain of the peak or shelf in dB]
+ * @param FS [sampling frequency]
+ */
+void design_biquad(float * coefs, int type, float f0, float Q, float gain_db, int FS) {
+
+	double w0 = 2.0 * M_PI * f0 / FS;
+	double c = cos(w0);
+	double alpha = sin(w0) / (2.0 * Q);
+	double A = pow(10.0, gain_db / 40.0);
+	double root = 2.0 * sqrt(A) * alpha;
+	double b0, b1, b2, a0, a1, a2;
+
+	// all but the peak and shelves share the denominator
+	a0 = 1.0 + alpha;
+	a1 = -2.0 * c;
+	a2 = 1.0 - alpha;
+
+	switch(type) {
+
+		case BIQUAD_LOWPASS:
+			b0 = (1.0 - c) / 2.0;	b1 = 1.0 - c;			b2 = (1.0 - c) / 2.0;
+			break;
+
+		case BIQUAD_HIGHPASS:
+			b0 = (1.0 + c) / 2.0;	b1 = -(1.0 + c);		b2 = (1.0 + c) / 2.0;
+			break;
+
+		case BIQUAD_BANDPASS:
+			b0 = alpha;				b1 = 0.0;				b2 = -alpha;
+			break;
+
+		case BIQUAD_NOTCH:
+			b0 = 1.0;				b1 = -2.0 * c;			b2 = 1.0;
+			break;
+
+		case BIQUAD_PEAK:
+			b0 = 1.0 + (alpha * A);	b1 = -2.0 * c;			b2 = 1.0 - (alpha * A);
+			a0 = 1.0 + (alpha / A);	a2 = 1.0 - (alpha / A);
+			break;
+
+		case BIQUAD_LOWSHELF:
+			b0 = A * ((A + 1.0) - ((A - 1.0) * c) + root);
+			b1 = 2.0 * A * ((A - 1.0) - ((A + 1.0) * c));
+			b2 = A * ((A + 1.0) - ((A - 1.0) * c) - root);
+			a0 = (A + 1.0) + ((A - 1.0) * c) + root;
+			a1 = -2.0 * ((A - 1.0) + ((A + 1.0) * c));
+			a2 = (A + 1.0) + ((A - 1.0) * c) - root;
+			break;
+
+		case BIQUAD_HIGHSHELF:
+			b0 = A * ((A + 1.0) + ((A - 1.0) * c) + root);
+			b1 = -2.0 * A * ((A - 1.0) + ((A + 1.0) * c));
+			b2 = A * ((A + 1.0) + ((A - 1.0) * c) - root);
+			a0 = (A + 1.0) - ((A - 1.0) * c) + root;
+			a1 = 2.0 * ((A - 1.0) - ((A + 1.0) * c));
+			a2 = (A + 1.0) - ((A - 1.0) * c) - root;
+			break;
+
+		default:
+			// anything else passes straight through
+			b0 = a0 = 1.0;	b1 = b2 = a1 = a2 = 0.0;
+			break;
+
+	}
+
+	// normalized by a0, the feedback terms negated the cmsis way
+	coefs[0] = (float)(b0 / a0);
+	coefs[1] = (float)(b1 / a0);
+	coefs[2] = (float)(b2 / a0);
+	coefs[3] = (float)(-a1 / a0);
+	coefs[4] = (float)(-a2 / a0);
+
+}
+
+
+/**
+ * @brief [design a spec into a buffer]
+ * 
+ * @param h [buffer for spec->num_taps coefficients]
+ * @param spec [what to design]
+ * @return [0 on success, 1 if the spec is invalid]
+ */
+static int design_spec(float * h, const DESIGN_SPEC_T * spec) {
+
+	if(spec->type == DESIGN_HALFBAND) return design_halfband(h, spec->num_taps, spec->beta);
+
+	if(spec->cutoff <= 0.0f || 2.0f * spec->cutoff >= spec->FS) return 1;
+	design_lowpass(h, spec->num_taps, spec->cutoff, spec->FS, spec->beta);
+	return 0;
+
+}
+
+
+/**
+ * @brief [coefficients for a spec, designed once and then taken from the cache]
+ * 
+ * @param A [arena for a design that doesn't fit in the cache]
+ * @param spec [what to design]
+ * @return [spec->num_taps coefficients, NULL if the spec is invalid or they don't fit anywhere]
+ */
+const float * design_fir(ARENA_T * A, const DESIGN_SPEC_T * spec) {
+
+	int i;
+	float * h;
+	const DESIGN_SPEC_T * S;
+
+	if(spec->num_taps < 1 || (spec->type != DESIGN_LOWPASS && spec->type != DESIGN_HALFBAND)) return NULL;
+
+	// the same spec again
+	for(i = 0; i < design_count; i++) {
+		S = &(design_cache[i].spec);
+		if(S->type == spec->type && S->num_taps == spec->num_taps && S->cutoff == spec->cutoff && 
+			S->FS == spec->FS && S->beta == spec->beta) {
+			design_hits++;
+			return design_cache[i].coefs;
+		}
+	}
+	design_misses++;
+
+	// into the cache if there's room, otherwise the arena
+	if(design_count < DESIGN_CACHE_SIZE && design_used + spec->num_taps <= DESIGN_CACHE_FLOATS) {
+		h = design_pool + design_used;
+		if(design_spec(h, spec)) return NULL;
+		design_cache[design_count].spec = *spec;
+		design_cache[design_count].coefs = h;
+		design_count++;
+		design_used += spec->num_taps;
+		return h;
+	}
+
+	h = (float *)arena_alloc(A, sizeof(float) * spec->num_taps);
+	if(h == NULL || design_spec(h, spec)) return NULL;
+	return h;
+
+}
+
+
+/**
+ * @brief [the lowpass ahead of the effect chain at a sampling frequency]
+ * 
+ * @param A [arena for a design that doesn't fit in the cache]
+ * @param FS [sampling frequency]
+ * @param num_taps [set to the length of the lowpass]
+ * @return [coefficients, NULL if they don't fit]
+ */
+const float * design_input_lowpass(ARENA_T * A, int FS, int * num_taps) {
+
+	float beta;
+	DESIGN_SPEC_T spec;
+
+	// the table, const in flash
+	if(FS == 48000) {
+		*num_taps = BL;
+		return B;
+	}
+
+	spec.type = DESIGN_LOWPASS;
+	spec.num_taps = design_kaiser_order(DESIGN_INPUT_ATTEN_DB, DESIGN_INPUT_STOP - DESIGN_INPUT_PASS, FS, &beta);
+	spec.cutoff = (DESIGN_INPUT_PASS + DESIGN_INPUT_STOP) / 2;
+	spec.FS = FS;
+	spec.beta = beta;
+
+	*num_taps = spec.num_taps;
+	return design_fir(A, &spec);
+
+}
+
+
+/**
+ * @brief [empty the design cache]
+ * 
+ */
+void design_forget(void) {
+
+	design_count = 0;
+	design_used = 0;
+	design_hits = 0;
+	design_misses = 0;
+
+}
+
+
+/**
+ * @brief [print the cache use, hits and misses]
+ * 
+ * @param print [function to print a line]
+ */
+void report_design(void (*print)(const char *)) {
+
+	char line[96];
+
+	snprintf(line, sizeof(line), "filter designs: %d cached, %d of %d coefs, %d hits, %d designed\r\n",
+		design_count, design_used, DESIGN_CACHE_FLOATS, design_hits, design_misses);
+	print(line);
+
+}
@@ -0,0 +1,223 @@
+/**
+ * @file design.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the declarations of the filter design routines: Kaiser windowed 
+ * sinc FIR filters, half-band filters and RBJ cookbook biquads, and the cache of FIR designs.
+ * 
+ * @details [the FIR designs are what MATLAB's fir1 gives with a Kaiser window (the eq band
+ * filters in filters/ came out of FDATool that way), so a crossover or sample rate change is a
+ * new spec instead of a new coefficient table]
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef DESIGN_H
+#define DESIGN_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+// FIR designs
+#define DESIGN_LOWPASS		0		// Kaiser windowed sinc lowpass
+#define DESIGN_HALFBAND		1		// Kaiser windowed half-band lowpass, cutoff FS / 4
+
+// biquad designs (RBJ audio eq cookbook)
+#define BIQUAD_LOWPASS		0
+#define BIQUAD_HIGHPASS		1
+#define BIQUAD_BANDPASS		2		// constant 0 dB peak gain
+#define BIQUAD_NOTCH		3
+#define BIQUAD_PEAK			4
+#define BIQUAD_LOWSHELF		5
+#define BIQUAD_HIGHSHELF	6
+
+// input lowpass ahead of the chain, the edges of the 48kHz table in fir_lowpass.h
+#define DESIGN_INPUT_PASS		10000.0f	// passband edge in Hz
+#define DESIGN_INPUT_STOP		12000.0f	// stopband edge in Hz
+#define DESIGN_INPUT_ATTEN_DB	60.0f		// stopband attenuation, as deep as the 48kHz table
+
+// cache of FIR designs, in static memory so it outlives the arena resets
+#define DESIGN_CACHE_SIZE	8		// designs remembered
+#define DESIGN_CACHE_FLOATS	1536	// coefficients remembered, over all the designs: the eq and lowpass at 96kHz
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [everything that decides a FIR design, and the key of the design cache]
+ * 
+ */
+typedef struct design_spec_struct {
+	int type;				// DESIGN_LOWPASS or DESIGN_HALFBAND
+	int num_taps;			// number of coefficients
+	float cutoff;			// -6 dB frequency in Hz, ignored for a half-band
+	int FS;					// sampling frequency
+	float beta;				// Kaiser window shape, higher is more stopband attenuation and a wider transition
+} DESIGN_SPEC_T;
+
+
+/**
+ * @brief [coefficients for a spec, designed once and then taken from the cache]
+ * @details [cached coefficients stay put for good, the cache never evicts. a design that 
+ * doesn't fit in the cache anymore goes into the arena]
+ * 
+ * @param A [arena for a design that doesn't fit in the cache]
+ * @param spec [what to design]
+ * @return [spec->num_taps coefficients, NULL if the spec is invalid or they don't fit anywhere]
+ */
+const float * design_fir(
+	ARENA_T * A,					// arena to fall back on
+	const DESIGN_SPEC_T * spec		// what to design
+);
+
+
+/**
+ * @brief [the lowpass ahead of the effect chain at a sampling frequency]
+ * @details [the 48kHz table is an equiripple design, the other rates get a Kaiser design to the same
+ * edges through the cache, which needs more taps for the same stopband. the board, the renderer and
+ * the real-time engine all run this one]
+ * 
+ * @param A [arena for a design that doesn't fit in the cache]
+ * @param FS [sampling frequency]
+ * @param num_taps [set to the length of the lowpass]
+ * @return [coefficients, NULL if they don't fit]
+ */
+const float * design_input_lowpass(
+	ARENA_T * A,			// arena to fall back on
+	int FS,					// sampling frequency
+	int * num_taps			// length of the lowpass
+);
+
+
+/**
+ * @brief [Kaiser windowed sinc lowpass, normalized to a DC gain of 1 (MATLAB fir1)]
+ * 
+ * @param h [buffer for num_taps coefficients]
+ * @param num_taps [number of coefficients]
+ * @param cutoff [-6 dB frequency in Hz]
+ * @param FS [sampling frequency]
+ * @param beta [Kaiser window shape]
+ */
+void design_lowpass(
+	float * h,			// coefficients
+	int num_taps,		// number of coefficients
+	float cutoff,		// cutoff in Hz
+	int FS,				// sampling frequency
+	float beta			// Kaiser window shape
+);
+
+
+/**
+ * @brief [Kaiser windowed half-band lowpass]
+ * @details [every other tap away from the center is exactly 0 and the center is 0.5, so a
+ * decimate or interpolate by 2 only has to multiply half the taps]
+ * 
+ * @param h [buffer for num_taps coefficients]
+ * @param num_taps [number of coefficients, 4k + 3 so the outermost taps aren't zeros]
+ * @param beta [Kaiser window shape]
+ * @return [0 on success, 1 if num_taps isn't 4k + 3]
+ */
+int design_halfband(
+	float * h,			// coefficients
+	int num_taps,		// number of coefficients
+	float beta			// Kaiser window shape
+);
+
+
+/**
+ * @brief [Kaiser windowed sinc lowpass split into the phases of a polyphase filter]
+ * @details [the prototype is num_phases * num_taps + 1 taps long at num_phases times the input rate.
+ * phase j holds taps j, j + num_phases, j + 2 num_phases ... time reversed, so it lines up with the 
+ * oldest to newest inputs for a dot product. phase num_phases is phase 0 one input later, so there is 
+ * always a next phase to interpolate towards. each phase has a DC gain close to 1]
+ * 
+ * @param phases [buffer for (num_phases + 1) * num_taps coefficients]
+ * @param num_phases [phases per input sample]
+ * @param num_taps [taps per phase]
+ * @param cutoff [-6 dB frequency as a fraction of the input rate, under 0.5]
+ * @param beta [Kaiser window shape]
+ */
+void design_polyphase(
+	float * phases,		// coefficients, phase by phase
+	int num_phases,		// phases per input sample
+	int num_taps,		// taps per phase
+	float cutoff,		// -6 dB frequency / input rate
+	float beta			// Kaiser window shape
+);
+
+
+/**
+ * @brief [Kaiser's estimate of the length and window for a lowpass spec]
+ * 
+ * @param atten_db [stopband attenuation in dB (and passband ripple)]
+ * @param transition [transition band width in Hz]
+ * @param FS [sampling frequency]
+ * @param beta [set to the window shape for the attenuation]
+ * @return [number of coefficients, odd]
+ */
+int design_kaiser_order(
+	float atten_db,		// stopband attenuation in dB
+	float transition,	// transition width in Hz
+	int FS,				// sampling frequency
+	float * beta		// window shape out
+);
+
+
+/**
+ * @brief [one biquad from the RBJ audio eq cookbook]
+ * @details [coefficients in the dsp biquad layout: b0, b1, b2, a1, a2 normalized by a0, with
+ * a1 and a2 negated the cmsis way (see DSP_BIQUAD_COEFS)]
+ * 
+ * @param coefs [buffer for the 5 coefficients]
+ * @param type [BIQUAD_LOWPASS through BIQUAD_HIGHSHELF]
+ * @param f0 [center or corner frequency in Hz]
+ * @param Q [quality factor, 0.7071 for a Butterworth lowpass/highpass, 0.7071 for a shelf slope of 1]
+ * @param gain_db [gain of the peak or shelf in dB, ignored by the others]
+ * @param FS [sampling frequency]
+ */
+void design_biquad(
+	float * coefs,		// coefficients
+	int type,			// BIQUAD_*
+	float f0,			// frequency in Hz
+	float Q,			// quality factor
+	float gain_db,		// peak or shelf gain
+	int FS				// sampling frequency
+);
+
+
+/**
+ * @brief [empty the design cache]
+ * @details [anything still using cached coefficients has to be done with them]
+ * 
+ */
+void design_forget(void);
+
+
+/**
+ * @brief [print the cache use, hits and misses]
+ * 
+ * @param print [function to print a line]
+ */
+void report_design(
+	void (*print)(const char *)		// prints a line
+);
+
+
+#endif
@@ -0,0 +1,571 @@
+/**
+ * @file dma_io.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for the zero-copy adc/dac block I/O.
+ * 
+ * @details [
+ * 		init_dma_io_clocks() - the hal, the 168MHz system clock and its tick, without the library's adc and dac
+ * 		
+ * 		init_dma_io() - set up TIM2, ADC1 (PA1), both DAC channels (PA4, PA5) and their DMA streams
+ * 		
+ * 		start_dma_io() - start the sample clock
+ * 		
+ * 		stop_dma_io() - stop the sample clock and both DMA streams, to re-plan for another block size
+ * 		
+ * 		dma_io_input() - wait for the next half of the adc buffer and return a pointer into it
+ * 		
+ * 		dma_io_output() - the matching half of the dac buffer
+ * 		
+ * 		dma_io_set_process() - run the processing straight from the DMA interrupt (low latency mode)
+ * 		
+ * 		dma_io_measure_latency() - round trip latency through a dac to adc loopback
+ * 		
+ * 		adc_to_float() - raw adc samples to floats, written into the lowpass history as its first pass
+ * 		
+ * 		adc_to_q15() - raw adc samples to Q15, the same for the fixed point lowpass
+ * 		
+ * 		float_to_dac_stereo() - floats to packed dac words for both channels, the last processing stage
+ * 		
+ * 		dac_silence() - midscale on both channels, for blocks that skip the processing
+ * ]
+ * 
+ * getblock() copied each block out of the adc DMA buffer and converted it, the main loop copied
+ * the filtered block into a separate left channel buffer, and putblockstereo() copied and converted
+ * both channels into the dac DMA buffer. Here the DMA buffers are handed to the loop directly: the
+ * conversion from adc codes is done as the samples are read out of the DMA buffer, straight into the
+ * input history of the lowpass (see fir_input()), and both output channels are converted and packed as
+ * they are written into it, so nothing is copied in between.
+ * 
+ * This file owns the adc, the dac, TIM2 and the DMA2 stream 0 interrupt, so the ece486 library's 
+ * initialize() isn't called: it sets up its own adc and dac, and linking it in brings its DMA2 stream 0
+ * handler and hal adc callbacks along with them. init_dma_io_clocks() does the rest of what it did.
+ * 
+ * The adc and the dac are both triggered by TIM2 at FS. The adc DMA (DMA2 stream 0) interrupts at 
+ * half and full transfer. The dac runs in dual mode, one DMA (DMA1 stream 5) writes both channels 
+ * through DHR12RD and only interrupts on an underrun. Because both buffers are the same length and start on the
+ * same timer tick, when adc half k has just been filled the dac has just finished playing half k, 
+ * so the loop has one block period to fill it.
+ * 
+ * That makes the I/O latency 2 * block_size samples, 4.2ms at the default block size of 100. In low
+ * latency mode the block is DMA_IO_LOW_LATENCY_BLOCK samples and the processing runs right in 
+ * the DMA interrupt, so nothing waits on the foreground loop and the I/O latency drops to 16 samples.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#ifdef ARM_MATH_CM4
+#include "stm32f4xx_hal.h"
+#include "stm32f4_discovery.h"
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "profiler.h"
+#include "trace.h"
+#include "dma_io.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [convert raw adc samples to floats in -1.0 to 1.0]
+ * 
+ * @param input [raw 12 bit adc samples]
+ * @param output [buffer for the float samples]
+ * @param n [number of samples]
+ */
+void adc_to_float(const uint16_t * input, float * output, int n) {
+
+	int i;
+
+	for(i = 0; i < n; i++) {
+		output[i] = (float)((int)input[i] - DMA_IO_MIDSCALE) * (1.0f / DMA_IO_FULLSCALE);
+	}
+
+}
+
+
+/**
+ * @brief [convert raw adc samples to Q15]
+ * 
+ * @param input [raw 12 bit adc samples]
+ * @param output [buffer for the Q15 samples]
+ * @param n [number of samples]
+ */
+void adc_to_q15(const uint16_t * input, q15_t * output, int n) {
+
+	int i;
+
+	for(i = 0; i < n; i++) output[i] = (q15_t)(((int)input[i] - DMA_IO_MIDSCALE) << 4);
+
+}
+
+
+/**
+ * @brief [clip, convert and pack left and right float samples into dual channel dac words]
+ * 
+ * @param left [samples for dac channel 1]
+ * @param right [samples for dac channel 2]
+ * @param output [dac words, channel 1 in bits 0-11 and channel 2 in bits 16-27]
+ * @param n [number of samples]
+ */
+void float_to_dac_stereo(const float * left, const float * right, uint32_t * output, int n) {
+
+	int i;
+	float l, r;
+
+	for(i = 0; i < n; i++) {
+
+		// scale to dac codes around midscale and clip to the 12 bit range
+		l = left[i] * DMA_IO_FULLSCALE + DMA_IO_MIDSCALE;
+		r = right[i] * DMA_IO_FULLSCALE + DMA_IO_MIDSCALE;
+		l = (l < 0.0f) ? 0.0f : ((l > 4095.0f) ? 4095.0f : l);
+		r = (r < 0.0f) ? 0.0f : ((r > 4095.0f) ? 4095.0f : r);
+
+		output[i] = (uint32_t)l | ((uint32_t)r << 16);
+
+	}
+
+}
+
+
+/**
+ * @brief [fill dac words with silence on both channels]
+ * 
+ * @param output [dac words]
+ * @param n [number of samples]
+ */
+void dac_silence(uint32_t * output, int n) {
+
+	int i;
+
+	for(i = 0; i < n; i++) output[i] = DMA_IO_MIDSCALE | ((uint32_t)DMA_IO_MIDSCALE << 16);
+
+}
+
+
+
+
+#ifdef ARM_MATH_CM4
+
+// GLOBAL VARIABLES TO THIS FILE ------------------------- 
+
+static TIM_HandleTypeDef htim;
+static ADC_HandleTypeDef hadc;
+static DAC_HandleTypeDef hdac;
+static DMA_HandleTypeDef hdma_adc;
+static DMA_HandleTypeDef hdma_dac;
+
+static DMA_IO_T * dma_io = NULL;	// io struct the DMA callbacks update
+
+// -------------------------------------------------------
+
+
+/**
+ * @brief [set up the hal, the system clock at 168MHz from the 8MHz crystal and the 1ms hal tick]
+ * 
+ */
+void init_dma_io_clocks(void) {
+
+	RCC_OscInitTypeDef osc = {0};
+	RCC_ClkInitTypeDef clk = {0};
+
+	HAL_Init();
+
+	// full speed needs the regulator at scale 1
+	__PWR_CLK_ENABLE();
+	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE1);
+
+	// 8MHz / 8 * 336 / 2 = 168MHz, / 7 = 48MHz for the usb
+	osc.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+	osc.HSEState = RCC_HSE_ON;
+	osc.PLL.PLLState = RCC_PLL_ON;
+	osc.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+	osc.PLL.PLLM = 8;
+	osc.PLL.PLLN = 336;
+	osc.PLL.PLLP = RCC_PLLP_DIV2;
+	osc.PLL.PLLQ = 7;
+	HAL_RCC_OscConfig(&osc);
+
+	// PCLK1 42MHz (TIM2 at 84MHz), PCLK2 84MHz
+	clk.ClockType = RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+	clk.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+	clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+	clk.APB1CLKDivider = RCC_HCLK_DIV4;
+	clk.APB2CLKDivider = RCC_HCLK_DIV2;
+	HAL_RCC_ClockConfig(&clk, FLASH_LATENCY_5);
+
+}
+
+
+/**
+ * @brief [set up the timer, adc, dac and DMA streams for block I/O]
+ * 
+ * @param A [sram arena the struct and DMA buffers are allocated from]
+ * @param block_size [number of samples per block]
+ * @param FS [sampling frequency]
+ * @return [pointer to the io struct, NULL if it doesn't fit in the arena or the hal fails]
+ */
+DMA_IO_T * init_dma_io(ARENA_T * A, int block_size, int FS) {
+
+	int i;
+	GPIO_InitTypeDef GPIO_InitStruct;
+	TIM_MasterConfigTypeDef master;
+	ADC_ChannelConfTypeDef adc_channel;
+	DAC_ChannelConfTypeDef dac_channel;
+
+
+	// set up struct and DMA buffers -------------------------------------------
+	arena_set_tag(A, "dma_io");
+	DMA_IO_T * IO = (DMA_IO_T *)arena_alloc(A, sizeof(DMA_IO_T));
+	if(IO == NULL) return NULL;
+	IO->adc_buf = (uint16_t *)arena_alloc(A, sizeof(uint16_t) * 2 * block_size);
+	IO->dac_buf = (uint32_t *)arena_alloc(A, sizeof(uint32_t) * 2 * block_size);
+	if(IO->adc_buf == NULL || IO->dac_buf == NULL) return NULL;
+
+	IO->block_size = block_size;
+	IO->process = NULL;
+	IO->context = NULL;
+	IO->ready = -1;
+	IO->half = 0;
+	IO->overruns = 0;
+	IO->errors = 0;
+	IO->underruns = 0;
+	IO->stamp = 0;
+	IO->release = 0;
+
+	// play silence until the first processed block is written
+	for(i = 0; i < 2 * block_size; i++) {
+		IO->dac_buf[i] = DMA_IO_MIDSCALE | (DMA_IO_MIDSCALE << 16);
+	}
+
+	dma_io = IO;
+
+
+	// clocks -----------------------------------------------------------------
+	__GPIOA_CLK_ENABLE();
+	__TIM2_CLK_ENABLE();
+	__ADC1_CLK_ENABLE();
+	__DAC_CLK_ENABLE();
+	__DMA1_CLK_ENABLE();
+	__DMA2_CLK_ENABLE();
+
+
+	// analog pins: PA1 adc in, PA4 and PA5 dac out ----------------------------
+	GPIO_InitStruct.Pin = GPIO_PIN_1 | GPIO_PIN_4 | GPIO_PIN_5;
+	GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
+	GPIO_InitStruct.Pull = GPIO_NOPULL;
+	HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+
+	// TIM2 update event is the sample clock, TIM2 runs at 2 * PCLK1 -----------
+	// rounded to the nearest count: 84MHz doesn't divide down to 44.1kHz, it runs 0.01% slow
+	htim.Instance = TIM2;
+	htim.Init.Prescaler = 0;
+	htim.Init.CounterMode = TIM_COUNTERMODE_UP;
+	htim.Init.Period = (((2 * HAL_RCC_GetPCLK1Freq()) + (FS / 2)) / FS) - 1;
+	htim.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+	if(HAL_TIM_Base_Init(&htim) != HAL_OK) return NULL;
+
+	master.MasterOutputTrigger = TIM_TRGO_UPDATE;
+	master.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+	HAL_TIMEx_MasterConfigSynchronization(&htim, &master);
+
+
+	// adc DMA: DMA2 stream 0 channel 0, circular, interrupts at half and full --
+	hdma_adc.Instance = DMA2_Stream0;
+	hdma_adc.Init.Channel = DMA_CHANNEL_0;
+	hdma_adc.Init.Direction = DMA_PERIPH_TO_MEMORY;
+	hdma_adc.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdma_adc.Init.MemInc = DMA_MINC_ENABLE;
+	hdma_adc.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+	hdma_adc.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+	hdma_adc.Init.Mode = DMA_CIRCULAR;
+	hdma_adc.Init.Priority = DMA_PRIORITY_HIGH;
+	hdma_adc.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+	if(HAL_DMA_Init(&hdma_adc) != HAL_OK) return NULL;
+	__HAL_LINKDMA(&hadc, DMA_Handle, hdma_adc);
+
+	HAL_NVIC_SetPriority(DMA2_Stream0_IRQn, 0, 0);
+	HAL_NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+
+
+	// adc: one conversion of channel 1 per TIM2 trigger -----------------------
+	hadc.Instance = ADC1;
+	hadc.Init.ClockPrescaler = ADC_CLOCKPRESCALER_PCLK_DIV4;
+	hadc.Init.Resolution = ADC_RESOLUTION12b;
+	hadc.Init.ScanConvMode = DISABLE;
+	hadc.Init.ContinuousConvMode = DISABLE;
+	hadc.Init.DiscontinuousConvMode = DISABLE;
+	hadc.Init.NbrOfDiscConversion = 0;
+	hadc.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_RISING;
+	hadc.Init.ExternalTrigConv = ADC_EXTERNALTRIGCONV_T2_TRGO;
+	hadc.Init.DataAlign = ADC_DATAALIGN_RIGHT;
+	hadc.Init.NbrOfConversion = 1;
+	hadc.Init.DMAContinuousRequests = ENABLE;
+	hadc.Init.EOCSelection = DISABLE;
+	if(HAL_ADC_Init(&hadc) != HAL_OK) return NULL;
+
+	adc_channel.Channel = ADC_CHANNEL_1;
+	adc_channel.Rank = 1;
+	adc_channel.SamplingTime = ADC_SAMPLETIME_15CYCLES;
+	adc_channel.Offset = 0;
+	if(HAL_ADC_ConfigChannel(&hadc, &adc_channel) != HAL_OK) return NULL;
+
+
+	// dac DMA: DMA1 stream 5 channel 7, circular words into DHR12RD -----------
+	hdma_dac.Instance = DMA1_Stream5;
+	hdma_dac.Init.Channel = DMA_CHANNEL_7;
+	hdma_dac.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	hdma_dac.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdma_dac.Init.MemInc = DMA_MINC_ENABLE;
+	hdma_dac.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+	hdma_dac.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+	hdma_dac.Init.Mode = DMA_CIRCULAR;
+	hdma_dac.Init.Priority = DMA_PRIORITY_HIGH;
+	hdma_dac.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+	if(HAL_DMA_Init(&hdma_dac) != HAL_OK) return NULL;
+
+
+	// dac: both channels loaded on the TIM2 trigger ---------------------------
+	hdac.Instance = DAC;
+	if(HAL_DAC_Init(&hdac) != HAL_OK) return NULL;
+	dac_channel.DAC_Trigger = DAC_TRIGGER_T2_TRGO;
+	dac_channel.DAC_OutputBuffer = DAC_OUTPUTBUFFER_ENABLE;
+	HAL_DAC_ConfigChannel(&hdac, &dac_channel, DAC_CHANNEL_1);
+	HAL_DAC_ConfigChannel(&hdac, &dac_channel, DAC_CHANNEL_2);
+
+
+	// return pointer to the struct --------------------------------------------
+	return IO;
+
+}
+
+
+/**
+ * @brief [start the DMA streams and the timer, the adc and dac run from here on]
+ * 
+ * @param IO [pointer to the io struct]
+ */
+void start_dma_io(DMA_IO_T * IO) {
+
+	// dac: the channel 1 DMA request loads both channels through the dual register
+	HAL_DMA_Start(&hdma_dac, (uint32_t)IO->dac_buf, (uint32_t)&(DAC->DHR12RD), 2 * IO->block_size);
+	DAC->CR |= DAC_CR_DMAEN1;
+	__HAL_DAC_ENABLE_IT(&hdac, DAC_IT_DMAUDR1);
+	HAL_NVIC_SetPriority(TIM6_DAC_IRQn, 0, 0);
+	HAL_NVIC_EnableIRQ(TIM6_DAC_IRQn);
+	__HAL_DAC_ENABLE(&hdac, DAC_CHANNEL_1);
+	__HAL_DAC_ENABLE(&hdac, DAC_CHANNEL_2);
+
+	// adc: conversions wait for the timer
+	HAL_ADC_Start_DMA(&hadc, (uint32_t *)IO->adc_buf, 2 * IO->block_size);
+
+	// both start on the same tick
+	HAL_TIM_Base_Start(&htim);
+
+}
+
+
+/**
+ * @brief [stop the timer and both DMA streams]
+ * 
+ * @param IO [pointer to the io struct]
+ */
+void stop_dma_io(DMA_IO_T * IO) {
+
+	// no more triggers, then take the streams down
+	HAL_TIM_Base_Stop(&htim);
+	HAL_ADC_Stop_DMA(&hadc);
+	HAL_NVIC_DisableIRQ(TIM6_DAC_IRQn);
+	DAC->CR &= ~DAC_CR_DMAEN1;
+	HAL_DMA_Abort(&hdma_dac);
+
+	IO->process = NULL;
+	IO->ready = -1;
+	dma_io = NULL;
+
+}
+
+
+/**
+ * @brief [wait for the next block of adc samples]
+ * 
+ * @param IO [pointer to the io struct]
+ * @return [block_size raw adc samples, inside the DMA buffer]
+ */
+const uint16_t * dma_io_input(DMA_IO_T * IO) {
+
+	// wait here until the DMA finishes a half
+	while(IO->ready < 0);
+
+	IO->half = IO->ready;
+	IO->release = IO->stamp;
+	IO->ready = -1;
+
+	return IO->adc_buf + (IO->half * IO->block_size);
+
+}
+
+
+/**
+ * @brief [dac half that goes with the block dma_io_input() returned]
+ * 
+ * @param IO [pointer to the io struct]
+ * @return [block_size dual channel dac words to fill, inside the DMA buffer]
+ */
+uint32_t * dma_io_output(DMA_IO_T * IO) {
+
+	return IO->dac_buf + (IO->half * IO->block_size);
+
+}
+
+
+/**
+ * @brief [run a processing routine straight from the DMA interrupt on every half]
+ * 
+ * @param IO [pointer to the io struct]
+ * @param process [routine to run on each half, NULL to go back to dma_io_input()]
+ * @param context [handed to process]
+ */
+void dma_io_set_process(DMA_IO_T * IO, DMA_IO_PROCESS_T process, void * context) {
+
+	// the interrupt can't see a routine without its context
+	HAL_NVIC_DisableIRQ(DMA2_Stream0_IRQn);
+	IO->context = context;
+	IO->process = process;
+	IO->ready = -1;
+	HAL_NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+
+}
+
+
+/**
+ * @brief [measure the round trip latency with a loopback from dac channel 2 (PA5) to the adc (PA1)]
+ * 
+ * @param IO [pointer to the io struct]
+ * @param timeout_blocks [blocks to wait for the step before giving up]
+ * @return [latency in samples, -1 if the step never showed up]
+ */
+int dma_io_measure_latency(DMA_IO_T * IO, int timeout_blocks) {
+
+	int i, b;
+	int latency = -1;
+	const uint16_t * in;
+	uint32_t * out;
+	uint32_t level = DMA_IO_MIDSCALE | (DMA_IO_MIDSCALE << 16);
+
+	// let a few blocks of silence through first so the input has settled
+	for(b = 0; b < 4; b++) {
+		dma_io_input(IO);
+		out = dma_io_output(IO);
+		for(i = 0; i < IO->block_size; i++) out[i] = level;
+	}
+
+	// step channel 2 to 3/4 scale in the dac half that goes with input block 0
+	level = DMA_IO_MIDSCALE | (3072 << 16);
+	for(b = 0; b < timeout_blocks && latency < 0; b++) {
+
+		in = dma_io_input(IO);
+		out = dma_io_output(IO);
+		for(i = 0; i < IO->block_size; i++) out[i] = level;
+
+		// the step shows up as a jump past 5/8 scale
+		for(i = 0; i < IO->block_size; i++) {
+			if(in[i] > 2560) {
+				latency = (b * IO->block_size) + i;
+				break;
+			}
+		}
+
+	}
+
+	// back to silence
+	level = DMA_IO_MIDSCALE | (DMA_IO_MIDSCALE << 16);
+	for(i = 0; i < 2 * IO->block_size; i++) IO->dac_buf[i] = level;
+
+	return latency;
+
+}
+
+
+// the adc DMA filled a half: process it right here in low latency mode, 
+// otherwise hand it to the loop
+static void dma_io_half_done(int half) {
+	if(dma_io == NULL) return;	// stopped
+	dma_io->stamp = profile_now();	// the block's deadline is one block period from here
+	if(dma_io->process != NULL) {
+		dma_io->release = dma_io->stamp;
+		dma_io->process(dma_io->context, dma_io->adc_buf + (half * dma_io->block_size), 
+			dma_io->dac_buf + (half * dma_io->block_size), dma_io->block_size);
+	} else {
+		if(dma_io->ready >= 0) dma_io->overruns++;	// the loop never picked up the last block
+		dma_io->ready = half;
+	}
+}
+
+// the adc DMA filled the first half
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef * h) {
+	dma_io_half_done(0);
+}
+
+// the adc DMA filled the second half
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef * h) {
+	dma_io_half_done(1);
+}
+
+// the adc overran (a conversion wasn't moved before the next one) or the DMA hit a transfer error,
+// the hal stops the transfer, so count it and start again (the halves can come back up out of step 
+// with the dac, which costs up to a block of latency until the next re-plan)
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef * h) {
+	if(dma_io == NULL) return;
+	dma_io->errors++;
+	HAL_ADC_Stop_DMA(&hadc);
+	HAL_ADC_Start_DMA(&hadc, (uint32_t *)dma_io->adc_buf, 2 * dma_io->block_size);
+}
+
+// the dac was triggered before its DMA delivered the sample (the bus was held up too long), the hal
+// takes the channel off the DMA, so count it and start the stream again (out of step with the adc
+// like an adc error, until the next re-plan)
+void HAL_DAC_DMAUnderrunCallbackCh1(DAC_HandleTypeDef * h) {
+	if(dma_io == NULL) return;
+	dma_io->underruns++;
+	HAL_DMA_Abort(&hdma_dac);
+	HAL_DMA_Start(&hdma_dac, (uint32_t)dma_io->dac_buf, (uint32_t)&(DAC->DHR12RD), 2 * dma_io->block_size);
+	DAC->CR |= DAC_CR_DMAEN1;
+}
+
+// channel 2 is loaded through the dual register by channel 1's DMA, so this only fires if it
+// ever gets a DMA of its own, counted all the same
+void HAL_DACEx_DMAUnderrunCallbackCh2(DAC_HandleTypeDef * h) {
+	if(dma_io == NULL) return;
+	dma_io->underruns++;
+}
+
+// the hal tick, HAL_GetTick() and HAL_Delay() count on it
+void SysTick_Handler(void) {
+	HAL_IncTick();
+}
+
+// handle the dac underrun interrupt
+void TIM6_DAC_IRQHandler(void) {
+	HAL_DAC_IRQHandler(&hdac);
+}
+
+// handle the adc DMA interrupt
+void DMA2_Stream0_IRQHandler(void) {
+	TRACE_BEGIN("adc dma irq");
+	HAL_DMA_IRQHandler(hadc.DMA_Handle);
+	TRACE_END("adc dma irq");
+}
+
+#endif
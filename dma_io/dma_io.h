@@ -0,0 +1,237 @@
+/**
+ * @file dma_io.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for 
+ * the zero-copy adc/dac block I/O: the processing loop works straight out of the
+ * halves of the circular DMA buffers.
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef DMA_IO_H
+#define DMA_IO_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "fixed.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define DMA_IO_MIDSCALE		2048		// 12 bit adc/dac code for 0.0
+#define DMA_IO_FULLSCALE	2048.0f		// adc/dac codes for 1.0
+#define DMA_IO_LOW_LATENCY_BLOCK	8	// block size for processing in the DMA interrupt
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [block processing routine run from the DMA interrupt in low latency mode]
+ * 
+ */
+typedef void (*DMA_IO_PROCESS_T)(void * context, const uint16_t * input, uint32_t * output, int n);
+
+
+/**
+ * @brief [structure containing the DMA buffers and the ping-pong state]
+ * @details [the adc and dac buffers are each two blocks long and run in circular mode off the 
+ * same timer. while the DMA fills (or plays) one half, the other half belongs to the processing
+ * loop. input half k is processed into output half k, which the dac plays one block later, so 
+ * the round trip is 2 * block_size samples plus the filter delay]
+ * 
+ */
+typedef struct dma_io_struct {
+	DMA_IO_PROCESS_T process;	// run in the DMA interrupt on every half, NULL to leave it to the loop
+	void * context;				// handed to process
+	int block_size;				// number of samples in half of a buffer
+	uint16_t * adc_buf;			// 2 * block_size adc samples, written by DMA
+	uint32_t * dac_buf;			// 2 * block_size dual channel dac words (left in bits 0-11, right in 16-27)
+	volatile int ready;			// half the adc just finished (0 or 1), -1 if the loop already has it
+	int half;					// half the loop is working on
+	volatile int overruns;		// blocks the loop didn't pick up before the next one was ready
+	volatile int errors;		// adc overruns and DMA transfer errors reported by the hal
+	volatile int underruns;		// dac DMA underruns reported by the hal, a sample the DMA didn't deliver in time
+	volatile uint32_t stamp;	// profile_now() when the adc finished the last half
+	uint32_t release;			// profile_now() when the adc finished the half being processed
+} DMA_IO_T;
+
+
+/**
+ * @brief [set up the hal, the system clock at 168MHz and the 1ms hal tick]
+ * @details [what the ece486 library's initialize() did, without its adc and dac. called once at
+ * startup, before anything else touches the hardware]
+ * 
+ */
+void init_dma_io_clocks(void);
+
+
+/**
+ * @brief [set up the timer, adc, dac and DMA streams for block I/O]
+ * @details [the buffers have to be reachable by DMA, so A has to be an sram arena (not the ccm).
+ * nothing starts moving until start_dma_io()]
+ * 
+ * @param A [sram arena the struct and DMA buffers are allocated from]
+ * @param block_size [number of samples per block]
+ * @param FS [sampling frequency]
+ * @return [pointer to the io struct, NULL if it doesn't fit in the arena]
+ */
+DMA_IO_T * init_dma_io(
+	ARENA_T * A,		// sram arena to allocate from
+	int block_size,		// number of samples per block
+	int FS				// sampling frequency
+);
+
+
+/**
+ * @brief [start the timer, the adc and dac run from here on]
+ * 
+ * @param IO [pointer to the io struct]
+ */
+void start_dma_io(
+	DMA_IO_T * IO		// pointer to io struct
+);
+
+
+/**
+ * @brief [stop the timer and both DMA streams]
+ * @details [the buffers stay allocated, the arena they came from can be released after this 
+ * to set up I/O with another block size]
+ * 
+ * @param IO [pointer to the io struct]
+ */
+void stop_dma_io(
+	DMA_IO_T * IO		// pointer to io struct
+);
+
+
+/**
+ * @brief [wait for the next block of adc samples]
+ * @details [the pointer points into the DMA buffer itself, it is valid until the adc comes 
+ * back around to the same half, one block from now]
+ * 
+ * @param IO [pointer to the io struct]
+ * @return [block_size raw adc samples]
+ */
+const uint16_t * dma_io_input(
+	DMA_IO_T * IO		// pointer to io struct
+);
+
+
+/**
+ * @brief [dac half that goes with the block dma_io_input() returned]
+ * 
+ * @param IO [pointer to the io struct]
+ * @return [block_size dual channel dac words to fill]
+ */
+uint32_t * dma_io_output(
+	DMA_IO_T * IO		// pointer to io struct
+);
+
+
+/**
+ * @brief [run a processing routine straight from the DMA interrupt on every half]
+ * @details [low latency mode: with a tiny block_size (DMA_IO_LOW_LATENCY_BLOCK) the chain runs
+ * as soon as each half is filled, and the foreground loop is left for block rate work. process
+ * has to finish in less than block_size sample periods. NULL goes back to dma_io_input()]
+ * 
+ * @param IO [pointer to the io struct]
+ * @param process [routine to run on each half]
+ * @param context [handed to process]
+ */
+void dma_io_set_process(
+	DMA_IO_T * IO,				// pointer to io struct
+	DMA_IO_PROCESS_T process,	// routine to run on each half
+	void * context				// handed to process
+);
+
+
+/**
+ * @brief [measure the round trip latency with a loopback from dac channel 2 (PA5) to the adc (PA1)]
+ * @details [a step is written into the dac half that goes with input block k, and the latency is
+ * the number of samples from the start of input block k to the step showing up at the adc. this
+ * is the latency an input sample sees through the I/O buffers, the dac and the analog path, 
+ * without the filters. the adc/dac have to be started, and no process routine set]
+ * 
+ * @param IO [pointer to the io struct]
+ * @param timeout_blocks [blocks to wait for the step before giving up]
+ * @return [latency in samples, -1 if the step never showed up (no loopback)]
+ */
+int dma_io_measure_latency(
+	DMA_IO_T * IO,				// pointer to io struct
+	int timeout_blocks			// blocks to wait for the step
+);
+
+
+/**
+ * @brief [convert raw adc samples to floats in -1.0 to 1.0]
+ * 
+ * @param input [raw 12 bit adc samples]
+ * @param output [buffer for the float samples]
+ * @param n [number of samples]
+ */
+void adc_to_float(
+	const uint16_t * input,		// raw adc samples
+	float * output,				// float samples
+	int n						// number of samples
+);
+
+
+/**
+ * @brief [convert raw adc samples to Q15]
+ * @details [the 12 bit codes around midscale, shifted up to the top of 16 bits]
+ * 
+ * @param input [raw 12 bit adc samples]
+ * @param output [buffer for the Q15 samples]
+ * @param n [number of samples]
+ */
+void adc_to_q15(
+	const uint16_t * input,		// raw adc samples
+	q15_t * output,				// Q15 samples
+	int n						// number of samples
+);
+
+
+/**
+ * @brief [clip, convert and pack left and right float samples into dual channel dac words]
+ * 
+ * @param left [samples for dac channel 1]
+ * @param right [samples for dac channel 2]
+ * @param output [dac words]
+ * @param n [number of samples]
+ */
+void float_to_dac_stereo(
+	const float * left,			// samples for dac channel 1
+	const float * right,		// samples for dac channel 2
+	uint32_t * output,			// dac words
+	int n						// number of samples
+);
+
+
+/**
+ * @brief [fill dac words with silence on both channels]
+ * 
+ * @param output [dac words]
+ * @param n [number of samples]
+ */
+void dac_silence(
+	uint32_t * output,			// dac words
+	int n						// number of samples
+);
+
+
+#endif
@@ -0,0 +1,419 @@
+/**
+ * @file dsp.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the scalar DSP backend, the backend selection and the FFT plans.
+ * 
+ * @details [
+ * 		dsp_num_backends(), dsp_get_backend() - the backends this cpu can run
+ * 		
+ * 		dsp_select() - run the kernels on another backend
+ * 		
+ * 		init_dsp_fft() - plan a radix-2 complex FFT
+ * 		
+ * 		dsp_scalar_*() - the plain C kernels, the reference the other backends are tested against
+ * ]
+ * 
+ * Everything with an inner loop over samples (the fir and eq kernels, the band sums, the Q15 
+ * conversions) goes through the dsp pointer instead of calling cmsis or looping itself, so the
+ * same effect code runs on the board, on an x86 host and on an ARM Linux host, each with the 
+ * vector unit it has. A backend that has no faster version of a kernel points at the scalar one.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "arena.h"
+#include "fixed.h"
+#include "dsp.h"
+
+// ----------------------------------------------------------
+
+
+
+
+// BACKENDS -------------------------------------------------
+
+const DSP_BACKEND_T dsp_scalar = {
+	"scalar",
+	dsp_scalar_fir,
+	dsp_scalar_biquad,
+	dsp_scalar_add,
+	dsp_scalar_scale,
+	dsp_scalar_mac,
+	dsp_scalar_dot,
+	dsp_scalar_fft,
+	float_to_q15,
+	q15_to_float
+};
+
+#if defined(ARM_MATH_CM4) && !defined(GAPE_DSP_SCALAR)
+const DSP_BACKEND_T * dsp = &dsp_cmsis;
+#else
+const DSP_BACKEND_T * dsp = &dsp_scalar;
+#endif
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [whether this cpu can run a backend]
+ * 
+ * @param B [backend]
+ * @return [1 if it can]
+ */
+static int dsp_supported(const DSP_BACKEND_T * B) {
+
+#ifdef DSP_HAVE_AVX2
+	if(B == &dsp_avx2) {
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	}
+#endif
+
+	return 1;
+
+}
+
+
+/**
+ * @brief [every backend compiled in, slowest first]
+ * 
+ * @param i [index]
+ * @return [backend, NULL past the end]
+ */
+static const DSP_BACKEND_T * dsp_compiled(int i) {
+
+	static const DSP_BACKEND_T * const compiled[] = {
+		&dsp_scalar,
+#ifdef ARM_MATH_CM4
+		&dsp_cmsis,
+#endif
+#ifdef DSP_HAVE_NEON
+		&dsp_neon,
+#endif
+#ifdef DSP_HAVE_AVX2
+		&dsp_avx2,
+#endif
+	};
+
+	return (i < (int)(sizeof(compiled) / sizeof(compiled[0]))) ? compiled[i] : NULL;
+
+}
+
+
+/**
+ * @brief [number of backends compiled in that this cpu can run]
+ * 
+ * @return [number of backends, at least 1 (scalar)]
+ */
+int dsp_num_backends(void) {
+
+	int i;
+	int count = 0;
+	const DSP_BACKEND_T * B;
+
+	for(i = 0; (B = dsp_compiled(i)) != NULL; i++) {
+		if(dsp_supported(B)) count++;
+	}
+
+	return count;
+
+}
+
+
+/**
+ * @brief [one of the backends this cpu can run]
+ * 
+ * @param i [0 to dsp_num_backends() - 1]
+ * @return [pointer to the backend, NULL past the end]
+ */
+const DSP_BACKEND_T * dsp_get_backend(int i) {
+
+	int k;
+	const DSP_BACKEND_T * B;
+
+	for(k = 0; (B = dsp_compiled(k)) != NULL; k++) {
+		if(dsp_supported(B) && i-- == 0) return B;
+	}
+
+	return NULL;
+
+}
+
+
+/**
+ * @brief [run the kernels on another backend]
+ * 
+ * @param name [name of the backend, NULL for the fastest this cpu can run]
+ * @return [0 on success, 1 if there is no such backend here]
+ */
+int dsp_select(const char * name) {
+
+	int i;
+	const DSP_BACKEND_T * B;
+
+	if(name == NULL) {
+#ifdef GAPE_DSP_SCALAR
+		dsp = &dsp_scalar;
+#else
+		dsp = dsp_get_backend(dsp_num_backends() - 1);
+#endif
+		return 0;
+	}
+
+	for(i = 0; (B = dsp_get_backend(i)) != NULL; i++) {
+		if(strcmp(B->name, name) == 0) {
+			dsp = B;
+			return 0;
+		}
+	}
+
+	return 1;
+
+}
+
+
+/**
+ * @brief [plan a radix-2 complex FFT]
+ * 
+ * @param A [arena the tables are allocated from]
+ * @param size [number of complex values, a power of 2 up to 65536]
+ * @return [pointer to the plan, NULL if it doesn't fit in the arena or size isn't a power of 2]
+ */
+DSP_FFT_T * init_dsp_fft(ARENA_T * A, int size) {
+
+	int i, j, b;
+	DSP_FFT_T * P;
+
+	// the bit reverse table is 16 bit
+	if(size < 2 || size > 65536 || (size & (size - 1)) != 0) return NULL;
+
+	P = (DSP_FFT_T *)arena_alloc(A, sizeof(DSP_FFT_T));	// allocate struct
+	if(P == NULL) return NULL;							// errcheck alloc
+
+	P->size = size;
+	P->log2_size = 0;
+	while((1 << P->log2_size) < size) P->log2_size++;
+
+	P->twiddle = (float *)arena_alloc(A, sizeof(float) * size);
+	P->bitrev = (uint16_t *)arena_alloc(A, sizeof(uint16_t) * size);
+	if(P->twiddle == NULL || P->bitrev == NULL) return NULL;
+
+	// twiddles in double so the error doesn't build up across the table
+	for(i = 0; i < size / 2; i++) {
+		P->twiddle[2*i] = (float)cos(-2.0 * M_PI * i / size);
+		P->twiddle[2*i+1] = (float)sin(-2.0 * M_PI * i / size);
+	}
+
+	for(i = 0; i < size; i++) {
+		j = 0;
+		for(b = 0; b < P->log2_size; b++) {
+			if(i & (1 << b)) j |= 1 << (P->log2_size - 1 - b);
+		}
+		P->bitrev[i] = j;
+	}
+
+#ifdef ARM_MATH_CM4
+	// cmsis has its own tables, from 16 to 4096 points. other sizes stay on the scalar FFT
+	P->cmsis = (arm_cfft_radix2_init_f32(&(P->S), size, 0, 1) == ARM_MATH_SUCCESS);
+#endif
+
+	return P;
+
+}
+
+
+
+
+// SCALAR KERNELS -------------------------------------------
+
+
+/**
+ * @brief [direct form FIR, what arm_fir_f32 does]
+ * 
+ * @param coefs [num_taps coefficients]
+ * @param num_taps [number of coefficients]
+ * @param state [last num_taps - 1 inputs followed by room for n more]
+ * @param input [n input samples]
+ * @param output [buffer for n filtered samples]
+ * @param n [number of samples]
+ */
+void dsp_scalar_fir(const float * coefs, int num_taps, float * state, const float * input, float * output, int n) {
+
+	int i, k;
+	float acc;
+	float * x;
+
+	// newest block after the last taps - 1 inputs, then convolve
+	if(input != state + (num_taps - 1)) memcpy(state + (num_taps - 1), input, sizeof(float) * n);
+	for(i = 0; i < n; i++) {
+		x = state + (num_taps - 1) + i;
+		acc = 0.0f;
+		for(k = 0; k < num_taps; k++) acc += coefs[k] * x[-k];
+		output[i] = acc;
+	}
+	memmove(state, state + n, sizeof(float) * (num_taps - 1));
+
+}
+
+
+/**
+ * @brief [cascade of direct form 1 biquads, what arm_biquad_cascade_df1_f32 does]
+ * @details [y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2], the a terms
+ * with the cmsis sign (added, not subtracted)]
+ * 
+ * @param coefs [DSP_BIQUAD_COEFS per stage]
+ * @param num_stages [number of stages]
+ * @param state [DSP_BIQUAD_STATE per stage]
+ * @param input [n input samples]
+ * @param output [buffer for n filtered samples]
+ * @param n [number of samples]
+ */
+void dsp_scalar_biquad(const float * coefs, int num_stages, float * state, const float * input, float * output, int n) {
+
+	int s, i;
+	float x, y;
+	const float * c;
+	float * z;
+	const float * in = input;
+
+	for(s = 0; s < num_stages; s++) {
+		c = coefs + DSP_BIQUAD_COEFS * s;
+		z = state + DSP_BIQUAD_STATE * s;
+		for(i = 0; i < n; i++) {
+			x = in[i];
+			y = c[0] * x + c[1] * z[0] + c[2] * z[1] + c[3] * z[2] + c[4] * z[3];
+			z[1] = z[0];
+			z[0] = x;
+			z[3] = z[2];
+			z[2] = y;
+			output[i] = y;
+		}
+		in = output;	// the next stage runs in place on this one's output
+	}
+
+}
+
+
+/**
+ * @brief [output = a + b]
+ * 
+ * @param a [n samples]
+ * @param b [n samples]
+ * @param output [buffer for n samples]
+ * @param n [number of samples]
+ */
+void dsp_scalar_add(const float * a, const float * b, float * output, int n) {
+
+	int i;
+
+	for(i = 0; i < n; i++) output[i] = a[i] + b[i];
+
+}
+
+
+/**
+ * @brief [output = scale * a]
+ * 
+ * @param a [n samples]
+ * @param scale [gain]
+ * @param output [buffer for n samples]
+ * @param n [number of samples]
+ */
+void dsp_scalar_scale(const float * a, float scale, float * output, int n) {
+
+	int i;
+
+	for(i = 0; i < n; i++) output[i] = scale * a[i];
+
+}
+
+
+/**
+ * @brief [acc += scale * a]
+ * 
+ * @param a [n samples]
+ * @param scale [gain]
+ * @param acc [n samples to add to]
+ * @param n [number of samples]
+ */
+void dsp_scalar_mac(const float * a, float scale, float * acc, int n) {
+
+	int i;
+
+	for(i = 0; i < n; i++) acc[i] += scale * a[i];
+
+}
+
+
+/**
+ * @brief [sum of a * b, what arm_dot_prod_f32 does]
+ * 
+ * @param a [n samples]
+ * @param b [n samples]
+ * @param n [number of samples]
+ * @return [dot product]
+ */
+float dsp_scalar_dot(const float * a, const float * b, int n) {
+
+	int i;
+	float acc = 0.0f;
+
+	for(i = 0; i < n; i++) acc += a[i] * b[i];
+
+	return acc;
+
+}
+
+
+/**
+ * @brief [in place radix-2 FFT of P->size interleaved complex values]
+ * @details [an inverse is done by the caller by conjugating before and after]
+ * 
+ * @param P [plan with the twiddles and bit reverse table]
+ * @param x [interleaved complex values]
+ */
+void dsp_scalar_fft(const DSP_FFT_T * P, float * x) {
+
+	int i, j, k, half, step;
+	int M = P->size;
+	float tr, ti, wr, wi, t;
+
+	// bit reverse order
+	for(i = 0; i < M; i++) {
+		j = P->bitrev[i];
+		if(j > i) {
+			t = x[2*i]; x[2*i] = x[2*j]; x[2*j] = t;
+			t = x[2*i+1]; x[2*i+1] = x[2*j+1]; x[2*j+1] = t;
+		}
+	}
+
+	// butterflies, the twiddle for span 2*half is every (M / (2*half))th one
+	for(half = 1; half < M; half <<= 1) {
+		step = M / (2 * half);
+		for(k = 0; k < half; k++) {
+			wr = P->twiddle[2 * k * step];
+			wi = P->twiddle[2 * k * step + 1];
+			for(i = k; i < M; i += 2 * half) {
+				j = i + half;
+				tr = wr * x[2*j] - wi * x[2*j+1];
+				ti = wr * x[2*j+1] + wi * x[2*j];
+				x[2*j] = x[2*i] - tr;
+				x[2*j+1] = x[2*i+1] - ti;
+				x[2*i] += tr;
+				x[2*i+1] += ti;
+			}
+		}
+	}
+
+}
@@ -0,0 +1,169 @@
+/**
+ * @file dsp.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the declarations of the DSP backend layer: the block kernels every
+ * filter and effect is built on, with one implementation per instruction set.
+ * 
+ * @details [backends, compiled in where the instruction set is there:
+ * 		dsp_scalar		plain C, the reference, always there
+ * 		dsp_cmsis		cmsis-dsp on the Cortex-M4 (ARM_MATH_CM4)
+ * 		dsp_avx2		AVX2/FMA on x86-64, for the Linux simulation, if the cpu has it
+ * 		dsp_neon		NEON on the Raspberry Pi (__ARM_NEON)
+ * the kernels all go through the dsp pointer. it starts out on cmsis on the board and scalar 
+ * everywhere else, dsp_select() moves it. built with GAPE_DSP_SCALAR (make DSP_SCALAR=1) it starts
+ * out on scalar on the board too and dsp_select(NULL) leaves it there, to compare against]
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef DSP_H
+#define DSP_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#ifdef ARM_MATH_CM4
+#include "arm_math.h"
+#endif
+
+#include "arena.h"
+#include "fixed.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define DSP_BIQUAD_COEFS	5		// b0, b1, b2, a1, a2 per stage, a1 and a2 with the cmsis sign
+#define DSP_BIQUAD_STATE	4		// x[n-1], x[n-2], y[n-1], y[n-2] per stage
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [plan for an in place radix-2 complex FFT of one size]
+ * 
+ */
+typedef struct dsp_fft_struct {
+	int size;					// M, a power of 2
+	int log2_size;				// log2(M)
+	float * twiddle;			// M / 2 interleaved complex exp(-2 pi i k / M)
+	uint16_t * bitrev;			// bit reversed index for each of the M bins
+#ifdef ARM_MATH_CM4
+	arm_cfft_radix2_instance_f32 S;	// cmsis radix-2 FFT
+	int cmsis;					// 1 if cmsis has tables for this size
+#endif
+} DSP_FFT_T;
+
+
+/**
+ * @brief [kernels of one backend]
+ * @details [in place (output the same buffer as an input) works for every kernel except fir and
+ * biquad, which need their state]
+ * 
+ */
+typedef struct dsp_backend {
+	const char * name;			// for reports and dsp_select()
+
+	// y[i] = sum over k of coefs[k] * x[i - k]. state holds the last num_taps - 1 inputs followed by
+	// room for n more, the cmsis arm_fir_f32 layout. input can already be in that room (see fir_input()).
+	// the coefs are symmetric in every GAPE filter, which makes the time reversed order cmsis reads them in the same
+	void (*fir)(const float * coefs, int num_taps, float * state, const float * input, float * output, int n);
+
+	// cascade of direct form 1 biquads, DSP_BIQUAD_COEFS coefs and DSP_BIQUAD_STATE state per stage
+	void (*biquad)(const float * coefs, int num_stages, float * state, const float * input, float * output, int n);
+
+	void (*add)(const float * a, const float * b, float * output, int n);		// output = a + b
+	void (*scale)(const float * a, float scale, float * output, int n);		// output = scale * a
+	void (*mac)(const float * a, float scale, float * acc, int n);			// acc += scale * a
+	float (*dot)(const float * a, const float * b, int n);					// sum of a * b
+
+	// forward FFT of P->size interleaved complex values in place, in natural order
+	void (*fft)(const DSP_FFT_T * P, float * x);
+
+	void (*float_to_q15)(const float * input, q15_t * output, int n);		// rounding and saturating
+	void (*q15_to_float)(const q15_t * input, float * output, int n);
+} DSP_BACKEND_T;
+
+
+extern const DSP_BACKEND_T * dsp;		// backend the kernels run on
+
+extern const DSP_BACKEND_T dsp_scalar;
+#ifdef ARM_MATH_CM4
+extern const DSP_BACKEND_T dsp_cmsis;
+#endif
+#if defined(__x86_64__) && defined(__GNUC__)
+#define DSP_HAVE_AVX2
+extern const DSP_BACKEND_T dsp_avx2;
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DSP_HAVE_NEON
+extern const DSP_BACKEND_T dsp_neon;
+#endif
+
+
+/**
+ * @brief [number of backends compiled in that this cpu can run]
+ * 
+ * @return [number of backends, at least 1 (scalar)]
+ */
+int dsp_num_backends(void);
+
+
+/**
+ * @brief [one of the backends this cpu can run]
+ * 
+ * @param i [0 to dsp_num_backends() - 1, 0 is scalar, the last one is the fastest]
+ * @return [pointer to the backend]
+ */
+const DSP_BACKEND_T * dsp_get_backend(
+	int i			// backend index
+);
+
+
+/**
+ * @brief [run the kernels on another backend]
+ * 
+ * @param name [name of the backend, NULL for the fastest this cpu can run]
+ * @return [0 on success, 1 if there is no such backend here]
+ */
+int dsp_select(
+	const char * name		// backend name or NULL
+);
+
+
+/**
+ * @brief [plan a radix-2 complex FFT]
+ * 
+ * @param A [arena the tables are allocated from]
+ * @param size [number of complex values, a power of 2 up to 65536]
+ * @return [pointer to the plan, NULL if it doesn't fit in the arena or size isn't a power of 2]
+ */
+DSP_FFT_T * init_dsp_fft(
+	ARENA_T * A,		// arena to allocate from
+	int size			// FFT size
+);
+
+
+// the scalar kernels, for other backends to fall back on --------------------
+void dsp_scalar_fir(const float * coefs, int num_taps, float * state, const float * input, float * output, int n);
+void dsp_scalar_biquad(const float * coefs, int num_stages, float * state, const float * input, float * output, int n);
+void dsp_scalar_add(const float * a, const float * b, float * output, int n);
+void dsp_scalar_scale(const float * a, float scale, float * output, int n);
+void dsp_scalar_mac(const float * a, float scale, float * acc, int n);
+float dsp_scalar_dot(const float * a, const float * b, int n);
+void dsp_scalar_fft(const DSP_FFT_T * P, float * x);
+
+
+#endif
@@ -0,0 +1,200 @@
+/**
+ * @file dsp_avx2.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the AVX2/FMA backend, for running the engine on an x86-64 host.
+ * 
+ * @details [the functions are compiled for AVX2 with a target attribute so the rest of the host
+ * build stays baseline x86-64. dsp_select() only hands this backend out if the cpu reports avx2
+ * and fma. the FIR keeps 8 neighbouring outputs in one register and broadcasts each coefficient
+ * over them, so every tap is one load and one FMA for 8 samples. the biquad is a recursion, it 
+ * and the FFT stay scalar]
+ * 
+ */
+
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "fixed.h"
+#include "dsp.h"
+
+// ----------------------------------------------------------
+
+
+#define DSP_AVX2 __attribute__((target("avx2,fma")))
+
+
+
+
+/**
+ * @brief [direct form FIR, 8 outputs per register]
+ */
+DSP_AVX2 static void dsp_avx2_fir(const float * coefs, int num_taps, float * state, const float * input, float * output, int n) {
+
+	int i, k;
+	float acc;
+	float * x;
+	__m256 sum;
+
+	if(input != state + (num_taps - 1)) memcpy(state + (num_taps - 1), input, sizeof(float) * n);
+
+	// output i + j reads x[i + j - k], so tap k is one unaligned load of 8 inputs
+	for(i = 0; i + 8 <= n; i += 8) {
+		x = state + (num_taps - 1) + i;
+		sum = _mm256_setzero_ps();
+		for(k = 0; k < num_taps; k++) {
+			sum = _mm256_fmadd_ps(_mm256_set1_ps(coefs[k]), _mm256_loadu_ps(x - k), sum);
+		}
+		_mm256_storeu_ps(output + i, sum);
+	}
+
+	for(; i < n; i++) {
+		x = state + (num_taps - 1) + i;
+		acc = 0.0f;
+		for(k = 0; k < num_taps; k++) acc += coefs[k] * x[-k];
+		output[i] = acc;
+	}
+
+	memmove(state, state + n, sizeof(float) * (num_taps - 1));
+
+}
+
+
+/**
+ * @brief [output = a + b]
+ */
+DSP_AVX2 static void dsp_avx2_add(const float * a, const float * b, float * output, int n) {
+
+	int i;
+
+	for(i = 0; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(output + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+	}
+	for(; i < n; i++) output[i] = a[i] + b[i];
+
+}
+
+
+/**
+ * @brief [output = scale * a]
+ */
+DSP_AVX2 static void dsp_avx2_scale(const float * a, float scale, float * output, int n) {
+
+	int i;
+	__m256 s = _mm256_set1_ps(scale);
+
+	for(i = 0; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(output + i, _mm256_mul_ps(s, _mm256_loadu_ps(a + i)));
+	}
+	for(; i < n; i++) output[i] = scale * a[i];
+
+}
+
+
+/**
+ * @brief [acc += scale * a]
+ */
+DSP_AVX2 static void dsp_avx2_mac(const float * a, float scale, float * acc, int n) {
+
+	int i;
+	__m256 s = _mm256_set1_ps(scale);
+
+	for(i = 0; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(acc + i, _mm256_fmadd_ps(s, _mm256_loadu_ps(a + i), _mm256_loadu_ps(acc + i)));
+	}
+	for(; i < n; i++) acc[i] += scale * a[i];
+
+}
+
+
+/**
+ * @brief [sum of a * b]
+ * @details [two accumulators hide the FMA latency, they are added across the register at the end]
+ */
+DSP_AVX2 static float dsp_avx2_dot(const float * a, const float * b, int n) {
+
+	int i;
+	float acc;
+	__m256 sum0 = _mm256_setzero_ps();
+	__m256 sum1 = _mm256_setzero_ps();
+	__m128 sum;
+
+	for(i = 0; i + 16 <= n; i += 16) {
+		sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+		sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), sum1);
+	}
+	for(; i + 8 <= n; i += 8) sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), sum0);
+
+	sum0 = _mm256_add_ps(sum0, sum1);
+	sum = _mm_add_ps(_mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1));
+	sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+	sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+	acc = _mm_cvtss_f32(sum);
+
+	for(; i < n; i++) acc += a[i] * b[i];
+
+	return acc;
+
+}
+
+
+/**
+ * @brief [floats to Q15, rounding to nearest and saturating]
+ * @details [the pack saturates, ties round to even instead of away from zero]
+ */
+DSP_AVX2 static void dsp_avx2_float_to_q15(const float * input, q15_t * output, int n) {
+
+	int i;
+	__m256 s = _mm256_set1_ps(Q15_ONE);
+	__m256i lo, hi;
+
+	for(i = 0; i + 16 <= n; i += 16) {
+		lo = _mm256_cvtps_epi32(_mm256_mul_ps(s, _mm256_loadu_ps(input + i)));
+		hi = _mm256_cvtps_epi32(_mm256_mul_ps(s, _mm256_loadu_ps(input + i + 8)));
+		// the pack works within 128 bit lanes, the permute puts the 4 quarters back in order
+		_mm256_storeu_si256((__m256i *)(output + i), _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8));
+	}
+	for(; i < n; i++) output[i] = float_to_q15_one(input[i]);
+
+}
+
+
+/**
+ * @brief [Q15 to floats]
+ */
+DSP_AVX2 static void dsp_avx2_q15_to_float(const q15_t * input, float * output, int n) {
+
+	int i;
+	__m256 s = _mm256_set1_ps(1.0f / Q15_ONE);
+
+	for(i = 0; i + 8 <= n; i += 8) {
+		__m256i x = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(input + i)));
+		_mm256_storeu_ps(output + i, _mm256_mul_ps(s, _mm256_cvtepi32_ps(x)));
+	}
+	for(; i < n; i++) output[i] = input[i] * (1.0f / Q15_ONE);
+
+}
+
+
+const DSP_BACKEND_T dsp_avx2 = {
+	"avx2",
+	dsp_avx2_fir,
+	dsp_scalar_biquad,
+	dsp_avx2_add,
+	dsp_avx2_scale,
+	dsp_avx2_mac,
+	dsp_avx2_dot,
+	dsp_scalar_fft,
+	dsp_avx2_float_to_q15,
+	dsp_avx2_q15_to_float
+};
+
+#endif
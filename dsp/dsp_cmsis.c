@@ -0,0 +1,147 @@
+/**
+ * @file dsp_cmsis.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the cmsis-dsp backend, the one the board runs on.
+ * 
+ * @details [the cmsis functions take instance structs set up by an init function that also 
+ * clears the state. the kernels here are handed the state from outside, so the instances are 
+ * filled in on the stack each call instead, which costs a few stores. cmsis doesn't take const 
+ * pointers, nothing here is written through the casts]
+ * 
+ */
+
+
+#ifdef ARM_MATH_CM4
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+
+#include "arm_math.h"
+#include "fixed.h"
+#include "dsp.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [direct form FIR with arm_fir_f32]
+ * @details [arm_fir_f32 slides its own state, the layout is the same as dsp_scalar_fir()]
+ */
+static void dsp_cmsis_fir(const float * coefs, int num_taps, float * state, const float * input, float * output, int n) {
+
+	arm_fir_instance_f32 S;
+
+	S.numTaps = num_taps;
+	S.pState = state;
+	S.pCoeffs = (float32_t *)coefs;
+	arm_fir_f32(&S, (float32_t *)input, output, n);
+
+}
+
+
+/**
+ * @brief [biquad cascade with arm_biquad_cascade_df1_f32]
+ */
+static void dsp_cmsis_biquad(const float * coefs, int num_stages, float * state, const float * input, float * output, int n) {
+
+	arm_biquad_casd_df1_inst_f32 S;
+
+	S.numStages = num_stages;
+	S.pState = state;
+	S.pCoeffs = (float32_t *)coefs;
+	arm_biquad_cascade_df1_f32(&S, (float32_t *)input, output, n);
+
+}
+
+
+/**
+ * @brief [output = a + b with arm_add_f32]
+ */
+static void dsp_cmsis_add(const float * a, const float * b, float * output, int n) {
+
+	arm_add_f32((float32_t *)a, (float32_t *)b, output, n);
+
+}
+
+
+/**
+ * @brief [output = scale * a with arm_scale_f32]
+ */
+static void dsp_cmsis_scale(const float * a, float scale, float * output, int n) {
+
+	arm_scale_f32((float32_t *)a, scale, output, n);
+
+}
+
+
+/**
+ * @brief [forward FFT with arm_cfft_radix2_f32, the scalar one for sizes cmsis has no tables for]
+ */
+static void dsp_cmsis_fft(const DSP_FFT_T * P, float * x) {
+
+	if(P->cmsis) {
+		arm_cfft_radix2_f32(&(P->S), x);
+	} else {
+		dsp_scalar_fft(P, x);
+	}
+
+}
+
+
+/**
+ * @brief [floats to Q15 with arm_float_to_q15]
+ * @details [saturates, but only rounds if cmsis was built with ARM_MATH_ROUNDING, so it can be 
+ * 1 LSB under dsp_scalar]
+ */
+static void dsp_cmsis_float_to_q15(const float * input, q15_t * output, int n) {
+
+	arm_float_to_q15((float32_t *)input, output, n);
+
+}
+
+
+/**
+ * @brief [sum of a * b with arm_dot_prod_f32]
+ */
+static float dsp_cmsis_dot(const float * a, const float * b, int n) {
+
+	float32_t result;
+
+	arm_dot_prod_f32((float32_t *)a, (float32_t *)b, n, &result);
+	return result;
+
+}
+
+
+/**
+ * @brief [Q15 to floats with arm_q15_to_float]
+ */
+static void dsp_cmsis_q15_to_float(const q15_t * input, float * output, int n) {
+
+	arm_q15_to_float((q15_t *)input, output, n);
+
+}
+
+
+// cmsis has no multiply-accumulate of a scaled vector, the scalar loop compiles to VFMA anyway
+const DSP_BACKEND_T dsp_cmsis = {
+	"cmsis",
+	dsp_cmsis_fir,
+	dsp_cmsis_biquad,
+	dsp_cmsis_add,
+	dsp_cmsis_scale,
+	dsp_scalar_mac,
+	dsp_cmsis_dot,
+	dsp_cmsis_fft,
+	dsp_cmsis_float_to_q15,
+	dsp_cmsis_q15_to_float
+};
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file dsp_neon.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the NEON backend, for running the engine on an ARM Linux host
+ * (Raspberry Pi and the like).
+ * 
+ * @details [the FIR keeps 4 neighbouring outputs in one register and multiply-accumulates each
+ * coefficient over them. the biquad is a recursion, it and the FFT stay scalar]
+ * 
+ */
+
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <arm_neon.h>
+
+#include "fixed.h"
+#include "dsp.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [direct form FIR, 4 outputs per register]
+ */
+static void dsp_neon_fir(const float * coefs, int num_taps, float * state, const float * input, float * output, int n) {
+
+	int i, k;
+	float acc;
+	float * x;
+	float32x4_t sum;
+
+	if(input != state + (num_taps - 1)) memcpy(state + (num_taps - 1), input, sizeof(float) * n);
+
+	for(i = 0; i + 4 <= n; i += 4) {
+		x = state + (num_taps - 1) + i;
+		sum = vdupq_n_f32(0.0f);
+		for(k = 0; k < num_taps; k++) sum = vmlaq_n_f32(sum, vld1q_f32(x - k), coefs[k]);
+		vst1q_f32(output + i, sum);
+	}
+
+	for(; i < n; i++) {
+		x = state + (num_taps - 1) + i;
+		acc = 0.0f;
+		for(k = 0; k < num_taps; k++) acc += coefs[k] * x[-k];
+		output[i] = acc;
+	}
+
+	memmove(state, state + n, sizeof(float) * (num_taps - 1));
+
+}
+
+
+/**
+ * @brief [output = a + b]
+ */
+static void dsp_neon_add(const float * a, const float * b, float * output, int n) {
+
+	int i;
+
+	for(i = 0; i + 4 <= n; i += 4) vst1q_f32(output + i, vaddq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+	for(; i < n; i++) output[i] = a[i] + b[i];
+
+}
+
+
+/**
+ * @brief [output = scale * a]
+ */
+static void dsp_neon_scale(const float * a, float scale, float * output, int n) {
+
+	int i;
+
+	for(i = 0; i + 4 <= n; i += 4) vst1q_f32(output + i, vmulq_n_f32(vld1q_f32(a + i), scale));
+	for(; i < n; i++) output[i] = scale * a[i];
+
+}
+
+
+/**
+ * @brief [acc += scale * a]
+ */
+static void dsp_neon_mac(const float * a, float scale, float * acc, int n) {
+
+	int i;
+
+	for(i = 0; i + 4 <= n; i += 4) vst1q_f32(acc + i, vmlaq_n_f32(vld1q_f32(acc + i), vld1q_f32(a + i), scale));
+	for(; i < n; i++) acc[i] += scale * a[i];
+
+}
+
+
+/**
+ * @brief [sum of a * b]
+ */
+static float dsp_neon_dot(const float * a, const float * b, int n) {
+
+	int i;
+	float acc;
+	float32x4_t sum = vdupq_n_f32(0.0f);
+	float32x2_t half;
+
+	for(i = 0; i + 4 <= n; i += 4) sum = vmlaq_f32(sum, vld1q_f32(a + i), vld1q_f32(b + i));
+
+	// pairwise adds, vaddvq_f32 is aarch64 only
+	half = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+	acc = vget_lane_f32(vpadd_f32(half, half), 0);
+
+	for(; i < n; i++) acc += a[i] * b[i];
+
+	return acc;
+
+}
+
+
+/**
+ * @brief [Q15 to floats]
+ */
+static void dsp_neon_q15_to_float(const q15_t * input, float * output, int n) {
+
+	int i;
+
+	for(i = 0; i + 4 <= n; i += 4) {
+		vst1q_f32(output + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(input + i))), 1.0f / Q15_ONE));
+	}
+	for(; i < n; i++) output[i] = input[i] * (1.0f / Q15_ONE);
+
+}
+
+
+// the float to Q15 conversion needs round to nearest, which 32 bit NEON doesn't have
+const DSP_BACKEND_T dsp_neon = {
+	"neon",
+	dsp_neon_fir,
+	dsp_scalar_biquad,
+	dsp_neon_add,
+	dsp_neon_scale,
+	dsp_neon_mac,
+	dsp_neon_dot,
+	dsp_scalar_fft,
+	float_to_q15,
+	dsp_neon_q15_to_float
+};
+
+#endif
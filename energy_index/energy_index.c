@@ -0,0 +1,219 @@
+/**
+ * @file energy_index.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for the shared prefix-sum energy index.
+ * 
+ * @details [
+ * 		init_energy_index() - initialize energy index struct and the circular prefix buffer
+ * 		
+ * 		update_energy_index() - accumulate a block of input samples into the index
+ * 		
+ * 		energy_index_add() - accumulate samples a level detector has already squared
+ * 		
+ * 		energy_mean_square() - mean-square of the input over any recent window
+ * 		
+ * 		energy_rms() - rms of the input over any recent window
+ * 		
+ * 		reset_energy_index() - clear the index back to silence
+ * ]
+ * 
+ * Instead of every level detector keeping its own history of squared samples (like RMS_T does), the 
+ * input is squared and summed once per block. Every granularity samples the running total of the 
+ * energy is written into a circular buffer, so the energy of the last N sub-blocks is just
+ * prefix[head] - prefix[head - N]. Any window up to max_window is then an O(1) lookup.
+ * 
+ * The running totals are kept in double precision because they only ever grow. Per sample the
+ * accumulation is still single precision, the double add only happens once per sub-block.
+ * 
+ * A detector that already squares every sample (the compressor's running mean-square) feeds its
+ * squares in with energy_index_add() from inside its own loop, so the index costs no extra pass.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "arena.h"
+ 
+#include "energy_index.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [initialize the energy index]
+ * @details [the longest window that can be queried is max_window samples. windows are
+ * resolved to a multiple of granularity samples]
+ * 
+ * @param A [arena the struct and prefix buffer are allocated from]
+ * @param max_window [longest window in samples any consumer will ask for]
+ * @param granularity [number of samples per prefix entry]
+ * 
+ * @return [pointer to the energy index struct, NULL on bad sizes or if it doesn't fit in the arena]
+ */
+ENERGY_T * init_energy_index(ARENA_T * A, int max_window, int granularity) {
+
+	if(granularity <= 0 || max_window < granularity) return NULL;
+
+	// set up struct for energy index -------------------------------------
+	ENERGY_T * E = (ENERGY_T *)arena_alloc(A, sizeof(ENERGY_T));	// allocate struct
+	if(E == NULL) return NULL;										// errcheck alloc
+
+	E->granularity = granularity;
+	// one extra entry so the oldest boundary of a max_window query is still in the buffer
+	E->num_entries = ((max_window + granularity - 1) / granularity) + 1;
+	E->head = 0;
+	E->total = 0.0;
+	E->partial = 0.0;
+	E->partial_count = 0;
+
+
+	// initialize circular buffer of running totals -----------------------
+	// all zero (as the arena hands it out) is the same as the input having been silent before we started
+	E->prefix = (volatile double *)arena_alloc(A, sizeof(double) * E->num_entries);
+	if(E->prefix == NULL) return NULL;
+
+
+	// return pointer to the struct ---------------------------------------
+	return E;
+
+}
+
+
+/**
+ * @brief [add n input samples to the energy index]
+ * @details [the block is walked in runs that end on granularity boundaries, so the inner
+ * loop is a plain sum of squares with no per-sample branch]
+ * 
+ * @param E [pointer to the energy index struct]
+ * @param input [buffer containing n input samples]
+ * @param n [number of samples to add]
+ */
+void update_energy_index(ENERGY_T * E, const float * input, int n) {
+
+	int i = 0;
+	int j, run;
+	float sum;
+
+	while(i < n) {
+
+		// number of samples left before the next granularity boundary
+		run = E->granularity - E->partial_count;
+		if(run > (n - i)) run = n - i;
+
+		// sum of squares for this run
+		sum = 0.0;
+		for(j = 0; j < run; j++) {
+			sum += input[i + j] * input[i + j];
+		}
+		energy_index_add(E, sum, run);
+		i += run;
+
+	}
+
+}
+
+
+/**
+ * @brief [add the sum of squares of n samples the caller has already squared]
+ * @details [n can't run past the next granularity boundary, granularity - partial_count samples
+ * away. summed in the same order as update_energy_index(), the index comes out the same]
+ * 
+ * @param E [pointer to the energy index struct]
+ * @param sum [sum of the squares of the samples]
+ * @param n [number of samples in the sum]
+ */
+void energy_index_add(ENERGY_T * E, float sum, int n) {
+
+	int next;
+
+	E->partial += sum;
+	E->partial_count += n;
+
+	// sub-block is complete, write the running total into the circular buffer
+	if(E->partial_count == E->granularity) {
+		E->total += E->partial;
+		E->partial = 0.0;
+		E->partial_count = 0;
+
+		// the entry is written before head moves onto it, for a reader in the foreground
+		next = (E->head == (E->num_entries - 1)) ? 0 : (E->head + 1);
+		E->prefix[next] = E->total;
+		E->head = next;
+	}
+
+}
+
+
+/**
+ * @brief [mean-square value of the most recent window samples]
+ * @details [the window covers the last window / granularity complete sub-blocks plus whatever 
+ * is in the sub-block currently being filled. like calc_rms, the energy is divided by the 
+ * full window length, so before the index fills the missing history counts as silence]
+ * 
+ * @param E [pointer to the energy index struct]
+ * @param window [number of samples to average over]
+ * 
+ * @return [mean-square value over the window]
+ */
+float energy_mean_square(ENERGY_T * E, int window) {
+
+	int n, head, oldest;
+	double energy;
+
+	// number of complete sub-blocks in the window, limited to what the buffer holds
+	n = window / E->granularity;
+	if(n < 1) n = 1;
+	if(n > (E->num_entries - 1)) n = E->num_entries - 1;
+
+	head = E->head;
+	oldest = head - n;
+	if(oldest < 0) oldest += E->num_entries;
+
+	// energy of the window is the difference of the two running totals
+	energy = (E->prefix[head] - E->prefix[oldest]) + E->partial;
+	if(energy < 0.0) energy = 0.0;	// guard against rounding when the input is silent
+
+	return (float)(energy / ((n * E->granularity) + E->partial_count));
+
+}
+
+
+/**
+ * @brief [rms value of the most recent window samples]
+ * 
+ * @param E [pointer to the energy index struct]
+ * @param window [number of samples to average over]
+ * 
+ * @return [rms value over the window]
+ */
+float energy_rms(ENERGY_T * E, int window) {
+
+	return sqrtf(energy_mean_square(E, window));
+
+}
+
+
+/**
+ * @brief [clear the index back to silence]
+ * @details [all zero is the same as the input having been silent, as at init]
+ * 
+ * @param E [pointer to the energy index struct]
+ */
+void reset_energy_index(ENERGY_T * E) {
+
+	memset((void *)E->prefix, 0, sizeof(double) * E->num_entries);
+	E->head = 0;
+	E->total = 0.0;
+	E->partial = 0.0;
+	E->partial_count = 0;
+
+}
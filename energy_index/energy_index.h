@@ -0,0 +1,143 @@
+/**
+ * @file energy_index.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for
+ * the shared prefix-sum energy index. Every level detector (compressor, gate, meters, tuner)
+ * can query the rms value of the input over its own window from this one structure.
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef ENERGY_INDEX_H
+#define ENERGY_INDEX_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [structure containing necessary fields for the prefix-sum energy index]
+ * @details [prefix[] is a circular buffer holding the running total of x[n]^2 taken at every
+ * granularity boundary. the energy of any window is then the difference between two entries]
+ * 
+ */
+typedef struct energy_struct {
+	int granularity;		// number of samples summed into each prefix entry
+	int num_entries;		// length of the circular prefix buffer
+	volatile double * prefix;	// circular buffer of cumulative energy at each granularity boundary
+	volatile int head;			// index of the most recent prefix entry, moved after the entry is written
+	double total;			// cumulative energy up to the last completed sub-block
+	float partial;			// energy of the sub-block currently being filled
+	int partial_count;		// number of samples in the current sub-block
+} ENERGY_T;
+
+
+/**
+ * @brief [initialize the energy index]
+ * @details [the longest window that can be queried is max_window samples. windows are
+ * resolved to a multiple of granularity samples, so a granularity equal to (or dividing) the
+ * block size gives exact windows at every block boundary]
+ * 
+ * @param A [arena the struct and prefix buffer are allocated from]
+ * @param max_window [longest window in samples any consumer will ask for]
+ * @param granularity [number of samples per prefix entry]
+ * 
+ * @return [pointer to the energy index struct, NULL on bad sizes or if it doesn't fit in the arena]
+ */
+ENERGY_T * init_energy_index(
+	ARENA_T * A,		// arena to allocate from
+	int max_window,		// longest window that can be queried, in samples
+	int granularity		// number of samples per prefix entry
+);
+
+
+/**
+ * @brief [add n input samples to the energy index]
+ * @details [this is the only pass over the input needed for level detection, every consumer
+ * queries the index afterwards. n doesn't have to line up with the granularity]
+ * 
+ * @param E [pointer to the energy index struct]
+ * @param input [buffer containing n input samples]
+ * @param n [number of samples to add]
+ */
+void update_energy_index(
+	ENERGY_T * E,			// pointer to energy index struct
+	const float * input,	// buffer containing input samples to work on
+	int n					// number of samples to add
+);
+
+
+/**
+ * @brief [add the sum of squares of n samples the caller has already squared]
+ * @details [for a level detector that squares every sample anyway, so it can feed the index 
+ * from its own loop instead of a second pass. n can't run past the next granularity boundary,
+ * granularity - partial_count samples away]
+ * 
+ * @param E [pointer to the energy index struct]
+ * @param sum [sum of the squares of the samples]
+ * @param n [number of samples in the sum]
+ */
+void energy_index_add(
+	ENERGY_T * E,			// pointer to energy index struct
+	float sum,				// sum of squares of the samples
+	int n					// number of samples in the sum
+);
+
+
+/**
+ * @brief [mean-square value of the most recent window samples]
+ * @details [with the granularity equal to the block size, this can be called from the 
+ * foreground while update_energy_index() runs in an interrupt: it reads head once and only
+ * entries that are already written]
+ * 
+ * @param E [pointer to the energy index struct]
+ * @param window [number of samples to average over, rounded down to a multiple of granularity]
+ * 
+ * @return [mean-square value over the window]
+ */
+float energy_mean_square(
+	ENERGY_T * E,		// pointer to energy index struct
+	int window			// number of samples to average over
+);
+
+
+/**
+ * @brief [rms value of the most recent window samples]
+ * 
+ * @param E [pointer to the energy index struct]
+ * @param window [number of samples to average over, rounded down to a multiple of granularity]
+ * 
+ * @return [rms value over the window]
+ */
+float energy_rms(
+	ENERGY_T * E,		// pointer to energy index struct
+	int window			// number of samples to average over
+);
+
+
+/**
+ * @brief [clear the index back to silence]
+ * 
+ * @param E [pointer to the energy index struct]
+ */
+void reset_energy_index(
+	ENERGY_T * E		// pointer to energy index struct
+);
+
+
+#endif
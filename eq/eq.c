@@ -26,98 +26,200 @@
  * the transition bands. Basically, when all bands are set to a flat response, it should output an 
  * untainted and undistorted flat response because each band was calculated from the other bands.
  * 
+ * The band filters are designed at init for the sample rate (see design.c): Kaiser windowed lowpasses at 
+ * EQ_LOW_CUTOFF and EQ_MID_CUTOFF, the same filters the FDATool tables in filters/ hold for 48kHz. The 
+ * designs are cached, so planning the chain again doesn't design them again. The filters are EQ_NUM_TAPS long at 
+ * 48kHz and keep that length in time at other rates (see eq_num_taps()), twice the taps at 96kHz.
+ * 
+ * init_eq_q15() and calc_eq_q15() are the same eq in fixed point for GAPE_FIXED builds: Q15 filters and
+ * delays, saturating band subtractions, and a Q27 sum of the bands.
+ * 
  */
 
 
 // INCLUDE -----------------------------------------------------------------
 
-#include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
-#include "arm_math.h"
+#include "fast_math.h"
+#include "arena.h"
+#include "fixed.h"
+#include "dsp.h"
+#include "fir.h"
 
 #include "delay.h"
 #include "eq.h"
 
-#include "eq_low_coefs.h"
-#include "eq_mid_coefs.h"
+#include "design.h"
 
 // -------------------------------------------------------------------------
 
 
 
 
+/**
+ * @brief [the full length low and mid band filters for a sampling frequency]
+ * 
+ * @param A [arena for designs that don't fit in the design cache]
+ * @param FS [sampling frequency]
+ * @param low [set to the low band filter]
+ * @param mid [set to the mid band filter]
+ * @return [0 on success, 1 if they don't fit]
+ */
+static int eq_band_filters(ARENA_T * A, int FS, const float ** low, const float ** mid) {
+
+	DESIGN_SPEC_T spec = { DESIGN_LOWPASS, eq_num_taps(EQ_NUM_TAPS, FS), EQ_LOW_CUTOFF, FS, EQ_KAISER_BETA };
+
+	*low = design_fir(A, &spec);
+	spec.cutoff = EQ_MID_CUTOFF;
+	*mid = design_fir(A, &spec);
+
+	return (*low == NULL || *mid == NULL);
+
+}
+
+
+/**
+ * @brief [length of a band filter at a sampling frequency]
+ * 
+ * @param num_taps [length at EQ_DESIGN_FS, odd]
+ * @param FS [sampling frequency]
+ * @return [length at FS, odd]
+ */
+int eq_num_taps(int num_taps, int FS) {
+
+	// scale the half length, so the result stays odd
+	int half = (int)((((int64_t)(num_taps - 1) / 2) * FS + (EQ_DESIGN_FS / 2)) / EQ_DESIGN_FS);
+
+	return (2 * half) + 1;
+
+}
+
+
+/**
+ * @brief [shorten a band filter to its middle num_taps, with a Hann taper]
+ * @details [the taper keeps the truncation from rippling, and the taps are scaled so the 
+ * passband gain stays at the full filter's, which the band subtraction relies on]
+ * 
+ * @param A [arena the taps are allocated from]
+ * @param coefs [full filter]
+ * @param full_taps [length of the full filter]
+ * @param num_taps [length to shorten to, odd]
+ * @return [num_taps coefficients, NULL if they don't fit in the arena]
+ */
+static float * eq_short_filter(ARENA_T * A, const float * coefs, int full_taps, int num_taps) {
+
+	int k;
+	int start = (full_taps - num_taps) / 2;
+	float full_dc = 0.0, dc = 0.0;
+
+	float * taps = (float *)arena_alloc(A, sizeof(float) * num_taps);
+	if(taps == NULL) return NULL;
+
+	for(k = 0; k < full_taps; k++) full_dc += coefs[k];
+
+	for(k = 0; k < num_taps; k++) {
+		taps[k] = coefs[start + k] * sinf(M_PI * (k + 1) / (num_taps + 1)) * sinf(M_PI * (k + 1) / (num_taps + 1));
+		dc += taps[k];
+	}
+
+	for(k = 0; k < num_taps; k++) taps[k] *= (full_dc / dc);
+
+	return taps;
+
+}
+
+
 /**
  * @brief [initialize eq struct for equalizer routines]
  * 
+ * @param A [arena the eq, its delays, fir state and band buffers are allocated from]
  * @param low_gain [bass gain in dB]
  * @param mid_gain [mid gain in dB]
  * @param high_gain [treble gain in dB]
  * @param block_size [number of samples to work on]
  * @param FS [sampling frequency used in the delay routine]
- * @return [pointer to the eq struct]
+ * @return [pointer to the eq struct, NULL if it doesn't fit in the arena]
  */
-EQ_T * init_eq(float low_gain, float mid_gain, float high_gain, int block_size, int FS) {
+EQ_T * init_eq(ARENA_T * A, float low_gain, float mid_gain, float high_gain, int block_size, int FS) {
+
+	return init_eq_taps(A, low_gain, mid_gain, high_gain, EQ_NUM_TAPS, block_size, FS);
+
+}
 
-	int i, j;
+
+/**
+ * @brief [initialize an eq with band filters shortened to num_taps]
+ * 
+ * @param A [arena the eq, its delays, filters and band buffers are allocated from]
+ * @param low_gain [bass gain in dB]
+ * @param mid_gain [mid gain in dB]
+ * @param high_gain [treble gain in dB]
+ * @param num_taps [length of the band filters at EQ_DESIGN_FS, odd, no more than EQ_NUM_TAPS]
+ * @param block_size [number of samples to work on]
+ * @param FS [sampling frequency, the filters are scaled to the same length in time]
+ * @return [pointer to the eq struct, NULL if it doesn't fit in the arena]
+ */
+EQ_T * init_eq_taps(ARENA_T * A, float low_gain, float mid_gain, float high_gain, int num_taps, int block_size, int FS) {
+
+	const float * low_coefs;
+	const float * mid_coefs;
+	int full_taps = eq_num_taps(EQ_NUM_TAPS, FS);
+
+	if(num_taps > EQ_NUM_TAPS || (num_taps % 2) == 0) return NULL;
+	num_taps = eq_num_taps(num_taps, FS);
 
 	// set up struct for eq -------------------------------------------------------------------------------------
-	EQ_T * Q = (EQ_T *)malloc(sizeof(EQ_T));	// allocate struct
-	if(Q == NULL) return NULL;					// errcheck malloc call
+	EQ_T * Q = (EQ_T *)arena_alloc(A, sizeof(EQ_T));	// allocate struct
+	if(Q == NULL) return NULL;							// errcheck alloc call
 	
 	Q->block_size = block_size;
 
 	// pow(dB / 20) = gain
-	Q->low_scale = pow(10, (low_gain / 20.0));
-	Q->mid_scale = pow(10, (mid_gain / 20.0));
-	Q->high_scale = pow(10, (high_gain / 20.0));
+	Q->low_scale = db_to_gain(low_gain);
+	Q->mid_scale = db_to_gain(mid_gain);
+	Q->high_scale = db_to_gain(high_gain);
 
 
 	// initialize delays for keeping the outputs in phase with each other ---------------------------------------
 	// delay the same amount as the delay caused by the fir routine
 	// both filters have the same number of coefs, so the delays will be the same
-	int sample_delay = ((eq_low_num - 1) / 2);	// delay for fir is (M-1)/2
-	Q->D1 = init_delay(0, FS, sample_delay, 1, block_size); // 0 is delay in samples instead of in seconds
-	Q->D2 = init_delay(0, FS, sample_delay, 1, block_size);
-	Q->D3 = init_delay(0, FS, sample_delay, 1, block_size);
+	int sample_delay = ((num_taps - 1) / 2);	// delay for fir is (M-1)/2
+	// 0 is delay in samples instead of in seconds, 0 is to output just the delayed signal
+	Q->D1 = init_delay(A, 0, FS, sample_delay, 1, 0, block_size);
+	Q->D2 = init_delay(A, 0, FS, sample_delay, 1, 0, block_size);
+	Q->D3 = init_delay(A, 0, FS, sample_delay, 1, 0, block_size);
 	if(Q->D1 == NULL || Q->D2 == NULL || Q->D3 == NULL) return NULL; 
 
-
-	// declare and initialize variables necessary for arm fir routines ------------------------------------------
-	float * low_state = (float *)malloc(sizeof(float) * (eq_low_num + block_size - 1));
-	float * mid_state = (float *)malloc(sizeof(float) * (eq_mid_num + block_size - 1));
-	if(low_state == NULL || mid_state == NULL) return NULL; 
-
-	// declare arm struct
-	arm_fir_instance_f32 S_low;
-	arm_fir_instance_f32 S_mid;
-
-	// initialize arm struct
-	arm_fir_init_f32(&S_low, eq_low_num, &(eq_low_coefs[0]), low_state, block_size);
-	arm_fir_init_f32(&S_mid, eq_mid_num, &(eq_mid_coefs[0]), mid_state, block_size);
-
-	Q->S_low = S_low;
-	Q->S_mid = S_mid;
+	// the full eq delays by 2 * (full_taps - 1) / 2, a shorter one is padded out to the same
+	Q->D_out = NULL;
+	if(num_taps < full_taps) {
+		Q->D_out = init_delay(A, 0, FS, full_taps - num_taps, 1, 0, block_size);
+		if(Q->D_out == NULL) return NULL;
+	}
 
 
-	// initialize band output buffers --------------------------------------------------------------------------
-	Q->low_band_out = (float *)malloc(sizeof(float) * block_size);
-	Q->mid_band_out = (float *)malloc(sizeof(float) * block_size);
-	Q->high_band_out = (float *)malloc(sizeof(float) * block_size);
-	if(Q->low_band_out == NULL || Q->mid_band_out == NULL || Q->high_band_out == NULL) return NULL; 
-	for(i = 0; i < block_size; i++) {
-		Q->low_band_out[i] = 0.0;
-		Q->mid_band_out[i] = 0.0;
-		Q->high_band_out[i] = 0.0;
+	// initialize the band filters ---------------------------------------------------------------------------
+	// 301 taps at 48kHz is long enough that big blocks are cheaper through the FFT (see fir.c), the full filters
+	// stay in the design cache. shortened filters are computed into the arena
+	if(eq_band_filters(A, FS, &low_coefs, &mid_coefs)) return NULL;
+	if(num_taps < full_taps) {
+		low_coefs = eq_short_filter(A, low_coefs, full_taps, num_taps);
+		mid_coefs = eq_short_filter(A, mid_coefs, full_taps, num_taps);
+		if(low_coefs == NULL || mid_coefs == NULL) return NULL;
 	}
+	Q->low = init_fir(A, low_coefs, num_taps, block_size, FIR_PLAN);
+	Q->mid = init_fir(A, mid_coefs, num_taps, block_size, FIR_PLAN);
+	if(Q->low == NULL || Q->mid == NULL) return NULL; 
 
 
-	// initialize eq output buffer -----------------------------------------------------------------------------
-	Q->output = (float *)malloc(sizeof(float) * block_size);
-	if(Q->output == NULL) return NULL;
-	for(j = 0; j < block_size; j++) {
-		Q->output[j] = 0.0;
-	}
+	// initialize band buffers (zeroed by the arena) ----------------------------------------------------------
+	Q->low_band_out = (float *)arena_alloc(A, sizeof(float) * block_size);
+	Q->mid_input = (float *)arena_alloc(A, sizeof(float) * block_size);
+	Q->mid_band_out = (float *)arena_alloc(A, sizeof(float) * block_size);
+	Q->high_band_out = (float *)arena_alloc(A, sizeof(float) * block_size);
+	if(Q->low_band_out == NULL || Q->mid_input == NULL || Q->mid_band_out == NULL || Q->high_band_out == NULL) return NULL; 
 
 
 	// return pointer to struct---------------------------------------------------------------------------------
@@ -135,57 +237,261 @@ EQ_T * init_eq(float low_gain, float mid_gain, float high_gain, int block_size,
  * rest of the spectrum not being filtered, by subtracting the input by the filtered samples. So using
  * two filters allows us to split off 3 different bands: the band below and the band above the first lowpass 
  * filter, and the band below and the band above the second lowpass filter. The band above the first lowpass
- * and the band below the second lowpass is the same band.]
+ * and the band below the second lowpass is the same band.
+ * The input is only read by the low band filter and the mid band delay, both before the output is written,
+ * so input and output can be the same buffer]
  * 
- * @param D1 [pointer to the delay struct]
- * @param D2 [pointer to the delay struct]
- * @param D3 [pointer to the delay struct]
  * @param Q [pointer to the eq struct]
- * @param input [buffer containing samples to work on]
+ * @param input [buffer containing n samples to work on]
+ * @param output [buffer for n equalized samples]
+ * @param n [number of samples to work on, no more than the block_size the eq was initialized with]
  */
-void calc_eq(DELAY_T * D1, DELAY_T * D2, DELAY_T * D3, EQ_T * Q, float * input) {
-
-	int i, j, k;
-	float mid_input[Q->block_size];
+void calc_eq(EQ_T * Q, const float * input, float * output, int n) {
 
 	// LOW BAND ------------------------------------------------------------------------------------------------
 	// calculate low band output with no gain
 	// lowpass with cutoff of 350Hz
-	arm_fir_f32(&(Q->S_low), input, Q->low_band_out, Q->block_size);
-
-	// delay filter output to stay in phase with mid and high band for reconstructing output
-	calc_delay(0, D1, Q->low_band_out);	// D1->output is now the final low band output to be reconstructed
+	calc_fir(Q->low, input, Q->low_band_out, n);
 
 
 	// MID BAND ------------------------------------------------------------------------------------------------
 	// delay input signal to stay in phase for mid band calculation
-	calc_delay(0, D2, input);	// 0 is to output just the delayed signal
+	calc_delay(Q->D2, input, Q->mid_input, n);
 
 	// input for mid band is the delayed signal minus the low band
 	// this gives the samples for the rest of the spectrum that the low band doesn't cover
-	for(j = 0; j < Q->block_size; j++) {
-		mid_input[j] = D2->output[j] - Q->low_band_out[j];
-	}
+	dsp->mac(Q->low_band_out, -1.0f, Q->mid_input, n);
+
+	// delay filter output to stay in phase with mid and high band for reconstructing output
+	// (done in place now that the undelayed low band isn't needed anymore)
+	calc_delay(Q->D1, Q->low_band_out, Q->low_band_out, n);	// this is now the final low band output to be reconstructed
+
 	// lowpass with cutoff of 1050Hz
 	// this contains the band from the cutoff of the low band, to 1050Hz
-	arm_fir_f32(&(Q->S_mid), mid_input, Q->mid_band_out, Q->block_size);
+	calc_fir(Q->mid, Q->mid_input, Q->mid_band_out, n);
 
 
 	// HIGH BAND -----------------------------------------------------------------------------------------------
 	// delay signal to stay in phase for high band calculation (note the input was already delayed once for the mid band calc)
-	calc_delay(0, D3, mid_input);	// delay the input to the mid filter once more 
+	calc_delay(Q->D3, Q->mid_input, Q->high_band_out, n);	// delay the input to the mid filter once more 
 
 	// the high band is the input going into the mid filter delayed, and then subtracted from the mid filter output
 	// this gives the samples for the rest of the spectrum that the low and mid band doesn't cover
-	for(k = 0; k < Q->block_size; k++) {
-		Q->high_band_out[k] = D3->output[k] - Q->mid_band_out[k];
-	}
+	dsp->mac(Q->mid_band_out, -1.0f, Q->high_band_out, n);
 
 
 	// calculate block of equalized output samples -------------------------------------------------------------
-	for(i = 0; i < Q->block_size; i++) {
-		// output is the output of each band scaled by the band gain and added together 
-		Q->output[i] = 0.6 * ((Q->low_scale * D1->output[i]) + (Q->mid_scale * Q->mid_band_out[i]) + (Q->high_scale * Q->high_band_out[i]));
-	}
+	// output is the output of each band scaled by the band gain and added together, times 0.6
+	dsp->scale(Q->low_band_out, 0.6f * Q->low_scale, output, n);
+	dsp->mac(Q->mid_band_out, 0.6f * Q->mid_scale, output, n);
+	dsp->mac(Q->high_band_out, 0.6f * Q->high_scale, output, n);
+
+	// line a shortened eq up with the full one
+	if(Q->D_out != NULL) calc_delay(Q->D_out, output, output, n);
 	
-}
\ No newline at end of file
+}
+
+
+/**
+ * @brief [samples the eq output keeps going after the input goes silent]
+ * @details [the longest path through the eq is the mid band: a delay of (M-1)/2 then the
+ * M tap mid filter, plus the padding of a shortened eq]
+ * 
+ * @param Q [pointer to the eq struct]
+ * @return [tail length in samples]
+ */
+int eq_tail(const EQ_T * Q) {
+
+	int taps = Q->mid->num_taps;
+
+	return ((taps - 1) / 2) + (taps - 1) + ((Q->D_out != NULL) ? Q->D_out->sample_delay : 0);
+
+}
+
+
+/**
+ * @brief [samples the eq output is delayed by]
+ * @details [every band goes through a (M-1)/2 delay and an M tap filter, (M-1)/2 of group
+ * delay each, plus the padding of a shortened eq]
+ * 
+ * @param Q [pointer to the eq struct]
+ * @return [group delay in samples]
+ */
+int eq_latency(const EQ_T * Q) {
+
+	return (2 * Q->D1->sample_delay) + ((Q->D_out != NULL) ? Q->D_out->sample_delay : 0);
+
+}
+
+
+/**
+ * @brief [clear the filters and delays back to silence]
+ * 
+ * @param Q [pointer to the eq struct]
+ */
+void reset_eq(EQ_T * Q) {
+
+	reset_fir(Q->low);
+	reset_fir(Q->mid);
+	reset_delay(Q->D1);
+	reset_delay(Q->D2);
+	reset_delay(Q->D3);
+	if(Q->D_out != NULL) reset_delay(Q->D_out);
+
+}
+
+
+/**
+ * @brief [b - a into out, two saturating subtracts at a time]
+ * 
+ * @param a [Q15 samples]
+ * @param b [Q15 samples to subtract]
+ * @param out [Q15 differences, can be a]
+ * @param n [number of samples]
+ */
+static void eq_sub_q15(const q15_t * a, const q15_t * b, q15_t * out, int n) {
+
+	int j;
+	uint32_t d;
+
+	for(j = 0; j + 1 < n; j += 2) {
+		d = __QSUB16(q15x2_read(a + j), q15x2_read(b + j));
+		memcpy(out + j, &d, sizeof(d));
+	}
+	if(j < n) out[j] = (q15_t)__SSAT((int32_t)a[j] - b[j], 16);
+
+}
+
+
+/**
+ * @brief [initialize the fixed point eq]
+ * 
+ * @param A [arena the eq, its delays, filters and band buffers are allocated from]
+ * @param low_gain [bass gain in dB]
+ * @param mid_gain [mid gain in dB]
+ * @param high_gain [treble gain in dB]
+ * @param block_size [number of samples to work on]
+ * @param FS [sampling frequency necessary for delay]
+ * @return [pointer to the eq struct, NULL if it doesn't fit in the arena]
+ */
+EQ_Q15_T * init_eq_q15(ARENA_T * A, float low_gain, float mid_gain, float high_gain, int block_size, int FS) {
+
+	int num_taps = eq_num_taps(EQ_NUM_TAPS, FS);
+	int sample_delay = ((num_taps - 1) / 2);	// delay for fir is (M-1)/2
+	const float * low_coefs;
+	const float * mid_coefs;
+
+	EQ_Q15_T * Q = (EQ_Q15_T *)arena_alloc(A, sizeof(EQ_Q15_T));	// allocate struct
+	if(Q == NULL) return NULL;										// errcheck alloc call
+
+	Q->block_size = block_size;
+
+	// the 0.6 output scale of calc_eq() goes in with the band gains
+	Q->low_scale = (int32_t)(0.6f * db_to_gain(low_gain) * (1 << EQ_Q15_GAIN_BITS) + 0.5f);
+	Q->mid_scale = (int32_t)(0.6f * db_to_gain(mid_gain) * (1 << EQ_Q15_GAIN_BITS) + 0.5f);
+	Q->high_scale = (int32_t)(0.6f * db_to_gain(high_gain) * (1 << EQ_Q15_GAIN_BITS) + 0.5f);
+
+	Q->D1 = init_delay_q15(A, 0, FS, sample_delay, 1, 0, block_size);
+	Q->D2 = init_delay_q15(A, 0, FS, sample_delay, 1, 0, block_size);
+	Q->D3 = init_delay_q15(A, 0, FS, sample_delay, 1, 0, block_size);
+	if(Q->D1 == NULL || Q->D2 == NULL || Q->D3 == NULL) return NULL;
+
+	if(eq_band_filters(A, FS, &low_coefs, &mid_coefs)) return NULL;
+	Q->low = init_fir_q15(A, low_coefs, num_taps, block_size);
+	Q->mid = init_fir_q15(A, mid_coefs, num_taps, block_size);
+	if(Q->low == NULL || Q->mid == NULL) return NULL;
+
+	Q->low_band_out = (q15_t *)arena_alloc(A, sizeof(q15_t) * block_size);
+	Q->mid_input = (q15_t *)arena_alloc(A, sizeof(q15_t) * block_size);
+	Q->mid_band_out = (q15_t *)arena_alloc(A, sizeof(q15_t) * block_size);
+	Q->high_band_out = (q15_t *)arena_alloc(A, sizeof(q15_t) * block_size);
+	if(Q->low_band_out == NULL || Q->mid_input == NULL || Q->mid_band_out == NULL || Q->high_band_out == NULL) return NULL;
+
+	return Q;
+
+}
+
+
+/**
+ * @brief [calculate output for the fixed point eq]
+ * @details [the same bands as calc_eq(). the input is shifted down EQ_Q15_HEADROOM bits first,
+ * so the band subtractions only saturate on input near full scale, and shifted back up out of
+ * the accumulator]
+ * 
+ * @param Q [pointer to the eq struct]
+ * @param input [buffer containing n Q15 samples to work on]
+ * @param output [buffer for n Q15 equalized samples]
+ * @param n [number of samples to work on, no more than block_size]
+ */
+void calc_eq_q15(EQ_Q15_T * Q, const q15_t * input, q15_t * output, int n) {
+
+	int i;
+	int32_t acc;
+	q15_t * x = Q->high_band_out;		// scaled input, not needed by the time the high band is written
+	const int shift = EQ_Q15_GAIN_BITS - EQ_Q15_HEADROOM;
+
+	for(i = 0; i < n; i++) x[i] = input[i] >> EQ_Q15_HEADROOM;
+
+	// LOW BAND
+	calc_fir_q15(Q->low, x, Q->low_band_out, n);
+
+	// MID BAND
+	calc_delay_q15(Q->D2, x, Q->mid_input, n);
+	eq_sub_q15(Q->mid_input, Q->low_band_out, Q->mid_input, n);
+	calc_delay_q15(Q->D1, Q->low_band_out, Q->low_band_out, n);
+	calc_fir_q15(Q->mid, Q->mid_input, Q->mid_band_out, n);
+
+	// HIGH BAND
+	calc_delay_q15(Q->D3, Q->mid_input, Q->high_band_out, n);
+	eq_sub_q15(Q->high_band_out, Q->mid_band_out, Q->high_band_out, n);
+
+	// sum of the bands, Q15 times Q12 with the headroom bit still out, rounded back to Q15
+	for(i = 0; i < n; i++) {
+		acc = (Q->low_scale * Q->low_band_out[i]) + (Q->mid_scale * Q->mid_band_out[i]) + (Q->high_scale * Q->high_band_out[i]);
+		output[i] = (q15_t)__SSAT((acc + (1 << (shift - 1))) >> shift, 16);
+	}
+
+}
+
+
+/**
+ * @brief [samples the fixed point eq output keeps going after the input goes silent]
+ * 
+ * @param Q [pointer to the eq struct]
+ * @return [tail length in samples]
+ */
+int eq_q15_tail(const EQ_Q15_T * Q) {
+
+	// the Q15 filters round their length up to even, the delays hold the real (M-1)/2
+	return 3 * Q->D1->sample_delay;
+
+}
+
+
+/**
+ * @brief [samples the fixed point eq output is delayed by]
+ * 
+ * @param Q [pointer to the eq struct]
+ * @return [group delay in samples]
+ */
+int eq_q15_latency(const EQ_Q15_T * Q) {
+
+	return 2 * Q->D1->sample_delay;
+
+}
+
+
+/**
+ * @brief [clear the fixed point filters and delays back to silence]
+ * 
+ * @param Q [pointer to the eq struct]
+ */
+void reset_eq_q15(EQ_Q15_T * Q) {
+
+	reset_fir_q15(Q->low);
+	reset_fir_q15(Q->mid);
+	reset_delay_q15(Q->D1);
+	reset_delay_q15(Q->D2);
+	reset_delay_q15(Q->D3);
+
+}
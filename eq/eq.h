@@ -22,6 +22,25 @@
 
 #include <stdint.h>
 
+#include "arena.h"
+#include "fixed.h"
+#include "fir.h"
+#include "delay.h"
+
+// --------------------------------------------------------------------
+
+
+// DEFINES ------------------------------------------------------------
+
+#define EQ_NUM_TAPS			301		// length of the full band filters at EQ_DESIGN_FS
+#define EQ_DESIGN_FS		48000	// rate the tap counts are given at, other rates keep the same length in time
+#define EQ_LOW_CUTOFF		350.0f	// low band to mid band crossover in Hz
+#define EQ_MID_CUTOFF		1050.0f	// mid band to high band crossover in Hz
+#define EQ_KAISER_BETA		2.0f	// window of the band filters
+
+#define EQ_Q15_HEADROOM		1		// bits the Q15 eq input gives up, the band subtractions can pass full scale
+#define EQ_Q15_GAIN_BITS	12		// fraction bits of the Q15 eq band gains, +15dB is 5.6
+
 // --------------------------------------------------------------------
 
 
@@ -36,49 +55,220 @@ typedef struct eq_struct {
 	float mid_scale;			// scale to RMS val to reach correct dB for the mid frequency band
 	float high_scale;			// scale to RMS val to reach correct dB for the high frequency band
 	int block_size;				// number of samples to work on
-	arm_fir_instance_f32 S_low;	// arm fir struct for the low band lowpass filter
-	arm_fir_instance_f32 S_mid;	// arm fir struct for the mid band lowpass filter
+	FIR_T * low;				// low band lowpass filter
+	FIR_T * mid;				// mid band lowpass filter
 	DELAY_T * D1;				// pointer to the delay struct
 	DELAY_T * D2;
 	DELAY_T * D3;
+	DELAY_T * D_out;			// pads a shortened eq out to the latency of the full one, NULL for the full eq
 	float * low_band_out;		// output buffer for the low band calculation		
+	float * mid_input;			// delayed input minus the low band, input to the mid band filter
 	float * mid_band_out;		// output buffer for the mid band calculation
 	float * high_band_out;		// output buffer for the high band calculation
-	float * output;				// buffer containing the equalized output samples
 } EQ_T;
 
 
 /**
- * @brief [initialize eq struct for arm iir routines]
+ * @brief [structure containing the fields for the fixed point eq]
+ * @details [same bands as EQ_T, with Q15 filters and delays. the band gains are Q12 with the
+ * output scale folded in, and the three bands are summed in a 32 bit Q27 accumulator]
+ * 
+ */
+typedef struct eq_q15_struct {
+	int32_t low_scale;			// Q12 gain for the low band, times the 0.6 output scale
+	int32_t mid_scale;			// Q12 gain for the mid band
+	int32_t high_scale;			// Q12 gain for the high band
+	int block_size;				// number of samples to work on
+	FIR_Q15_T * low;			// low band lowpass filter
+	FIR_Q15_T * mid;			// mid band lowpass filter
+	DELAY_Q15_T * D1;			// delays keeping the bands in phase
+	DELAY_Q15_T * D2;
+	DELAY_Q15_T * D3;
+	q15_t * low_band_out;		// low band
+	q15_t * mid_input;			// delayed input minus the low band
+	q15_t * mid_band_out;		// mid band
+	q15_t * high_band_out;		// high band, and the scaled input before that
+} EQ_Q15_T;
+
+
+/**
+ * @brief [initialize eq struct for the eq routines]
  * 
+ * @param A [arena the eq, its delays, fir state and band buffers are allocated from]
  * @param low_gain [bass gain in dB]
  * @param mid_gain [mid gain in dB]
  * @param high_gain [treble gain in dB]
- * @param block_size [number of samples to work on]
- * @return [pointer to the eq struct]
+ * @param block_size [number of samples to work on, picks direct form or FFT filters]
+ * @return [pointer to the eq struct, NULL if it doesn't fit in the arena]
  */
 EQ_T * init_eq(
+	ARENA_T * A,		// arena to allocate from
+	float low_gain,		// scale in dB for low band
+	float mid_gain,		// scale in dB for mid band
+	float high_gain,	// scale in dB for high band
+	int block_size,		// number of samples to work on
+	int FS 				// sampling frequency necessary for delay
+);
+
+
+/**
+ * @brief [initialize an eq with band filters shortened to num_taps]
+ * @details [a cheaper quality tier of the same eq. the filters are the middle num_taps of the
+ * full filters with a Hann taper, so the band edges are softer. the output is delayed to the 
+ * same latency as the full eq, so the two can be crossfaded]
+ * 
+ * @param A [arena the eq, its delays, filters and band buffers are allocated from]
+ * @param low_gain [bass gain in dB]
+ * @param mid_gain [mid gain in dB]
+ * @param high_gain [treble gain in dB]
+ * @param num_taps [length of the band filters at EQ_DESIGN_FS, odd, no more than EQ_NUM_TAPS]
+ * @param block_size [number of samples to work on]
+ * @param FS [sampling frequency, the filters are scaled to the same length in time]
+ * @return [pointer to the eq struct, NULL if it doesn't fit in the arena]
+ */
+EQ_T * init_eq_taps(
+	ARENA_T * A,		// arena to allocate from
 	float low_gain,		// scale in dB for low band
 	float mid_gain,		// scale in dB for mid band
 	float high_gain,	// scale in dB for high band
+	int num_taps,		// length of the band filters at EQ_DESIGN_FS
 	int block_size,		// number of samples to work on
 	int FS 				// sampling frequency necessary for delay
 );
 
 
+/**
+ * @brief [length of a band filter at a sampling frequency]
+ * @details [the same length in time as num_taps at EQ_DESIGN_FS, so the band edges are as sharp
+ * at every rate, rounded to odd so the filter delay stays a whole number of samples]
+ *
+ * @param num_taps [length at EQ_DESIGN_FS, odd]
+ * @param FS [sampling frequency]
+ * @return [length at FS, odd]
+ */
+int eq_num_taps(
+	int num_taps,		// length at EQ_DESIGN_FS
+	int FS				// sampling frequency
+);
+
+
 /**
  * @brief [calculate output for equalizer]
+ * @details [input and output can be the same buffer]
  * 
  * @param Q [pointer to the eq struct]
- * @param input [buffer containing samples to work on]
+ * @param input [buffer containing n samples to work on]
+ * @param output [buffer for n equalized samples]
+ * @param n [number of samples to work on, no more than block_size]
  */
 void calc_eq(
-	DELAY_T * D1,	// pointer to delay struct
-	DELAY_T * D2,	// pointer to delay struct
-	DELAY_T * D3,	// pointer to delay struct
-	EQ_T * Q,		// pointer to eq struct 
-	float * input	// buffer of input samples to work on
+	EQ_T * Q,				// pointer to eq struct 
+	const float * input,	// buffer of input samples to work on
+	float * output,			// buffer for equalized samples
+	int n					// number of samples to work on
+);
+
+
+/**
+ * @brief [samples the eq output keeps going after the input goes silent]
+ * 
+ * @param Q [pointer to the eq struct]
+ * @return [tail length in samples]
+ */
+int eq_tail(
+	const EQ_T * Q			// pointer to eq struct
+);
+
+
+/**
+ * @brief [samples the eq output is delayed by]
+ * 
+ * @param Q [pointer to the eq struct]
+ * @return [group delay in samples]
+ */
+int eq_latency(
+	const EQ_T * Q			// pointer to eq struct
+);
+
+
+/**
+ * @brief [clear the filters and delays back to silence]
+ * 
+ * @param Q [pointer to the eq struct]
+ */
+void reset_eq(
+	EQ_T * Q				// pointer to eq struct
+);
+
+
+/**
+ * @brief [initialize the fixed point eq]
+ * 
+ * @param A [arena the eq, its delays, filters and band buffers are allocated from]
+ * @param low_gain [bass gain in dB]
+ * @param mid_gain [mid gain in dB]
+ * @param high_gain [treble gain in dB]
+ * @param block_size [number of samples to work on]
+ * @param FS [sampling frequency necessary for delay]
+ * @return [pointer to the eq struct, NULL if it doesn't fit in the arena]
+ */
+EQ_Q15_T * init_eq_q15(
+	ARENA_T * A,		// arena to allocate from
+	float low_gain,		// scale in dB for low band
+	float mid_gain,		// scale in dB for mid band
+	float high_gain,	// scale in dB for high band
+	int block_size,		// number of samples to work on
+	int FS 				// sampling frequency necessary for delay
+);
+
+
+/**
+ * @brief [calculate output for the fixed point eq]
+ * @details [input and output can be the same buffer]
+ * 
+ * @param Q [pointer to the eq struct]
+ * @param input [buffer containing n Q15 samples to work on]
+ * @param output [buffer for n Q15 equalized samples]
+ * @param n [number of samples to work on, no more than block_size]
+ */
+void calc_eq_q15(
+	EQ_Q15_T * Q,			// pointer to eq struct 
+	const q15_t * input,	// buffer of input samples to work on
+	q15_t * output,			// buffer for equalized samples
+	int n					// number of samples to work on
+);
+
+
+/**
+ * @brief [samples the fixed point eq output keeps going after the input goes silent]
+ * 
+ * @param Q [pointer to the eq struct]
+ * @return [tail length in samples]
+ */
+int eq_q15_tail(
+	const EQ_Q15_T * Q		// pointer to eq struct
+);
+
+
+/**
+ * @brief [samples the fixed point eq output is delayed by]
+ * 
+ * @param Q [pointer to the eq struct]
+ * @return [group delay in samples]
+ */
+int eq_q15_latency(
+	const EQ_Q15_T * Q		// pointer to eq struct
+);
+
+
+/**
+ * @brief [clear the fixed point filters and delays back to silence]
+ * 
+ * @param Q [pointer to the eq struct]
+ */
+void reset_eq_q15(
+	EQ_Q15_T * Q			// pointer to eq struct
 );
 
 
-#endif
\ No newline at end of file
+#endif
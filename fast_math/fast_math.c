@@ -0,0 +1,72 @@
+/**
+ * @file fast_math.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the block versions of the fast math routines.
+ * 
+ * @details [
+ * 		fast_log2_block() - log2 of every value in a buffer
+ * 		
+ * 		fast_exp2_block() - 2^x of every value in a buffer
+ * 		
+ * 		db_to_gain_block() - dB to linear gain for every value in a buffer
+ * 		
+ * 		gain_to_db_block() - linear gain to dB for every value in a buffer
+ * 		
+ * 		fast_sqrt_block() - sqrt of every value in a buffer
+ * 		
+ * 		fast_rsqrt_block() - 1 / sqrt of every value in a buffer
+ * ]
+ * 
+ * The loop bodies are the inline scalar routines from fast_math.h. They have no branches (the 
+ * clamps compile to min/max) and no calls, so at -O3 gcc turns each loop into SIMD code on 
+ * targets that have it. On the M4 they are still straight-line single precision code.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include "fast_math.h"
+
+// ----------------------------------------------------------
+
+
+
+
+void fast_log2_block(const float * input, float * output, int n) {
+	int i;
+	for(i = 0; i < n; i++) output[i] = fast_log2f(input[i]);
+}
+
+
+void fast_exp2_block(const float * input, float * output, int n) {
+	int i;
+	for(i = 0; i < n; i++) output[i] = fast_exp2f(input[i]);
+}
+
+
+void db_to_gain_block(const float * input, float * output, int n) {
+	int i;
+	for(i = 0; i < n; i++) output[i] = db_to_gain(input[i]);
+}
+
+
+void gain_to_db_block(const float * input, float * output, int n) {
+	int i;
+	for(i = 0; i < n; i++) output[i] = gain_to_db(input[i]);
+}
+
+
+void fast_sqrt_block(const float * input, float * output, int n) {
+	int i;
+	for(i = 0; i < n; i++) output[i] = fast_sqrtf(input[i]);
+}
+
+
+void fast_rsqrt_block(const float * input, float * output, int n) {
+	int i;
+	for(i = 0; i < n; i++) output[i] = fast_rsqrtf(input[i]);
+}
@@ -0,0 +1,198 @@
+/**
+ * @file fast_math.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the float-only approximations of the math routines used in the 
+ * audio path (dB/gain conversions, log2, exp2, sqrt, rsqrt).
+ * 
+ * @details [the scalar versions are static inline so the per-sample loops in the effects don't
+ * pay for a function call. the _block versions in fast_math.c run the same math over a buffer
+ * with no branches in the loop body, so the compiler can vectorize them (SSE/AVX/NEON).
+ * 
+ * 		function 		valid input 			max error (measured by bench_fast_math over the valid input)
+ * 		-----------------------------------------------------------------------------------------
+ * 		fast_log2f		x > 0 (normal floats)	1.3e-5 absolute
+ * 		fast_exp2f		-126 <= x < 128			3.5e-7 relative (clamped outside the range)
+ * 		gain_to_db		any, floored at -200dB	1.0e-4 dB absolute
+ * 		db_to_gain		-700dB to 700dB			3.2e-6 relative
+ * 		fast_sqrtf		x >= 0					exact, single precision hardware sqrt
+ * 		fast_rsqrtf		x > 0 (normal floats)	4.8e-6 relative
+ * 
+ * 		there is no approximation for sqrt. both the Cortex-M4 (VSQRT.F32) and x86 (SQRTSS) have
+ * 		a single precision sqrt instruction that is faster than any polynomial; the cost in 
+ * 		calc_rms was sqrt() promoting to double and calling libm.]
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define FM_LOG2_10_OVER_20	0.16609640474436812f	// log2(10) / 20, dB to log2 gain
+#define FM_20_LOG10_2		6.0205999132796239f		// 20 * log10(2), log2 gain to dB
+#define FM_MIN_GAIN			1.0e-10f				// -200dB floor for gain_to_db
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [union for getting at the bits of a float without breaking strict aliasing]
+ * 
+ */
+typedef union fm_bits {
+	float f;
+	uint32_t i;
+} FM_BITS_T;
+
+
+/**
+ * @brief [base 2 logarithm]
+ * @details [the exponent field of the float is the integer part of the log. the mantissa m is
+ * in [1, 2) and log2(m) is (m - 1) times a degree 5 polynomial in (m - 1), fit for minimum error on [0, 1)]
+ * 
+ * @param x [input value, must be positive]
+ * @return [log2(x)]
+ */
+static inline float fast_log2f(float x) {
+
+	FM_BITS_T v;
+	float e, t;
+
+	v.f = x;
+	e = (float)((int32_t)((v.i >> 23) & 0xff) - 127);	// unbiased exponent
+	v.i = (v.i & 0x007fffff) | 0x3f800000;				// mantissa with the exponent of 1.0
+	t = v.f - 1.0f;
+
+	// log2(1 + t) = t * q(t)
+	return e + t * (1.4426832519532202f + t * (-0.7204423704172996f + t * (0.46930168670204764f 
+		+ t * (-0.3033896656398871f + t * (0.14643361233411376f + t * -0.03459521019227134f)))));
+
+}
+
+
+/**
+ * @brief [base 2 exponential]
+ * @details [x is split into an integer part that becomes the exponent field of the result,
+ * and a fraction f in [0, 1) where 2^f is a degree 5 polynomial. adding 127 before the 
+ * truncation makes the int conversion a floor without calling floorf (which is a libm call
+ * on the M4)]
+ * 
+ * @param x [input value, clamped to [-126, 127.99]]
+ * @return [2^x]
+ */
+static inline float fast_exp2f(float x) {
+
+	FM_BITS_T v;
+	int32_t i;
+	float f, p;
+
+	// keep the result a normal float
+	x = (x < -126.0f) ? -126.0f : x;
+	x = (x > 127.99f) ? 127.99f : x;
+
+	i = (int32_t)(x + 127.0f);	// biased integer exponent, x + 127 is positive so truncation is floor
+	f = x - (float)(i - 127);	// fraction in [0, 1), exact since x and the integer part are close
+
+	// 2^f = 1 + f * q(f)
+	p = 1.0f + f * (0.6931474587978174f + f * (0.24021095110068894f + f * (0.0556373459794602f 
+		+ f * (0.00923196363016925f + f * 0.0017716955762371294f))));
+
+	v.i = (uint32_t)i << 23;
+	return v.f * p;
+
+}
+
+
+/**
+ * @brief [convert a gain in dB to a linear gain, gain = 10^(dB / 20)]
+ * 
+ * @param db [gain in dB]
+ * @return [linear gain]
+ */
+static inline float db_to_gain(float db) {
+	return fast_exp2f(db * FM_LOG2_10_OVER_20);
+}
+
+
+/**
+ * @brief [convert a linear gain (or rms level) to dB, dB = 20log10(gain)]
+ * 
+ * @param gain [linear gain, values below FM_MIN_GAIN are clamped to -200dB]
+ * @return [gain in dB]
+ */
+static inline float gain_to_db(float gain) {
+	gain = (gain < FM_MIN_GAIN) ? FM_MIN_GAIN : gain;
+	return FM_20_LOG10_2 * fast_log2f(gain);
+}
+
+
+/**
+ * @brief [single precision square root]
+ * @details [maps to the hardware sqrt instruction, never promotes to double]
+ * 
+ * @param x [input value, must not be negative]
+ * @return [sqrt(x)]
+ */
+static inline float fast_sqrtf(float x) {
+	return __builtin_sqrtf(x);
+}
+
+
+/**
+ * @brief [reciprocal square root]
+ * @details [bit-level initial guess followed by two newton iterations]
+ * 
+ * @param x [input value, must be positive]
+ * @return [1 / sqrt(x)]
+ */
+static inline float fast_rsqrtf(float x) {
+
+	FM_BITS_T v;
+	float y;
+
+	v.f = x;
+	v.i = 0x5f375a86 - (v.i >> 1);
+	y = v.f;
+
+	y = y * (1.5f - (0.5f * x * y * y));
+	y = y * (1.5f - (0.5f * x * y * y));
+
+	return y;
+
+}
+
+
+/**
+ * @brief [block versions of the routines above, output may be the same buffer as input]
+ * 
+ * @param input [buffer of n values to work on]
+ * @param output [buffer of n results]
+ * @param n [number of values]
+ */
+void fast_log2_block(const float * input, float * output, int n);
+void fast_exp2_block(const float * input, float * output, int n);
+void db_to_gain_block(const float * input, float * output, int n);
+void gain_to_db_block(const float * input, float * output, int n);
+void fast_sqrt_block(const float * input, float * output, int n);
+void fast_rsqrt_block(const float * input, float * output, int n);
+
+
+#endif
@@ -21,8 +21,9 @@
 
 
 // fs of 48k
-int eq_low_num = 301;
-float eq_low_coefs[301] = {
+// const, so the table is read out of flash instead of being copied into sram at startup
+static const int eq_low_num = 301;
+static const float eq_low_coefs[301] = {
  0.000537974340683233234403082256847028475,
  0.0005106133212330696974357024942037242  ,
  0.000480777040537639483407106322232493767,
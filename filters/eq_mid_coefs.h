@@ -20,8 +20,9 @@
  */
 
 
-int eq_mid_num = 301;
-float eq_mid_coefs[301] = {
+// const, so the table is read out of flash instead of being copied into sram at startup
+static const int eq_mid_num = 301;
+static const float eq_mid_coefs[301] = {
  0.000911556355174426109419516528475924133,
  0.000946483210971063560444649365166469579,
  0.000964110818058510048861320385071849159,
@@ -21,8 +21,9 @@
 #define FIR_LOWPASS_H
 
 
-int BL = 48;
-float B[48] = {
+// const, so the table is read out of flash instead of being copied into sram at startup
+static const int BL = 48;
+static const float B[48] = {
   -0.004430111032, -0.01099904813, -0.01126175001,0.0002033681376,  0.01301323157,
     0.01085966919,-0.003508112626,-0.007573440205, 0.007321337238,  0.01779179275,
     0.00299743237, -0.01648918167,-0.005753920414,    0.023352677,  0.02093379572,
@@ -0,0 +1,727 @@
+/**
+ * @file fir.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for the block FIR filter.
+ * 
+ * @details [
+ * 		fir_choose_kind() - pick direct form or overlap-save for a number of taps and block size
+ * 		
+ * 		init_fir() - initialize the filter state for either kernel
+ * 		
+ * 		calc_fir() - filter a block of samples
+ * 		
+ * 		fir_input() - room for the next block in the filter's history, so it is written there instead of copied
+ * 		
+ * 		reset_fir() - clear the input history back to silence
+ * 		
+ * 		fir_plan() - time the kernels for a filter and pick the fastest
+ * 		
+ * 		fir_find_wisdom(), fir_forget_wisdom() - look up and clear the remembered plans
+ * 		
+ * 		fir_export_wisdom(), fir_import_wisdom() - keep the plans across boots (flash or a file)
+ * 		
+ * 		report_fir_wisdom() - print the plans
+ * 		
+ * 		init_fir_q15() - initialize a Q15 direct form filter
+ * 		
+ * 		calc_fir_q15() - filter a block of Q15 samples with the dual MAC
+ * 		
+ * 		fir_q15_input() - room for the next Q15 block in the filter's history
+ * 		
+ * 		reset_fir_q15() - clear the Q15 input history back to silence
+ * ]
+ * 
+ * The direct form costs num_taps multiply-adds per output sample no matter the block size. The 
+ * overlap-save form keeps the last M input samples (M a power of 2, at least num_taps + block_size - 1),
+ * transforms them, multiplies by the spectrum of the coefficients and transforms back. The last
+ * block_size outputs of the circular convolution are the same as the linear convolution, so the 
+ * output matches the direct form. Its cost per block only grows with M log M, so per sample it gets 
+ * cheaper as the block gets bigger. The 301 tap eq filters are cheaper through the FFT from about 
+ * 128 sample blocks up, the 48 tap lowpass never is.
+ * 
+ * Both kernels run on the dsp backend (see dsp.h): the direct form is dsp->fir (arm_fir_f32 on
+ * the board), the transforms are dsp->fft. A symmetric filter can also run folded: the two inputs
+ * that meet the same coefficient are added first, half the multiplies for one more add.
+ * 
+ * Which one is fastest depends on more than the cost model in fir_choose_kind() can see (the
+ * backend, the caches, the flash wait states), so FIR_PLAN measures instead, the way FFTW 
+ * plans: each kernel is built and timed on the real filter length and block size, and the 
+ * fastest is remembered as wisdom keyed by taps, block size, symmetry and dsp backend. The 
+ * wisdom can be exported and imported again on the next boot (a flash sector on the board, a 
+ * cache file on the host), so a known configuration starts without timing anything.
+ * 
+ * The Q15 filter is direct form only. Two taps go through the M4's SMLALD per cycle into a 64 bit 
+ * accumulator, so nothing can overflow before the one rounding back to Q15 at the end.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "arena.h"
+#include "fixed.h"
+#include "dsp.h"
+#include "profiler.h"
+#include "fir.h"
+
+// ----------------------------------------------------------
+
+
+// remembered plans, filled in by fir_plan() and fir_import_wisdom()
+static FIR_WISDOM_T wisdom[FIR_WISDOM_SIZE];
+static int wisdom_count = 0;
+static int wisdom_evict = 0;		// next plan a full table gives up, round robin
+
+static const char * const kind_names[FIR_NUM_KINDS] = { "auto", "direct", "fft", "folded" };
+
+
+
+
+/**
+ * @brief [size of the FFT for the overlap-save kernel]
+ * 
+ * @param num_taps [number of coefficients]
+ * @param block_size [samples per block]
+ * @param log2_size [set to log2 of the size]
+ * @return [smallest power of 2 >= num_taps + block_size - 1]
+ */
+static int fir_fft_size(int num_taps, int block_size, int * log2_size) {
+
+	int M = 1;
+	int log2 = 0;
+
+	while(M < num_taps + block_size - 1) {
+		M <<= 1;
+		log2++;
+	}
+
+	if(log2_size != NULL) *log2_size = log2;
+	return M;
+
+}
+
+
+/**
+ * @brief [pick the cheaper kernel for a filter]
+ * 
+ * @param num_taps [number of coefficients]
+ * @param block_size [samples per block]
+ * @return [FIR_DIRECT or FIR_FFT]
+ */
+int fir_choose_kind(int num_taps, int block_size) {
+
+	int M, log2;
+	float direct, fft;
+
+	M = fir_fft_size(num_taps, block_size, &log2);
+
+	// the bit reverse table is 16 bit
+	if(M > 65536) return FIR_DIRECT;
+
+	direct = FIR_COST_TAP * num_taps * block_size;
+	fft = (2.0f * (M / 2) * log2 * FIR_COST_BUTTERFLY) + (M * FIR_COST_BIN);
+
+	return (fft < direct) ? FIR_FFT : FIR_DIRECT;
+
+}
+
+
+/**
+ * @brief [whether the coefficients are symmetric, so the filter can run folded]
+ * 
+ * @param coefs [num_taps coefficients]
+ * @param num_taps [number of coefficients]
+ * @return [1 if coefs[k] == coefs[num_taps - 1 - k] for every k]
+ */
+static int fir_symmetric(const float * coefs, int num_taps) {
+
+	int k;
+
+	for(k = 0; k < num_taps / 2; k++) {
+		if(coefs[k] != coefs[num_taps - 1 - k]) return 0;
+	}
+
+	return 1;
+
+}
+
+
+/**
+ * @brief [direct form of a symmetric filter, adding the mirrored inputs before the multiply]
+ * @details [same state layout as dsp->fir]
+ * 
+ * @param F [fir struct, state holds the last num_taps - 1 inputs]
+ * @param input [n input samples]
+ * @param output [buffer for n filtered samples]
+ * @param n [number of samples]
+ */
+static void fir_folded(FIR_T * F, const float * input, float * output, int n) {
+
+	int i, k;
+	int taps = F->num_taps;
+	int half = taps / 2;
+	float acc;
+	const float * c = F->coefs;
+	const float * x;
+
+	if(input != F->state + (taps - 1)) memcpy(F->state + (taps - 1), input, sizeof(float) * n);
+
+	// output i is the oldest tap on state[i] through the newest on state[i + taps - 1]
+	for(i = 0; i < n; i++) {
+		x = F->state + i;
+		acc = (taps & 1) ? (c[half] * x[half]) : 0.0f;
+		for(k = 0; k < half; k++) acc += c[k] * (x[k] + x[taps - 1 - k]);
+		output[i] = acc;
+	}
+
+	memmove(F->state, F->state + n, sizeof(float) * (taps - 1));
+
+}
+
+
+/**
+ * @brief [hash of the current dsp backend name, so plans from another backend aren't used]
+ * 
+ * @return [FNV-1a hash of dsp->name]
+ */
+static uint32_t fir_backend_hash(void) {
+
+	uint32_t h = 2166136261u;
+	const char * c;
+
+	for(c = dsp->name; *c != '\0'; c++) h = (h ^ (uint8_t)*c) * 16777619u;
+
+	return h;
+
+}
+
+
+/**
+ * @brief [the remembered plan for a filter shape on the current dsp backend]
+ * 
+ * @param num_taps [number of coefficients]
+ * @param block_size [samples per block]
+ * @param symmetric [1 if the coefficients are symmetric]
+ * @return [pointer to the plan, NULL if there isn't one]
+ */
+const FIR_WISDOM_T * fir_find_wisdom(int num_taps, int block_size, int symmetric) {
+
+	int i;
+	uint32_t backend = fir_backend_hash();
+
+	for(i = 0; i < wisdom_count; i++) {
+		if(wisdom[i].num_taps == num_taps && wisdom[i].block_size == block_size && 
+			wisdom[i].symmetric == symmetric && wisdom[i].backend == backend) return &(wisdom[i]);
+	}
+
+	return NULL;
+
+}
+
+
+/**
+ * @brief [forget every plan]
+ * 
+ */
+void fir_forget_wisdom(void) {
+
+	wisdom_count = 0;
+	wisdom_evict = 0;
+
+}
+
+
+/**
+ * @brief [time per block of one kernel on a trial filter]
+ * @details [the input is silence, the kernels take the same time whatever the samples are.
+ * the first block warms the caches and isn't counted]
+ * 
+ * @param A [arena for the trial filter, given back by the caller]
+ * @param coefs [num_taps coefficients]
+ * @param num_taps [number of coefficients]
+ * @param block_size [samples per block]
+ * @param kind [kernel to time]
+ * @return [fastest block in ticks, 0 if the trial filter didn't fit]
+ */
+static uint32_t fir_time_kind(ARENA_T * A, const float * coefs, int num_taps, int block_size, int kind) {
+
+	int b;
+	uint32_t start, ticks, best = UINT32_MAX;
+	FIR_T * F = init_fir(A, coefs, num_taps, block_size, kind);
+	float * x = (float *)arena_alloc(A, sizeof(float) * block_size);
+
+	if(F == NULL || x == NULL) return 0;
+
+	calc_fir(F, x, x, block_size);
+	for(b = 0; b < FIR_PLAN_BLOCKS; b++) {
+		start = profile_now();
+		calc_fir(F, x, x, block_size);
+		ticks = profile_now() - start;
+		if(ticks < best) best = ticks;
+	}
+
+	return (best == 0) ? 1 : best;
+
+}
+
+
+/**
+ * @brief [fastest kernel for a filter on the current dsp backend]
+ * 
+ * @param A [arena to build the trial filters in]
+ * @param coefs [num_taps coefficients]
+ * @param num_taps [number of coefficients]
+ * @param block_size [samples per block]
+ * @return [FIR_DIRECT, FIR_FFT or FIR_FOLDED]
+ */
+int fir_plan(ARENA_T * A, const float * coefs, int num_taps, int block_size) {
+
+	int kind;
+	size_t mark, fallback_mark = 0;
+	FIR_WISDOM_T plan;
+	FIR_WISDOM_T * W = &plan;
+	const FIR_WISDOM_T * known;
+	int symmetric = fir_symmetric(coefs, num_taps);
+
+	known = fir_find_wisdom(num_taps, block_size, symmetric);
+	if(known != NULL) return known->kind;
+
+	memset(W, 0, sizeof(FIR_WISDOM_T));
+	W->num_taps = num_taps;
+	W->block_size = block_size;
+	W->backend = fir_backend_hash();
+	W->symmetric = symmetric;
+	W->measured = 1;
+
+	profile_start_clock();
+
+	// every trial filter goes back to the arena (and its fallback) before the next
+	mark = arena_mark(A);
+	if(A->fallback != NULL) fallback_mark = arena_mark(A->fallback);
+	for(kind = FIR_DIRECT; kind < FIR_NUM_KINDS; kind++) {
+		if(kind == FIR_FFT && fir_fft_size(num_taps, block_size, NULL) > 65536) continue;
+		if(kind == FIR_FOLDED && !symmetric) continue;
+		W->ticks[kind] = fir_time_kind(A, coefs, num_taps, block_size, kind);
+		arena_release(A, mark);
+		if(A->fallback != NULL) arena_release(A->fallback, fallback_mark);
+	}
+
+	// fastest one that fit, the cost model if none did
+	W->kind = 0;
+	for(kind = FIR_DIRECT; kind < FIR_NUM_KINDS; kind++) {
+		if(W->ticks[kind] != 0 && (W->kind == 0 || W->ticks[kind] < W->ticks[W->kind])) W->kind = kind;
+	}
+	if(W->kind == 0) return fir_choose_kind(num_taps, block_size);
+
+	// a full table gives up one plan for it, round robin, the rest stay
+	if(wisdom_count < FIR_WISDOM_SIZE) {
+		wisdom[wisdom_count++] = plan;
+	} else {
+		wisdom[wisdom_evict] = plan;
+		wisdom_evict = (wisdom_evict + 1) % FIR_WISDOM_SIZE;
+	}
+	return W->kind;
+
+}
+
+
+/**
+ * @brief [sum of the words of the wisdom, to catch a half written or stale copy]
+ */
+static uint32_t fir_wisdom_checksum(const FIR_WISDOM_T * W, int count) {
+
+	int i;
+	uint32_t sum = FIR_WISDOM_MAGIC ^ (uint32_t)count;
+	const uint32_t * w = (const uint32_t *)W;
+
+	for(i = 0; i < (int)((sizeof(FIR_WISDOM_T) * count) / sizeof(uint32_t)); i++) sum = (sum * 31u) + w[i];
+
+	return sum;
+
+}
+
+
+/**
+ * @brief [copy the plans out, to keep them across boots]
+ * @details [a header of magic, count and checksum words, then the plans]
+ * 
+ * @param buf [buffer for the wisdom, word aligned]
+ * @param size [size of the buffer in bytes]
+ * @return [bytes written, 0 if the buffer is too small]
+ */
+int fir_export_wisdom(void * buf, int size) {
+
+	int i;
+	uint32_t * header = (uint32_t *)buf;
+	FIR_WISDOM_T * W = (FIR_WISDOM_T *)(header + 3);
+	int bytes = (3 * sizeof(uint32_t)) + (wisdom_count * sizeof(FIR_WISDOM_T));
+
+	if(size < bytes) return 0;
+
+	// measured only means something until the next boot, exported it's always 0 so the same
+	// plans export the same bytes, whether they were timed or imported
+	memcpy(W, wisdom, wisdom_count * sizeof(FIR_WISDOM_T));
+	for(i = 0; i < wisdom_count; i++) W[i].measured = 0;
+
+	header[0] = FIR_WISDOM_MAGIC;
+	header[1] = wisdom_count;
+	header[2] = fir_wisdom_checksum(W, wisdom_count);
+
+	return bytes;
+
+}
+
+
+/**
+ * @brief [take in plans exported on an earlier boot]
+ * 
+ * @param buf [exported wisdom, word aligned]
+ * @param size [bytes available to read]
+ * @return [0 on success, 1 if the buffer doesn't hold valid wisdom]
+ */
+int fir_import_wisdom(const void * buf, int size) {
+
+	int i;
+	const uint32_t * header = (const uint32_t *)buf;
+	const FIR_WISDOM_T * W = (const FIR_WISDOM_T *)(header + 3);
+
+	if(size < (int)(3 * sizeof(uint32_t)) || header[0] != FIR_WISDOM_MAGIC || header[1] > FIR_WISDOM_SIZE) return 1;
+	if(size < (int)((3 * sizeof(uint32_t)) + (header[1] * sizeof(FIR_WISDOM_T)))) return 1;
+	if(header[2] != fir_wisdom_checksum(W, header[1])) return 1;
+
+	wisdom_count = header[1];
+	wisdom_evict = 0;
+	memcpy(wisdom, W, wisdom_count * sizeof(FIR_WISDOM_T));
+	for(i = 0; i < wisdom_count; i++) wisdom[i].measured = 0;
+
+	return 0;
+
+}
+
+
+/**
+ * @brief [print the remembered plans and the time of each kernel]
+ * 
+ * @param print [function to print a line]
+ */
+void report_fir_wisdom(void (*print)(const char *)) {
+
+	int i, k;
+	int len;
+	char line[128];
+	const FIR_WISDOM_T * W;
+
+	snprintf(line, sizeof(line), "fir plans: %d on %s\r\n", wisdom_count, dsp->name);
+	print(line);
+
+	for(i = 0; i < wisdom_count; i++) {
+		W = &(wisdom[i]);
+		len = snprintf(line, sizeof(line), "  %3d taps, block %3d: %-6s (%s)", W->num_taps, W->block_size,
+			kind_names[W->kind], W->measured ? "timed" : "wisdom");
+		for(k = FIR_DIRECT; k < FIR_NUM_KINDS; k++) {
+			if(W->ticks[k] != 0 && len < (int)sizeof(line)) {
+				len += snprintf(line + len, sizeof(line) - len, " %s %lu", kind_names[k], (unsigned long)W->ticks[k]);
+			}
+		}
+		if(len < (int)sizeof(line) - 3) snprintf(line + len, sizeof(line) - len, "\r\n");
+		print(line);
+	}
+
+}
+
+
+#ifndef ARM_MATH_CM4
+/**
+ * @brief [read the wisdom from a cache file]
+ * 
+ * @param path [file name]
+ * @return [0 on success, 1 if the file is missing or not valid wisdom]
+ */
+int fir_load_wisdom(const char * path) {
+
+	int bytes;
+	uint32_t buf[(3 * sizeof(uint32_t) + sizeof(wisdom)) / sizeof(uint32_t)];
+	FILE * f = fopen(path, "rb");
+
+	if(f == NULL) return 1;
+	bytes = (int)fread(buf, 1, sizeof(buf), f);
+	fclose(f);
+
+	return fir_import_wisdom(buf, bytes);
+
+}
+
+
+/**
+ * @brief [write the wisdom to a cache file]
+ * 
+ * @param path [file name]
+ * @return [0 on success, 1 if it couldn't be written]
+ */
+int fir_save_wisdom(const char * path) {
+
+	int bytes, ok;
+	uint32_t buf[(3 * sizeof(uint32_t) + sizeof(wisdom)) / sizeof(uint32_t)];
+	FILE * f;
+
+	bytes = fir_export_wisdom(buf, sizeof(buf));
+	f = fopen(path, "wb");
+	if(f == NULL) return 1;
+	ok = ((int)fwrite(buf, 1, bytes, f) == bytes);
+	if(fclose(f) != 0) ok = 0;
+
+	return ok ? 0 : 1;
+
+}
+#endif
+
+
+/**
+ * @brief [initialize a block FIR filter]
+ * 
+ * @param A [arena the state is allocated from]
+ * @param coefs [num_taps coefficients]
+ * @param num_taps [number of coefficients]
+ * @param block_size [most samples per call]
+ * @param kind [FIR_AUTO, FIR_PLAN or one of the kernels]
+ * @return [pointer to the fir struct, NULL if it doesn't fit in the arena]
+ */
+FIR_T * init_fir(ARENA_T * A, const float * coefs, int num_taps, int block_size, int kind) {
+
+	int i, M;
+	FIR_T * F;
+
+	// planned before anything is allocated, the trial filters come out of the same arena
+	if(kind == FIR_PLAN) kind = fir_plan(A, coefs, num_taps, block_size);
+	if(kind == FIR_AUTO) kind = fir_choose_kind(num_taps, block_size);
+	if(kind == FIR_FOLDED && !fir_symmetric(coefs, num_taps)) kind = FIR_DIRECT;
+
+	// set up struct for the filter -------------------------------------------
+	F = (FIR_T *)arena_alloc(A, sizeof(FIR_T));	// allocate struct
+	if(F == NULL) return NULL;					// errcheck alloc
+
+	F->kind = kind;
+	F->num_taps = num_taps;
+	F->block_size = block_size;
+	F->coefs = coefs;
+
+
+	// DIRECT AND FOLDED FORM --------------------------------------------------
+	if(kind != FIR_FFT) {
+
+		F->state = (float *)arena_alloc(A, sizeof(float) * (num_taps + block_size - 1));
+		if(F->state == NULL) return NULL;
+		return F;
+
+	}
+
+
+	// OVERLAP-SAVE ------------------------------------------------------------
+	M = fir_fft_size(num_taps, block_size, NULL);
+	F->fft_size = M;
+
+	F->fft = init_dsp_fft(A, M);
+	F->frame = (float *)arena_alloc(A, sizeof(float) * M);
+	F->H = (float *)arena_alloc(A, sizeof(float) * 2 * M);
+	F->work = (float *)arena_alloc(A, sizeof(float) * 2 * M);
+	if(F->fft == NULL || F->frame == NULL || F->H == NULL || F->work == NULL) return NULL;
+
+	// spectrum of the zero padded coefficients, with the 1/M of the inverse FFT folded in
+	for(i = 0; i < num_taps; i++) F->H[2*i] = coefs[i] / M;
+	dsp->fft(F->fft, F->H);
+
+	return F;
+
+}
+
+
+/**
+ * @brief [filter a block of samples]
+ * 
+ * @param F [pointer to the fir struct]
+ * @param input [buffer containing n input samples]
+ * @param output [buffer for n filtered samples]
+ * @param n [number of samples, no more than block_size]
+ */
+void calc_fir(FIR_T * F, const float * input, float * output, int n) {
+
+	int i, M;
+	float re, im;
+
+	// DIRECT FORM -------------------------------------------------------------
+	if(F->kind == FIR_DIRECT) {
+
+		dsp->fir(F->coefs, F->num_taps, F->state, input, output, n);
+		return;
+
+	}
+
+	if(F->kind == FIR_FOLDED) {
+
+		fir_folded(F, input, output, n);
+		return;
+
+	}
+
+
+	// OVERLAP-SAVE ------------------------------------------------------------
+	M = F->fft_size;
+
+	// slide the newest n samples into the frame of the last M inputs, fir_input() already did
+	if(input != F->frame + (M - n)) {
+		memmove(F->frame, F->frame + n, sizeof(float) * (M - n));
+		memcpy(F->frame + (M - n), input, sizeof(float) * n);
+	}
+
+	for(i = 0; i < M; i++) {
+		F->work[2*i] = F->frame[i];
+		F->work[2*i+1] = 0.0f;
+	}
+	dsp->fft(F->fft, F->work);
+
+	// multiply by the filter spectrum, conjugated for the inverse FFT
+	for(i = 0; i < M; i++) {
+		re = F->work[2*i] * F->H[2*i] - F->work[2*i+1] * F->H[2*i+1];
+		im = F->work[2*i] * F->H[2*i+1] + F->work[2*i+1] * F->H[2*i];
+		F->work[2*i] = re;
+		F->work[2*i+1] = -im;
+	}
+	dsp->fft(F->fft, F->work);
+
+	// the last n outputs don't wrap around, the real part doesn't change under the conjugate
+	for(i = 0; i < n; i++) output[i] = F->work[2 * (M - n + i)];
+
+}
+
+
+/**
+ * @brief [where the next n input samples go in the filter's own history]
+ * 
+ * @param F [pointer to the fir struct]
+ * @param n [number of samples the next calc_fir() gets]
+ * @return [room for n samples, handed to calc_fir() as its input]
+ */
+float * fir_input(FIR_T * F, int n) {
+
+	int M;
+
+	if(F->kind != FIR_FFT) return F->state + (F->num_taps - 1);
+
+	// the frame slides now, calc_fir() sees the block is already in place
+	M = F->fft_size;
+	memmove(F->frame, F->frame + n, sizeof(float) * (M - n));
+	return F->frame + (M - n);
+
+}
+
+
+/**
+ * @brief [clear the input history back to silence]
+ * 
+ * @param F [pointer to the fir struct]
+ */
+void reset_fir(FIR_T * F) {
+
+	if(F->kind != FIR_FFT) {
+		memset(F->state, 0, sizeof(float) * (F->num_taps + F->block_size - 1));
+	} else {
+		memset(F->frame, 0, sizeof(float) * F->fft_size);
+	}
+
+}
+
+
+/**
+ * @brief [initialize a Q15 direct form FIR filter]
+ * 
+ * @param A [arena the taps and state are allocated from]
+ * @param coefs [num_taps float coefficients]
+ * @param num_taps [number of coefficients]
+ * @param block_size [most samples per call]
+ * @return [pointer to the fir struct, NULL if it doesn't fit in the arena]
+ */
+FIR_Q15_T * init_fir_q15(ARENA_T * A, const float * coefs, int num_taps, int block_size) {
+
+	int k;
+	int taps = (num_taps + 1) & ~1;		// even, for two taps per MAC
+
+	FIR_Q15_T * F = (FIR_Q15_T *)arena_alloc(A, sizeof(FIR_Q15_T));	// allocate struct
+	if(F == NULL) return NULL;											// errcheck alloc
+
+	F->num_taps = taps;
+	F->block_size = block_size;
+
+	// time reversed, the extra tap of an odd filter is a zero on the oldest sample
+	F->coefs = (q15_t *)arena_alloc(A, sizeof(q15_t) * taps);
+	F->state = (q15_t *)arena_alloc(A, sizeof(q15_t) * (taps + block_size - 1));
+	if(F->coefs == NULL || F->state == NULL) return NULL;
+	for(k = 0; k < num_taps; k++) F->coefs[taps - 1 - k] = float_to_q15_one(coefs[k]);
+
+	return F;
+
+}
+
+
+/**
+ * @brief [filter a block of Q15 samples]
+ * 
+ * @param F [pointer to the fir struct]
+ * @param input [buffer containing n Q15 input samples]
+ * @param output [buffer for n Q15 filtered samples]
+ * @param n [number of samples, no more than block_size]
+ */
+void calc_fir_q15(FIR_Q15_T * F, const q15_t * input, q15_t * output, int n) {
+
+	int i, k;
+	int taps = F->num_taps;
+	uint64_t acc;
+	const q15_t * x;
+
+	// newest block after the last taps - 1 inputs, unless it was written there
+	if(input != F->state + (taps - 1)) memcpy(F->state + (taps - 1), input, sizeof(q15_t) * n);
+
+	// output i is the oldest tap on state[i] through the newest on state[i + taps - 1]
+	for(i = 0; i < n; i++) {
+		x = F->state + i;
+		acc = 0;
+		for(k = 0; k < taps; k += 2) {
+			acc = __SMLALD(q15x2_read(x + k), q15x2_read(F->coefs + k), acc);
+		}
+		output[i] = q30_to_q15((int64_t)acc);
+	}
+
+	memmove(F->state, F->state + n, sizeof(q15_t) * (taps - 1));
+
+}
+
+
+/**
+ * @brief [where the next input samples go in the Q15 filter's own history]
+ * 
+ * @param F [pointer to the fir struct]
+ * @return [room for block_size samples, handed to calc_fir_q15() as its input]
+ */
+q15_t * fir_q15_input(FIR_Q15_T * F) {
+
+	return F->state + (F->num_taps - 1);
+
+}
+
+
+/**
+ * @brief [clear the input history of a Q15 filter back to silence]
+ * 
+ * @param F [pointer to the fir struct]
+ */
+void reset_fir_q15(FIR_Q15_T * F) {
+
+	memset(F->state, 0, sizeof(q15_t) * (F->num_taps + F->block_size - 1));
+
+}
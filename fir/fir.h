@@ -0,0 +1,354 @@
+/**
+ * @file fir.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for 
+ * the block FIR filter, which runs either as a direct convolution or as an FFT
+ * overlap-save convolution depending on the number of taps and the block size.
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef FIR_H
+#define FIR_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "fixed.h"
+#include "dsp.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define FIR_AUTO			0		// pick the cheaper kernel for the taps and block size
+#define FIR_DIRECT			1		// direct form convolution
+#define FIR_FFT				2		// overlap-save convolution with an FFT
+#define FIR_FOLDED			3		// direct form adding the mirrored inputs first, symmetric filters only
+#define FIR_PLAN			4		// time each kernel that fits and keep the fastest (or ask the wisdom)
+#define FIR_NUM_KINDS		4		// kinds are 1 to FIR_NUM_KINDS - 1
+
+// planner
+#define FIR_PLAN_BLOCKS		4		// blocks timed per kernel, the fastest one counts
+#define FIR_WISDOM_SIZE		16		// plans remembered
+#define FIR_WISDOM_MAGIC	0x47465731u	// "GFW1", start of exported wisdom
+
+// rough cost of each kernel, in cycles, used by fir_choose_kind()
+#define FIR_COST_TAP		1.25f	// one tap of one output sample, direct form
+#define FIR_COST_BUTTERFLY	6.0f	// one radix-2 butterfly
+#define FIR_COST_BIN		4.0f	// per FFT bin: multiply by the filter spectrum, copy in and out
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [structure containing the fields for the block FIR filter]
+ * @details [y[n] = sum over k of coefs[k] * x[n - k]. the GAPE filters are all linear 
+ * phase (symmetric), so the time reversed order cmsis stores coefficients in is the same]
+ * 
+ */
+typedef struct fir_struct {
+	int kind;					// FIR_DIRECT, FIR_FFT or FIR_FOLDED
+	int num_taps;				// number of coefficients
+	int block_size;				// most samples per call
+	const float * coefs;		// coefficients, not copied (they stay in flash)
+
+	// direct and folded form -----------
+	float * state;				// last num_taps - 1 inputs followed by the current block
+
+	// overlap-save --------------------
+	int fft_size;				// M, a power of 2 >= num_taps + block_size - 1
+	DSP_FFT_T * fft;			// plan for the M point FFT
+	float * frame;				// last M input samples
+	float * H;					// spectrum of the coefficients, M interleaved complex values
+	float * work;				// M interleaved complex values
+} FIR_T;
+
+
+/**
+ * @brief [one plan the planner remembers: the fastest kernel for a filter shape on a backend]
+ * 
+ */
+typedef struct fir_wisdom_struct {
+	uint16_t num_taps;					// number of coefficients
+	uint16_t block_size;				// samples per block
+	uint32_t backend;					// hash of the dsp backend name the kernels ran on
+	uint32_t ticks[FIR_NUM_KINDS];		// time per block of each kernel, 0 if it wasn't a candidate
+	uint8_t symmetric;					// 1 if the folded kernel was a candidate
+	uint8_t kind;						// fastest kernel
+	uint8_t measured;					// 1 if timed since boot, 0 if imported
+	uint8_t pad;
+} FIR_WISDOM_T;
+
+
+/**
+ * @brief [structure containing the fields for the Q15 direct form FIR filter]
+ * @details [the taps are stored time reversed, so each output is a dot product running forward
+ * through the state two taps at a time]
+ * 
+ */
+typedef struct fir_q15_struct {
+	int num_taps;				// number of coefficients, rounded up to even for the dual MAC
+	int block_size;				// most samples per call
+	q15_t * coefs;				// Q15 coefficients time reversed, with a zero tap in front if there were an odd number
+	q15_t * state;				// last num_taps - 1 inputs followed by the current block
+} FIR_Q15_T;
+
+
+/**
+ * @brief [pick the cheaper kernel for a filter]
+ * @details [direct form costs num_taps per output sample, overlap-save costs two FFTs and
+ * a spectrum multiply per block, spread over the block. short filters and small blocks
+ * stay direct, long filters on big blocks go to the FFT]
+ * 
+ * @param num_taps [number of coefficients]
+ * @param block_size [samples per block]
+ * @return [FIR_DIRECT or FIR_FFT]
+ */
+int fir_choose_kind(
+	int num_taps,		// number of coefficients
+	int block_size		// samples per block
+);
+
+
+/**
+ * @brief [initialize a block FIR filter]
+ * 
+ * @param A [arena the state is allocated from]
+ * @param coefs [num_taps coefficients, have to stay around (the tables in flash)]
+ * @param num_taps [number of coefficients]
+ * @param block_size [most samples per call]
+ * @param kind [FIR_AUTO, FIR_PLAN or one of the kernels, FIR_FOLDED falls back to FIR_DIRECT
+ * if the coefficients aren't symmetric]
+ * @return [pointer to the fir struct, NULL if it doesn't fit in the arena]
+ */
+FIR_T * init_fir(
+	ARENA_T * A,			// arena to allocate from
+	const float * coefs,	// coefficients
+	int num_taps,			// number of coefficients
+	int block_size,			// most samples per call
+	int kind				// FIR_AUTO, FIR_PLAN, FIR_DIRECT, FIR_FFT or FIR_FOLDED
+);
+
+
+/**
+ * @brief [fastest kernel for a filter on the current dsp backend]
+ * @details [looks the filter shape up in the wisdom first. otherwise each kernel that fits is 
+ * built in the arena and timed on a few blocks, the arena is given back, and the winner is 
+ * remembered. once FIR_WISDOM_SIZE plans are remembered a new one replaces one of them, round 
+ * robin. the timing takes a few milliseconds per filter on the board]
+ * 
+ * @param A [arena to build the trial filters in]
+ * @param coefs [num_taps coefficients]
+ * @param num_taps [number of coefficients]
+ * @param block_size [samples per block]
+ * @return [FIR_DIRECT, FIR_FFT or FIR_FOLDED]
+ */
+int fir_plan(
+	ARENA_T * A,			// arena for the trial filters
+	const float * coefs,	// coefficients
+	int num_taps,			// number of coefficients
+	int block_size			// samples per block
+);
+
+
+/**
+ * @brief [the remembered plan for a filter shape on the current dsp backend]
+ * 
+ * @param num_taps [number of coefficients]
+ * @param block_size [samples per block]
+ * @param symmetric [1 if the coefficients are symmetric]
+ * @return [pointer to the plan, NULL if there isn't one]
+ */
+const FIR_WISDOM_T * fir_find_wisdom(
+	int num_taps,			// number of coefficients
+	int block_size,			// samples per block
+	int symmetric			// 1 for a symmetric filter
+);
+
+
+/**
+ * @brief [forget every plan]
+ * 
+ */
+void fir_forget_wisdom(void);
+
+
+/**
+ * @brief [copy the plans out, to keep them across boots]
+ * 
+ * @param buf [buffer for the wisdom, word aligned]
+ * @param size [size of the buffer in bytes]
+ * @return [bytes written, 0 if the buffer is too small]
+ */
+int fir_export_wisdom(
+	void * buf,				// buffer for the wisdom
+	int size				// size of the buffer in bytes
+);
+
+
+/**
+ * @brief [take in plans exported on an earlier boot]
+ * @details [anything that isn't exported wisdom (erased flash, a missing file) is ignored. 
+ * imported plans replace the remembered ones]
+ * 
+ * @param buf [exported wisdom, word aligned]
+ * @param size [bytes available to read]
+ * @return [0 on success, 1 if the buffer doesn't hold valid wisdom]
+ */
+int fir_import_wisdom(
+	const void * buf,		// exported wisdom
+	int size				// bytes available
+);
+
+
+/**
+ * @brief [print the remembered plans and the time of each kernel]
+ * 
+ * @param print [function to print a line]
+ */
+void report_fir_wisdom(
+	void (*print)(const char *)		// prints a line
+);
+
+
+#ifndef ARM_MATH_CM4
+/**
+ * @brief [read the wisdom from a cache file]
+ * 
+ * @param path [file name]
+ * @return [0 on success, 1 if the file is missing or not valid wisdom]
+ */
+int fir_load_wisdom(
+	const char * path		// file name
+);
+
+
+/**
+ * @brief [write the wisdom to a cache file]
+ * 
+ * @param path [file name]
+ * @return [0 on success, 1 if it couldn't be written]
+ */
+int fir_save_wisdom(
+	const char * path		// file name
+);
+#endif
+
+
+/**
+ * @brief [filter a block of samples]
+ * @details [input and output can be the same buffer]
+ * 
+ * @param F [pointer to the fir struct]
+ * @param input [buffer containing n input samples]
+ * @param output [buffer for n filtered samples]
+ * @param n [number of samples, no more than block_size]
+ */
+void calc_fir(
+	FIR_T * F,				// pointer to fir struct
+	const float * input,	// buffer of input samples
+	float * output,			// buffer for filtered samples
+	int n					// number of samples
+);
+
+
+/**
+ * @brief [where the next n input samples go in the filter's own history]
+ * @details [a producer (the adc conversion) writes the block straight in and hands the same 
+ * pointer to calc_fir(), which then doesn't copy it. once per calc_fir(), with the same n, the 
+ * overlap-save frame slides here. a block written here and never filtered still goes into the 
+ * history]
+ * 
+ * @param F [pointer to the fir struct]
+ * @param n [number of samples the next calc_fir() gets]
+ * @return [room for n samples]
+ */
+float * fir_input(
+	FIR_T * F,				// pointer to fir struct
+	int n					// number of samples
+);
+
+
+/**
+ * @brief [clear the input history back to silence]
+ * @details [same state as after init, as if only zeros had gone through]
+ * 
+ * @param F [pointer to the fir struct]
+ */
+void reset_fir(
+	FIR_T * F				// pointer to fir struct
+);
+
+
+/**
+ * @brief [initialize a Q15 direct form FIR filter]
+ * @details [the float coefficients are rounded to Q15 into the arena, they have to be in -1.0 to 1.0]
+ * 
+ * @param A [arena the taps and state are allocated from]
+ * @param coefs [num_taps float coefficients]
+ * @param num_taps [number of coefficients]
+ * @param block_size [most samples per call]
+ * @return [pointer to the fir struct, NULL if it doesn't fit in the arena]
+ */
+FIR_Q15_T * init_fir_q15(
+	ARENA_T * A,			// arena to allocate from
+	const float * coefs,	// coefficients
+	int num_taps,			// number of coefficients
+	int block_size			// most samples per call
+);
+
+
+/**
+ * @brief [filter a block of Q15 samples]
+ * @details [input and output can be the same buffer]
+ * 
+ * @param F [pointer to the fir struct]
+ * @param input [buffer containing n Q15 input samples]
+ * @param output [buffer for n Q15 filtered samples]
+ * @param n [number of samples, no more than block_size]
+ */
+void calc_fir_q15(
+	FIR_Q15_T * F,			// pointer to fir struct
+	const q15_t * input,	// buffer of input samples
+	q15_t * output,			// buffer for filtered samples
+	int n					// number of samples
+);
+
+
+/**
+ * @brief [where the next input samples go in the Q15 filter's own history]
+ * @details [written there and handed to calc_fir_q15() as its input, the block isn't copied]
+ * 
+ * @param F [pointer to the fir struct]
+ * @return [room for block_size samples]
+ */
+q15_t * fir_q15_input(
+	FIR_Q15_T * F			// pointer to fir struct
+);
+
+
+/**
+ * @brief [clear the input history of a Q15 filter back to silence]
+ * 
+ * @param F [pointer to the fir struct]
+ */
+void reset_fir_q15(
+	FIR_Q15_T * F			// pointer to fir struct
+);
+
+
+#endif
@@ -0,0 +1,66 @@
+/**
+ * @file fixed.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the conversions between floats and Q15.
+ * 
+ * @details [
+ * 		float_to_q15() - floats to Q15, rounding and saturating
+ * 		
+ * 		q15_to_float() - Q15 to floats
+ * ]
+ * 
+ * Built with GAPE_FIXED (make FIXED=1) the lowpass, the delay line and the eq run in fixed point
+ * (see calc_fir_q15(), calc_delay_q15(), calc_eq_q15() and calc_rms_q31()). Samples are Q15, 
+ * filter taps are Q15 and every sum of products is kept in a 64 bit Q30 accumulator fed two 
+ * taps at a time by the dual MAC (SMLALD), then rounded and saturated back to Q15 once. Where a 
+ * sum can pass full scale before it is scaled back down (the eq bands) the signal gives up a bit
+ * of headroom on the way in.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "fixed.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [convert floats in -1.0 to 1.0 to Q15, rounding and saturating]
+ * 
+ * @param input [float samples]
+ * @param output [buffer for the Q15 samples]
+ * @param n [number of samples]
+ */
+void float_to_q15(const float * input, q15_t * output, int n) {
+
+	int i;
+
+	for(i = 0; i < n; i++) output[i] = float_to_q15_one(input[i]);
+
+}
+
+
+/**
+ * @brief [convert Q15 samples to floats]
+ * 
+ * @param input [Q15 samples]
+ * @param output [buffer for the float samples]
+ * @param n [number of samples]
+ */
+void q15_to_float(const q15_t * input, float * output, int n) {
+
+	int i;
+
+	for(i = 0; i < n; i++) output[i] = input[i] * (1.0f / Q15_ONE);
+
+}
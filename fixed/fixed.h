@@ -0,0 +1,164 @@
+/**
+ * @file fixed.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the Q15/Q31 types, the saturation helpers and the Cortex-M4 SIMD
+ * intrinsics the fixed point pipeline is built on, and the conversions between fixed and float.
+ * 
+ * @details [on the board the types and intrinsics come from cmsis (arm_math.h, which pulls in 
+ * core_cm4.h). on the host they are emulated here with plain C that gives the same results bit
+ * for bit, so the fixed point routines run unchanged in the host tests. the emulation is only
+ * for correctness, the host timings say nothing about the board]
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef FIXED_H
+#define FIXED_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef ARM_MATH_CM4
+#include "arm_math.h"
+#endif
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define Q15_ONE			32768.0f		// Q15 code for 1.0, one more than the largest
+#define Q15_MAX			32767
+#define Q15_MIN			-32768
+
+// ---------------------------------------------------------
+
+
+
+
+#ifndef ARM_MATH_CM4
+
+// HOST EMULATION ------------------------------------------
+// same names and results as the cmsis intrinsics
+
+typedef int16_t q15_t;		// 1.15 fixed point
+typedef int32_t q31_t;		// 1.31 fixed point
+typedef int64_t q63_t;		// 1.63 fixed point
+
+// saturate to a signed bits wide value
+static inline int32_t __SSAT(int32_t x, uint32_t bits) {
+	int32_t max = (int32_t)((1u << (bits - 1)) - 1);
+	return (x > max) ? max : ((x < -max - 1) ? -max - 1 : x);
+}
+
+// 32 bit saturating add
+static inline int32_t __QADD(int32_t x, int32_t y) {
+	int64_t s = (int64_t)x + y;
+	return (s > INT32_MAX) ? INT32_MAX : ((s < INT32_MIN) ? INT32_MIN : (int32_t)s);
+}
+
+// two 16 bit saturating adds / subtracts in one word
+static inline uint32_t __QADD16(uint32_t x, uint32_t y) {
+	int32_t lo = __SSAT((int16_t)x + (int16_t)y, 16);
+	int32_t hi = __SSAT((int16_t)(x >> 16) + (int16_t)(y >> 16), 16);
+	return ((uint32_t)hi << 16) | ((uint32_t)lo & 0xFFFF);
+}
+static inline uint32_t __QSUB16(uint32_t x, uint32_t y) {
+	int32_t lo = __SSAT((int16_t)x - (int16_t)y, 16);
+	int32_t hi = __SSAT((int16_t)(x >> 16) - (int16_t)(y >> 16), 16);
+	return ((uint32_t)hi << 16) | ((uint32_t)lo & 0xFFFF);
+}
+
+// dual 16 x 16 multiply, both products added to a 32 bit / 64 bit accumulator
+static inline uint32_t __SMLAD(uint32_t x, uint32_t y, uint32_t acc) {
+	return (uint32_t)((int64_t)(int32_t)acc + ((int16_t)x * (int16_t)y) + ((int16_t)(x >> 16) * (int16_t)(y >> 16)));
+}
+static inline uint64_t __SMLALD(uint32_t x, uint32_t y, uint64_t acc) {
+	return (uint64_t)((int64_t)acc + ((int16_t)x * (int16_t)y) + ((int16_t)(x >> 16) * (int16_t)(y >> 16)));
+}
+
+// ---------------------------------------------------------
+
+#endif
+
+
+
+
+/**
+ * @brief [two neighbouring Q15 samples as one word, for the dual MAC]
+ * @details [the M4 does unaligned word loads, the memcpy compiles to one]
+ * 
+ * @param p [first sample, in the low half]
+ * @return [both samples]
+ */
+static inline uint32_t q15x2_read(const q15_t * p) {
+	uint32_t x;
+	memcpy(&x, p, sizeof(x));
+	return x;
+}
+
+
+/**
+ * @brief [round a Q30 product or sum of products back to Q15, saturating]
+ * 
+ * @param acc [Q30 accumulator]
+ * @return [Q15 value]
+ */
+static inline q15_t q30_to_q15(int64_t acc) {
+	acc = (acc + (1 << 14)) >> 15;
+	return (q15_t)((acc > Q15_MAX) ? Q15_MAX : ((acc < Q15_MIN) ? Q15_MIN : acc));
+}
+
+
+/**
+ * @brief [convert one float to Q15, rounding and saturating]
+ * 
+ * @param x [float value]
+ * @return [Q15 value]
+ */
+static inline q15_t float_to_q15_one(float x) {
+	float y = x * Q15_ONE;
+	y = (y >= 0.0f) ? (y + 0.5f) : (y - 0.5f);
+	return (q15_t)((y > Q15_MAX) ? Q15_MAX : ((y < Q15_MIN) ? Q15_MIN : y));
+}
+
+
+/**
+ * @brief [convert floats in -1.0 to 1.0 to Q15, rounding and saturating]
+ * 
+ * @param input [float samples]
+ * @param output [buffer for the Q15 samples]
+ * @param n [number of samples]
+ */
+void float_to_q15(
+	const float * input,	// float samples
+	q15_t * output,			// Q15 samples
+	int n					// number of samples
+);
+
+
+/**
+ * @brief [convert Q15 samples to floats]
+ * 
+ * @param input [Q15 samples]
+ * @param output [buffer for the float samples]
+ * @param n [number of samples]
+ */
+void q15_to_float(
+	const q15_t * input,	// Q15 samples
+	float * output,			// float samples
+	int n					// number of samples
+);
+
+
+#endif
@@ -0,0 +1,712 @@
+/**
+ * @file effect_graph.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for the effect chain graph.
+ * 
+ * @details [
+ * 		init_graph() - initialize an empty graph
+ * 		
+ * 		graph_add_effect() - add an effect node, fed by the graph input or an earlier node
+ * 		
+ * 		graph_add_mix() - add a node that mixes parallel branches back together
+ * 		
+ * 		plan_graph() - assign block buffers to every node by liveness analysis
+ * 		
+ * 		graph_add_tiers() - add an effect with quality tiers
+ * 		
+ * 		graph_set_quality() - move every effect with tiers to a quality level
+ * 		
+ * 		reset_graph() - clear every effect back to silence, after a bypass
+ * 		
+ * 		graph_set_profiler() - time each node as a profiler stage
+ * 		
+ * 		graph_defer_updates() - leave the effects' block rate updates to the caller
+ * 		
+ * 		update_graph() - run every effect's block rate update
+ * 		
+ * 		run_graph() - process one block through every node
+ * ]
+ * 
+ * A chain like comp -> eq -> delay is three calls to graph_add_effect(), each taking the previous 
+ * node as its input. A parallel split is two effects taking the same input, and graph_add_mix() 
+ * brings the branches back together.
+ * 
+ * Because a node can only take inputs from nodes added before it, the order the nodes were added in
+ * is already a valid processing order. plan_graph() walks that order once: every output that nobody
+ * reads after the current node goes back on a free list before the current node takes a buffer, so
+ * the node runs in place on its input whenever it can. A 5 stage serial chain needs one buffer, each
+ * parallel branch that is alive at the same time needs one more.
+ * 
+ * The graph, the effect state and the buffers all come out of one arena. To change the effects,
+ * reset the arena and build a new graph.
+ * 
+ */
+
+
+// INCLUDE ------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include "arena.h"
+#include "profiler.h"
+#include "trace.h"
+#include "effect_graph.h"
+
+// --------------------------------------------------------------------
+
+
+
+
+/**
+ * @brief [initialize an empty graph]
+ * 
+ * @param A [arena the graph, its effects and its buffers are allocated from]
+ * @param block_size [number of samples to work on]
+ * @param FS [sampling frequency passed to the effects]
+ * @return [pointer to the graph struct, NULL if it doesn't fit in the arena]
+ */
+GRAPH_T * init_graph(ARENA_T * A, int block_size, int FS) {
+
+	arena_set_tag(A, "graph");
+	GRAPH_T * G = (GRAPH_T *)arena_alloc(A, sizeof(GRAPH_T));	// allocate struct
+	if(G == NULL) return NULL;									// errcheck alloc call
+
+	G->A = A;
+	G->block_size = block_size;
+	G->FS = FS;
+	G->num_nodes = 0;
+	G->output_node = -1;
+	G->num_buffers = 0;
+	G->profiler = NULL;
+	G->num_levels = 1;
+	G->fade_buffer = NULL;
+	G->tail = -1;
+	G->defer_updates = 0;
+	G->latency = 0;
+
+	return G;
+
+}
+
+
+/**
+ * @brief [add an effect to the graph]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param ops [callbacks of the effect]
+ * @param params [effect parameters handed to ops->init]
+ * @param input [node id feeding the effect, GRAPH_INPUT for the graph input]
+ * @return [node id, or -1 on error]
+ */
+int graph_add_effect(GRAPH_T * G, const EFFECT_OPS_T * ops, const float * params, int input) {
+
+	GRAPH_NODE_T * N;
+
+	// the input has to be the graph input or a node that is already in the graph
+	if(G->num_nodes == GRAPH_MAX_NODES) return -1;
+	if(input < GRAPH_INPUT || input >= G->num_nodes) return -1;
+
+	N = &(G->nodes[G->num_nodes]);
+	N->ops = ops;
+	N->num_inputs = 1;
+	N->inputs[0] = input;
+	N->gains[0] = 1.0;
+	N->last_use = -1;
+	N->buffer = -1;
+	N->stage = -1;
+	N->num_tiers = 0;
+	N->fade_to = -1;
+
+	// initialize the effect, charging its state to the effect in the arena report
+	arena_set_tag(G->A, ops->name);
+	N->state = ops->init(G->A, params, G->block_size, G->FS);
+	arena_set_tag(G->A, "graph");
+	if(N->state == NULL) return -1;
+
+	return G->num_nodes++;
+
+}
+
+
+/**
+ * @brief [add an effect with quality tiers to the graph]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param tiers [callbacks of each tier, best quality (tier 0) first]
+ * @param num_tiers [number of tiers]
+ * @param params [effect parameters handed to each tier's init]
+ * @param fade [crossfade length of a step up in samples]
+ * @param input [node id feeding the effect, GRAPH_INPUT for the graph input]
+ * @return [node id, or -1 on error]
+ */
+int graph_add_tiers(GRAPH_T * G, const EFFECT_OPS_T * const * tiers, int num_tiers, const float * params, int fade, int input) {
+
+	int t;
+	int node;
+	GRAPH_NODE_T * N;
+
+	if(num_tiers < 1 || num_tiers > GRAPH_MAX_TIERS || fade < 1) return -1;
+
+	// tier 0 goes in as a plain effect, then the rest are initialized alongside it
+	node = graph_add_effect(G, tiers[0], params, input);
+	if(node < 0) return -1;
+	N = &(G->nodes[node]);
+
+	N->tier_ops[0] = tiers[0];
+	N->tier_states[0] = N->state;
+	for(t = 1; t < num_tiers; t++) {
+		arena_set_tag(G->A, tiers[t]->name);
+		N->tier_ops[t] = tiers[t];
+		N->tier_states[t] = tiers[t]->init(G->A, params, G->block_size, G->FS);
+		arena_set_tag(G->A, "graph");
+		if(N->tier_states[t] == NULL) return -1;
+	}
+
+	N->num_tiers = num_tiers;
+	N->tier = 0;
+	N->want = 0;
+	N->fade_to = -1;
+	N->fade_len = fade;
+	N->fade_pos = 0;
+
+	if(num_tiers > G->num_levels) G->num_levels = num_tiers;
+
+	return node;
+
+}
+
+
+/**
+ * @brief [add a node that mixes parallel branches back together]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param num_inputs [number of branches to mix]
+ * @param inputs [node ids of the branches]
+ * @param gains [gain for each branch]
+ * @return [node id, or -1 on error]
+ */
+int graph_add_mix(GRAPH_T * G, int num_inputs, const int * inputs, const float * gains) {
+
+	int i;
+	GRAPH_NODE_T * N;
+
+	if(G->num_nodes == GRAPH_MAX_NODES) return -1;
+	if(num_inputs < 1 || num_inputs > GRAPH_MAX_INPUTS) return -1;
+
+	N = &(G->nodes[G->num_nodes]);
+	N->ops = NULL;		// mix node
+	N->state = NULL;
+	N->num_inputs = num_inputs;
+	for(i = 0; i < num_inputs; i++) {
+		if(inputs[i] < GRAPH_INPUT || inputs[i] >= G->num_nodes) return -1;
+		N->inputs[i] = inputs[i];
+		N->gains[i] = gains[i];
+	}
+	N->last_use = -1;
+	N->buffer = -1;
+	N->stage = -1;
+	N->num_tiers = 0;
+	N->fade_to = -1;
+
+	return G->num_nodes++;
+
+}
+
+
+/**
+ * @brief [plan the block buffers for the graph]
+ * @details [first pass finds the last node that reads each output. second pass walks the 
+ * processing order with a free list of buffers: the inputs that die at a node are freed before
+ * the node takes its own buffer, so it ends up processing in place on one of them]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param output [node id whose output is the graph output]
+ * @return [0 on success, 1 on error]
+ */
+int plan_graph(GRAPH_T * G, int output) {
+
+	int i, j, k, in;
+	int free_list[GRAPH_MAX_NODES];		// stack of buffers nobody is using
+	int num_free = 0;
+	int tail[GRAPH_MAX_NODES];			// longest tail from the graph input through each node
+	int latency[GRAPH_MAX_NODES];		// longest latency from the graph input through each node
+	int t, node_tail, in_tail, in_latency;
+	GRAPH_NODE_T * N;
+
+	if(output < 0 || output >= G->num_nodes) return 1;
+	G->output_node = output;
+
+
+	// LIVENESS ----------------------------------------------------------------------
+	// nodes only read earlier nodes, so the last reader is the highest index reading it
+	for(k = 0; k < G->num_nodes; k++) G->nodes[k].last_use = -1;
+	for(k = 0; k < G->num_nodes; k++) {
+		for(i = 0; i < G->nodes[k].num_inputs; i++) {
+			in = G->nodes[k].inputs[i];
+			if(in >= 0) G->nodes[in].last_use = k;
+		}
+	}
+
+
+	// BUFFER ASSIGNMENT -------------------------------------------------------------
+	G->num_buffers = 0;
+	for(k = 0; k < G->num_nodes; k++) {
+
+		N = &(G->nodes[k]);
+
+		// hand back the buffers of inputs that are read for the last time here
+		for(i = 0; i < N->num_inputs; i++) {
+			in = N->inputs[i];
+			if(in < 0 || G->nodes[in].last_use != k || G->nodes[in].buffer == GRAPH_OUTPUT) continue;
+			// the same branch can go into a mix twice, only free it once
+			for(j = 0; j < i; j++) if(N->inputs[j] == in) break;
+			if(j == i) free_list[num_free++] = G->nodes[in].buffer;
+		}
+
+		// take a buffer for this node's output
+		if(k == output) {
+			N->buffer = GRAPH_OUTPUT;		// written straight into the caller's output
+		} else if(num_free > 0) {
+			N->buffer = free_list[--num_free];
+		} else {
+			N->buffer = G->num_buffers++;
+		}
+
+		// nobody reads this output, its buffer is free again right away
+		if(N->last_use == -1 && N->buffer != GRAPH_OUTPUT) {
+			free_list[num_free++] = N->buffer;
+		}
+
+	}
+
+
+	// TAIL --------------------------------------------------------------------------
+	// a node's output goes on for its own tail past the longest tail coming into it. the 
+	// tiers of an effect can have different tails, the longest counts
+	for(k = 0; k < G->num_nodes; k++) {
+
+		N = &(G->nodes[k]);
+
+		node_tail = 0;
+		if(N->ops != NULL) {
+			if(N->num_tiers == 0) {
+				node_tail = (N->ops->tail != NULL) ? N->ops->tail(N->state) : -1;
+			} else {
+				for(i = 0; i < N->num_tiers && node_tail >= 0; i++) {
+					t = (N->tier_ops[i]->tail != NULL) ? N->tier_ops[i]->tail(N->tier_states[i]) : -1;
+					node_tail = (t < 0) ? -1 : ((t > node_tail) ? t : node_tail);
+				}
+			}
+		}
+
+		in_tail = 0;
+		for(i = 0; i < N->num_inputs; i++) {
+			in = N->inputs[i];
+			t = (in == GRAPH_INPUT) ? 0 : tail[in];
+			if(t < 0 || in_tail < 0) in_tail = -1;
+			else if(t > in_tail) in_tail = t;
+		}
+		tail[k] = (node_tail < 0 || in_tail < 0) ? -1 : (in_tail + node_tail);
+
+	}
+	G->tail = tail[output];
+
+
+	// LATENCY -----------------------------------------------------------------------
+	// the same walk for the delay of the signal. the tiers of an effect have the same latency,
+	// and branches of a mix with different latencies are smeared, the longest is reported
+	for(k = 0; k < G->num_nodes; k++) {
+
+		N = &(G->nodes[k]);
+
+		in_latency = 0;
+		for(i = 0; i < N->num_inputs; i++) {
+			in = N->inputs[i];
+			t = (in == GRAPH_INPUT) ? 0 : latency[in];
+			if(t > in_latency) in_latency = t;
+		}
+
+		t = (N->ops != NULL && N->ops->latency != NULL) ? N->ops->latency(N->state) : 0;
+		latency[k] = in_latency + t;
+
+	}
+	G->latency = latency[output];
+
+
+	// ALLOCATE BUFFERS --------------------------------------------------------------
+	// aligned for the block routines, zeroed by the arena
+	arena_set_tag(G->A, "graph");
+	for(i = 0; i < G->num_buffers; i++) {
+		G->buffers[i] = (float *)arena_alloc_aligned(G->A, sizeof(float) * G->block_size, 16);
+		if(G->buffers[i] == NULL) return 1;
+	}
+
+	// one more for crossfading tiers, the nodes run one at a time so they can share it
+	if(G->num_levels > 1) {
+		G->fade_buffer = (float *)arena_alloc_aligned(G->A, sizeof(float) * G->block_size, 16);
+		if(G->fade_buffer == NULL) return 1;
+	}
+
+	// the input history a step down primes the cheaper tier on, whole blocks covering the 
+	// longest tail of tiers 1 and up, none if one of them has no end
+	for(k = 0; k < G->num_nodes; k++) {
+
+		N = &(G->nodes[k]);
+		if(N->num_tiers < 2) continue;
+
+		node_tail = 0;
+		for(i = 1; i < N->num_tiers && node_tail >= 0; i++) {
+			t = (N->tier_ops[i]->tail != NULL) ? N->tier_ops[i]->tail(N->tier_states[i]) : -1;
+			node_tail = (t < 0) ? -1 : ((t > node_tail) ? t : node_tail);
+		}
+
+		N->history_blocks = (node_tail > 0) ? ((node_tail + G->block_size - 1) / G->block_size) : 0;
+		N->history_pos = 0;
+		N->history = NULL;
+		if(N->history_blocks > 0) {
+			N->history = (float *)arena_alloc_aligned(G->A, sizeof(float) * N->history_blocks * G->block_size, 16);
+			if(N->history == NULL) return 1;
+		}
+
+	}
+
+	return 0;
+
+}
+
+
+/**
+ * @brief [clear every effect in the graph back to silence]
+ * 
+ * @param G [pointer to the graph struct]
+ */
+void reset_graph(GRAPH_T * G) {
+
+	int k, t;
+	GRAPH_NODE_T * N;
+
+	for(k = 0; k < G->num_nodes; k++) {
+
+		N = &(G->nodes[k]);
+		if(N->ops == NULL) continue;
+
+		// finish a crossfade, the output is silent so the switch can't be heard
+		if(N->fade_to >= 0) {
+			N->tier = N->fade_to;
+			N->ops = N->tier_ops[N->tier];
+			N->state = N->tier_states[N->tier];
+			N->fade_to = -1;
+		}
+
+		if(N->num_tiers == 0) {
+			if(N->ops->reset != NULL) N->ops->reset(N->state);
+		} else {
+			for(t = 0; t < N->num_tiers; t++) {
+				if(N->tier_ops[t]->reset != NULL) N->tier_ops[t]->reset(N->tier_states[t]);
+			}
+			if(N->history != NULL) memset(N->history, 0, sizeof(float) * N->history_blocks * G->block_size);
+		}
+
+	}
+
+}
+
+
+/**
+ * @brief [time every node of the graph as its own profiler stage]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param P [profiler to add the stages to]
+ * @return [0 on success, 1 if the profiler ran out of stages]
+ */
+int graph_set_profiler(GRAPH_T * G, PROFILER_T * P) {
+
+	int k;
+	GRAPH_NODE_T * N;
+
+	for(k = 0; k < G->num_nodes; k++) {
+		N = &(G->nodes[k]);
+		N->stage = profile_add_stage(P, (N->ops != NULL) ? N->ops->name : "mix");
+		if(N->stage < 0) return 1;
+	}
+
+	G->profiler = P;
+	return 0;
+
+}
+
+
+/**
+ * @brief [move every effect with tiers to a quality level]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param level [quality level, 0 to num_levels - 1]
+ */
+void graph_set_quality(GRAPH_T * G, int level) {
+
+	int k;
+	GRAPH_NODE_T * N;
+
+	if(level < 0) level = 0;
+
+	for(k = 0; k < G->num_nodes; k++) {
+		N = &(G->nodes[k]);
+		if(N->num_tiers == 0) continue;
+		N->want = (level < N->num_tiers) ? level : (N->num_tiers - 1);
+	}
+
+}
+
+
+/**
+ * @brief [print the tier each effect with tiers is running]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param print [prints one line, UART_putstr on the board]
+ */
+void report_graph_tiers(const GRAPH_T * G, void (*print)(const char *)) {
+
+	int k;
+	char line[64];
+	const GRAPH_NODE_T * N;
+
+	for(k = 0; k < G->num_nodes; k++) {
+		N = &(G->nodes[k]);
+		if(N->num_tiers == 0) continue;
+		snprintf(line, sizeof(line), "  node %d: tier %d of %d, %s%s\r\n", k, N->tier, N->num_tiers, 
+			N->ops->name, (N->fade_to >= 0) ? " (fading)" : "");
+		print(line);
+	}
+
+}
+
+
+/**
+ * @brief [start crossfading an effect node from its running tier to N->want]
+ * @details [the tier coming in last ran who knows how long ago, so it is reset and then runs
+ * unheard for its tail, until its history is the current input, before the fade starts. a
+ * tier with an unknown tail fades in straight from silence]
+ * 
+ * @param N [node to switch]
+ */
+static void graph_start_fade(GRAPH_NODE_T * N) {
+
+	int t = N->want;
+	int prime = (N->tier_ops[t]->tail != NULL) ? N->tier_ops[t]->tail(N->tier_states[t]) : -1;
+
+	if(N->tier_ops[t]->reset != NULL) N->tier_ops[t]->reset(N->tier_states[t]);
+
+	N->fade_to = t;
+	N->fade_pos = (prime > 0) ? -prime : 0;
+
+}
+
+
+/**
+ * @brief [step an effect node down to the cheaper tier N->want in one block]
+ * @details [the running tier is already too slow, so it isn't run to fade out. the cheaper 
+ * tier is reset and run over the input history into the fade buffer, then takes over. with 
+ * the same latency and the same input behind it, the cut is only the difference between the 
+ * two tiers' responses]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param N [node to switch]
+ */
+static void graph_step_down(GRAPH_T * G, GRAPH_NODE_T * N) {
+
+	int b;
+	int t = N->want;
+	const float * block;
+
+	if(N->tier_ops[t]->reset != NULL) N->tier_ops[t]->reset(N->tier_states[t]);
+
+	// oldest block first
+	for(b = 0; b < N->history_blocks; b++) {
+		block = N->history + (((N->history_pos + b) % N->history_blocks) * G->block_size);
+		N->tier_ops[t]->process(N->tier_states[t], block, G->fade_buffer, G->block_size);
+	}
+
+	N->tier = t;
+	N->ops = N->tier_ops[t];
+	N->state = N->tier_states[t];
+
+}
+
+
+/**
+ * @brief [crossfade an effect node from its running tier to N->fade_to]
+ * @details [the old tier runs into the fade buffer first, so src can be dst. while fade_pos 
+ * is negative the new tier is still priming and only the old one is heard]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param N [node crossfading]
+ * @param src [input block]
+ * @param dst [output block]
+ */
+static void graph_crossfade(GRAPH_T * G, GRAPH_NODE_T * N, const float * src, float * dst) {
+
+	int j;
+	float g;
+	float step = 1.0f / N->fade_len;
+
+	N->ops->process(N->state, src, G->fade_buffer, G->block_size);
+	N->tier_ops[N->fade_to]->process(N->tier_states[N->fade_to], src, dst, G->block_size);
+
+	// linear fade from the old tier to the new one
+	for(j = 0; j < G->block_size; j++) {
+		g = (N->fade_pos + j + 1) * step;
+		if(g < 0.0f) g = 0.0f;
+		if(g > 1.0f) g = 1.0f;
+		dst[j] = (g * dst[j]) + ((1.0f - g) * G->fade_buffer[j]);
+	}
+	N->fade_pos += G->block_size;
+
+	// done, the new tier is the running one
+	if(N->fade_pos >= N->fade_len) {
+		N->tier = N->fade_to;
+		N->ops = N->tier_ops[N->tier];
+		N->state = N->tier_states[N->tier];
+		N->fade_to = -1;
+	}
+
+}
+
+
+/**
+ * @brief [run a node's block rate update, on both tiers while it crossfades]
+ * 
+ * @param N [node to update]
+ */
+static void graph_update_node(GRAPH_NODE_T * N) {
+
+	if(N->ops == NULL) return;
+	if(N->ops->update != NULL) N->ops->update(N->state);
+	if(N->fade_to >= 0 && N->tier_ops[N->fade_to]->update != NULL) N->tier_ops[N->fade_to]->update(N->tier_states[N->fade_to]);
+
+}
+
+
+/**
+ * @brief [leave the effects' block rate updates to the caller]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param defer [1 to leave the updates to update_graph(), 0 for run_graph() to run them]
+ */
+void graph_defer_updates(GRAPH_T * G, int defer) {
+
+	G->defer_updates = defer;
+
+}
+
+
+/**
+ * @brief [run every effect's block rate update]
+ * @details [only the tiers of an effect that are processing]
+ * 
+ * @param G [pointer to the graph struct]
+ */
+void update_graph(GRAPH_T * G) {
+
+	int k;
+	GRAPH_NODE_T * N;
+
+	for(k = 0; k < G->num_nodes; k++) {
+		N = &(G->nodes[k]);
+		graph_update_node(N);
+	}
+
+}
+
+
+/**
+ * @brief [run every node of the graph on one block]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param input [block_size input samples]
+ * @param output [block_size output samples]
+ */
+void run_graph(GRAPH_T * G, float * input, float * output) {
+
+	int i, j, k, in;
+	float acc;
+	float * src[GRAPH_MAX_INPUTS];
+	float * dst;
+	const char * name;
+	GRAPH_NODE_T * N;
+
+	for(k = 0; k < G->num_nodes; k++) {
+
+		N = &(G->nodes[k]);
+
+		// find the buffers for this node
+		for(i = 0; i < N->num_inputs; i++) {
+			in = N->inputs[i];
+			if(in == GRAPH_INPUT) {
+				src[i] = input;
+			} else if(G->nodes[in].buffer == GRAPH_OUTPUT) {
+				src[i] = output;
+			} else {
+				src[i] = G->buffers[G->nodes[in].buffer];
+			}
+		}
+		dst = (N->buffer == GRAPH_OUTPUT) ? output : G->buffers[N->buffer];
+
+
+		// a crossfade can finish and change ops, so the end of the trace goes under the same name
+		name = (N->ops != NULL) ? N->ops->name : "mix";
+		PROFILE_BEGIN(G->profiler, N->stage);
+		TRACE_BEGIN(name);
+
+		if(N->num_tiers > 0) {
+
+			// a step down in the middle of a step up drops the fade, the old tier never stopped
+			if(N->fade_to >= 0 && N->want >= N->tier) N->fade_to = -1;
+
+			// switch tiers at the block boundary, unless a step up is still fading
+			if(N->fade_to < 0 && N->want > N->tier) {
+				graph_step_down(G, N);
+				TRACE_INSTANT(N->ops->name, N->tier);
+			} else if(N->fade_to < 0 && N->want < N->tier) {
+				graph_start_fade(N);
+				TRACE_INSTANT(N->tier_ops[N->want]->name, N->want);
+			}
+
+			// keep this block for priming, before an in place tier overwrites it
+			if(N->history_blocks > 0) {
+				memcpy(N->history + (N->history_pos * G->block_size), src[0], sizeof(float) * G->block_size);
+				N->history_pos = (N->history_pos + 1) % N->history_blocks;
+			}
+
+		}
+
+		if(N->fade_to >= 0) {
+			// TIER CROSSFADE ----------------------------------
+			graph_crossfade(G, N, src[0], dst);
+			if(!G->defer_updates) graph_update_node(N);
+		} else if(N->ops != NULL) {
+			// EFFECT ------------------------------------------
+			N->ops->process(N->state, src[0], dst, G->block_size);
+			if(!G->defer_updates) graph_update_node(N);
+		} else {
+			// MIX ---------------------------------------------
+			// every input sample is read before the output sample is written,
+			// so dst can be one of the inputs
+			for(j = 0; j < G->block_size; j++) {
+				acc = 0.0;
+				for(i = 0; i < N->num_inputs; i++) {
+					acc += N->gains[i] * src[i][j];
+				}
+				dst[j] = acc;
+			}
+		}
+
+		TRACE_END(name);
+		PROFILE_END(G->profiler, N->stage);
+
+	}
+
+}
+
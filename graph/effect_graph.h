@@ -0,0 +1,314 @@
+/**
+ * @file effect_graph.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for 
+ * the effect chain graph. Effects register init/process callbacks and are wired
+ * in series, or split into parallel branches that are mixed back together.
+ * 
+ */
+
+
+// HEADER DEFINITION ------------------------------------
+
+#ifndef EFFECT_GRAPH_H
+#define EFFECT_GRAPH_H
+ 
+// ------------------------------------------------------
+
+
+// INCLUDE ----------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "profiler.h"
+
+// ------------------------------------------------------
+
+
+// DEFINES ----------------------------------------------
+
+#define GRAPH_MAX_NODES		16		// most effects + mixes in one graph
+#define GRAPH_MAX_INPUTS	4		// most branches going into one mix node
+#define GRAPH_MAX_TIERS		4		// most quality tiers of one effect
+
+#define GRAPH_INPUT			-1		// node id of the graph input, use as the input of the first effect
+#define GRAPH_OUTPUT		-2		// buffer id of the caller's output buffer
+
+// ------------------------------------------------------
+
+
+
+
+/**
+ * @brief [callbacks an effect registers to be used as a node in the graph]
+ * @details [process has to work when input and output are the same buffer, the planner
+ * reuses buffers in place whenever the input isn't needed by any later node. init allocates
+ * all of its state from the arena, so there is nothing to free: reconfiguring is a reset_arena()
+ * and a new graph. tail, reset, update and latency are optional: an effect without a tail is
+ * never bypassed, one without a reset is left as it was, one without a latency doesn't delay
+ * the signal. update is the effect's block rate control 
+ * work (level detection, parameter smoothing), kept out of process so that process can run in
+ * an interrupt while update runs in the foreground (see graph_defer_updates())]
+ * 
+ */
+typedef struct effect_ops {
+	const char * name;																// name of the effect for reports
+	void * (*init)(ARENA_T * A, const float * params, int block_size, int FS);	// returns effect state or NULL
+	void (*process)(void * state, const float * input, float * output, int n);		// process n samples
+	int (*tail)(void * state);														// samples of output after the input goes silent
+	void (*reset)(void * state);													// clear the state back to silence
+	void (*update)(void * state);													// block rate control, after process
+	int (*latency)(void * state);													// samples the signal comes out delayed by
+} EFFECT_OPS_T;
+
+
+/**
+ * @brief [one effect or mix in the graph]
+ * 
+ */
+typedef struct graph_node {
+	const EFFECT_OPS_T * ops;			// effect callbacks, NULL for a mix node
+	void * state;						// effect state from ops->init
+	int num_inputs;						// 1 for an effect, 1 to GRAPH_MAX_INPUTS for a mix
+	int inputs[GRAPH_MAX_INPUTS];		// node ids feeding this node (GRAPH_INPUT for the graph input)
+	float gains[GRAPH_MAX_INPUTS];		// gain applied to each input of a mix node
+	int last_use;						// index of the last node that reads this output
+	int buffer;							// block buffer holding this output (GRAPH_OUTPUT for the output node)
+	int stage;							// profiler stage timing this node, -1 for none
+
+	// quality tiers, ops and state above are the running tier's
+	int num_tiers;								// 0 for a plain effect or a mix
+	const EFFECT_OPS_T * tier_ops[GRAPH_MAX_TIERS];	// callbacks of each tier, best first
+	void * tier_states[GRAPH_MAX_TIERS];		// state of each tier
+	int tier;									// tier running
+	int want;									// tier graph_set_quality() asked for
+	int fade_to;								// tier being faded in, -1 when not fading
+	int fade_len;								// samples in a crossfade
+	int fade_pos;								// samples of the crossfade done, negative while the new tier primes
+	float * history;							// the last history_blocks input blocks, to prime a cheaper tier on
+	int history_blocks;							// blocks of input kept, enough for the longest tail of tiers 1 and up
+	int history_pos;							// oldest block in history
+} GRAPH_NODE_T;
+
+
+/**
+ * @brief [structure containing the nodes of the graph and the planned block buffers]
+ * @details [nodes run in the order they were added, and a node can only take inputs from nodes
+ * added before it, so that order is always a valid processing order]
+ * 
+ */
+typedef struct graph_struct {
+	ARENA_T * A;							// arena the effects and buffers are allocated from
+	int block_size;							// number of samples to work on
+	int FS;									// sampling frequency passed to the effects
+	int num_nodes;							// number of nodes added
+	GRAPH_NODE_T nodes[GRAPH_MAX_NODES];	// nodes in processing order
+	int output_node;						// node that writes the graph output
+	int num_buffers;						// number of block buffers after planning
+	float * buffers[GRAPH_MAX_NODES];		// intermediate block buffers
+	PROFILER_T * profiler;					// times each node, NULL for none
+	int num_levels;							// most tiers of any node, 1 if none have tiers
+	float * fade_buffer;					// output of the tier being faded out
+	int tail;								// samples the output keeps going after the input goes silent, -1 if unknown
+	int defer_updates;						// 1 if the caller runs the updates with update_graph(), 0 if run_graph() does
+	int latency;							// samples the output is delayed by along the path to it
+} GRAPH_T;
+
+
+/**
+ * @brief [initialize an empty graph]
+ * 
+ * @param A [arena the graph, its effects and its buffers are allocated from]
+ * @param block_size [number of samples to work on]
+ * @param FS [sampling frequency passed to the effects]
+ * @return [pointer to the graph struct, NULL if it doesn't fit in the arena]
+ */
+GRAPH_T * init_graph(
+	ARENA_T * A,		// arena to allocate from
+	int block_size,		// number of samples to work on
+	int FS				// sampling frequency
+);
+
+
+/**
+ * @brief [add an effect to the graph]
+ * @details [two effects with the same input split the signal into parallel branches. the 
+ * effect's allocations are charged to ops->name in the arena report]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param ops [callbacks of the effect]
+ * @param params [effect parameters handed to ops->init]
+ * @param input [node id feeding the effect, GRAPH_INPUT for the graph input]
+ * @return [node id, or -1 on error]
+ */
+int graph_add_effect(
+	GRAPH_T * G,					// pointer to graph struct
+	const EFFECT_OPS_T * ops,		// effect callbacks
+	const float * params,			// effect parameters
+	int input						// node feeding this effect
+);
+
+
+/**
+ * @brief [add an effect with quality tiers to the graph]
+ * @details [every tier is initialized up front with the same params, so switching tiers 
+ * never allocates. the tiers have to have the same latency. a step up resets the better tier,
+ * runs it unheard for its tail so it has the current input's history, then crossfades from 
+ * one to the other over fade samples, both running the whole time. a step down happens when
+ * the blocks are already too slow, so the better tier isn't run again: the cheaper tier is 
+ * reset, primed on the last blocks of input the graph keeps for it and cut over to in one 
+ * block. a cheaper tier with an unknown tail has no input kept and starts from silence]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param tiers [callbacks of each tier, best quality (tier 0) first]
+ * @param num_tiers [number of tiers]
+ * @param params [effect parameters handed to each tier's init]
+ * @param fade [crossfade length of a step up in samples]
+ * @param input [node id feeding the effect, GRAPH_INPUT for the graph input]
+ * @return [node id, or -1 on error]
+ */
+int graph_add_tiers(
+	GRAPH_T * G,							// pointer to graph struct
+	const EFFECT_OPS_T * const * tiers,		// callbacks of each tier
+	int num_tiers,							// number of tiers
+	const float * params,					// effect parameters
+	int fade,								// crossfade length in samples
+	int input								// node feeding this effect
+);
+
+
+/**
+ * @brief [add a node that mixes parallel branches back together]
+ * @details [output is the sum of each input scaled by its gain]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param num_inputs [number of branches to mix]
+ * @param inputs [node ids of the branches]
+ * @param gains [gain for each branch]
+ * @return [node id, or -1 on error]
+ */
+int graph_add_mix(
+	GRAPH_T * G,			// pointer to graph struct
+	int num_inputs,			// number of branches to mix
+	const int * inputs,		// node ids of the branches
+	const float * gains		// gain for each branch
+);
+
+
+/**
+ * @brief [plan the block buffers for the graph]
+ * @details [liveness analysis over the processing order. a buffer is handed back to the free list
+ * as soon as the last node reading it has run, and the next node to need a buffer takes it,
+ * so a serial chain of any length runs in place in a single buffer. the tail of the graph, the 
+ * longest sum of effect tails on any path to the output, is worked out at the same time, and so
+ * is the latency, the longest sum of effect latencies on any path to the output]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param output [node id whose output is the graph output]
+ * @return [0 on success, 1 on error]
+ */
+int plan_graph(
+	GRAPH_T * G,		// pointer to graph struct
+	int output			// node that writes the graph output
+);
+
+
+/**
+ * @brief [clear every effect in the graph back to silence]
+ * @details [for resuming after the graph was bypassed through silence. a crossfade that was
+ * under way finishes right away, nothing can be heard of it]
+ * 
+ * @param G [pointer to the graph struct]
+ */
+void reset_graph(
+	GRAPH_T * G			// pointer to graph struct
+);
+
+
+/**
+ * @brief [time every node of the graph as its own profiler stage]
+ * @details [effects are added under their ops->name, mixes as "mix". the times are only
+ * recorded when built with GAPE_PROFILE]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param P [profiler to add the stages to]
+ * @return [0 on success, 1 if the profiler ran out of stages]
+ */
+int graph_set_profiler(
+	GRAPH_T * G,		// pointer to graph struct
+	PROFILER_T * P		// profiler to add the stages to
+);
+
+
+/**
+ * @brief [move every effect with tiers to a quality level]
+ * @details [level 0 is the best, an effect with fewer tiers goes to its last one. the switch
+ * starts at the next block. a node fading up finishes first, unless this steps it back down]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param level [quality level, 0 to num_levels - 1]
+ */
+void graph_set_quality(
+	GRAPH_T * G,		// pointer to graph struct
+	int level			// quality level
+);
+
+
+/**
+ * @brief [print the tier each effect with tiers is running]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param print [prints one line, UART_putstr on the board]
+ */
+void report_graph_tiers(
+	const GRAPH_T * G,				// pointer to graph struct
+	void (*print)(const char *)		// prints one line
+);
+
+
+/**
+ * @brief [leave the effects' block rate updates to the caller]
+ * @details [for a graph run from an interrupt. the interrupt only does each effect's process,
+ * and the foreground calls update_graph() once per block, so the control work doesn't add
+ * to the time the interrupt holds the cpu. an update that comes late leaves the effect on 
+ * its last settings for another block]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param defer [1 to leave the updates to update_graph(), 0 for run_graph() to run them]
+ */
+void graph_defer_updates(
+	GRAPH_T * G,		// pointer to graph struct
+	int defer			// 1 to leave the updates to the caller
+);
+
+
+/**
+ * @brief [run every effect's block rate update]
+ * @details [run_graph() does this after each node unless the updates are deferred]
+ * 
+ * @param G [pointer to the graph struct]
+ */
+void update_graph(
+	GRAPH_T * G			// pointer to graph struct
+);
+
+
+/**
+ * @brief [run every node of the graph on one block]
+ * 
+ * @param G [pointer to the graph struct]
+ * @param input [block_size input samples]
+ * @param output [block_size output samples]
+ */
+void run_graph(
+	GRAPH_T * G,		// pointer to graph struct
+	float * input,		// buffer of input samples
+	float * output		// buffer for output samples
+);
+
+
+#endif
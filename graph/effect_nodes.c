@@ -0,0 +1,192 @@
+/**
+ * @file effect_nodes.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the graph callbacks for the delay, compressor and equalizer.
+ * 
+ * @details [the calc_* routines all take (state, input, output, n) and work in place, so 
+ * the process callbacks are just casts of the effect state. so are the reset callbacks, and
+ * the tail callbacks say how long each effect rings on after its input goes silent, the latency
+ * callbacks how long the signal is delayed through it (the delay's echo is the effect, not a 
+ * latency). the Q15 nodes convert the block to Q15 and back around the fixed point routine, 
+ * which costs two passes over the block against the filter taps and halves the memory of the
+ * delay line]
+ * 
+ */
+
+
+// INCLUDE ------------------------------------------------------------
+
+#include <stdio.h>
+#include "arena.h"
+#include "fixed.h"
+
+#include "delay.h"
+#include "calc_rms.h"
+#include "compressor.h"
+#include "eq.h"
+#include "effect_nodes.h"
+
+// --------------------------------------------------------------------
+
+
+
+
+// DELAY --------------------------------------------------------------
+
+static void * delay_node_init(ARENA_T * A, const float * params, int block_size, int FS) {
+	// 1 means delay is in seconds
+	return init_delay(A, 1, FS, params[0], params[1], (int)params[2], block_size);
+}
+
+static void delay_node_process(void * state, const float * input, float * output, int n) {
+	calc_delay((DELAY_T *)state, input, output, n);
+}
+
+static int delay_node_tail(void * state) {
+	// the echo comes sample_delay samples after the input
+	return ((DELAY_T *)state)->sample_delay;
+}
+
+static void delay_node_reset(void * state) {
+	reset_delay((DELAY_T *)state);
+}
+
+const EFFECT_OPS_T delay_node = { "delay", delay_node_init, delay_node_process, delay_node_tail, delay_node_reset };
+
+
+
+
+// COMPRESSOR ---------------------------------------------------------
+
+static void * compressor_node_init(ARENA_T * A, const float * params, int block_size, int FS) {
+	// the window is in seconds, the same length of time at every rate
+	return init_compressor(A, params[0], params[1], (int)(params[2] * FS + 0.5f), block_size);
+}
+
+static void compressor_node_process(void * state, const float * input, float * output, int n) {
+	calc_compressor((COMP_T *)state, input, output, n);
+}
+
+static int compressor_node_tail(void * state) {
+	// silence in is silence out, whatever the gain
+	return 0;
+}
+
+static void compressor_node_reset(void * state) {
+	reset_compressor((COMP_T *)state);
+}
+
+const EFFECT_OPS_T compressor_node = { "compressor", compressor_node_init, compressor_node_process, compressor_node_tail, compressor_node_reset };
+
+
+
+
+// EQUALIZER ----------------------------------------------------------
+
+static void * eq_node_init(ARENA_T * A, const float * params, int block_size, int FS) {
+	return init_eq(A, params[0], params[1], params[2], block_size, FS);
+}
+
+static void eq_node_process(void * state, const float * input, float * output, int n) {
+	calc_eq((EQ_T *)state, input, output, n);
+}
+
+static int eq_node_tail(void * state) {
+	return eq_tail((EQ_T *)state);
+}
+
+static void eq_node_reset(void * state) {
+	reset_eq((EQ_T *)state);
+}
+
+static int eq_node_latency(void * state) {
+	return eq_latency((EQ_T *)state);
+}
+
+const EFFECT_OPS_T eq_node = { "eq", eq_node_init, eq_node_process, eq_node_tail, eq_node_reset, NULL, eq_node_latency };
+
+
+// cheaper quality tiers of the eq, same params, same latency ----------
+
+static void * eq_151_node_init(ARENA_T * A, const float * params, int block_size, int FS) {
+	return init_eq_taps(A, params[0], params[1], params[2], 151, block_size, FS);
+}
+
+static void * eq_75_node_init(ARENA_T * A, const float * params, int block_size, int FS) {
+	return init_eq_taps(A, params[0], params[1], params[2], 75, block_size, FS);
+}
+
+const EFFECT_OPS_T eq_151_node = { "eq/151", eq_151_node_init, eq_node_process, eq_node_tail, eq_node_reset, NULL, eq_node_latency };
+const EFFECT_OPS_T eq_75_node = { "eq/75", eq_75_node_init, eq_node_process, eq_node_tail, eq_node_reset, NULL, eq_node_latency };
+
+const EFFECT_OPS_T * const eq_tiers[EQ_NUM_TIERS] = { &eq_node, &eq_151_node, &eq_75_node };
+
+
+
+
+// FIXED POINT --------------------------------------------------------
+
+typedef struct {
+	void * fx;				// Q15 effect state
+	q15_t * buffer;			// the block in Q15
+} Q15_NODE_T;
+
+static Q15_NODE_T * q15_node_init(ARENA_T * A, void * fx, int block_size) {
+	Q15_NODE_T * N;
+	if(fx == NULL) return NULL;
+	N = (Q15_NODE_T *)arena_alloc(A, sizeof(Q15_NODE_T));
+	if(N == NULL) return NULL;
+	N->fx = fx;
+	N->buffer = (q15_t *)arena_alloc(A, sizeof(q15_t) * block_size);
+	return (N->buffer == NULL) ? NULL : N;
+}
+
+static void * delay_q15_node_init(ARENA_T * A, const float * params, int block_size, int FS) {
+	return q15_node_init(A, init_delay_q15(A, 1, FS, params[0], params[1], (int)params[2], block_size), block_size);
+}
+
+static void delay_q15_node_process(void * state, const float * input, float * output, int n) {
+	Q15_NODE_T * N = (Q15_NODE_T *)state;
+	float_to_q15(input, N->buffer, n);
+	calc_delay_q15((DELAY_Q15_T *)N->fx, N->buffer, N->buffer, n);
+	q15_to_float(N->buffer, output, n);
+}
+
+static int delay_q15_node_tail(void * state) {
+	return ((DELAY_Q15_T *)((Q15_NODE_T *)state)->fx)->sample_delay;
+}
+
+static void delay_q15_node_reset(void * state) {
+	reset_delay_q15((DELAY_Q15_T *)((Q15_NODE_T *)state)->fx);
+}
+
+const EFFECT_OPS_T delay_q15_node = { "delay/q15", delay_q15_node_init, delay_q15_node_process, delay_q15_node_tail, delay_q15_node_reset };
+
+
+static void * eq_q15_node_init(ARENA_T * A, const float * params, int block_size, int FS) {
+	return q15_node_init(A, init_eq_q15(A, params[0], params[1], params[2], block_size, FS), block_size);
+}
+
+static void eq_q15_node_process(void * state, const float * input, float * output, int n) {
+	Q15_NODE_T * N = (Q15_NODE_T *)state;
+	float_to_q15(input, N->buffer, n);
+	calc_eq_q15((EQ_Q15_T *)N->fx, N->buffer, N->buffer, n);
+	q15_to_float(N->buffer, output, n);
+}
+
+static int eq_q15_node_tail(void * state) {
+	return eq_q15_tail((EQ_Q15_T *)((Q15_NODE_T *)state)->fx);
+}
+
+static void eq_q15_node_reset(void * state) {
+	reset_eq_q15((EQ_Q15_T *)((Q15_NODE_T *)state)->fx);
+}
+
+static int eq_q15_node_latency(void * state) {
+	return eq_q15_latency((EQ_Q15_T *)((Q15_NODE_T *)state)->fx);
+}
+
+const EFFECT_OPS_T eq_q15_node = { "eq/q15", eq_q15_node_init, eq_q15_node_process, eq_q15_node_tail, eq_q15_node_reset, NULL, eq_q15_node_latency };
@@ -0,0 +1,45 @@
+/**
+ * @file effect_nodes.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the graph callbacks for each of the GAPE effects, so they can be
+ * added to an effect graph with graph_add_effect().
+ * 
+ * @details [parameter layout handed to init for each effect:
+ * 		delay_node 		{ time_delay (seconds), delay_gain, input_toggle }
+ * 		compressor_node	{ threshold (dB), ratio, rms window (seconds) }
+ * 		eq_node			{ lowband_gain, midband_gain, highband_gain (dB) }
+ * the Q15 nodes take the same parameters as the float ones]
+ * 
+ */
+
+
+#ifndef EFFECT_NODES_H
+#define EFFECT_NODES_H
+
+
+#include "effect_graph.h"
+
+
+extern const EFFECT_OPS_T delay_node;
+extern const EFFECT_OPS_T compressor_node;
+extern const EFFECT_OPS_T eq_node;
+
+
+// quality tiers of the eq (see graph_add_tiers()): full 301 tap band filters, then 151 and 75 taps
+#define EQ_NUM_TIERS	3
+#define EQ_TIER_FADE	1024	// crossfade in samples, longer than the 301 sample filter history
+
+extern const EFFECT_OPS_T eq_151_node;
+extern const EFFECT_OPS_T eq_75_node;
+extern const EFFECT_OPS_T * const eq_tiers[EQ_NUM_TIERS];
+
+
+// fixed point versions for GAPE_FIXED, Q15 state inside, float blocks in and out of the graph
+extern const EFFECT_OPS_T delay_q15_node;
+extern const EFFECT_OPS_T eq_q15_node;
+
+
+#endif
@@ -50,6 +50,7 @@
 #include <stdio.h>
 #include <math.h>
 
+#include "arena.h"
 #include "read_effect.h"
 
 // -------------------------------------------------------
@@ -60,21 +61,20 @@
 /**
  * @brief [initialize the struct for giving the main program access to the input from the gui]
  * @details [this function waits until the gui set PB3, which says that now there is valid data on the pins]
- * @return [pointer to the effect seelction struct]
+ * @param A [arena the struct is allocated from]
+ * @return [pointer to the effect seelction struct, NULL if it doesn't fit in the arena]
  */
- FX_T * init_effects_read(void) {
-
-	int i, j;
-
-	FX_T * F = (FX_T *)malloc(sizeof(FX_T));
-	F->pin_states = (int *)malloc(sizeof(int) * 8);
-	F->effect_params = (int *)malloc(sizeof(int) * 3);
+ FX_T * init_effects_read(ARENA_T * A) {
+
+	// the arena hands out zeroed memory, so the pin states and params start at 0
+	arena_set_tag(A, "gui");
+	FX_T * F = (FX_T *)arena_alloc(A, sizeof(FX_T));
+	if(F == NULL) return NULL;
+	F->pin_states = (int *)arena_alloc(A, sizeof(int) * 8);		// state of 8 PD pins
+	F->effect_params = (int *)arena_alloc(A, sizeof(int) * 3);	// values to set in main program
 	if(F->pin_states == NULL || F->effect_params == NULL) {
 		return NULL;
 	}
-	F->effect = 0;
-	for(i = 0; i < 8; i++) F->pin_states[i] = 0;	// state of 8 PD pins	
-	for(j = 0; j < 3; j++) F->effect_params[j] = 0;	// values to set in main program
 
 
 	// initialize LEDs for waiting for valid send
@@ -365,15 +365,3 @@ void read_effect(FX_T * F) {
 
 }
 
-
-/**
- * @brief [free memory allocated for FX_T]
- * 
- * @param F [pointer to struct]
- */
-void free_fx(FX_T * F) {
-  // free memory allocated for struct
-  free(F);
-  // NULL pointer for safety
-  F = NULL;
-}
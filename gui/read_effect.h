@@ -14,6 +14,9 @@
 #define READ_EFFECT
 
 
+#include "arena.h"
+
+
  typedef struct effect {
  	int * pin_states;		// buffer containing the state of each PD pin (pin_states[0] -> PD0)
  	int * effect_params;	// buffer containing the values to set for the selected effect
@@ -23,8 +26,15 @@
 
 
 
+/**
+ * @brief [initialize the struct for giving the main program access to the input from the gui]
+ * @details [waits until the gui sets PB3, meaning there is a valid send of effect and params]
+ * 
+ * @param A [arena the struct is allocated from]
+ * @return [pointer to the effect struct, NULL if it doesn't fit in the arena]
+ */
 FX_T * init_effects_read(
-		void
+		ARENA_T * A		// arena to allocate from
 	);
 
 
@@ -52,9 +62,4 @@ void read_effect(
 	);
 
 
-void free_fx(
-		FX_T * F
-	);
-
-
 #endif
\ No newline at end of file
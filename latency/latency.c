@@ -0,0 +1,141 @@
+/**
+ * @file latency.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the latency profiles and the functions for timing the chain.
+ * 
+ * @details [
+ * 		init_latency() - reset the timing for a profile
+ * 		
+ * 		latency_begin() - start timing a block
+ * 		
+ * 		latency_end() - stop timing a block
+ * 		
+ * 		report_latency() - print the I/O latency, cpu load and headroom
+ * ]
+ * 
+ * The block size sets both sides of the trade: the I/O latency is two blocks (see dma_io.c), 
+ * while the cost per sample of the block overhead, and of the FFT filters (see fir.c), drop as 
+ * the block grows. Small blocks are for playing live, big blocks leave room for longer chains.
+ * The sampling frequency is the other side of the same trade: every block period is shorter at 96kHz,
+ * and the filters that keep their length in time are longer, while 32kHz leaves room for heavy chains.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "dma_io.h"
+#include "profiler.h"
+#include "latency.h"
+
+// ----------------------------------------------------------
+
+
+
+
+// LATENCY PROFILES AND RATES -----------------------------------------------
+
+const LATENCY_PROFILE_T latency_profiles[LATENCY_NUM_PROFILES] = {
+	{ "live", DMA_IO_LOW_LATENCY_BLOCK, 1 },
+	{ "16", 16, 0 },
+	{ "32", 32, 0 },
+	{ "64", 64, 0 },
+	{ "100", 100, 0 },
+	{ "128", 128, 0 },
+	{ "256", 256, 0 },
+};
+
+const int latency_rates[LATENCY_NUM_RATES] = { 32000, 44100, 48000, 96000 };
+
+
+
+
+/**
+ * @brief [reset the latency struct for a profile]
+ * 
+ * @param L [pointer to the latency struct]
+ * @param profile [profile the chain is planned for]
+ * @param FS [sampling frequency]
+ * @param filter_samples [group delay of the filters in the chain, in samples]
+ */
+void init_latency(LATENCY_T * L, const LATENCY_PROFILE_T * profile, int FS, int filter_samples) {
+
+	L->profile = profile;
+	L->FS = FS;
+	L->io_samples = 2 * profile->block_size;
+	L->filter_samples = filter_samples;
+	L->budget = (uint32_t)(((uint64_t)profile_ticks_per_sec() * profile->block_size) / FS);
+	L->start = 0;
+	L->last = 0;
+	L->worst = 0;
+	L->total = 0;
+	L->blocks = 0;
+
+	profile_start_clock();
+
+}
+
+
+/**
+ * @brief [start timing a block]
+ * 
+ * @param L [pointer to the latency struct]
+ */
+void latency_begin(LATENCY_T * L) {
+
+	L->start = profile_now();
+
+}
+
+
+/**
+ * @brief [stop timing a block]
+ * 
+ * @param L [pointer to the latency struct]
+ */
+void latency_end(LATENCY_T * L) {
+
+	uint32_t t = profile_now() - L->start;	// unsigned, so a wrap of the counter comes out right
+
+	L->last = t;
+	if(t > L->worst) L->worst = t;
+	L->total += t;
+	L->blocks++;
+
+}
+
+
+/**
+ * @brief [print the latency of the profile, and the cpu load and headroom once blocks have been timed]
+ * 
+ * @param L [pointer to the latency struct]
+ * @param print [prints one line, UART_putstr on the board]
+ */
+void report_latency(const LATENCY_T * L, void (*print)(const char *)) {
+
+	char line[112];
+	int total = L->io_samples + L->filter_samples;
+	int mean, worst;
+
+	// latency in us, integer math so it doesn't need printf float support
+	snprintf(line, sizeof(line), "profile %s at %d Hz: block %d%s, latency %d samples (%d us) = %d I/O + %d filters\r\n",
+		L->profile->name, L->FS, L->profile->block_size, L->profile->in_interrupt ? " in interrupt" : "",
+		total, (int)(((int64_t)total * 1000000) / L->FS), L->io_samples, L->filter_samples);
+	print(line);
+
+	if(L->blocks == 0 || L->budget == 0) return;
+
+	// load in percent of the block period
+	mean = (int)((L->total * 100) / ((uint64_t)L->blocks * L->budget));
+	worst = (int)(((uint64_t)L->worst * 100) / L->budget);
+	snprintf(line, sizeof(line), "  cpu %d%% mean, %d%% worst over %lu blocks, headroom %d%%\r\n",
+		mean, worst, (unsigned long)L->blocks, 100 - worst);
+	print(line);
+
+}
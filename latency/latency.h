@@ -0,0 +1,132 @@
+/**
+ * @file latency.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for 
+ * the latency profiles: the block sizes and sampling frequencies the chain can be planned for, 
+ * and the I/O latency and cpu headroom each one ends up with.
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define LATENCY_NUM_PROFILES	7	// entries in latency_profiles[]
+#define LATENCY_DEFAULT_PROFILE	4	// 100 samples, the old getblocksize()
+#define LATENCY_LOW_PROFILE		0	// DMA_IO_LOW_LATENCY_BLOCK samples in the DMA interrupt
+
+#define LATENCY_NUM_RATES		4	// entries in latency_rates[]
+#define LATENCY_DEFAULT_RATE	2	// 48kHz, the rate the coefficient tables in filters/ are for
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [a block size the chain can be planned for]
+ * 
+ */
+typedef struct latency_profile_struct {
+	const char * name;		// reported over the uart
+	int block_size;			// samples per block
+	int in_interrupt;		// 1 to run the chain in the adc DMA interrupt, 0 for the loop
+} LATENCY_PROFILE_T;
+
+
+// smallest block (lowest latency) first
+extern const LATENCY_PROFILE_T latency_profiles[LATENCY_NUM_PROFILES];
+
+// sampling frequencies the chain can be planned for, lowest (cheapest) first
+extern const int latency_rates[LATENCY_NUM_RATES];
+
+
+/**
+ * @brief [structure containing the latency and processing time of the running profile]
+ * @details [times are in ticks of profile_now(): cpu cycles on the board, nanoseconds on
+ * the host. the budget is one block period, the time the chain has before the dac catches up]
+ * 
+ */
+typedef struct latency_struct {
+	const LATENCY_PROFILE_T * profile;	// profile the chain is planned for
+	int FS;						// sampling frequency
+	int io_samples;				// adc/dac buffer latency, 2 * block_size
+	int filter_samples;			// group delay of the filters in the chain
+	uint32_t budget;			// ticks in one block period
+	uint32_t start;				// tick latency_begin() was called
+	uint32_t last;				// last block
+	uint32_t worst;				// longest block
+	uint64_t total;				// sum over all blocks, for the mean
+	uint32_t blocks;			// blocks timed
+} LATENCY_T;
+
+
+/**
+ * @brief [reset the latency struct for a profile]
+ * @details [also starts the cycle counter on the board]
+ * 
+ * @param L [pointer to the latency struct]
+ * @param profile [profile the chain is planned for]
+ * @param FS [sampling frequency]
+ * @param filter_samples [group delay of the filters in the chain, in samples]
+ */
+void init_latency(
+	LATENCY_T * L,							// pointer to latency struct
+	const LATENCY_PROFILE_T * profile,		// profile the chain is planned for
+	int FS,									// sampling frequency
+	int filter_samples						// group delay of the filters
+);
+
+
+/**
+ * @brief [start timing a block]
+ * 
+ * @param L [pointer to the latency struct]
+ */
+void latency_begin(
+	LATENCY_T * L		// pointer to latency struct
+);
+
+
+/**
+ * @brief [stop timing a block]
+ * 
+ * @param L [pointer to the latency struct]
+ */
+void latency_end(
+	LATENCY_T * L		// pointer to latency struct
+);
+
+
+/**
+ * @brief [print the latency of the profile, and the cpu load and headroom once blocks have been timed]
+ * @details [headroom is the part of the block period left over in the worst block, the 
+ * margin before the chain starts missing blocks]
+ * 
+ * @param L [pointer to the latency struct]
+ * @param print [prints one line, UART_putstr on the board]
+ */
+void report_latency(
+	const LATENCY_T * L,			// pointer to latency struct
+	void (*print)(const char *)		// prints one line
+);
+
+
+#endif
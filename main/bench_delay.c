@@ -0,0 +1,139 @@
+/**
+ * @file bench_delay.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to measure the delay kernels compiled for each block
+ * size against the generic loop. It builds for the host (makefile.host.GNUmakefile) and for the 
+ * STM32F407 (make bench), where the results are sent out the uart.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#ifdef ARM_MATH_CM4
+#include "stm32f4xx_hal.h"
+#include "stm32f4_discovery.h"
+#include "ece486.h"
+#include "uart_rx.h"
+#else
+#include <time.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "arena.h"
+#include "delay.h"
+
+// ---------------------------------------------------------------------
+
+#define MAX_BLOCK 256
+#define SAMPLES 48000		// samples timed per kernel, a second of audio
+#define FS 48000
+#define ECHO_DELAY 4800		// 100ms echo, the delay effect
+#define EQ_DELAY 150		// (301 - 1) / 2, the eq band delays
+
+
+
+// timer and output -----------------------------------------------------
+// cycles from the DWT cycle counter on the M4, nanoseconds on the host
+
+#ifdef ARM_MATH_CM4
+#define TIME_UNIT "cycles"
+static uint32_t now(void) { return DWT->CYCCNT; }
+static void print_line(const char * s) { UART_putstr(s); }
+#else
+#define TIME_UNIT "ns"
+static uint32_t now(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint32_t)((t.tv_sec * 1000000000ull) + t.tv_nsec);
+}
+static void print_line(const char * s) { fputs(s, stdout); }
+#endif
+
+
+static uint8_t pool[32 * 1024];
+static ARENA_T arena;
+
+static float buffer[MAX_BLOCK];
+static volatile float sink;		// keeps the loops from being optimized away
+static char line[128];
+
+
+/**
+ * @brief [time a second of audio through one delay, in place, a block at a time]
+ * @return [average time per sample]
+ */
+static float time_delay(DELAY_T * D, int block_size) {
+
+	int k;
+	uint32_t start, total = 0;
+
+	for(k = 0; k < SAMPLES / block_size; k++) {
+		start = now();
+		calc_delay(D, buffer, buffer, block_size);
+		total += now() - start;
+		sink = buffer[k % block_size];
+	}
+
+	return (float)total / ((SAMPLES / block_size) * block_size);
+
+}
+
+
+/**
+ * @brief [time the kernel for a block size against the generic loop]
+ */
+static void report(int block_size, int sample_delay, int input_toggle) {
+
+	float t_kernel, t_generic;
+	DELAY_T * D;
+
+	reset_arena(&arena);
+	D = init_delay(&arena, 0, FS, sample_delay, 0.5f, input_toggle, block_size);
+	if(D == NULL) { print_line("could not initialize\r\n"); return; }
+
+	t_kernel = time_delay(D, block_size);
+	D->kernel = NULL;
+	t_generic = time_delay(D, block_size);
+
+	snprintf(line, sizeof(line), "block %3d delay %4d toggle %d  kernel %6.2f %s  generic %6.2f %s  speedup %5.2fx\r\n", 
+		block_size, sample_delay, input_toggle, t_kernel, TIME_UNIT, t_generic, TIME_UNIT, t_generic / t_kernel);
+	print_line(line);
+
+}
+
+
+
+
+int main(int argc, char const *argv[]) {
+
+	int b, i;
+	int block_sizes[7] = {8, 16, 32, 64, 100, 128, 256};
+
+#ifdef ARM_MATH_CM4
+	initialize(FS_48K, MONO_IN, STEREO_OUT);	// system clock
+	init_uart();
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+	init_arena(&arena, pool, sizeof(pool));
+	for(i = 0; i < MAX_BLOCK; i++) buffer[i] = ((float)rand() / RAND_MAX) - 0.5f;
+
+	print_line("time per sample\r\n");
+	for(b = 0; b < 7; b++) {
+		report(block_sizes[b], ECHO_DELAY, 1);
+		report(block_sizes[b], EQ_DELAY, 0);
+	}
+
+#ifdef ARM_MATH_CM4
+	while(1);
+#endif
+
+	return 0;
+
+}
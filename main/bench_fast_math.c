@@ -0,0 +1,198 @@
+/**
+ * @file bench_fast_math.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to measure the error and the speed of the fast math
+ * routines against libm. It builds for the host (makefile.host.GNUmakefile) and for the 
+ * STM32F407 (make bench), where the results are sent out the uart.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#ifdef ARM_MATH_CM4
+#include "stm32f4xx_hal.h"
+#include "stm32f4_discovery.h"
+#include "ece486.h"
+#include "uart_rx.h"
+#else
+#include <time.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "fast_math.h"
+
+// ---------------------------------------------------------------------
+
+#define N 256		// values per timed block
+#define REPS 200	// number of timed blocks per routine
+
+
+
+// timer and output -----------------------------------------------------
+// cycles from the DWT cycle counter on the M4, nanoseconds on the host
+
+#ifdef ARM_MATH_CM4
+#define TIME_UNIT "cycles"
+static uint32_t now(void) { return DWT->CYCCNT; }
+static void print_line(const char * s) { UART_putstr(s); }
+#else
+#define TIME_UNIT "ns"
+static uint32_t now(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint32_t)((t.tv_sec * 1000000000ull) + t.tv_nsec);
+}
+static void print_line(const char * s) { fputs(s, stdout); }
+#endif
+
+
+static float in[N], out[N];
+static volatile float sink;		// keeps the scalar loops from being optimized away
+static char line[128];
+
+
+// libm reference loops
+static void ref_log2(const float * x, float * y, int n) { int i; for(i = 0; i < n; i++) y[i] = log2f(x[i]); }
+static void ref_exp2(const float * x, float * y, int n) { int i; for(i = 0; i < n; i++) y[i] = exp2f(x[i]); }
+static void ref_db_to_gain(const float * x, float * y, int n) { int i; for(i = 0; i < n; i++) y[i] = powf(10.0f, x[i] / 20.0f); }
+static void ref_gain_to_db(const float * x, float * y, int n) { int i; for(i = 0; i < n; i++) y[i] = 20.0f * log10f(x[i]); }
+static void ref_sqrt(const float * x, float * y, int n) { int i; for(i = 0; i < n; i++) y[i] = (float)sqrt(x[i]); }
+static void ref_rsqrt(const float * x, float * y, int n) { int i; for(i = 0; i < n; i++) y[i] = 1.0f / sqrtf(x[i]); }
+
+
+/**
+ * @brief [time one block routine over REPS blocks]
+ * @return [average time per value]
+ */
+static float time_block(void (*fn)(const float *, float *, int)) {
+
+	int r;
+	uint32_t start, total = 0;
+
+	for(r = 0; r < REPS; r++) {
+		start = now();
+		fn(in, out, N);
+		total += now() - start;
+		sink = out[r % N];
+	}
+
+	return (float)total / (REPS * N);
+
+}
+
+
+/**
+ * @brief [fill the input buffer with values spread over [lo, hi], geometric if log is set]
+ */
+static void fill(float lo, float hi, int log) {
+
+	int i;
+	for(i = 0; i < N; i++) {
+		if(log) {
+			in[i] = lo * powf(hi / lo, (float)i / (N - 1));
+		} else {
+			in[i] = lo + (hi - lo) * i / (N - 1);
+		}
+	}
+
+}
+
+
+static void report(const char * name, void (*fast)(const float *, float *, int), void (*ref)(const float *, float *, int)) {
+
+	float t_fast = time_block(fast);
+	float t_ref = time_block(ref);
+
+	snprintf(line, sizeof(line), "%-12s fast %8.2f %s  libm %8.2f %s  speedup %5.2fx\r\n", 
+		name, t_fast, TIME_UNIT, t_ref, TIME_UNIT, t_ref / t_fast);
+	print_line(line);
+
+}
+
+
+
+
+int main(int argc, char const *argv[]) {
+
+	int i, k;
+	double x, e, err;
+	double max_log2 = 0, max_exp2 = 0, max_g2db = 0, max_db2g = 0, max_rsqrt = 0;
+
+#ifdef ARM_MATH_CM4
+	initialize(FS_48K, MONO_IN, STEREO_OUT);	// system clock
+	init_uart();
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+
+	// MAX ERROR -----------------------------------------------------------------
+	// sweep each routine over its valid input against the double precision result
+
+	for(k = 0; k < 200000; k++) {
+
+		// log2 and gain_to_db over 1e-30 to 1e30 (absolute error)
+		x = pow(10.0, -30.0 + 60.0 * k / 200000.0);
+		err = fabs(fast_log2f((float)x) - log2((float)x));
+		if(err > max_log2) max_log2 = err;
+		if(x >= FM_MIN_GAIN) {
+			err = fabs(gain_to_db((float)x) - 20.0 * log10((float)x));
+			if(err > max_g2db) max_g2db = err;
+		}
+
+		// rsqrt over the same range (relative error)
+		e = 1.0 / sqrt((float)x);
+		err = fabs(fast_rsqrtf((float)x) - e) / e;
+		if(err > max_rsqrt) max_rsqrt = err;
+
+		// exp2 over -126 to 127.99 (relative error)
+		x = -126.0 + 253.99 * k / 200000.0;
+		e = exp2((float)x);
+		err = fabs(fast_exp2f((float)x) - e) / e;
+		if(err > max_exp2) max_exp2 = err;
+
+		// db_to_gain over -700dB to 700dB (relative error)
+		x = -700.0 + 1400.0 * k / 200000.0;
+		e = pow(10.0, (float)x / 20.0);
+		err = fabs(db_to_gain((float)x) - e) / e;
+		if(err > max_db2g) max_db2g = err;
+
+	}
+
+	print_line("max error\r\n");
+	snprintf(line, sizeof(line), "  fast_log2f  %.3g abs\r\n", max_log2); print_line(line);
+	snprintf(line, sizeof(line), "  fast_exp2f  %.3g rel\r\n", max_exp2); print_line(line);
+	snprintf(line, sizeof(line), "  gain_to_db  %.3g dB\r\n", max_g2db); print_line(line);
+	snprintf(line, sizeof(line), "  db_to_gain  %.3g rel\r\n", max_db2g); print_line(line);
+	snprintf(line, sizeof(line), "  fast_rsqrtf %.3g rel\r\n", max_rsqrt); print_line(line);
+
+
+	// SPEED ---------------------------------------------------------------------
+
+	print_line("time per value\r\n");
+
+	fill(1e-6, 1e6, 1);
+	report("log2", fast_log2_block, ref_log2);
+	report("gain_to_db", gain_to_db_block, ref_gain_to_db);
+	report("sqrt", fast_sqrt_block, ref_sqrt);
+	report("rsqrt", fast_rsqrt_block, ref_rsqrt);
+
+	fill(-60.0, 60.0, 0);
+	report("exp2", fast_exp2_block, ref_exp2);
+	report("db_to_gain", db_to_gain_block, ref_db_to_gain);
+
+	for(i = 0; i < N; i++) sink += out[i];
+
+#ifdef ARM_MATH_CM4
+	while(1);
+#endif
+
+	return 0;
+
+}
@@ -14,9 +14,10 @@
  * called after the HAL DMA recieve interrupt is completed, i.e. once the program receives the characters from the python gui. 
  * 
  * After all the variables and buffers needed for the program are declared, the FIR filter that lowpass filters the input guitar
- * signal is initialized using the arm cmsis dsp library routine. This filter is designed to cutoff at 10kHz to filter any 
+ * signal is initialized (see fir.c). This filter is designed to cutoff at 10kHz to filter any 
  * unwanted noise/harmonics before we do the dsp on the signal. The design was based on the frequency spectrum of an electric guitar
- * output, as the range goes out to around 10kHz.
+ * output, as the range goes out to around 10kHz. The float filters and band sums run on the cmsis dsp backend (see dsp.c), the 
+ * same effect code runs on the scalar, AVX2 or NEON backend in the host tests.
  * 
  * Then the selected effect is initialized with the appropriate inititialize function. These functions initialize the structures needed
  * for their corresponding calculation routines, that actually manipulate the signal to produce the corresponding guitar effect. Before
@@ -25,9 +26,54 @@
  * which completely distorts the output signal and produces garbage. The error checking makes sure that it doesn't use a delay value of 
  * more than 0.5 seconds.
  * 
- * The rest of the program is an infinite loop manipulating the input to produce the appropriate output effect. The input is first lowpass
- * filtered with the cutoff at 10kHz as previously mentioned, and then continues to call the calculate function corresponding to the 
- * previously called initialize function. 
+ * The selected effect is added as a node of an effect graph (see effect_graph.c), which can also hold a chain of effects or parallel
+ * branches that are mixed back together.
+ * 
+ * The rest of the program is an infinite loop manipulating the input to produce the appropriate output effect. Each block is converted
+ * straight out of the adc DMA buffer (see dma_io.c) into the lowpass filter's input history, lowpass filtered with the cutoff at 
+ * 10kHz as previously mentioned, and then runs through the effect graph. The filtered input and the effect output are converted 
+ * straight into the dac DMA buffer. 
+ * 
+ * The block size is picked from a table of latency profiles (see latency.c), from 8 samples processed straight from the adc 
+ * DMA interrupt up to 256 samples. The default is 100 samples, or the 8 sample profile when built with GAPE_LOW_LATENCY 
+ * (make LOW_LATENCY=1). When the chain runs in the interrupt, the interrupt only applies the effects' settings, and their 
+ * block rate control runs in the foreground loop, once for every block (see graph_defer_updates()). Pressing the user 
+ * button stops the adc/dac, moves to the next profile and plans everything again for its block size: the DMA buffers, 
+ * the filters (direct form or FFT, whichever is cheaper at that size) and the effect chain. 
+ * Each profile reports its I/O latency when it starts, and the cpu load and headroom after a second of running, so the 
+ * latency can be traded against the room left for the chain. Built with GAPE_PROFILE (make PROFILE=1), every stage of the 
+ * chain and every effect in the graph is timed with the cycle counter (see profiler.c), and the per stage times and load are
+ * reported along with the headroom. Every block is also checked against its deadline, the time the dac comes back around to
+ * its half (see deadline.c): missed deadlines, dropped blocks and a histogram of the response time are reported with the rest,
+ * and can be read at any time through deadline_stats(). The stages, the effects, the interrupts and profile changes are also 
+ * recorded in a trace ring (see trace.c), which is dumped over the uart as a Chrome trace the first time a deadline is missed. 
+ * The equalizer also comes in cheaper tiers with shorter filters; when blocks get close to their deadline the quality scheduler
+ * (see quality.c) steps it down a tier, crossfading to the new filter, and back up once there is room. Between songs, once 
+ * the input has been silent for longer than the lowpass and the effects ring on, the chain is skipped and silence is played
+ * until the next onset, which resets the chain and is processed as usual (see activity.c). Built with GAPE_FIXED (make FIXED=1)
+ * the adc samples are converted to Q15, lowpass filtered two taps at a time with the dual MAC, and the delay and equalizer
+ * run in Q15 (see fixed.c). The compressor stays float. Built with GAPE_MEASURE_LATENCY, the round trip latency is 
+ * measured through a jumper from PA5 (dac channel 2) to PA1 (adc) each time a profile starts and reported over the uart.
+ * 
+ * The chain runs at 32, 44.1, 48 or 96kHz (see latency_rates[]), 48kHz unless built with another rate (make RATE=32000).
+ * Holding the user button down for a second steps to the next rate instead of the next profile, and the load reported
+ * after a second shows what the rate costs. At 48kHz the lowpass is the table in fir_lowpass.h, at the other rates a 
+ * Kaiser lowpass with the same 10kHz passband and 12kHz stopband is designed at init. The eq filters keep their length in
+ * time, and the delay and the compressor's rms window are given in seconds, so the effects sound the same at every rate.
+ * A rate the longest delay doesn't fit in the arena at is skipped when running the delay.
+ * 
+ * The lowpass and the eq filters are planned by timing each fir kernel at the real length and block size (see fir_plan()).
+ * The plans are kept in the last flash sector and read back at startup, so a profile that has run before starts without
+ * timing anything. A new plan is written back before the adc/dac start, the sector erase takes a second or two.
+ * 
+ * All of the program and effect state is allocated from one static arena (see arena.c) with a fixed budget, ARENA_BUDGET.
+ * The effect state and fir state, which are read every sample, are allocated from the 64KB of core-coupled memory first, and
+ * only go to the sram arena once that is full. The adc/dac DMA buffers always come from sram. The lowpass coefficient
+ * table is const and stays in flash. The eq band filters are designed at init for the running sample rate (see design.c)
+ * into a static pool, and stay cached there across re-plans. The effect and its parameters are copied out of the gui
+ * struct, so both arenas can be reset every time the chain is planned again. Once the effect is set up, the bytes each
+ * part used are reported over the uart. If the selected effect doesn't fit, the report is still sent, saying what ran
+ * out, before the error led is lit.
  * 
  * The program never returns. If an error is caught, then an error led is lit up on the STM32F407-Discovery board and then remains
  * in an infinite loop.
@@ -45,144 +91,327 @@
 #include "ece486.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 
+#include "uart_rx.h"
+#include "arena.h"
+#include "dma_io.h"
+#include "fixed.h"
+#include "fir.h"
+#include "design.h"
+#include "latency.h"
+#include "profiler.h"
+#include "deadline.h"
+#include "trace.h"
+#include "quality.h"
+#include "activity.h"
 #include "delay.h"
 #include "calc_rms.h"
 #include "compressor.h"
 #include "eq.h"
 #include "read_effect.h"
-
-#include "fir_lowpass.h"
+#include "effect_graph.h"
+#include "effect_nodes.h"
 
 // ---------------------------------------------------------------------
 
 
 // DEFINES -------------------------------------------------------------
 
-#define FS 48000	// sampling frequency of 48kHz
+#define MAX_DELAY_MS 500	// longest delay the gui can ask for
+#define CCM_BYTES (64 * 1024)	// size of the core-coupled memory at CCMDATARAM_BASE
+#define RMS_WINDOW_MS 208		// compressor rms window, 10000 samples at 48kHz
+#define DEBOUNCE_MS 20			// user button bounce
+#define RATE_HOLD_MS 1000		// holding the user button this long steps the rate instead of the profile
+
+// fir plans are kept in the last 128KB flash sector, far past the end of the program. the linker script
+// comes with the toolchain and doesn't reserve it, so the program's end is checked before it is used
+#define WISDOM_FLASH_ADDR 0x080E0000
+#define WISDOM_FLASH_SECTOR FLASH_SECTOR_11
+#define WISDOM_BYTES (3 * sizeof(uint32_t) + FIR_WISDOM_SIZE * sizeof(FIR_WISDOM_T))
 
 // ---------------------------------------------------------------------
 
 
- 
+// the longest delay line is the biggest thing in the arena, catch a budget that can't hold it at compile time
+_Static_assert((MAX_DELAY_MS * 48000 / 1000) * sizeof(float) < ARENA_BUDGET, "ARENA_BUDGET can't hold the longest delay at 48kHz");
 
-int main(int argc, char const *argv[]) {
+// from the linker script: the initial values of .data are the last thing the program puts in flash
+extern uint32_t _sidata, _sdata, _edata;
 
-	// Set up system clock, adc, dac, etc
-	initialize(FS_48K, MONO_IN, STEREO_OUT); 
+// every buffer and effect struct is allocated out of this block, or out of the ccm
+static uint8_t arena_pool[ARENA_BUDGET] __attribute__((aligned(ARENA_ALIGN)));
+static ARENA_T arena;	// sram, DMA can reach it
+static ARENA_T ccm;		// core-coupled memory, cpu only, falls back to the sram arena
 
-	// GET EFFECT --------------------------------------------------------------------------------------
-	// set up buffers for reading the effect and params from gui
-	FX_T * F = init_effects_read();		// this call waits until PB3 is set, meaning there is a valid send of effect and params
-	if(F == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
-	// F->effect and F->effect_params are updated by the read effect call
-	read_effect(F);
-	// -------------------------------------------------------------------------------------------------
+// profiler stages of the chain, added in this order ahead of the effect nodes
+enum { STAGE_BLOCK, STAGE_LOWPASS, STAGE_DAC, NUM_STAGES };
+static const char * stage_names[NUM_STAGES] = { "block", "lowpass", "dac" };
 
-	// now start the adc and dac since we don't have to wait for an input anymore
-	init_dac(FS_48K, STEREO_OUT);
-	init_adc(FS_48K, MONO_IN);
-	init_uart();
+// time a stage of the chain with the profiler, and mark it in the trace
+#define STAGE_BEGIN(E, stage)	do { PROFILE_BEGIN((E)->profiler, (stage)); TRACE_BEGIN(stage_names[stage]); } while(0)
+#define STAGE_END(E, stage)		do { TRACE_END(stage_names[stage]); PROFILE_END((E)->profiler, (stage)); } while(0)
 
-	
-	// SELECTEFFECT ------------------------------------------------------------------------------------
 
-	/* effects format:
-	effect { effect, appropriate parameters for effect }
-	delay = { 1, time_delay, delay_gain }
-	compressor = { 2, threshold, ratio }
-	equalizer = { 3, lowband_gain, midband_gain, highband_gain } */
 
-	int effect = F->effect;
+/**
+ * @brief [state the processing chain needs, used by the loop or by the DMA interrupt in low latency mode]
+ * 
+ */
+typedef struct engine_struct {
+#ifdef GAPE_FIXED
+	FIR_Q15_T * lowpass;			// Q15 lowpass filter for the guitar signal, the input block is converted into its history
+	q15_t * filtered;				// lowpass output as Q15
+#else
+	FIR_T * lowpass;				// lowpass filter for the guitar signal, the input block is converted into its history
+#endif
+	int FS;							// sampling frequency the chain is planned for
+	int lowpass_taps;				// length of the lowpass at that rate
+	GRAPH_T * G;					// effect chain
+	LATENCY_T latency;				// latency and processing time of the profile
+	PROFILER_T * profiler;			// times each stage with GAPE_PROFILE, NULL otherwise
+	DEADLINE_T * deadline;			// how close each block comes to its deadline
+	TRACE_T * trace;				// recent events, dumped over the uart after a missed deadline
+	QUALITY_T * quality;			// steps the effects down to cheaper tiers when blocks get close to the deadline
+	ACTIVITY_T * activity;			// skips the chain through silence
+	int silent_halves;				// dac halves already holding silence while bypassed
+	int reported;					// the one second report has been sent
+	int dumped;						// the trace has been dumped
+	uint32_t updated;				// blocks the foreground has run the effects' block rate updates for
+	float * lpf_samples_output;		// lowpass filtered input, also the left output channel
+	float * effect_output;			// effect chain output, the right output channel
+} ENGINE_T;
+
+static ENGINE_T engine;
+
+
+/**
+ * @brief [process one block from an adc DMA half into the matching dac DMA half]
+ * 
+ * @param context [pointer to the engine struct]
+ * @param in [n raw adc samples]
+ * @param out [n dac words]
+ * @param n [number of samples]
+ */
+static void process_block(void * context, const uint16_t * in, uint32_t * out, int n) {
+
+	ENGINE_T * E = (ENGINE_T *)context;
+
+	latency_begin(&(E->latency));
+	STAGE_BEGIN(E, STAGE_BLOCK);
+
+	// the adc conversion is the lowpass's first pass: the DMA half that just filled is converted straight into
+	// the filter's own input history, which the filter then runs on without copying it
+	STAGE_BEGIN(E, STAGE_LOWPASS);
+#ifdef GAPE_FIXED
+	q15_t * input = fir_q15_input(E->lowpass);
+	adc_to_q15(in, input, n);
+#else
+	float * input = fir_input(E->lowpass, n);
+	adc_to_float(in, input, n);
+#endif
+
+	// through silence, once the tails have rung out, there is nothing to compute. once both dac halves
+	// hold silence there is nothing to write either
+#ifdef GAPE_FIXED
+	switch(activity_update_q15(E->activity, input, n)) {
+#else
+	switch(activity_update(E->activity, input, n)) {
+#endif
+		case ACTIVITY_BYPASS:
+			if(E->silent_halves < 2) {
+				dac_silence(out, n);
+				E->silent_halves++;
+			}
+			STAGE_END(E, STAGE_LOWPASS);
+			STAGE_END(E, STAGE_BLOCK);
+			latency_end(&(E->latency));
+			deadline_done(E->deadline);
+			return;
+		case ACTIVITY_RESUME:
+			// start from silence, like the chain had run on zeros the whole time. the reset clears
+			// the block in the lowpass history too, so it is converted again
+#ifdef GAPE_FIXED
+			reset_fir_q15(E->lowpass);
+			adc_to_q15(in, input, n);
+#else
+			reset_fir(E->lowpass);
+			input = fir_input(E->lowpass, n);
+			adc_to_float(in, input, n);
+#endif
+			reset_graph(E->G);
+			E->silent_halves = 0;
+			break;
+	}
+
+	// lowpass filter the input guitar signal
+#ifdef GAPE_FIXED
+	calc_fir_q15(E->lowpass, input, E->filtered, n);
+	q15_to_float(E->filtered, E->lpf_samples_output, n);
+#else
+	calc_fir(E->lowpass, input, E->lpf_samples_output, n);
+#endif
+	STAGE_END(E, STAGE_LOWPASS);
+
+	// CALCULATE EFFECTS ---------------------------------------------------------------------------------------------------
+	// run the effect chain on the filtered guitar signal, each node is timed and traced by the graph
+	run_graph(E->G, E->lpf_samples_output, E->effect_output);
+
+	// filtered input out the left channel, effect out the right, written straight into the dac DMA half
+	STAGE_BEGIN(E, STAGE_DAC);
+	float_to_dac_stereo(E->lpf_samples_output, E->effect_output, out, n);
+	STAGE_END(E, STAGE_DAC);
+
+	STAGE_END(E, STAGE_BLOCK);
+	latency_end(&(E->latency));
+
+	// step the effects with tiers down or up at the block boundary, the graph cuts down or crossfades up
+	if(quality_update(E->quality, E->latency.last)) graph_set_quality(E->G, E->quality->level);
+
+	// the dac half is written, check it made it before the dac comes back around
+	deadline_done(E->deadline);
+
+}
+
+ 
+
+/**
+ * @brief [check the selected effect fits at a sampling frequency]
+ * @details [only the delay line grows with the rate enough to matter, 0.5 seconds at 96kHz
+ * is more than the arena holds in float]
+ * 
+ * @param FS [sampling frequency]
+ * @param effect [1 = delay, 2 = compressor, 3 = equalizer]
+ * @return [1 if it fits, 0 if not]
+ */
+static int effect_fits(int FS, int effect) {
+
+#ifdef GAPE_FIXED
+	return (effect != 1) || ((MAX_DELAY_MS * FS / 1000) * sizeof(q15_t) < ARENA_BUDGET);
+#else
+	return (effect != 1) || ((MAX_DELAY_MS * FS / 1000) * sizeof(float) < ARENA_BUDGET);
+#endif
+
+}
+
+
+/**
+ * @brief [plan the whole chain for a block size and rate: DMA buffers, filters and the effect graph]
+ * @details [everything comes out of the arenas, which are reset first, so this can be called 
+ * again with another profile or rate once the adc/dac are stopped]
+ * 
+ * @param P [latency profile with the block size to plan for]
+ * @param FS [sampling frequency to plan for]
+ * @param effect [1 = delay, 2 = compressor, 3 = equalizer]
+ * @param fx_params [parameters for the effect from the gui]
+ * @return [pointer to the io struct, ready to start]
+ */
+static DMA_IO_T * plan_engine(const LATENCY_PROFILE_T * P, int FS, int effect, const int * fx_params) {
+
+	int block_size = P->block_size;
+	const float * lowpass_coefs;
 
 	// declare variables used for effects assigned in switch cases --------------
 	// cannot declare variables in switch case, so we declare all here
 	
+	// effect graph --------------
+	GRAPH_T * G;		// graph holding the effect chain
+	int node;			// node id of the last effect added to the chain
+	float params[3];	// parameters handed to the effect node
+
 	// switch delay --------------
-	DELAY_T * D; 	// delay struct
 	float delay, delay_gain; 
 
 	// switch compressor ---------
-	RMS_T * V; 		// rms struct
-	int window;
 	float threshold, ratio;
-	COMP_T * C;		// comp struct
 
 	// switch eq -----------------
-	EQ_T * Q;		// eq struct
 	float low_gain, mid_gain, high_gain;
 
 	// -------------------------------------------------------------------------------------------------
 
 
-	// initialize ---------------------------------------------------------------
-	int block_size, i;
+	// start over from empty arenas (resetting the ccm resets its sram fallback too),
+	// the interrupts can't be left recording into the old trace
+	trace_attach(NULL);
+	reset_arena(&ccm);
 
 
-	// get number of samples in each block (default of 100)
-	block_size = getblocksize();
+	// set up the adc/dac DMA buffers, which have to be in sram -------------------
+	engine.FS = FS;
+	DMA_IO_T * IO = init_dma_io(&arena, block_size, FS);
+	if(IO == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
 
-
-	// allocate memory for input and output buffers -----------------------------
-	float * input = (float *)malloc(sizeof(float) * block_size);
-	float * output1 = (float *)malloc(sizeof(float) * block_size);
-	float * lpf_samples_output = (float *)malloc(sizeof(float) * block_size);
-	if(input == NULL || output1 == NULL || lpf_samples_output == NULL) {
+	// allocate memory for the processing buffers ------------------------------
+	// DMA never touches these, so they go in the ccm
+	arena_set_tag(&ccm, "main");
+#ifdef GAPE_FIXED
+	engine.filtered = (q15_t *)arena_alloc(&ccm, sizeof(q15_t) * block_size);
+	if(engine.filtered == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
+#endif
+	engine.lpf_samples_output = (float *)arena_alloc(&ccm, sizeof(float) * block_size);
+	engine.effect_output = (float *)arena_alloc(&ccm, sizeof(float) * block_size);
+	if(engine.lpf_samples_output == NULL || engine.effect_output == NULL) {
 		flagerror(MEMORY_ALLOCATION_ERROR);
 		while(1);
 	} 
 
 
-	// initialize lowpass arm_fir filter to filter input guitar signal to 10K ---
-	// setup state variable array used by arm_fir routine
-	float * fir_state = (float *)malloc(sizeof(float) * (BL + block_size - 1));
-	if(fir_state == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
-	// initialize arm_fir struct
-	arm_fir_instance_f32 S;
-	// ceofs found in fir_lowpass.h
-	arm_fir_init_f32(&S, BL, &(B[0]), fir_state, block_size);	
+	// initialize lowpass fir filter to filter input guitar signal to 10K -------
+	// ceofs found in fir_lowpass.h at 48kHz, const in flash, designed at the other rates. fir state in the ccm
+	lowpass_coefs = design_input_lowpass(&ccm, FS, &(engine.lowpass_taps));
+	if(lowpass_coefs == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
+#ifdef GAPE_FIXED
+	engine.lowpass = init_fir_q15(&ccm, lowpass_coefs, engine.lowpass_taps, block_size);
+#else
+	engine.lowpass = init_fir(&ccm, lowpass_coefs, engine.lowpass_taps, block_size, FIR_PLAN);
+#endif
+	if(engine.lowpass == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
 	
 	
 
 	// INIT EFFECTS ----------------------------------------------------------------------------------------------------
+	// the selected effect is added to the effect graph, the processing loop just runs the graph.
+	// longer chains are more graph_add_effect() calls, each taking the previous node as input
+
+	G = init_graph(&ccm, block_size, FS);
+	if(G == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
 
 	switch(effect) {
 		case 1: // DELAY --------------------------------------------------------
 			
-			delay = F->effect_params[0];		// this is delay in seconds
-			if(delay > 0.5) { flagerror(DEBUG_ERROR); while(1); }		// don't delay more than half a second
-			delay_gain = F->effect_params[1];
+			delay = fx_params[0];		// this is delay in seconds
+			if(delay * 1000 > MAX_DELAY_MS) { flagerror(DEBUG_ERROR); while(1); }		// don't delay more than half a second
+			delay_gain = fx_params[1];
 			if(delay_gain > 1) { flagerror(DEBUG_ERROR); while(1); }	// limit output vol to input vol
 
-			// free struct now that we got the values we needed from it
-			free_fx(F);
-
-			// initialize delay structure for delay routine 
-			// D = init_delay(1, FS, delay, delay_gain, block_size);		// 1 means delay is in seconds
-			D = init_delay(1, FS, 0.5, 1, block_size);
-			if(D == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }	
+			// initialize delay node for delay routine { time_delay, delay_gain, input_toggle }
+			// params[0] = delay; params[1] = delay_gain;
+			params[0] = 0.5;
+			params[1] = 1;
+			params[2] = 0;	// 0 is just the delayed signal, the input goes out the other channel
+#ifdef GAPE_FIXED
+			node = graph_add_effect(G, &delay_q15_node, params, GRAPH_INPUT);
+#else
+			node = graph_add_effect(G, &delay_node, params, GRAPH_INPUT);
+#endif
 			
 			break;
 
  		case 2: // COMPRESSOR ---------------------------------------------------
 
-			// initialize rms detection -----------
- 			window = 100 * block_size;
-			V = init_rms(window, block_size);
-			if(V == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
-			
 			// initialize compressor --------------
-			threshold = F->effect_params[0];	// 0db entered is 1VRMS
+			threshold = fx_params[0];	// 0db entered is 1VRMS
 			if(threshold > 6) { flagerror(DEBUG_ERROR); while(1); } // limit threshold to the max rms voltage the board is capable of
-			ratio = F->effect_params[1];
+			ratio = fx_params[1];
 			if(ratio <= 0) { flagerror(DEBUG_ERROR); while(1); }	// limit ratio to positive value
 
-			// free struct now that we got the values we needed from it
-			free_fx(F);
-
-			C = init_compressor(threshold, ratio, block_size);
-			if(C == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
+			// compressor node { threshold, ratio, window }, the rms window is the same length of time at every rate
+			params[0] = threshold;
+			params[1] = ratio;
+			params[2] = RMS_WINDOW_MS / 1000.0f;
+			node = graph_add_effect(G, &compressor_node, params, GRAPH_INPUT);
 
 			break;
 
@@ -190,18 +419,23 @@ int main(int argc, char const *argv[]) {
 
 			// initialize eq
 			// limit the gain for each band to +-15dB
-			low_gain = F->effect_params[0];
+			low_gain = fx_params[0];
 			if(low_gain > 15 || low_gain < -15) { flagerror(DEBUG_ERROR); while(1); }
-			mid_gain = F->effect_params[1];
+			mid_gain = fx_params[1];
 			if(mid_gain > 15 || mid_gain < -15) { flagerror(DEBUG_ERROR); while(1); }
-			high_gain = F->effect_params[2];
+			high_gain = fx_params[2];
 			if(high_gain > 15 || high_gain < -15) { flagerror(DEBUG_ERROR); while(1); }
 
-			// free struct now that we got the values we needed from it
-			free_fx(F);
-
-			Q = init_eq(low_gain, mid_gain, high_gain, block_size, FS);
-			if(Q == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
+			// eq node { low, mid, high }
+			params[0] = low_gain;
+			params[1] = mid_gain;
+			params[2] = high_gain;
+#ifdef GAPE_FIXED
+			node = graph_add_effect(G, &eq_q15_node, params, GRAPH_INPUT);
+#else
+			// the shorter eq filters are there for the quality scheduler to fall back on
+			node = graph_add_tiers(G, eq_tiers, EQ_NUM_TIERS, params, EQ_TIER_FADE, GRAPH_INPUT);
+#endif
 
 			break;
 
@@ -212,68 +446,311 @@ int main(int argc, char const *argv[]) {
 			while(1);
 	}
 
-	// -----------------------------------------------------------------------------------------------------------------
+	// the last effect in the chain writes the output, plan the block buffers between the effects
+	if(node >= 0 && plan_graph(G, node)) node = -1;
+
+	// report the memory used by each effect against the budget, before giving up if it didn't fit
+	UART_putstr("ccm usage:\r\n");
+	report_arena(&ccm, UART_putstr);
+	UART_putstr("sram usage:\r\n");
+	report_arena(&arena, UART_putstr);
+	if(node < 0) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
+	engine.G = G;
+
+	// run from the DMA interrupt, the effects' block rate control is left to the foreground
+	graph_defer_updates(G, P->in_interrupt);
+
+	// time each stage of the chain, and each effect in the graph
+	engine.profiler = NULL;
+#ifdef GAPE_PROFILE
+	int i;
+	engine.profiler = init_profiler(&ccm, NUM_STAGES + GRAPH_MAX_NODES);
+	if(engine.profiler == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
+	for(i = 0; i < NUM_STAGES; i++) profile_add_stage(engine.profiler, stage_names[i]);
+	graph_set_profiler(G, engine.profiler);
+#endif
+
+	// watch every block's deadline from the time its adc half was filled
+	engine.deadline = init_deadline(&ccm, IO, block_size, FS);
+	if(engine.deadline == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
+
+	// record the last few hundred events, to see what happened around a missed deadline
+	engine.trace = init_trace(&ccm, TRACE_EVENTS);
+	if(engine.trace == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
+	trace_attach(engine.trace);
+	TRACE_INSTANT("profile", block_size);
+	// start at the best quality, for as many levels as the effect with the most tiers
+	engine.quality = init_quality(&ccm, G->num_levels, block_size, FS);
+	if(engine.quality == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
+
+	// the chain rings on for the lowpass and then the longest path through the effects
+	engine.activity = init_activity(&ccm, ACTIVITY_OPEN_DB, ACTIVITY_CLOSE_DB, (G->tail < 0) ? -1 : ((engine.lowpass_taps - 1) + G->tail));
+	if(engine.activity == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
+	engine.silent_halves = 0;
+
+	engine.reported = 0;
+	engine.dumped = 0;
+
+	// the lowpass delays the signal (M - 1) / 2 samples on top of the I/O buffers, and the effects
+	// (the eq's band filters) by the latency along the graph's path to the output
+	init_latency(&(engine.latency), P, FS, ((engine.lowpass_taps - 1) / 2) + G->latency);
+	engine.updated = 0;
+	report_latency(&(engine.latency), UART_putstr);
+	report_fir_wisdom(UART_putstr);
+	report_design(UART_putstr);
+
+	return IO;
+
+}
 
 
+/**
+ * @brief [run the effects' block rate updates once for every block the interrupt has finished]
+ * @details [only when the chain runs in the interrupt and the updates are left to the foreground.
+ * blocks the foreground fell behind on are caught up one update each, in order]
+ * 
+ * @param E [pointer to the engine struct]
+ */
+static void update_engine(ENGINE_T * E) {
 
-	// process input data stream, "block_size" samples at a time
-	while(1) {
+	if(!E->G->defer_updates) return;
 
-		// get input samples from adc
-		getblock(input);	// Wait here until the input buffer is filled... Then process	
-  
-    	// lowpass filter the input guitar signal
-    	arm_fir_f32(&S, input, lpf_samples_output, block_size);
+	while(E->updated != E->latency.blocks) {
+		E->updated++;
+		update_graph(E->G);
+	}
 
-    	// output the input samples
-		for (i = 0; i < block_size; i++) {
-			output1[i] = lpf_samples_output[i];
-		}
+}
 
 
-		// CALCULATE EFFECTS ---------------------------------------------------------------------------------------------------
+// UART_putstr for the reports, catching the updates up before every line: a line blocks until
+// the uart has sent it, so a report holds the effects' settings back for a line at most, not the
+// seconds the whole trace takes
+static void monitor_print(const char * s) {
+	update_engine(&engine);
+	UART_putstr(s);
+}
 
-		switch(effect) {
-			case 1: // DELAY -----------------------------------------------------------------
-				// delay the guitar signal by D->sample_delay samples
-				calc_delay(0, D, lpf_samples_output);	// 1 is to add delay to input signal
 
-				// pass buffers for output to the dac
-				putblockstereo(output1, D->output);
-				
-				break;
+/**
+ * @brief [foreground checks between blocks]
+ * @details [after a second of blocks the cpu load, headroom, stage times and deadlines are reported 
+ * once. the first missed deadline freezes the trace and dumps it over the uart as a Chrome trace,
+ * the dump takes seconds and the audio stops while it goes out unless the chain runs in the
+ * interrupt. the effects' updates are caught up between the lines (see monitor_print())]
+ * 
+ * @param E [pointer to the engine struct]
+ * @param P [latency profile the engine is running]
+ */
+static void monitor_engine(ENGINE_T * E, const LATENCY_PROFILE_T * P) {
+
+	if(!E->reported && E->latency.blocks >= (E->FS / P->block_size)) {
+		report_latency(&(E->latency), monitor_print);
+		if(E->profiler != NULL) report_profiler(E->profiler, monitor_print);
+		report_deadline(E->deadline, monitor_print);
+		report_quality(E->quality, monitor_print);
+		report_activity(E->activity, monitor_print);
+		report_graph_tiers(E->G, monitor_print);
+		E->reported = 1;
+	}
 
-	 		case 2:	// COMPRESSOR ------------------------------------------------------------
-				// detect RMS level
-				calc_rms(V, lpf_samples_output);
+	if(!E->dumped && E->deadline->missed > 0) {
+		trace_freeze(E->trace, 1);
+		monitor_print("trace:\r\n");
+		trace_export_json(E->trace, monitor_print);
+		trace_freeze(E->trace, 0);
+		E->dumped = 1;
+	}
 
-				// compress
-				calc_compressor(C, V->output, lpf_samples_output);
+}
 
-				// pass buffers for output to the dac
-				putblockstereo(output1, C->output);
 
-				break;
+/**
+ * @brief [check for a new press of the user button]
+ * 
+ * @return [1 on the first call after the button goes down, 0 otherwise]
+ */
+static int profile_button(void) {
+
+	static int last = 0;
+	int state = BSP_PB_GetState(BUTTON_KEY);
+	int pressed = (state && !last);
+
+	last = state;
+	return pressed;
+
+}
 
-			case 3:	// EQ --------------------------------------------------------------------
-				// adjust freq bands with equalizer
-				calc_eq(Q->D1, Q->D2, Q->D3, Q, lpf_samples_output);
 
-				// pass buffers for output to the dac
-				putblockstereo(output1, Q->output);
+/**
+ * @brief [whether the wisdom sector is past the end of the program in flash]
+ * 
+ * @return [1 if it is free, 0 if the program has grown into it]
+ */
+static int wisdom_sector_free(void) {
+
+	uint32_t end = (uint32_t)&_sidata + ((uint32_t)&_edata - (uint32_t)&_sdata);
 
-				break;
+	return end <= WISDOM_FLASH_ADDR;
 
-			default:
+}
 
-				// invalid effect input
-				flagerror(DEBUG_ERROR);	// turn on error led
-				while(1);
+
+/**
+ * @brief [write the fir plans to flash if there are new ones]
+ * @details [only when the adc and dac are stopped, the cpu stalls on flash while it erases.
+ * never once the program reaches into the sector, the erase would take the program with it]
+ * 
+ */
+static void save_wisdom(void) {
+
+	static uint32_t buf[WISDOM_BYTES / sizeof(uint32_t)];
+	int i, bytes;
+	uint32_t sector_error;
+	FLASH_EraseInitTypeDef erase;
+
+	if(!wisdom_sector_free()) return;
+	bytes = fir_export_wisdom(buf, sizeof(buf));
+	if(bytes == 0 || memcmp(buf, (const void *)WISDOM_FLASH_ADDR, bytes) == 0) return;
+
+	erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+	erase.Sector = WISDOM_FLASH_SECTOR;
+	erase.NbSectors = 1;
+	erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+	HAL_FLASH_Unlock();
+	if(HAL_FLASHEx_Erase(&erase, &sector_error) == HAL_OK) {
+		for(i = 0; i < bytes / (int)sizeof(uint32_t); i++) {
+			HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, WISDOM_FLASH_ADDR + (i * sizeof(uint32_t)), buf[i]);
 		}
+	}
+	HAL_FLASH_Lock();
+
+}
+
+
+int main(int argc, char const *argv[]) {
+
+	// Set up the hal and the system clock. not initialize(), the adc and dac are dma_io's (see dma_io.c)
+	init_dma_io_clocks();
 
-		// ---------------------------------------------------------------------------------------------------------------------
+	// all state below comes out of the arenas
+	// nothing is linked into the ccm, so the arena gets all of it (its clock is on out of reset)
+	init_arena(&arena, arena_pool, sizeof(arena_pool));
+	init_arena(&ccm, (void *)CCMDATARAM_BASE, CCM_BYTES);
+	arena_set_fallback(&ccm, &arena);
+
+	// GET EFFECT --------------------------------------------------------------------------------------
+	// set up buffers for reading the effect and params from gui
+	FX_T * F = init_effects_read(&arena);	// this call waits until PB3 is set, meaning there is a valid send of effect and params
+	if(F == NULL) { flagerror(MEMORY_ALLOCATION_ERROR); while(1); }
+	// F->effect and F->effect_params are updated by the read effect call
+	read_effect(F);
 
+	/* effects format:
+	effect { effect, appropriate parameters for effect }
+	delay = { 1, time_delay, delay_gain }
+	compressor = { 2, threshold, ratio }
+	equalizer = { 3, lowband_gain, midband_gain, highband_gain } */
+
+	// F lives in the arena, which is reset every time the chain is planned
+	int effect = F->effect;
+	int fx_params[3] = { F->effect_params[0], F->effect_params[1], F->effect_params[2] };
+	// -------------------------------------------------------------------------------------------------
+
+	// the adc and dac are set up for each profile (see dma_io.c), and started right before processing
+	init_uart();
+
+	// the user button steps through the latency profiles
+	BSP_PB_Init(BUTTON_KEY, BUTTON_MODE_GPIO);
+
+	// fir plans from earlier boots, erased flash is ignored
+	if(wisdom_sector_free()) fir_import_wisdom((const void *)WISDOM_FLASH_ADDR, WISDOM_BYTES);
+
+
+	// pick the profile to start in: a tiny block processed in the DMA interrupt, or getblocksize() samples (100)
+#ifdef GAPE_LOW_LATENCY
+	int profile = LATENCY_LOW_PROFILE;
+#else
+	int profile = LATENCY_DEFAULT_PROFILE;
+#endif
+
+	// and the rate, 48kHz or the one built with, moving up past any the effect doesn't fit at
+	int i, rate = LATENCY_DEFAULT_RATE;
+#ifdef GAPE_FS
+	for(i = 0; i < LATENCY_NUM_RATES; i++) if(latency_rates[i] == GAPE_FS) rate = i;
+#endif
+	for(i = 0; i < LATENCY_NUM_RATES && !effect_fits(latency_rates[rate], effect); i++) rate = (rate + 1) % LATENCY_NUM_RATES;
+
+	const LATENCY_PROFILE_T * P;
+	DMA_IO_T * IO;
+	uint32_t pressed;
+
+	while(1) {
+
+		// plan everything for this profile's block size and the rate, then start the adc and dac
+		P = &(latency_profiles[profile]);
+		IO = plan_engine(P, latency_rates[rate], effect, fx_params);
+		save_wisdom();
+		start_dma_io(IO);
+
+#ifdef GAPE_MEASURE_LATENCY
+		// round trip through the PA5 -> PA1 jumper, the lowpass adds its (M - 1) / 2 samples of delay on top
+		// and the effects their latency along the graph
+		char line[96];
+		int latency = dma_io_measure_latency(IO, 1000);
+		snprintf(line, sizeof(line), "block %d: round trip %d samples (%d us) + %d lowpass + %d effects\r\n", 
+			P->block_size, latency, (latency * 1000000) / engine.FS, (engine.lowpass_taps - 1) / 2, engine.G->latency);
+		UART_putstr(line);
+#endif
+
+		if(P->in_interrupt) {
+
+			// the chain runs in the adc DMA interrupt from here on
+			dma_io_set_process(IO, process_block, &engine);
+
+			// block rate work (analysis, parameter updates) goes here, the interrupt preempts it every block.
+			// the interrupt only applies the effects' settings, their updates run here once per block
+			engine.updated = engine.latency.blocks;
+			while(!profile_button()) {
+				update_engine(&engine);
+				monitor_engine(&engine, P);
+			}
+
+		} else {
+
+			// process input data stream, "block_size" samples at a time
+			while(!profile_button()) {
+
+				// Wait here until the input half is filled... Then process into the matching output half
+				process_block(&engine, dma_io_input(IO), dma_io_output(IO), P->block_size);
+
+				monitor_engine(&engine, P);
+
+			}
+
+		}
+
+		// on to the next profile, or the next rate if the button is held, the arenas are reset when it is planned
+		stop_dma_io(IO);
+		pressed = HAL_GetTick();
+
+		// wait out the bounce, so letting go doesn't count as another press
+		HAL_Delay(DEBOUNCE_MS);
+		while(BSP_PB_GetState(BUTTON_KEY));
+		HAL_Delay(DEBOUNCE_MS);
+		profile_button();
+
+		if((HAL_GetTick() - pressed) >= RATE_HOLD_MS) {
+			do {
+				rate = (rate + 1) % LATENCY_NUM_RATES;
+			} while(!effect_fits(latency_rates[rate], effect));
+			// the filters designed for the old rate aren't needed again
+			design_forget();
+		} else {
+			profile = (profile + 1) % LATENCY_NUM_PROFILES;
+		}
 
 	}
 
-}
\ No newline at end of file
+}
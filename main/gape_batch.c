@@ -0,0 +1,129 @@
+/**
+ * @file gape_batch.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to render the gui presets over a set of recordings on
+ * every core of a host.
+ *
+ * @details [
+ * gape_batch [-j workers] [-p presets] [-o dir] [-S summary] [-r rate] [-b block] [-f format] [-d backend] in.wav ...
+ *
+ * 		-j workers	threads, one per online cpu by default
+ * 		-p presets	comma separated preset numbers, 1 to 11 (see render_presets[]), all of them by default
+ * 		-o dir		where the outputs go, <dir>/<input name>_pNN.wav, the current directory by default
+ * 		-S summary	csv of every job and its timing, <dir>/batch_summary.csv by default
+ * 		-r, -b, -f, -d	as for gape_render
+ *
+ * every preset is rendered over every file (see batch.c). the totals, the speedup over one worker
+ * and what each worker did are printed, and it exits with 1 if any job failed]
+ *
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "arena.h"
+#include "dsp.h"
+#include "wav.h"
+#include "render.h"
+#include "batch.h"
+
+// ---------------------------------------------------------------------
+
+
+
+static uint8_t pool[RENDER_ARENA_BYTES] __attribute__((aligned(ARENA_ALIGN)));
+static ARENA_T arena;
+
+static void print_line(const char * s) { fputs(s, stdout); }
+
+
+static void usage(void) {
+	fprintf(stderr, "usage: gape_batch [-j workers] [-p 1,2,...] [-o dir] [-S summary.csv] [-r rate] [-b block] [-f 16|24|32|float] [-d backend] in.wav ...\n");
+	exit(2);
+}
+
+
+int main(int argc, char * argv[]) {
+
+	int c, i, failed, format;
+	int num_workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	int presets[RENDER_NUM_PRESETS];
+	int num_presets = 0;
+	char summary[BATCH_PATH];
+	const char * summary_path = NULL;
+	const char * out_dir = ".";
+	const char * backend = NULL;
+	char * p;
+	RENDER_OPTS_T opts = { 0, 0, 0, -1, 0 };
+	BATCH_T * B;
+
+	while((c = getopt(argc, argv, "+j:p:o:S:r:b:f:d:")) != -1) {
+		switch(c) {
+			case 'j': num_workers = atoi(optarg); break;
+			case 'o': out_dir = optarg; break;
+			case 'S': summary_path = optarg; break;
+			case 'r': opts.FS = atoi(optarg); break;
+			case 'b': opts.block_size = atoi(optarg); break;
+			case 'd': backend = optarg; break;
+			case 'p':
+				for(p = optarg; *p != '\0' && num_presets < RENDER_NUM_PRESETS; p += (*p == ',')) {
+					presets[num_presets++] = (int)strtol(p, &p, 10);
+					if(*p != ',' && *p != '\0') usage();
+				}
+				break;
+			case 'f':
+				for(format = 0; format < WAV_NUM_FORMATS; format++) {
+					if(strncmp(optarg, wav_format_names[format], strlen(optarg)) == 0) break;
+				}
+				if(format == WAV_NUM_FORMATS) usage();
+				opts.format = format;
+				break;
+			default: usage();
+		}
+	}
+	if(optind >= argc) usage();
+
+	// all the presets unless asked for some
+	if(num_presets == 0) {
+		for(i = 0; i < RENDER_NUM_PRESETS; i++) presets[num_presets++] = render_presets[i].number;
+	}
+	if(num_workers < 1) num_workers = 1;
+	if(num_workers > BATCH_MAX_WORKERS) num_workers = BATCH_MAX_WORKERS;
+
+	if(dsp_select(backend) != 0) {
+		fprintf(stderr, "gape_batch: no %s backend on this cpu\n", backend);
+		return 1;
+	}
+
+	init_arena(&arena, pool, sizeof(pool));
+	B = init_batch(&arena, (const char * const *)(argv + optind), argc - optind, presets, num_presets, out_dir, num_workers, &opts);
+	if(B == NULL) {
+		fprintf(stderr, "gape_batch: couldn't set up the batch, check the preset numbers and the output directory name\n");
+		return 1;
+	}
+
+	printf("%d presets x %d files on %d workers, %s\n", num_presets, argc - optind, num_workers, dsp->name);
+	failed = run_batch(B);
+	report_batch(B, print_line);
+
+	if(summary_path == NULL) {
+		snprintf(summary, sizeof(summary), "%s/batch_summary.csv", out_dir);
+		summary_path = summary;
+	}
+	if(write_batch_summary(B, summary_path) != 0) fprintf(stderr, "gape_batch: can't write %s\n", summary_path);
+	else printf("summary in %s\n", summary_path);
+
+	for(i = 0; i < B->num_jobs; i++) {
+		if(B->jobs[i].failed) fprintf(stderr, "gape_batch: %s with preset %d failed\n", B->jobs[i].input, render_presets[B->jobs[i].preset].number);
+	}
+	close_batch(B);
+
+	return (failed > 0);
+
+}
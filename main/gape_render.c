@@ -0,0 +1,126 @@
+/**
+ * @file gape_render.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to render a WAV file through a GAPE effect chain on a host.
+ *
+ * @details [
+ * gape_render [-r rate] [-o rate] [-b block] [-f format] [-s] [-d backend] in.wav out.wav effect ...
+ *
+ * 		-r rate		rate the chain runs at, 48000 by default (32000, 44100, 48000 or 96000 like the board)
+ * 		-o rate		rate of the output, the input's by default
+ * 		-b block	samples the chain runs on at once, RENDER_BLOCK by default
+ * 		-f format	16, 24, 32 or float, the input's by default
+ * 		-s			stereo out like the dac: lowpass filtered input left, effect right
+ * 		-d backend	dsp backend (scalar, avx2, neon), the fastest by default
+ *
+ * each effect is name:p0,p1,p2 with the parameters effect_nodes.h gives for it, in the order they
+ * run, e.g. eq:3,0,-3 delay:0.3,0.4,1. parameters left off take the defaults in render.c, and
+ * preset:N is gui preset N (see render_presets[]).
+ * the input is read as it is rendered and nothing is held in memory, so session recordings of any
+ * length render in the same few megabytes. the time it took and the real-time factor are printed]
+ *
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "arena.h"
+#include "dsp.h"
+#include "wav.h"
+#include "render.h"
+
+// ---------------------------------------------------------------------
+
+
+
+static uint8_t pool[RENDER_ARENA_BYTES] __attribute__((aligned(ARENA_ALIGN)));
+static ARENA_T arena;
+
+static void print_line(const char * s) { fputs(s, stdout); }
+
+
+static void usage(void) {
+	fprintf(stderr, "usage: gape_render [-r rate] [-o rate] [-b block] [-f 16|24|32|float] [-s] [-d backend] in.wav out.wav effect[:p0,p1,p2] ...\n");
+	exit(2);
+}
+
+
+int main(int argc, char * argv[]) {
+
+	int c, i, num_fx, format;
+	const char * backend = NULL;
+	RENDER_OPTS_T opts = { 0, 0, 0, -1, 0 };
+	RENDER_FX_T chain[RENDER_MAX_EFFECTS];
+	WAV_T in, out;
+	RENDER_T * R;
+
+	while((c = getopt(argc, argv, "+r:o:b:f:sd:")) != -1) {
+		switch(c) {
+			case 'r': opts.FS = atoi(optarg); break;
+			case 'o': opts.out_rate = atoi(optarg); break;
+			case 'b': opts.block_size = atoi(optarg); break;
+			case 's': opts.stereo = 1; break;
+			case 'd': backend = optarg; break;
+			case 'f':
+				for(format = 0; format < WAV_NUM_FORMATS; format++) {
+					if(strncmp(optarg, wav_format_names[format], strlen(optarg)) == 0) break;
+				}
+				if(format == WAV_NUM_FORMATS) usage();
+				opts.format = format;
+				break;
+			default: usage();
+		}
+	}
+	if(argc - optind < 3 || argc - optind - 2 > RENDER_MAX_EFFECTS) usage();
+
+	num_fx = argc - optind - 2;
+	for(i = 0; i < num_fx; i++) {
+		if(render_parse_effect(argv[optind + 2 + i], &chain[i]) != 0) {
+			fprintf(stderr, "gape_render: don't know the effect %s\n", argv[optind + 2 + i]);
+			return 1;
+		}
+	}
+
+	if(dsp_select(backend) != 0) {
+		fprintf(stderr, "gape_render: no %s backend on this cpu\n", backend);
+		return 1;
+	}
+
+	init_arena(&arena, pool, sizeof(pool));
+
+	if(open_wav(&in, argv[optind]) != 0) {
+		fprintf(stderr, "gape_render: can't read %s as a WAV file\n", argv[optind]);
+		return 1;
+	}
+
+	R = init_render(&arena, &in, chain, num_fx, &opts);
+	if(R == NULL) {
+		fprintf(stderr, "gape_render: the chain didn't initialize, check the rates and the effect parameters\n");
+		report_arena(&arena, print_line);
+		return 1;
+	}
+
+	format = (opts.format < 0) ? in.format : opts.format;
+	if(create_wav(&out, &arena, argv[optind + 1], R->out_rate, R->stereo ? 2 : 1, format) != 0) {
+		fprintf(stderr, "gape_render: can't write %s\n", argv[optind + 1]);
+		return 1;
+	}
+
+	printf("%s: %lld frames, %s, %d channels, on %s\n", argv[optind], (long long)in.frames, wav_format_names[in.format], in.channels, dsp->name);
+	if(run_render(R, &out) != 0 || close_wav(&out) != 0) {
+		fprintf(stderr, "gape_render: writing %s failed\n", argv[optind + 1]);
+		return 1;
+	}
+	close_wav(&in);
+
+	report_render(R, print_line);
+
+	return 0;
+
+}
@@ -0,0 +1,160 @@
+/**
+ * @file gape_rt.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to run a GAPE effect chain in real time on a Linux host.
+ *
+ * @details [
+ * gape_rt [-r rate] [-b block] [-q blocks] [-p priority] [-c io,dsp] [-t seconds] [-x] [-s] [-f format] [-d backend] source sink effect ...
+ *
+ * 		-r rate		rate of a pipe or null source, 48000 by default. a file runs at its own
+ * 		-b block	samples in a block, RT_BLOCK by default
+ * 		-q blocks	blocks queued ahead of the sink, the latency, RT_PREFILL by default
+ * 		-p priority	SCHED_FIFO priority of the dsp thread, the io thread runs one above, RT_PRIORITY by default, 0 for none
+ * 		-c io,dsp	cpus to pin the io and dsp threads to, not pinned by default
+ * 		-t seconds	stop after this much input, at the end of the source or on ctrl-c by default
+ * 		-x			freewheel, as fast as the chain runs with no clock, for files
+ * 		-s			stereo out like the dac: lowpass filtered input left, effect right
+ * 		-f format	16, 24, 32 or float for a file sink, the source file's or float by default
+ * 		-d backend	dsp backend (scalar, avx2, neon), the fastest by default
+ *
+ * source and sink are backend:path, file:take.wav (or just take.wav), pipe:- for stdin or stdout,
+ * pipe:path for a fifo, or null. pipes carry raw interleaved native floats, a pipe source is mono
+ * unless -s. the effects are the same as for gape_render. e.g.
+ *
+ * 		arecord -f FLOAT_LE -r 48000 | gape_rt pipe:- pipe:- preset:1 | aplay -f FLOAT_LE -r 48000
+ * 		gape_rt -t 60 null null eq:3,0,-3 delay:0.3,0.4,1		a minute of the chain's timing and xruns
+ *
+ * the setup that was granted, the xruns, the dsp time and the latency are printed on stderr, so
+ * they stay out of a pipe on stdout. it exits with 1 if the source or sink failed]
+ *
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include "arena.h"
+#include "dsp.h"
+#include "wav.h"
+#include "render.h"
+#include "rt_io.h"
+#include "rt.h"
+
+// ---------------------------------------------------------------------
+
+
+
+static uint8_t pool[RENDER_ARENA_BYTES] __attribute__((aligned(ARENA_ALIGN)));
+static ARENA_T arena;
+
+static RT_T * volatile engine = NULL;
+
+static void print_line(const char * s) { fputs(s, stderr); }
+
+static void on_signal(int sig) { if(engine != NULL) rt_stop(engine); }
+
+
+static void usage(void) {
+	fprintf(stderr, "usage: gape_rt [-r rate] [-b block] [-q blocks] [-p priority] [-c io,dsp] [-t seconds] [-x] [-s] [-f 16|24|32|float] [-d backend] source sink effect[:p0,p1,p2] ...\n");
+	exit(2);
+}
+
+
+int main(int argc, char * argv[]) {
+
+	int c, i, num_fx, failed;
+	int FS = RENDER_FS;
+	int stereo = 0;
+	int format = -1;
+	const char * backend = NULL;
+	char * p;
+	RT_OPTS_T opts = { 0, 0, RT_PRIORITY, -1, -1, 0, 0 };
+	RENDER_FX_T chain[RENDER_MAX_EFFECTS];
+	RT_IO_T * source;
+	RT_IO_T * sink;
+	RT_T * R;
+
+	while((c = getopt(argc, argv, "+r:b:q:p:c:t:xsf:d:")) != -1) {
+		switch(c) {
+			case 'r': FS = atoi(optarg); break;
+			case 'b': opts.block_size = atoi(optarg); break;
+			case 'q': opts.prefill = atoi(optarg); break;
+			case 'p': opts.priority = atoi(optarg); break;
+			case 't': opts.seconds = atof(optarg); break;
+			case 'x': opts.freewheel = 1; break;
+			case 's': stereo = 1; break;
+			case 'd': backend = optarg; break;
+			case 'c':
+				opts.io_cpu = (int)strtol(optarg, &p, 10);
+				if(*p != ',') usage();
+				opts.dsp_cpu = (int)strtol(p + 1, &p, 10);
+				if(*p != '\0') usage();
+				break;
+			case 'f':
+				for(format = 0; format < WAV_NUM_FORMATS; format++) {
+					if(strncmp(optarg, wav_format_names[format], strlen(optarg)) == 0) break;
+				}
+				if(format == WAV_NUM_FORMATS) usage();
+				break;
+			default: usage();
+		}
+	}
+	if(argc - optind < 3 || argc - optind - 2 > RENDER_MAX_EFFECTS) usage();
+
+	num_fx = argc - optind - 2;
+	for(i = 0; i < num_fx; i++) {
+		if(render_parse_effect(argv[optind + 2 + i], &chain[i]) != 0) {
+			fprintf(stderr, "gape_rt: don't know the effect %s\n", argv[optind + 2 + i]);
+			return 1;
+		}
+	}
+
+	if(dsp_select(backend) != 0) {
+		fprintf(stderr, "gape_rt: no %s backend on this cpu\n", backend);
+		return 1;
+	}
+
+	init_arena(&arena, pool, sizeof(pool));
+	if(opts.block_size <= 0) opts.block_size = RT_BLOCK;
+
+	// the sink runs at the source's rate, a file source sets it
+	source = init_rt_io(&arena, argv[optind], 0, FS, stereo ? 2 : 1, WAV_FLOAT32, opts.block_size);
+	if(source == NULL) {
+		fprintf(stderr, "gape_rt: can't open %s as a source\n", argv[optind]);
+		return 1;
+	}
+	if(format < 0) format = (source->ops == &rt_io_file) ? source->wav.format : WAV_FLOAT32;
+	sink = init_rt_io(&arena, argv[optind + 1], 1, source->FS, stereo ? 2 : 1, format, opts.block_size);
+	if(sink == NULL) {
+		fprintf(stderr, "gape_rt: can't open %s as a sink\n", argv[optind + 1]);
+		return 1;
+	}
+
+	R = init_rt(&arena, source, sink, chain, num_fx, &opts);
+	if(R == NULL) {
+		fprintf(stderr, "gape_rt: the chain didn't initialize, check the rate, the block size and the effect parameters\n");
+		report_arena(&arena, print_line);
+		return 1;
+	}
+
+	engine = R;
+	signal(SIGINT, on_signal);
+	signal(SIGTERM, on_signal);
+	signal(SIGPIPE, SIG_IGN);		// a sink that goes away is a failed write, not the end of the program
+
+	failed = run_rt(R);
+	failed |= close_rt_io(source);
+	failed |= close_rt_io(sink);
+
+	report_rt(R, print_line);
+	if(failed) fprintf(stderr, "gape_rt: %s or %s failed\n", argv[optind], argv[optind + 1]);
+
+	return failed;
+
+}
@@ -0,0 +1,119 @@
+/**
+ * @file test_activity.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test that bypassing the chain through silence
+ * gives the same output as running it the whole time.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "arena.h"
+#include "effect_graph.h"
+#include "effect_nodes.h"
+#include "activity.h"
+
+// ---------------------------------------------------------------------
+
+#define BLOCK 64
+#define FS 48000
+#define BURST 20		// blocks of noise at the start and after the silence
+#define SILENCE 100		// blocks of silence in between, well past the tail
+#define HUM_BLOCKS 10	// blocks at the end of the silence with a hum between the close and open levels
+#define HUM 0.003f
+
+
+
+static uint8_t pool[ARENA_BUDGET];
+static ARENA_T arena;
+
+static void print_line(const char * s) { fputs(s, stdout); }
+
+
+// eq into a 10ms echo
+static GRAPH_T * make_chain(void) {
+	float eq[3] = {6, -3, 3};
+	float echo[3] = {0.01, 0.5, 1};
+	GRAPH_T * G = init_graph(&arena, BLOCK, FS);
+	int n;
+	if(G == NULL) return NULL;
+	n = graph_add_effect(G, &eq_node, eq, GRAPH_INPUT);
+	n = graph_add_effect(G, &delay_node, echo, n);
+	if(n < 0 || plan_graph(G, n)) return NULL;
+	return G;
+}
+
+
+int main(int argc, char const *argv[]) {
+
+	int b, i, first_bypass = -1;
+	int failed = 0;
+	float input[BLOCK], ref[BLOCK], out[BLOCK];
+	double err = 0, err_silence = 0;
+	GRAPH_T * R;
+	GRAPH_T * G;
+	ACTIVITY_T * X;
+
+	init_arena(&arena, pool, sizeof(pool));
+	srand(1);
+
+	// one chain runs on every block, the other only when the detector says to
+	R = make_chain();
+	G = make_chain();
+	if(R == NULL || G == NULL) { printf("could not initialize\n"); return 1; }
+	X = init_activity(&arena, ACTIVITY_OPEN_DB, ACTIVITY_CLOSE_DB, G->tail);
+	if(X == NULL) { printf("could not initialize\n"); return 1; }
+	printf("tail %d samples (eq %d + echo %d)\n", G->tail, (3 * 300) / 2, FS / 100);
+	if(G->tail != ((3 * 300) / 2) + (FS / 100)) failed = 1;
+
+
+	// noise, silence, then a little hum under the onset level, then noise again
+	for(b = 0; b < 2 * BURST + SILENCE; b++) {
+
+		for(i = 0; i < BLOCK; i++) {
+			if(b < BURST || b >= BURST + SILENCE) input[i] = ((float)rand() / RAND_MAX) - 0.5f;
+			else if(b >= BURST + SILENCE - HUM_BLOCKS) input[i] = (i & 1) ? HUM : -HUM;
+			else input[i] = 0.0f;
+		}
+
+		run_graph(R, input, ref);
+
+		switch(activity_update(X, input, BLOCK)) {
+			case ACTIVITY_BYPASS:
+				if(first_bypass < 0) first_bypass = b;
+				for(i = 0; i < BLOCK; i++) out[i] = 0.0f;
+				break;
+			case ACTIVITY_RESUME:
+				reset_graph(G);
+				// fall through
+			default:
+				run_graph(G, input, out);
+		}
+
+		for(i = 0; i < BLOCK; i++) err = fmax(err, fabs(ref[i] - out[i]));
+		if(b < BURST + SILENCE - HUM_BLOCKS) err_silence = err;
+
+	}
+
+	report_activity(X, print_line);
+	printf("first bypassed block %d, max difference %g before the hum, %g after\n", first_bypass, err_silence, err);
+
+	// the first block bypassed starts a whole tail after the burst ended
+	if(first_bypass != BURST + (G->tail + BLOCK - 1) / BLOCK) failed = 1;
+	// the hum under the onset level stays bypassed, the noise comes back
+	if(X->onsets != 1 || !X->active) failed = 1;
+	// bypassing through true silence only drops the rounding left in the FFT frames and the band
+	// subtraction, -80dB or less. the hum only goes through the reference chain
+	if(err_silence > 1e-4 || err > 4 * HUM) failed = 1;
+
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
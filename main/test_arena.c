@@ -0,0 +1,101 @@
+/**
+ * @file test_arena.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the arena allocator: alignment, zeroing,
+ * the budget, release to a mark, the per owner accounting and falling back to a second arena.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "arena.h"
+
+// ---------------------------------------------------------------------
+
+
+static uint8_t pool[1024];
+static ARENA_T arena;
+
+static uint8_t small_pool[64];
+static ARENA_T small;
+
+static void print_line(const char * line) { fputs(line, stdout); }
+
+
+
+
+int main(int argc, char const *argv[]) {
+
+	int i;
+	int failed = 0;
+	size_t mark;
+	float * a;
+	float * b;
+	uint8_t * c;
+
+	// fill the pool with garbage, allocations have to come back zeroed anyway
+	memset(pool, 0xAA, sizeof(pool));
+	init_arena(&arena, pool, sizeof(pool));
+
+
+	// alignment and zeroing
+	arena_set_tag(&arena, "first");
+	c = (uint8_t *)arena_alloc(&arena, 3);
+	a = (float *)arena_alloc(&arena, sizeof(float) * 10);
+	b = (float *)arena_alloc_aligned(&arena, sizeof(float) * 10, 32);
+	if(((uintptr_t)a % ARENA_ALIGN) != 0 || ((uintptr_t)b % 32) != 0) failed = 1;
+	for(i = 0; i < 3; i++) if(c[i] != 0) failed = 1;
+	for(i = 0; i < 10; i++) if(a[i] != 0.0 || b[i] != 0.0) failed = 1;
+
+	// every byte so far, padding included, is charged to "first"
+	if(arena.tags[0].bytes != 0 || arena.tags[1].bytes != arena_mark(&arena)) failed = 1;
+
+
+	// release back to a mark gives the memory back, and it is handed out zeroed again
+	arena_set_tag(&arena, "second");
+	mark = arena_mark(&arena);
+	a = (float *)arena_alloc(&arena, 256);
+	memset(a, 0xFF, 256);
+	arena_release(&arena, mark);
+	b = (float *)arena_alloc(&arena, 256);
+	if(a != b || b[0] != 0.0) failed = 1;
+
+
+	// over budget fails without touching the arena
+	mark = arena_mark(&arena);
+	if(arena_alloc(&arena, sizeof(pool)) != NULL || arena_mark(&arena) != mark) failed = 1;
+	if(arena.failed != sizeof(pool)) failed = 1;
+
+	report_arena(&arena, print_line);
+
+
+	// reset empties it
+	reset_arena(&arena);
+	if(arena_mark(&arena) != 0 || arena_alloc(&arena, sizeof(pool)) == NULL) failed = 1;
+
+
+	// a small arena (the ccm) spills into its fallback once it's full, resetting it resets both
+	reset_arena(&arena);
+	init_arena(&small, small_pool, sizeof(small_pool));
+	arena_set_fallback(&small, &arena);
+	arena_set_tag(&small, "effect");
+	c = (uint8_t *)arena_alloc(&small, 48);
+	a = (float *)arena_alloc(&small, 48);
+	if(c < small_pool || c >= small_pool + sizeof(small_pool)) failed = 1;
+	if((uint8_t *)a < pool || (uint8_t *)a >= pool + sizeof(pool)) failed = 1;
+	if(small.tags[1].bytes != 48 || arena.tags[1].bytes != 48 || small.failed != 0) failed = 1;
+	reset_arena(&small);
+	if(arena_mark(&small) != 0 || arena_mark(&arena) != 0) failed = 1;
+
+	printf("%s\n", failed ? "failed" : "passed");
+
+	return failed;
+
+}
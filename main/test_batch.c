@@ -0,0 +1,151 @@
+/**
+ * @file test_batch.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the batch renderer: every job of a preset x file
+ * grid runs once, on some worker, and writes the same file a render on its own does.
+ *
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "arena.h"
+#include "dsp.h"
+#include "wav.h"
+#include "render.h"
+#include "batch.h"
+
+// ---------------------------------------------------------------------
+
+#define RATE 44100
+#define NUM_FILES 3
+#define NUM_PRESETS 4
+#define WORKERS 4
+#define SUMMARY "test_batch.csv"
+
+
+
+static uint8_t pool[RENDER_ARENA_BYTES];
+static ARENA_T arena;			// the renders on their own
+static uint8_t batch_pool[64 * 1024];
+static ARENA_T batch_arena;		// the job grid and the workers, kept while the outputs are checked
+
+static const char * files[NUM_FILES] = { "test_batch_a.wav", "test_batch_b.wav", "test_batch_c.wav" };
+static const int lengths[NUM_FILES] = { RATE / 2, RATE / 5, RATE };		// out of order, the longest goes first
+static const int presets[NUM_PRESETS] = { 2, 4, 7, 11 };
+
+static float input[RATE];
+static float batch_out[2 * RATE], alone_out[2 * RATE];
+
+static void print_line(const char * s) { fputs(s, stdout); }
+
+
+// the job on its own into a buffer, and its batch output read back. returns the frames, -1 if they differ in length
+static int render_alone(const BATCH_JOB_T * J) {
+
+	WAV_T in, out;
+	RENDER_T * R;
+	RENDER_OPTS_T opts = { 0, 0, 0, -1, 0 };
+	int n;
+
+	reset_arena(&arena);
+	if(open_wav(&in, J->input) != 0) return -1;
+	R = init_render(&arena, &in, &(render_presets[J->preset].fx), 1, &opts);
+	if(R == NULL || create_wav(&out, &arena, "test_batch_alone.wav", R->out_rate, 1, WAV_FLOAT32) != 0) return -1;
+	run_render(R, &out);
+	close_wav(&out);
+	close_wav(&in);
+
+	if(open_wav(&in, "test_batch_alone.wav") != 0) return -1;
+	n = read_wav(&in, 0, alone_out, 2 * RATE);
+	close_wav(&in);
+	remove("test_batch_alone.wav");
+
+	if(open_wav(&in, J->output) != 0 || read_wav(&in, 0, batch_out, 2 * RATE) != n) return -1;
+	close_wav(&in);
+
+	return n;
+
+}
+
+
+int main(int argc, char const *argv[]) {
+
+	int f, i, j, n, lines, jobs, stolen;
+	int failed = 0;
+	double err;
+	char line[1024];
+	BATCH_T * B;
+	WAV_T W;
+	FILE * file;
+	RENDER_OPTS_T opts = { 0, 0, 0, WAV_FLOAT32, 0 };
+
+	init_arena(&arena, pool, sizeof(pool));
+	init_arena(&batch_arena, batch_pool, sizeof(batch_pool));
+	dsp_select(NULL);
+	srand(1);
+
+	// noise, each file as long as its entry in lengths
+	for(f = 0; f < NUM_FILES; f++) {
+		for(i = 0; i < lengths[f]; i++) input[i] = 0.5f * (((float)rand() / RAND_MAX) - 0.5f);
+		if(create_wav(&W, &arena, files[f], RATE, 1, WAV_FLOAT32) != 0) { printf("could not create %s\n", files[f]); return 1; }
+		write_wav(&W, input, NULL, lengths[f]);
+		close_wav(&W);
+		reset_arena(&arena);
+	}
+
+	B = init_batch(&batch_arena, files, NUM_FILES, presets, NUM_PRESETS, ".", WORKERS, &opts);
+	if(B == NULL) { printf("could not initialize\n"); return 1; }
+	if(run_batch(B) != 0) failed = 1;
+	report_batch(B, print_line);
+
+	// longest file first, every job run once
+	jobs = stolen = 0;
+	for(i = 0; i < WORKERS; i++) {
+		jobs += B->workers[i].jobs;
+		stolen += B->workers[i].stolen;
+	}
+	if(jobs != B->num_jobs || B->num_jobs != NUM_FILES * NUM_PRESETS || strcmp(B->jobs[0].input, files[2]) != 0) failed = 1;
+	for(j = 0; j < B->num_jobs; j++) {
+		if(B->jobs[j].worker < 0 || B->jobs[j].worker >= WORKERS || B->jobs[j].failed) failed = 1;
+	}
+
+	// each output is what rendering it on its own writes, to the bit
+	for(j = 0; j < B->num_jobs; j++) {
+		for(f = 0; f < NUM_FILES; f++) if(B->jobs[j].input == files[f]) break;
+		n = render_alone(&(B->jobs[j]));
+		err = (n < 0) ? 1 : 0;
+		for(i = 0; i < n; i++) err = fmax(err, fabs(batch_out[i] - alone_out[i]));
+		printf("%-18s preset %2d (%-20s) worker %d, %6d frames, %.1fx real time, difference %g\n", B->jobs[j].input,
+			render_presets[B->jobs[j].preset].number, render_presets[B->jobs[j].preset].name, B->jobs[j].worker, n,
+			B->jobs[j].audio / B->jobs[j].seconds, err);
+		if(n <= lengths[f] || err != 0) failed = 1;
+	}
+
+	// a header and a line a job
+	if(write_batch_summary(B, SUMMARY) != 0) failed = 1;
+	lines = 0;
+	file = fopen(SUMMARY, "r");
+	while(file != NULL && fgets(line, sizeof(line), file) != NULL) lines++;
+	if(file != NULL) fclose(file);
+	if(lines != B->num_jobs + 1) failed = 1;
+
+	// a preset that isn't on the gui
+	i = 12;
+	if(init_batch(&arena, files, 1, &i, 1, ".", 1, &opts) != NULL) failed = 1;
+
+	for(j = 0; j < B->num_jobs; j++) remove(B->jobs[j].output);
+	for(f = 0; f < NUM_FILES; f++) remove(files[f]);
+	remove(SUMMARY);
+	close_batch(B);
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
@@ -0,0 +1,106 @@
+/**
+ * @file test_compressor.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the single pass compressor against
+ * calc_rms followed by a threshold on the rms values.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "arena.h"
+#include "calc_rms.h"
+#include "energy_index.h"
+#include "compressor.h"
+
+// ---------------------------------------------------------------------
+
+
+
+
+// both paths run on the same input, a sine that swells above and falls back below
+// the threshold, so the compressor switches in and out a few times. the outputs
+// have to be identical sample for sample. the compressor also runs in place to
+// check that input == output works, and a second one runs each block in two uneven
+// pieces to check that the detection carries over from one call to the next. the
+// energy index the compressor feeds has to read the same as one fed the input
+// directly with update_energy_index(), and the one fed in pieces the same up to
+// the rounding of the pieces being summed separately.
+
+// all the test state comes out of this arena
+static uint8_t pool[1 << 20];
+static ARENA_T arena;
+
+int main(int argc, char const *argv[]) {
+
+
+	int block_size, window, i, b;
+	int mismatches = 0, compressed = 0, split = 37, index_errors = 0;
+	block_size = 100;
+	window = 100 * block_size;
+	float input[100], rms[100], reference[100], output[100], pieces[100];
+
+
+	// two-stage path: rms values, then threshold on the rms value
+	init_arena(&arena, pool, sizeof(pool));
+	RMS_T * V = init_rms(&arena, window);
+	COMP_T * ref = init_compressor(&arena, -7, 2, window, block_size);	// only used for threshold_rms
+	ENERGY_T * E = init_energy_index(&arena, window, block_size);
+
+	// single pass compressor, a whole block at a time and in pieces
+	COMP_T * C = init_compressor(&arena, -7, 2, window, block_size);
+	COMP_T * P = init_compressor(&arena, -7, 2, window, block_size);
+
+	if(V == NULL || ref == NULL || E == NULL || C == NULL || P == NULL) { printf("could not initialize\n"); return 1; }
+
+
+	for(b = 0; b < 2000; b++) {
+
+		for(i = 0; i < block_size; i++) {
+			input[i] = (0.2 + 0.6 * sin(0.001 * b)) * sin(0.0573 * (b * block_size + i));
+			output[i] = input[i];
+		}
+
+		calc_rms(V, input, rms, block_size);
+		for(i = 0; i < block_size; i++) {
+			reference[i] = (rms[i] > ref->threshold_rms) ? input[i] * 0.5 : input[i];
+		}
+
+		calc_compressor(C, output, output, block_size);
+		calc_compressor(P, input, pieces, split);
+		calc_compressor(P, input + split, pieces + split, block_size - split);
+
+		update_energy_index(E, input, block_size);
+		if(energy_mean_square(C->E, window) != energy_mean_square(E, window)) index_errors++;
+		if(fabsf(energy_mean_square(P->E, window) - energy_mean_square(E, window)) > 1e-6 * energy_mean_square(E, window)) index_errors++;
+
+		for(i = 0; i < block_size; i++) {
+			if(reference[i] != output[i] || reference[i] != pieces[i]) mismatches++;
+			if(reference[i] != input[i]) compressed++;
+		}
+
+	}
+
+	printf("compressed samples: %d, mismatches: %d, energy index mismatches: %d\n", compressed, mismatches, index_errors);
+
+	// after a reset both paths start again from silence
+	reset_rms(V);
+	reset_compressor(C);
+	if(energy_mean_square(C->E, window) != 0) index_errors++;
+	calc_rms(V, input, rms, block_size);
+	calc_compressor(C, input, output, block_size);
+	for(i = 0; i < block_size; i++) {
+		reference[i] = (rms[i] > ref->threshold_rms) ? input[i] * 0.5 : input[i];
+		if(reference[i] != output[i]) mismatches++;
+	}
+	printf("after reset, mismatches: %d\n", mismatches);
+
+	return (mismatches == 0 && index_errors == 0 && compressed > 0) ? 0 : 1;
+
+}
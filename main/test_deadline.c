@@ -0,0 +1,82 @@
+/**
+ * @file test_deadline.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the block deadline monitor.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "arena.h"
+#include "dma_io.h"
+#include "deadline.h"
+
+// ---------------------------------------------------------------------
+
+#define BLOCK 100
+#define FS 48000
+
+
+
+static uint8_t pool[4 * 1024];
+static ARENA_T arena;
+
+static void print_line(const char * s) { fputs(s, stdout); }
+
+
+int main(int argc, char const *argv[]) {
+
+	int failed = 0;
+	uint32_t p;
+	DMA_IO_T IO = { 0 };
+	DEADLINE_STATS_T S;
+	DEADLINE_T * D;
+
+	init_arena(&arena, pool, sizeof(pool));
+
+	// the io counters already have something on them, only what comes after init counts
+	IO.overruns = 3;
+	IO.underruns = 1;
+	D = init_deadline(&arena, &IO, BLOCK, FS);
+	if(D == NULL) { printf("could not initialize\n"); return 1; }
+	p = D->period;
+
+
+	// blocks at 11%, 52%, 99% and 120% of the period, the counter wraps during the second one
+	deadline_record(D, 1000, 1000 + (p / 100) * 11);
+	deadline_record(D, 0xFFFFFFFFu - 100, (0xFFFFFFFFu - 100) + (p / 100) * 52);
+	deadline_record(D, 0, (p / 100) * 99);
+	deadline_record(D, 0, p + (p / 5));
+	IO.overruns = 5;
+	IO.underruns = 2;
+
+	deadline_stats(D, &S);
+	report_deadline(D, print_line);
+	if(S.blocks != 4 || S.missed != 1 || S.overruns != 2 || S.errors != 0 || S.underruns != 1) failed = 1;
+	if(S.min_response != (p / 100) * 11 || S.max_response != p + (p / 5) || S.min_slack != -(int32_t)(p / 5)) failed = 1;
+	if(D->hist[2] != 1 || D->hist[10] != 1 || D->hist[19] != 1 || D->hist[DEADLINE_BINS - 1] != 1) failed = 1;
+	if(deadline_safe(D, 0)) failed = 1;
+
+
+	// a clean run is safe as long as the slowest block leaves the margin
+	reset_deadline(D);
+	if(deadline_safe(D, 0)) failed = 1;		// nothing recorded yet
+	deadline_record(D, 0, p / 10);
+	deadline_record(D, 0, (p / 100) * 40);
+	printf("clean run: safe with 50%% margin %d, with 70%% margin %d\n", deadline_safe(D, 50), deadline_safe(D, 70));
+	if(!deadline_safe(D, 50) || deadline_safe(D, 70)) failed = 1;
+
+	// but not with a dac underrun
+	IO.underruns = 3;
+	if(deadline_safe(D, 50)) failed = 1;
+
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
@@ -4,48 +4,127 @@
  * @author Jacob Allenwood
  * @date October 22, 2015
  *
- * @brief This file contains the main program to test the delay effect.
+ * @brief This file contains the main program to test the delay effect, and the kernels compiled 
+ * for each block size against the generic loop.
  * 
  */
 
 // include files -------------------------------------------------------
 #include <stdlib.h>
 #include <stdio.h>
+#include <math.h>
 
+#include "arena.h"
 #include "delay.h"
 
 // ---------------------------------------------------------------------
 
 #define FS 10
+#define MAX_BLOCK 256
+#define BLOCKS 40		// blocks through each kernel, enough to wrap the history several times
+#define MAX_ERROR 1e-6
 
 
 
+// all the test state comes out of this arena
+static uint8_t pool[ARENA_BUDGET];
+static ARENA_T arena;
+
+
+// a kernel against the generic loop, in place, returns the worst difference
+static double check_kernel(int block_size, int sample_delay, int input_toggle) {
+
+	int k, i;
+	double err = 0;
+	static float a[MAX_BLOCK], b[MAX_BLOCK];
+	DELAY_T * K = init_delay(&arena, 0, FS, sample_delay, 0.7, input_toggle, block_size);
+	DELAY_T * G = init_delay(&arena, 0, FS, sample_delay, 0.7, input_toggle, block_size);
+
+	if(K == NULL || G == NULL || K->kernel == NULL) return 1.0;
+	G->kernel = NULL;
+
+	for(k = 0; k < BLOCKS; k++) {
+		for(i = 0; i < block_size; i++) a[i] = b[i] = ((float)rand() / RAND_MAX) - 0.5f;
+		calc_delay(K, a, a, block_size);
+		calc_delay(G, b, b, block_size);
+		for(i = 0; i < block_size; i++) err = fmax(err, fabs(a[i] - b[i]));
+	}
+
+	// a short block falls back on the generic loop and the kernel picks up after it
+	calc_delay(K, a, a, block_size / 2);
+	calc_delay(G, b, b, block_size / 2);
+	for(k = 0; k < 2; k++) {
+		calc_delay(K, a, a, block_size);
+		calc_delay(G, b, b, block_size);
+		for(i = 0; i < block_size; i++) err = fmax(err, fabs(a[i] - b[i]));
+	}
+
+	return err;
+
+}
+
 int main(int argc, char const *argv[]) {
 
 
 	int block_size, i, j;
 	block_size = 10;
 	float input[10] = {0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9};
+	float output[10];
 
 
-	// setup delay struct
-	DELAY_T * D = init_delay(FS, 0.1, 1.0, block_size);
+	// setup delay struct, 1 is delay in seconds, 1 is delay added to the input
+	init_arena(&arena, pool, sizeof(pool));
+	DELAY_T * D = init_delay(&arena, 1, FS, 0.1, 1.0, 1, block_size);
 
-	calc_delay(D, input);
+	calc_delay(D, input, output, block_size);
 
 	for(i = 0; i < block_size; i++) {
-		printf("%f,", D->output[i]);
+		printf("%f,", output[i]);
 	}
 	printf("\n\n");
 
-	calc_delay(D, input);
+	calc_delay(D, input, output, block_size);
 
 	for(j = 0; j < block_size; j++) {
-		printf("%f,", D->output[j]);
+		printf("%f,", output[j]);
 	}
 
 	printf("\n\n");
 
+
+	// every kernel, with delays shorter than, around and longer than a block
+	int block_sizes[7] = {8, 16, 32, 64, 100, 128, 256};
+	int delays[4] = {3, 100, 150, 4800};
+	int b, d, t, failed = 0;
+	double err, worst = 0;
+
+	for(b = 0; b < 7; b++) {
+		for(d = 0; d < 4; d++) {
+			for(t = 0; t < 2; t++) {
+				reset_arena(&arena);
+				err = check_kernel(block_sizes[b], delays[d], t);
+				if(err > worst) worst = err;
+				if(err > MAX_ERROR) {
+					printf("block %d delay %d toggle %d: kernel off by %g\n", block_sizes[b], delays[d], t, err);
+					failed = 1;
+				}
+			}
+		}
+	}
+	printf("kernels against the generic loop: max difference %g\n", worst);
+
+	// no delay, or less than a sample, has no history to run through and is turned down
+	reset_arena(&arena);
+	if(init_delay(&arena, 0, FS, 0, 0.5, 1, 128) != NULL) failed = 1;
+	if(init_delay(&arena, 1, 48000, 0.00001, 0.5, 1, 128) != NULL) failed = 1;
+	if(init_delay_q15(&arena, 1, 48000, 0.00001, 0.5, 1, 128) != NULL) failed = 1;
+	if(init_delay(&arena, 1, 48000, 0.00003, 0.5, 1, 128) == NULL) failed = 1;		// just over a sample
+	printf("delays under a sample turned down: %s\n", failed ? "no" : "yes");
+
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
 }
 
 
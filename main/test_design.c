@@ -0,0 +1,259 @@
+/**
+ * @file test_design.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the filter designs: the eq band filters 
+ * against the FDATool tables, half-band and Kaiser order designs against their specs, the 
+ * biquads against the cookbook gains, the design cache, and the eq and input lowpass at every rate.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "arena.h"
+#include "dsp.h"
+#include "profiler.h"
+#include "design.h"
+#include "latency.h"
+#include "eq.h"
+
+#include "../filters/eq_low_coefs.h"
+#include "../filters/eq_mid_coefs.h"
+#include "../filters/fir_lowpass.h"
+
+// ---------------------------------------------------------------------
+
+#define RATE 48000				// sample rate the eq runs at
+#define MAX_TAPS 512
+#define MAX_TABLE_ERROR 1e-7	// designed taps against the MATLAB tables
+#define MAX_GAIN_ERROR 1e-3		// biquad gains against the cookbook, linear
+#define EQ_BLOCK 100
+#define EQ_MAX_TAIL 1200			// samples, the eq path at 96kHz is under this
+
+
+
+static uint8_t pool[ARENA_BUDGET];
+static ARENA_T arena;
+
+static float h[MAX_TAPS];
+static float eq_in[EQ_MAX_TAIL + EQ_BLOCK], eq_out[EQ_MAX_TAIL + EQ_BLOCK];
+
+
+// gain of a FIR at frequency f, sampled at fs
+static double fir_gain_at(const float * c, int num_taps, double f, int fs) {
+	int k;
+	double re = 0, im = 0;
+	for(k = 0; k < num_taps; k++) {
+		re += c[k] * cos(2.0 * M_PI * f / fs * k);
+		im -= c[k] * sin(2.0 * M_PI * f / fs * k);
+	}
+	return sqrt(re * re + im * im);
+}
+
+static double fir_gain(const float * c, int num_taps, double f) {
+	return fir_gain_at(c, num_taps, f, RATE);
+}
+
+// gain of a biquad at frequency f, a1 and a2 with the cmsis sign
+static double biquad_gain(const float * c, double f) {
+	double w = 2.0 * M_PI * f / RATE;
+	double nr = c[0] + c[1] * cos(w) + c[2] * cos(2 * w), ni = -c[1] * sin(w) - c[2] * sin(2 * w);
+	double dr = 1.0 - c[3] * cos(w) - c[4] * cos(2 * w), di = c[3] * sin(w) + c[4] * sin(2 * w);
+	return sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+}
+
+static int check(const char * name, double got, double want, double tolerance) {
+	int bad = fabs(got - want) > tolerance;
+	printf("%-24s %10.6f (want %10.6f)%s\n", name, got, want, bad ? " FAILED" : "");
+	return bad;
+}
+
+
+
+
+int main(int argc, char const *argv[]) {
+
+	int i, k, n, taps, r, fs, peak;
+	int failed = 0;
+	double err, worst, stop;
+	float beta, amp;
+	float coefs[DSP_BIQUAD_COEFS], state[DSP_BIQUAD_STATE], x[256];
+	uint32_t t0, t_design, t_cached;
+	const float * low;
+	const float * again;
+	EQ_T * Q;
+	EQ_T * S;
+	DESIGN_SPEC_T spec = { DESIGN_LOWPASS, 301, 350.0f, RATE, 2.0f };
+
+	init_arena(&arena, pool, sizeof(pool));
+	profile_start_clock();
+
+
+	// EQ BAND FILTERS ---------------------------------------------------
+	// the FDATool tables: Kaiser, beta 2, 301 taps, 350Hz and 1050Hz
+	t0 = profile_now();
+	low = design_fir(&arena, &spec);
+	t_design = profile_now() - t0;
+	err = 0;
+	for(k = 0; k < eq_low_num; k++) err = fmax(err, fabs(low[k] - eq_low_coefs[k]));
+	for(k = 0; k < eq_low_num; k++) if(low[k] != low[eq_low_num - 1 - k]) failed = 1;
+	printf("350Hz band filter: max difference from the table %g\n", err);
+	if(err > MAX_TABLE_ERROR) failed = 1;
+
+	design_lowpass(h, 301, 1050.0f, RATE, 2.0f);
+	err = 0;
+	for(k = 0; k < eq_mid_num; k++) err = fmax(err, fabs(h[k] - eq_mid_coefs[k]));
+	printf("1050Hz band filter: max difference from the table %g\n", err);
+	if(err > MAX_TABLE_ERROR) failed = 1;
+
+	// the same spec again comes out of the cache, another rate is designed
+	t0 = profile_now();
+	again = design_fir(&arena, &spec);
+	t_cached = profile_now() - t0;
+	printf("301 taps: designed in %lu ticks, cached in %lu\n", (unsigned long)t_design, (unsigned long)t_cached);
+	if(again != low) failed = 1;
+	spec.FS = 44100;
+	if(design_fir(&arena, &spec) == low) failed = 1;
+
+
+	// HALF-BAND -----------------------------------------------------------
+	if(design_halfband(h, 33, 6.0f) != 1) failed = 1;
+	if(design_halfband(h, 31, 6.0f) != 0) failed = 1;
+	for(k = 0; k < 31; k++) {
+		if(k != 15 && ((k - 15) % 2) == 0 && h[k] != 0.0f) failed = 1;
+	}
+	if(h[15] != 0.5f) failed = 1;
+	failed |= check("half-band dc", fir_gain(h, 31, 0.0), 1.0, 1e-6);
+	failed |= check("half-band FS/4", fir_gain(h, 31, RATE / 4.0), 0.5, 1e-6);
+
+
+	// KAISER ORDER ------------------------------------------------------
+	// 60 dB down from 12kHz with 10kHz passing, the input lowpass spec
+	taps = design_kaiser_order(60.0f, 2000.0f, RATE, &beta);
+	printf("60 dB, 2kHz transition: %d taps, beta %.4f\n", taps, beta);
+	if(taps > MAX_TAPS || (taps % 2) == 0) { printf("FAILED\n"); return 1; }
+	failed |= check("kaiser beta", beta, 0.1102 * (60.0 - 8.7), 1e-4);
+	design_lowpass(h, taps, 11000.0f, RATE, beta);
+	worst = stop = 0;
+	for(i = 0; i <= 100; i++) {
+		worst = fmax(worst, fabs(fir_gain(h, taps, 10000.0 * i / 100) - 1.0));
+		stop = fmax(stop, fir_gain(h, taps, 12000.0 + 12000.0 * i / 100));
+	}
+	printf("passband ripple %g, stopband %.1f dB\n", worst, 20 * log10(stop));
+	if(worst > 2e-3 || stop > pow(10.0, -58.0 / 20)) failed = 1;
+
+
+	// BIQUADS ---------------------------------------------------------------
+	design_biquad(coefs, BIQUAD_LOWPASS, 1000.0f, 0.7071f, 0.0f, RATE);
+	failed |= check("lowpass dc", biquad_gain(coefs, 0.0), 1.0, MAX_GAIN_ERROR);
+	failed |= check("lowpass f0", biquad_gain(coefs, 1000.0), 0.7071, MAX_GAIN_ERROR);
+	design_biquad(coefs, BIQUAD_HIGHPASS, 1000.0f, 0.7071f, 0.0f, RATE);
+	failed |= check("highpass nyquist", biquad_gain(coefs, RATE / 2.0), 1.0, MAX_GAIN_ERROR);
+	failed |= check("highpass f0", biquad_gain(coefs, 1000.0), 0.7071, MAX_GAIN_ERROR);
+	design_biquad(coefs, BIQUAD_BANDPASS, 1000.0f, 2.0f, 0.0f, RATE);
+	failed |= check("bandpass f0", biquad_gain(coefs, 1000.0), 1.0, MAX_GAIN_ERROR);
+	design_biquad(coefs, BIQUAD_NOTCH, 1000.0f, 2.0f, 0.0f, RATE);
+	failed |= check("notch f0", biquad_gain(coefs, 1000.0), 0.0, MAX_GAIN_ERROR);
+	failed |= check("notch dc", biquad_gain(coefs, 0.0), 1.0, MAX_GAIN_ERROR);
+	design_biquad(coefs, BIQUAD_LOWSHELF, 200.0f, 0.7071f, 6.0f, RATE);
+	failed |= check("low shelf dc", biquad_gain(coefs, 0.0), pow(10.0, 6.0 / 20), MAX_GAIN_ERROR);
+	failed |= check("low shelf nyquist", biquad_gain(coefs, RATE / 2.0), 1.0, MAX_GAIN_ERROR);
+	design_biquad(coefs, BIQUAD_HIGHSHELF, 5000.0f, 0.7071f, -6.0f, RATE);
+	failed |= check("high shelf nyquist", biquad_gain(coefs, RATE / 2.0), pow(10.0, -6.0 / 20), MAX_GAIN_ERROR);
+	failed |= check("high shelf dc", biquad_gain(coefs, 0.0), 1.0, MAX_GAIN_ERROR);
+
+	// a peak through the dsp biquad kernel: a sine at f0 comes out 9 dB up once it settles
+	design_biquad(coefs, BIQUAD_PEAK, 1000.0f, 1.0f, 9.0f, RATE);
+	failed |= check("peak f0", biquad_gain(coefs, 1000.0), pow(10.0, 9.0 / 20), MAX_GAIN_ERROR);
+	for(k = 0; k < DSP_BIQUAD_STATE; k++) state[k] = 0.0f;
+	amp = 0.0f;
+	for(n = 0; n < 40; n++) {
+		for(i = 0; i < 256; i++) x[i] = 0.1f * sinf(2.0f * M_PI * 1000.0f * (n * 256 + i) / RATE);
+		dsp->biquad(coefs, 1, state, x, x, 256);
+		if(n >= 20) for(i = 0; i < 256; i++) amp = fmaxf(amp, fabsf(x[i]));
+	}
+	failed |= check("peak through the kernel", amp / 0.1, pow(10.0, 9.0 / 20), 1e-2);
+
+
+	// CACHE -------------------------------------------------------------------
+	// once it's full, designs go into the arena and aren't remembered
+	design_forget();
+	spec.FS = RATE;
+	spec.num_taps = 101;
+	for(i = 0; i < DESIGN_CACHE_SIZE; i++) {
+		spec.cutoff = 1000.0f + 100.0f * i;
+		if(design_fir(&arena, &spec) == NULL) failed = 1;
+	}
+	spec.cutoff = 100.0f;
+	low = design_fir(&arena, &spec);
+	again = design_fir(&arena, &spec);
+	if(low == NULL || again == NULL || low == again) failed = 1;
+	spec.cutoff = 1000.0f;
+	if(design_fir(&arena, &spec) == NULL) failed = 1;
+	report_design((void (*)(const char *))printf);
+	spec.cutoff = 30000.0f;
+	if(design_fir(&arena, &spec) != NULL) failed = 1;
+
+
+	// RATES -------------------------------------------------------------------
+	// at every rate the flat eq puts the input back together 0.6 times, (M - 1) samples late, for the same
+	// length of time, the shortened tiers line up with it, and the lowpass designed to the 48kHz table's edges meets them
+	design_forget();
+	for(r = 0; r < LATENCY_NUM_RATES; r++) {
+
+		fs = latency_rates[r];
+		taps = eq_num_taps(EQ_NUM_TAPS, fs);
+		Q = init_eq(&arena, 0, 0, 0, EQ_BLOCK, fs);
+		S = init_eq_taps(&arena, 0, 0, 0, 151, EQ_BLOCK, fs);
+		if(Q == NULL || S == NULL || (taps % 2) == 0) { printf("eq at %d Hz could not initialize\n", fs); return 1; }
+		if(Q->mid->num_taps != taps || S->mid->num_taps != eq_num_taps(151, fs)) failed = 1;
+
+		for(i = 0; i < EQ_MAX_TAIL + EQ_BLOCK; i++) eq_in[i] = (i == 0) ? 1.0f : 0.0f;
+		for(i = 0; i < EQ_MAX_TAIL; i += EQ_BLOCK) calc_eq(Q, eq_in + i, eq_out + i, EQ_BLOCK);
+		peak = 0;
+		err = 0;
+		for(i = 0; i < EQ_MAX_TAIL; i++) {
+			if(fabsf(eq_out[i]) > fabsf(eq_out[peak])) peak = i;
+			if(i != taps - 1) err = fmax(err, fabs(eq_out[i]));
+		}
+		printf("%5d Hz: eq %d taps (%.2f ms), peak %.4f at %d, rest %g, tail %d", fs, taps, 1000.0 * taps / fs,
+			eq_out[peak], peak, err, eq_tail(Q));
+		if(peak != taps - 1 || fabs(eq_out[peak] - 0.6) > 1e-4 || err > 1e-4) failed = 1;
+
+		// the shortened tier comes out at the same time
+		for(i = 0; i < EQ_MAX_TAIL; i += EQ_BLOCK) calc_eq(S, eq_in + i, eq_out + i, EQ_BLOCK);
+		if(fabs(eq_out[taps - 1] - 0.6) > 1e-4) failed = 1;
+		if(fabs((double)(taps - 1) / fs - (double)(EQ_NUM_TAPS - 1) / EQ_DESIGN_FS) > 1.0 / fs) failed = 1;
+
+		// the input lowpass everything runs: the table at 48kHz, designed to its edges at the others
+		low = design_input_lowpass(&arena, fs, &taps);
+		if(low == NULL) { printf(" FAILED\n"); return 1; }
+		if(fs == 48000) {
+			printf(", lowpass the %d tap table\n", taps);
+			if(taps != BL) failed = 1;
+			for(i = 0; i < BL && taps == BL; i++) if(low[i] != B[i]) failed = 1;
+		} else {
+			worst = stop = 0;
+			for(i = 0; i <= 100; i++) {
+				worst = fmax(worst, fabs(fir_gain_at(low, taps, DESIGN_INPUT_PASS * i / 100, fs) - 1.0));
+				stop = fmax(stop, fir_gain_at(low, taps, DESIGN_INPUT_STOP + (fs / 2 - DESIGN_INPUT_STOP) * i / 100, fs));
+			}
+			printf(", lowpass %d taps %.1f dB\n", taps, 20 * log10(stop));
+			if(worst > 2e-3 || stop > pow(10.0, -58.0 / 20)) failed = 1;
+		}
+
+		reset_arena(&arena);
+
+	}
+	report_design((void (*)(const char *))printf);
+
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
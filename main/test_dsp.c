@@ -0,0 +1,228 @@
+/**
+ * @file test_dsp.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test every DSP backend this cpu can run against
+ * a double precision reference, and the eq running on each one against the scalar backend.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "arena.h"
+#include "fixed.h"
+#include "dsp.h"
+#include "eq.h"
+
+#include "../filters/eq_low_coefs.h"
+
+// ---------------------------------------------------------------------
+
+#define MAX_BLOCK 256
+#define BLOCKS 8			// blocks through the fir and biquad, so the history carries over
+#define FFT_SIZE 512
+#define MAX_TAPS 512		// room in the fir state
+#define FS 48000
+#define MAX_ERROR 1e-5		// float kernels against the double reference, relative to full scale
+#define MAX_EQ_ERROR 1e-5	// eq on a backend against the eq on scalar
+
+
+
+static uint8_t pool[ARENA_BUDGET];
+static ARENA_T arena;
+
+static float a[MAX_BLOCK], b[MAX_BLOCK], out[MAX_BLOCK];
+static float history[MAX_BLOCK * BLOCKS];
+static float state[MAX_TAPS + MAX_BLOCK];
+static float x[2 * FFT_SIZE], ref_eq[MAX_BLOCK * BLOCKS];
+static q15_t q[MAX_BLOCK];
+
+
+static float noise(void) {
+	return ((float)rand() / RAND_MAX) - 0.5f;
+}
+
+
+// a two stage lowpass/peaking cascade, a1 and a2 with the cmsis sign
+static const float biquad_coefs[2 * DSP_BIQUAD_COEFS] = {
+	0.0200833656f, 0.0401667312f, 0.0200833656f, 1.5610180758f, -0.6413515381f,
+	1.0236f, -1.9124f, 0.8977f, 1.9124f, -0.9213f
+};
+
+
+
+
+// one backend's kernels against the reference, returns the worst error ------
+static double check_backend(const DSP_BACKEND_T * B, int n) {
+
+	int i, k, s, blk;
+	double err = 0, acc, y, yn, re, im;
+	double z[2][4];
+	DSP_FFT_T * P;
+
+	srand(n);
+
+	// fir: the 301 tap eq filter, a block at a time
+	memset(state, 0, sizeof(state));
+	for(i = 0; i < n * BLOCKS; i++) history[i] = noise();
+	for(blk = 0; blk < BLOCKS; blk++) {
+		B->fir(eq_low_coefs, eq_low_num, state, history + blk * n, out, n);
+		for(i = 0; i < n; i++) {
+			acc = 0;
+			for(k = 0; k < eq_low_num && k <= blk * n + i; k++) acc += (double)eq_low_coefs[k] * history[blk * n + i - k];
+			err = fmax(err, fabs(acc - out[i]));
+		}
+	}
+
+	// biquad cascade, in place on the second block onwards
+	memset(state, 0, sizeof(state));
+	memset(z, 0, sizeof(z));
+	for(blk = 0; blk < BLOCKS; blk++) {
+		for(i = 0; i < n; i++) a[i] = history[blk * n + i];
+		B->biquad(biquad_coefs, 2, state, a, (blk == 0) ? out : a, n);
+		for(i = 0; i < n; i++) {
+			y = history[blk * n + i];
+			for(s = 0; s < 2; s++) {
+				const float * c = biquad_coefs + s * DSP_BIQUAD_COEFS;
+				yn = c[0] * y + c[1] * z[s][0] + c[2] * z[s][1] + c[3] * z[s][2] + c[4] * z[s][3];
+				z[s][1] = z[s][0]; z[s][0] = y;
+				z[s][3] = z[s][2]; z[s][2] = yn;
+				y = yn;
+			}
+			err = fmax(err, fabs(y - ((blk == 0) ? out[i] : a[i])));
+		}
+	}
+
+	// add, scale, mac, with the output on top of an input
+	for(i = 0; i < n; i++) { a[i] = noise(); b[i] = noise(); }
+	B->add(a, b, out, n);
+	for(i = 0; i < n; i++) err = fmax(err, fabs(((double)a[i] + b[i]) - out[i]));
+	B->scale(a, 0.37f, out, n);
+	for(i = 0; i < n; i++) err = fmax(err, fabs(0.37 * a[i] - out[i]));
+	memcpy(out, b, sizeof(float) * n);
+	B->mac(a, -1.0f, out, n);
+	for(i = 0; i < n; i++) err = fmax(err, fabs(((double)b[i] - a[i]) - out[i]));
+	memcpy(out, a, sizeof(float) * n);
+	B->mac(out, 0.5f, out, n);
+	for(i = 0; i < n; i++) err = fmax(err, fabs(1.5 * a[i] - out[i]));
+
+	// dot product, relative to the n products it sums
+	acc = 0;
+	for(i = 0; i < n; i++) acc += (double)a[i] * b[i];
+	err = fmax(err, fabs(acc - B->dot(a, b, n)) / n);
+
+	// conversions, within 1 LSB of the rounded value, saturating past full scale
+	for(i = 0; i < n; i++) a[i] = 2.2f * noise();
+	a[0] = 1.0f; a[n - 1] = -1.0f;
+	B->float_to_q15(a, q, n);
+	for(i = 0; i < n; i++) {
+		y = fmax(fmin(round(a[i] * 32768.0), 32767.0), -32768.0);
+		if(fabs(y - q[i]) > 1) err = fmax(err, 1.0);
+	}
+	B->q15_to_float(q, out, n);
+	for(i = 0; i < n; i++) err = fmax(err, fabs(q[i] / 32768.0 - out[i]));
+
+	// fft against a direct DFT, scaled down by the size to compare to full scale
+	reset_arena(&arena);
+	P = init_dsp_fft(&arena, FFT_SIZE);
+	if(P == NULL) return 1.0;
+	for(i = 0; i < 2 * FFT_SIZE; i++) history[i] = x[i] = noise();
+	B->fft(P, x);
+	for(k = 0; k < FFT_SIZE; k++) {
+		re = im = 0;
+		for(i = 0; i < FFT_SIZE; i++) {
+			re += history[2*i] * cos(-2.0 * M_PI * i * k / FFT_SIZE) - history[2*i+1] * sin(-2.0 * M_PI * i * k / FFT_SIZE);
+			im += history[2*i] * sin(-2.0 * M_PI * i * k / FFT_SIZE) + history[2*i+1] * cos(-2.0 * M_PI * i * k / FFT_SIZE);
+		}
+		err = fmax(err, fabs(re - x[2*k]) / FFT_SIZE);
+		err = fmax(err, fabs(im - x[2*k+1]) / FFT_SIZE);
+	}
+
+	return err;
+
+}
+
+
+// the eq on the current backend, compared to the reference block, returns the worst error ------
+static double run_eq(int n, int make_ref) {
+
+	int i, blk;
+	double err = 0;
+	EQ_T * Q;
+
+	reset_arena(&arena);
+	Q = init_eq(&arena, 6.0f, -3.0f, 2.0f, n, FS);
+	if(Q == NULL) return 1.0;
+
+	srand(7);
+	for(blk = 0; blk < BLOCKS; blk++) {
+		for(i = 0; i < n; i++) a[i] = noise();
+		calc_eq(Q, a, a, n);
+		for(i = 0; i < n; i++) {
+			if(make_ref) ref_eq[blk * n + i] = a[i];
+			else err = fmax(err, fabs(ref_eq[blk * n + i] - a[i]));
+		}
+	}
+
+	return err;
+
+}
+
+
+
+
+int main(int argc, char const *argv[]) {
+
+	int b, i;
+	int failed = 0;
+	int block_sizes[3] = {13, 64, 256};		// 13 leaves a tail past every vector width
+	double err;
+	const DSP_BACKEND_T * B;
+
+	init_arena(&arena, pool, sizeof(pool));
+
+	printf("%d backends, default %s\n", dsp_num_backends(), dsp->name);
+	if(dsp_num_backends() < 1 || dsp_get_backend(0) != &dsp_scalar) failed = 1;
+	if(dsp_get_backend(dsp_num_backends()) != NULL) failed = 1;
+	if(dsp_select("no such backend") == 0) failed = 1;
+
+
+	// every kernel on every backend
+	for(i = 0; (B = dsp_get_backend(i)) != NULL; i++) {
+		for(b = 0; b < 3; b++) {
+			err = check_backend(B, block_sizes[b]);
+			printf("%-8s block %3d: max error %g\n", B->name, block_sizes[b], err);
+			if(err > MAX_ERROR) failed = 1;
+		}
+	}
+
+
+	// the eq through each backend against the eq through scalar
+	for(b = 0; b < 3; b++) {
+		if(dsp_select("scalar") != 0) failed = 1;
+		run_eq(block_sizes[b], 1);
+		for(i = 0; (B = dsp_get_backend(i)) != NULL; i++) {
+			if(dsp_select(B->name) != 0 || dsp != B) failed = 1;
+			err = run_eq(block_sizes[b], 0);
+			printf("eq on %-8s block %3d: max error %g\n", B->name, block_sizes[b], err);
+			if(err > MAX_EQ_ERROR) failed = 1;
+		}
+	}
+
+
+	// the fastest one this cpu has is the last one listed
+	dsp_select(NULL);
+	printf("selected %s\n", dsp->name);
+	if(dsp != dsp_get_backend(dsp_num_backends() - 1)) failed = 1;
+
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
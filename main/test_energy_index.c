@@ -0,0 +1,88 @@
+/**
+ * @file test_energy_index.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the prefix-sum energy index against calc_rms.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "arena.h"
+#include "calc_rms.h"
+#include "energy_index.h"
+
+// ---------------------------------------------------------------------
+
+
+
+
+// the rms value at the end of every block from calc_rms should be the same as
+// asking the energy index for the same window. a couple of different windows are
+// queried from the same index to show one pass over the input serves all of them.
+// a second index fed in pieces that don't line up with its granularity has to read
+// the same, up to the rounding of the pieces being summed separately.
+
+// all the test state comes out of this arena
+static uint8_t pool[ARENA_BUDGET];
+static ARENA_T arena;
+
+int main(int argc, char const *argv[]) {
+
+
+	int block_size, i, b, w;
+	int windows[3] = {10, 40, 100};
+	float input[10], rms[10];
+	int pieces = 0;
+	float err, max_err = 0.0;
+	block_size = 10;
+
+
+	// one rms struct per window, and a single energy index for all of them
+	RMS_T * V[3];
+	init_arena(&arena, pool, sizeof(pool));
+	for(w = 0; w < 3; w++) V[w] = init_rms(&arena, windows[w]);
+	ENERGY_T * E = init_energy_index(&arena, 100, block_size);
+	ENERGY_T * F = init_energy_index(&arena, 100, block_size);
+	if(E == NULL || F == NULL) { printf("could not initialize energy index\n"); return 1; }
+
+
+	for(b = 0; b < 50; b++) {
+
+		for(i = 0; i < block_size; i++) {
+			input[i] = 0.9 * sin(0.05 * (b * block_size + i)) * ((b < 25) ? 1.0 : 0.1);
+		}
+
+		update_energy_index(E, input, block_size);
+		update_energy_index(F, input, 3);
+		update_energy_index(F, input + 3, block_size - 3);
+		if(fabs(energy_rms(F, windows[2]) - energy_rms(E, windows[2])) > 1e-6 * energy_rms(E, windows[2])) pieces++;
+
+		for(w = 0; w < 3; w++) {
+			calc_rms(V[w], input, rms, block_size);
+			err = fabs(rms[block_size - 1] - energy_rms(E, windows[w]));
+			if(err > max_err) max_err = err;
+		}
+
+	}
+
+	printf("max error: %g, blocks that differ when fed in pieces: %d\n", max_err, pieces);
+	if(pieces != 0) max_err = 1;
+
+	// reset is silence, every window reads zero until new input comes in
+	reset_energy_index(E);
+	err = 0;
+	for(w = 0; w < 3; w++) err += energy_rms(E, windows[w]);
+	update_energy_index(E, input, block_size);
+	printf("after reset: %g, one block later: %g\n", err, energy_rms(E, block_size));
+	if(err != 0 || energy_rms(E, block_size) == 0) max_err = 1;
+
+	printf((max_err < 1e-4) ? "passed\n" : "FAILED\n");
+	return (max_err < 1e-4) ? 0 : 1;
+
+}
@@ -0,0 +1,169 @@
+/**
+ * @file test_fir.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the FFT and folded block FIR filters against the 
+ * direct form, with the input copied in or written in place, and the planner and its wisdom, full
+ * or not.
+ *
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "arena.h"
+#include "fir.h"
+
+#include "../filters/eq_low_coefs.h"
+#include "../filters/fir_lowpass.h"
+
+// ---------------------------------------------------------------------
+
+#define MAX_BLOCK 256
+#define BLOCKS 20		// blocks to run, enough for the 301 tap history to fill several times over
+#define MAX_ERROR 1e-5
+#define WISDOM_FILE "test_fir.wisdom"
+
+
+
+static uint8_t pool[ARENA_BUDGET];
+static ARENA_T arena;
+
+
+
+
+int main(int argc, char const *argv[]) {
+
+	int b, k, i, block_size, kind, bytes;
+	int failed = 0;
+	int block_sizes[4] = {16, 64, 100, 256};
+	float input[MAX_BLOCK], direct[MAX_BLOCK], fft[MAX_BLOCK], folded[MAX_BLOCK];
+	float * in_place;
+	double err, err_folded;
+	size_t mark;
+	uint32_t saved[64];
+	const FIR_WISDOM_T * W;
+	FIR_T * D;
+	FIR_T * F;
+	FIR_T * S;
+
+	init_arena(&arena, pool, sizeof(pool));
+	srand(1);
+
+
+	// the eq filter through every kernel, at each block size. the FFT and folded run in place to check that too
+	for(b = 0; b < 4; b++) {
+
+		block_size = block_sizes[b];
+		D = init_fir(&arena, eq_low_coefs, eq_low_num, block_size, FIR_DIRECT);
+		F = init_fir(&arena, eq_low_coefs, eq_low_num, block_size, FIR_FFT);
+		S = init_fir(&arena, eq_low_coefs, eq_low_num, block_size, FIR_FOLDED);
+		if(D == NULL || F == NULL || S == NULL || S->kind != FIR_FOLDED) { printf("could not initialize\n"); return 1; }
+
+		err = err_folded = 0;
+		for(k = 0; k < BLOCKS; k++) {
+			for(i = 0; i < block_size; i++) input[i] = fft[i] = folded[i] = ((float)rand() / RAND_MAX) - 0.5f;
+			calc_fir(D, input, direct, block_size);
+			calc_fir(F, fft, fft, block_size);
+			calc_fir(S, folded, folded, block_size);
+			for(i = 0; i < block_size; i++) err = fmax(err, fabs(direct[i] - fft[i]));
+			for(i = 0; i < block_size; i++) err_folded = fmax(err_folded, fabs(direct[i] - folded[i]));
+		}
+
+		printf("block %3d: fft size %d, max error %g, folded %g, auto picks %s\n", block_size, F->fft_size, err, err_folded,
+			(fir_choose_kind(eq_low_num, block_size) == FIR_FFT) ? "fft" : "direct");
+		if(err > MAX_ERROR || err_folded > MAX_ERROR) failed = 1;
+		reset_arena(&arena);
+
+	}
+
+	// every kernel with the input written straight into its history, the way the adc conversion does
+	for(kind = FIR_DIRECT; kind < FIR_NUM_KINDS; kind++) {
+		D = init_fir(&arena, eq_low_coefs, eq_low_num, 100, FIR_DIRECT);
+		F = init_fir(&arena, eq_low_coefs, eq_low_num, 100, kind);
+		if(D == NULL || F == NULL) { printf("could not initialize\n"); return 1; }
+		err = 0;
+		for(k = 0; k < BLOCKS; k++) {
+			in_place = fir_input(F, 100);
+			for(i = 0; i < 100; i++) input[i] = in_place[i] = ((float)rand() / RAND_MAX) - 0.5f;
+			calc_fir(D, input, direct, 100);
+			calc_fir(F, in_place, fft, 100);
+			for(i = 0; i < 100; i++) err = fmax(err, fabs(direct[i] - fft[i]));
+		}
+		printf("%s written in place: max error %g\n", (kind == FIR_FFT) ? "fft" : ((kind == FIR_FOLDED) ? "folded" : "direct"), err);
+		if(err > MAX_ERROR) failed = 1;
+		reset_arena(&arena);
+	}
+
+	// a filter that isn't symmetric can't run folded
+	input[0] = 1.0f; input[1] = 0.5f; input[2] = 0.25f;
+	S = init_fir(&arena, input, 3, 16, FIR_FOLDED);
+	if(S == NULL || S->kind != FIR_DIRECT) failed = 1;
+	reset_arena(&arena);
+
+
+	// PLANNER -----------------------------------------------------------
+	// every plan picks a kernel, is remembered, and gives the arena back
+	for(b = 0; b < 4; b++) {
+		mark = arena_mark(&arena);
+		kind = fir_plan(&arena, eq_low_coefs, eq_low_num, block_sizes[b]);
+		W = fir_find_wisdom(eq_low_num, block_sizes[b], 1);
+		if(arena_mark(&arena) != mark) failed = 1;
+		if(W == NULL || W->kind != kind || !W->measured || W->ticks[FIR_DIRECT] == 0 || W->ticks[FIR_FOLDED] == 0) failed = 1;
+		if(kind != FIR_DIRECT && kind != FIR_FFT && kind != FIR_FOLDED) failed = 1;
+	}
+	F = init_fir(&arena, eq_low_coefs, eq_low_num, 100, FIR_PLAN);
+	if(F == NULL || F->kind != fir_find_wisdom(eq_low_num, 100, 1)->kind) failed = 1;
+	reset_arena(&arena);
+	report_fir_wisdom((void (*)(const char *))printf);
+
+	// exported, forgotten and imported back the plans are the same, marked as not timed this boot
+	bytes = fir_export_wisdom(saved, sizeof(saved));
+	if(bytes == 0 || fir_export_wisdom(saved, 8) != 0) failed = 1;
+	kind = fir_find_wisdom(eq_low_num, 256, 1)->kind;
+	fir_forget_wisdom();
+	if(fir_find_wisdom(eq_low_num, 256, 1) != NULL) failed = 1;
+	if(fir_import_wisdom(saved, bytes) != 0) failed = 1;
+	W = fir_find_wisdom(eq_low_num, 256, 1);
+	if(W == NULL || W->kind != kind || W->measured) failed = 1;
+	if(fir_plan(&arena, eq_low_coefs, eq_low_num, 256) != kind || W->measured) failed = 1;
+
+	// the same through a cache file
+	if(fir_save_wisdom(WISDOM_FILE) != 0) failed = 1;
+	fir_forget_wisdom();
+	if(fir_load_wisdom(WISDOM_FILE) != 0 || fir_find_wisdom(eq_low_num, 64, 1) == NULL) failed = 1;
+	remove(WISDOM_FILE);
+	if(fir_load_wisdom(WISDOM_FILE) == 0) failed = 1;
+
+	// erased flash and damaged wisdom are turned away, and leave the plans alone
+	memset(saved + 16, 0xFF, sizeof(saved) - 16 * sizeof(uint32_t));
+	if(fir_import_wisdom(saved, bytes) == 0) failed = 1;
+	memset(saved, 0xFF, sizeof(saved));
+	if(fir_import_wisdom(saved, sizeof(saved)) == 0) failed = 1;
+	if(fir_find_wisdom(eq_low_num, 64, 1) == NULL) failed = 1;
+
+
+	// a full table gives up one plan at a time for new ones, oldest first, and keeps the rest
+	fir_forget_wisdom();
+	input[0] = 0.25f; input[1] = 0.5f; input[2] = 0.25f;
+	for(b = 1; b <= FIR_WISDOM_SIZE + 2; b++) fir_plan(&arena, input, 3, b);
+	if(fir_find_wisdom(3, 1, 1) != NULL || fir_find_wisdom(3, 2, 1) != NULL) failed = 1;
+	for(b = 3; b <= FIR_WISDOM_SIZE + 2; b++) if(fir_find_wisdom(3, b, 1) == NULL) failed = 1;
+	reset_arena(&arena);
+
+
+	// the 48 tap lowpass is never worth an FFT, the 301 tap eq filters are at the default block size
+	if(fir_choose_kind(BL, 256) != FIR_DIRECT) failed = 1;
+	if(fir_choose_kind(eq_low_num, 100) != FIR_FFT) failed = 1;
+	if(fir_choose_kind(eq_low_num, 16) != FIR_DIRECT) failed = 1;
+
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
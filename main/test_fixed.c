@@ -0,0 +1,177 @@
+/**
+ * @file test_fixed.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the Q15/Q31 routines against the float 
+ * ones: the intrinsic emulation, the SNR of each routine, saturation, and the time each takes.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "arena.h"
+#include "fixed.h"
+#include "fir.h"
+#include "delay.h"
+#include "calc_rms.h"
+#include "eq.h"
+#include "profiler.h"
+
+#include "../filters/fir_lowpass.h"
+
+// ---------------------------------------------------------------------
+
+#define BLOCK 100
+#define FS 48000
+#define BLOCKS 200		// blocks of noise through each routine
+
+
+
+static uint8_t pool[ARENA_BUDGET];
+static ARENA_T arena;
+
+static float input[BLOCK], ref[BLOCK], out[BLOCK];
+static q15_t input_q15[BLOCK], out_q15[BLOCK];
+
+
+// running signal and error energy for the SNR
+typedef struct { double signal, error; } SNR_T;
+
+static void snr_add(SNR_T * S, int n) {
+	int i;
+	for(i = 0; i < n; i++) {
+		S->signal += (double)ref[i] * ref[i];
+		S->error += ((double)ref[i] - out[i]) * ((double)ref[i] - out[i]);
+	}
+}
+
+static double snr_db(const SNR_T * S) {
+	return 10.0 * log10(S->signal / S->error);
+}
+
+// a block of noise at half scale, as float and as the same Q15 values
+static void noise_block(void) {
+	int i;
+	for(i = 0; i < BLOCK; i++) input[i] = ((float)rand() / RAND_MAX) - 0.5f;
+	float_to_q15(input, input_q15, BLOCK);
+	q15_to_float(input_q15, input, BLOCK);
+}
+
+static int check(const char * name, double snr, double min_snr, uint32_t float_ticks, uint32_t fixed_ticks) {
+	printf("%-10s SNR %6.1f dB (need %4.0f), host time float %lu, fixed %lu ns\n", name, snr, min_snr,
+		(unsigned long)float_ticks, (unsigned long)fixed_ticks);
+	return snr < min_snr;
+}
+
+
+
+
+int main(int argc, char const *argv[]) {
+
+	int b, i, wrapped;
+	int failed = 0;
+	uint32_t t0, t_float, t_fixed;
+	SNR_T S;
+
+	init_arena(&arena, pool, sizeof(pool));
+	profile_start_clock();
+	srand(1);
+
+
+	// INTRINSIC EMULATION -----------------------------------------------------
+	// the corners where the board saturates or carries into 64 bits
+	if(__SSAT(40000, 16) != 32767 || __SSAT(-40000, 16) != -32768 || __SSAT(-5, 16) != -5) failed = 1;
+	if(__SMLALD(0x80008000u, 0x80008000u, 0) != ((uint64_t)1 << 31)) failed = 1;
+	if(__SMLALD(0x00020003u, 0x00050007u, 1) != 1 + 3*7 + 2*5) failed = 1;
+	if(__QSUB16(0x7FFF8000u, 0xFFFF0001u) != 0x7FFF8000u) failed = 1;
+	if(q30_to_q15((int64_t)1 << 31) != Q15_MAX || float_to_q15_one(-1.0f) != Q15_MIN) failed = 1;
+	printf("intrinsics: %s\n", failed ? "wrong" : "ok");
+
+
+	// LOWPASS -----------------------------------------------------------------
+	FIR_T * F = init_fir(&arena, B, BL, BLOCK, FIR_DIRECT);
+	FIR_Q15_T * Fq = init_fir_q15(&arena, B, BL, BLOCK);
+	S.signal = S.error = 0;
+	t_float = t_fixed = 0;
+	for(b = 0; b < BLOCKS; b++) {
+		noise_block();
+		t0 = profile_now(); calc_fir(F, input, ref, BLOCK); t_float += profile_now() - t0;
+		t0 = profile_now(); calc_fir_q15(Fq, input_q15, out_q15, BLOCK); t_fixed += profile_now() - t0;
+		q15_to_float(out_q15, out, BLOCK);
+		snr_add(&S, BLOCK);
+	}
+	failed |= check("lowpass", snr_db(&S), 70, t_float / BLOCKS, t_fixed / BLOCKS);
+
+
+	// DELAY -------------------------------------------------------------------
+	DELAY_T * D = init_delay(&arena, 1, FS, 0.01, 0.7, 1, BLOCK);
+	DELAY_Q15_T * Dq = init_delay_q15(&arena, 1, FS, 0.01, 0.7, 1, BLOCK);
+	S.signal = S.error = 0;
+	t_float = t_fixed = 0;
+	for(b = 0; b < BLOCKS; b++) {
+		noise_block();
+		t0 = profile_now(); calc_delay(D, input, ref, BLOCK); t_float += profile_now() - t0;
+		t0 = profile_now(); calc_delay_q15(Dq, input_q15, out_q15, BLOCK); t_fixed += profile_now() - t0;
+		q15_to_float(out_q15, out, BLOCK);
+		snr_add(&S, BLOCK);
+	}
+	failed |= check("delay", snr_db(&S), 85, t_float / BLOCKS, t_fixed / BLOCKS);
+
+
+	// RMS ---------------------------------------------------------------------
+	RMS_T * V = init_rms(&arena, 480);
+	RMS_Q31_T * Vq = init_rms_q31(&arena, 480);
+	S.signal = S.error = 0;
+	t_float = t_fixed = 0;
+	for(b = 0; b < BLOCKS; b++) {
+		noise_block();
+		t0 = profile_now(); calc_rms(V, input, ref, BLOCK); t_float += profile_now() - t0;
+		t0 = profile_now(); calc_rms_q31(Vq, input_q15, out_q15, BLOCK); t_fixed += profile_now() - t0;
+		q15_to_float(out_q15, out, BLOCK);
+		snr_add(&S, BLOCK);
+	}
+	failed |= check("rms", snr_db(&S), 80, t_float / BLOCKS, t_fixed / BLOCKS);
+
+
+	// EQ ----------------------------------------------------------------------
+	EQ_T * Q = init_eq(&arena, 6, -3, 3, BLOCK, FS);
+	EQ_Q15_T * Qq = init_eq_q15(&arena, 6, -3, 3, BLOCK, FS);
+	S.signal = S.error = 0;
+	t_float = t_fixed = 0;
+	for(b = 0; b < BLOCKS; b++) {
+		noise_block();
+		t0 = profile_now(); calc_eq(Q, input, ref, BLOCK); t_float += profile_now() - t0;
+		t0 = profile_now(); calc_eq_q15(Qq, input_q15, out_q15, BLOCK); t_fixed += profile_now() - t0;
+		q15_to_float(out_q15, out, BLOCK);
+		snr_add(&S, BLOCK);
+	}
+	failed |= check("eq", snr_db(&S), 65, t_float / BLOCKS, t_fixed / BLOCKS);
+	if(Q == NULL || Qq == NULL || F == NULL || Fq == NULL || D == NULL || Dq == NULL || V == NULL || Vq == NULL) failed = 1;
+
+
+	// SATURATION --------------------------------------------------------------
+	// full scale 100Hz square wave with every band at +15dB, well past full scale out of the eq.
+	// saturated samples stay at the rail with the right sign instead of wrapping around
+	Q = init_eq(&arena, 15, 15, 15, BLOCK, FS);
+	Qq = init_eq_q15(&arena, 15, 15, 15, BLOCK, FS);
+	wrapped = 0;
+	for(b = 0; b < 20; b++) {
+		for(i = 0; i < BLOCK; i++) input[i] = (((b * BLOCK + i) / 240) & 1) ? 1.0f : -1.0f;
+		float_to_q15(input, input_q15, BLOCK);
+		calc_eq(Q, input, ref, BLOCK);
+		calc_eq_q15(Qq, input_q15, out_q15, BLOCK);
+		for(i = 0; i < BLOCK; i++) if(fabsf(ref[i]) > 0.5f && (ref[i] > 0) != (out_q15[i] > 0)) wrapped++;
+	}
+	printf("saturation: %d samples wrapped\n", wrapped);
+	if(wrapped) failed = 1;
+
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
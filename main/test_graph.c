@@ -0,0 +1,243 @@
+/**
+ * @file test_graph.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the effect graph buffer planning and processing.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "arena.h"
+#include "effect_graph.h"
+#include "profiler.h"
+
+// ---------------------------------------------------------------------
+
+#define BLOCK 8
+
+
+
+// test effect: multiplies the input by params[0] -------------------------
+
+typedef struct { float gain; int block_size; } GAIN_T;
+
+static void * gain_init(ARENA_T * A, const float * params, int block_size, int FS) {
+	GAIN_T * N = (GAIN_T *)arena_alloc(A, sizeof(GAIN_T));
+	if(N == NULL) return NULL;
+	N->gain = params[0];
+	N->block_size = block_size;
+	return N;
+}
+static void gain_process(void * state, const float * input, float * output, int n) {
+	int i;
+	GAIN_T * N = (GAIN_T *)state;
+	for(i = 0; i < n; i++) output[i] = N->gain * input[i];
+}
+static const EFFECT_OPS_T gain_node = { "gain", gain_init, gain_process };
+
+// the gain with a block rate update that counts the blocks it has seen
+static int updates = 0;
+static void gain_update(void * state) { updates++; }
+static const EFFECT_OPS_T counted_node = { "counted", gain_init, gain_process, NULL, NULL, gain_update };
+
+// a cheaper tier of the same effect, at twice the gain so the crossfade shows in the output
+static void * gain2_init(ARENA_T * A, const float * params, int block_size, int FS) {
+	GAIN_T * N = (GAIN_T *)gain_init(A, params, block_size, FS);
+	if(N != NULL) N->gain *= 2;
+	return N;
+}
+static const EFFECT_OPS_T gain2_node = { "gain/2", gain2_init, gain_process };
+static const EFFECT_OPS_T * const gain_tiers[2] = { &gain_node, &gain2_node };
+
+// tiers with history: the gain tiers delayed by DELAY samples
+#define DELAY 5
+typedef struct { GAIN_T * gain; float line[DELAY]; int pos; } LAG_T;
+
+static void * lag_init(ARENA_T * A, const float * params, int block_size, int FS) {
+	LAG_T * N = (LAG_T *)arena_alloc(A, sizeof(LAG_T));
+	if(N == NULL) return NULL;
+	N->gain = (GAIN_T *)gain_init(A, params, block_size, FS);
+	return (N->gain == NULL) ? NULL : N;
+}
+static void * lag2_init(ARENA_T * A, const float * params, int block_size, int FS) {
+	LAG_T * N = (LAG_T *)lag_init(A, params, block_size, FS);
+	if(N != NULL) N->gain->gain *= 2;
+	return N;
+}
+static void lag_process(void * state, const float * input, float * output, int n) {
+	int i;
+	float x;
+	LAG_T * N = (LAG_T *)state;
+	for(i = 0; i < n; i++) {
+		x = input[i];
+		output[i] = N->gain->gain * N->line[N->pos];
+		N->line[N->pos] = x;
+		N->pos = (N->pos + 1) % DELAY;
+	}
+}
+static int lag_tail(void * state) { return DELAY; }
+static int lag_latency(void * state) { return DELAY; }
+static void lag_reset(void * state) {
+	LAG_T * N = (LAG_T *)state;
+	for(N->pos = 0; N->pos < DELAY; N->pos++) N->line[N->pos] = 0;
+	N->pos = 0;
+}
+static const EFFECT_OPS_T lag_node = { "lag", lag_init, lag_process, lag_tail, lag_reset, NULL, lag_latency };
+static const EFFECT_OPS_T lag2_node = { "lag/2", lag2_init, lag_process, lag_tail, lag_reset, NULL, lag_latency };
+static const EFFECT_OPS_T * const lag_tiers[2] = { &lag_node, &lag2_node };
+
+static uint8_t pool[16 * 1024];
+static ARENA_T arena;
+
+
+
+
+int main(int argc, char const *argv[]) {
+
+	int i, n, a, b, mix;
+	int failed = 0;
+	float one = 1.0, two = 2.0, three = 3.0;
+	float input[BLOCK], output[BLOCK];
+	int branches[2];
+	float gains[2] = {1.0, 0.5};
+	GRAPH_T * G;
+
+	for(i = 0; i < BLOCK; i++) input[i] = i;
+	init_arena(&arena, pool, sizeof(pool));
+
+
+	// 5 stage serial chain -> runs in place, no intermediate buffers past the first
+	G = init_graph(&arena, BLOCK, 48000);
+	n = GRAPH_INPUT;
+	for(i = 0; i < 5; i++) n = graph_add_effect(G, &gain_node, &two, n);
+	plan_graph(G, n);
+	run_graph(G, input, output);
+	printf("serial chain: %d buffers, output[3] = %g\n", G->num_buffers, output[3]);
+	if(G->num_buffers != 1 || output[3] != 3 * 32) failed = 1;
+	reset_arena(&arena);		// reconfigure
+
+
+	// split into two branches, process each, mix back together, then one more stage
+	//   input -> a (x2) -> a2 (x2) ---> mix (1.0, 0.5) -> x2 -> output
+	//   input -> b (x3) ------------/
+	G = init_graph(&arena, BLOCK, 48000);
+	a = graph_add_effect(G, &gain_node, &two, GRAPH_INPUT);
+	b = graph_add_effect(G, &gain_node, &three, GRAPH_INPUT);
+	branches[0] = graph_add_effect(G, &gain_node, &two, a);
+	branches[1] = b;
+	mix = graph_add_mix(G, 2, branches, gains);
+	n = graph_add_effect(G, &gain_node, &two, mix);
+	plan_graph(G, n);
+	run_graph(G, input, output);
+	printf("split/merge: %d buffers, output[3] = %g\n", G->num_buffers, output[3]);
+	if(G->num_buffers != 2 || output[3] != 2 * ((4 * 3) + (0.5 * 9))) failed = 1;
+
+	// same graph, every node timed as a profiler stage (the host build has GAPE_PROFILE)
+	PROFILE_STATS_T S;
+	PROFILER_T * P = init_profiler(&arena, GRAPH_MAX_NODES);
+	if(P == NULL || graph_set_profiler(G, P)) failed = 1;
+	for(i = 0; i < 3; i++) run_graph(G, input, output);
+	profile_stats(P, profile_find_stage(P, "mix"), &S);
+	printf("profiled: %d stages, mix ran %u times\n", P->num_stages, S.count);
+	if(P->num_stages != 5 || S.count != 3) failed = 1;
+	reset_arena(&arena);
+
+
+	// block rate updates run after process, or only when the caller asks once they are deferred
+	G = init_graph(&arena, BLOCK, 48000);
+	n = graph_add_effect(G, &counted_node, &two, GRAPH_INPUT);
+	if(n < 0 || plan_graph(G, n)) failed = 1;
+	run_graph(G, input, output);
+	graph_defer_updates(G, 1);
+	run_graph(G, input, output);
+	run_graph(G, input, output);
+	printf("updates: %d after 3 blocks with the last 2 deferred", updates);
+	if(updates != 1) failed = 1;
+	update_graph(G);
+	printf(", %d after update_graph()\n", updates);
+	if(updates != 2) failed = 1;
+	reset_arena(&arena);
+
+
+	// effect with two tiers, a step down to 2x cuts over at once, a step up crossfades back over two blocks
+	G = init_graph(&arena, BLOCK, 48000);
+	n = graph_add_tiers(G, gain_tiers, 2, &one, 2 * BLOCK, GRAPH_INPUT);
+	if(n < 0 || plan_graph(G, n) || G->num_levels != 2) failed = 1;
+	for(i = 0; i < BLOCK; i++) input[i] = 1.0;
+	run_graph(G, input, output);
+	if(output[BLOCK - 1] != 1.0) failed = 1;
+	graph_set_quality(G, 1);
+	run_graph(G, input, output);
+	printf("tier cut: %g .. %g", output[0], output[BLOCK - 1]);
+	if(output[0] != 2.0 || G->nodes[n].tier != 1 || G->nodes[n].fade_to != -1) failed = 1;
+	graph_set_quality(G, 0);
+	run_graph(G, input, output);
+	printf(", fade: first block %g .. %g", output[0], output[BLOCK - 1]);
+	for(i = 0; i < BLOCK; i++) if(fabsf(output[i] - (2.0 - (i + 1) / (2.0 * BLOCK))) > 1e-6) failed = 1;
+	run_graph(G, input, output);
+	printf(", second block ends at %g", output[BLOCK - 1]);
+	if(output[BLOCK - 1] != 1.0 || G->nodes[n].tier != 0 || G->nodes[n].fade_to != -1) failed = 1;
+	run_graph(G, input, output);
+	printf(", then %g\n", output[0]);
+	if(output[0] != 1.0) failed = 1;
+
+	// a step down halfway through a step up drops the fade, the cheaper tier never stopped
+	graph_set_quality(G, 1);
+	run_graph(G, input, output);
+	graph_set_quality(G, 0);
+	run_graph(G, input, output);
+	graph_set_quality(G, 1);
+	run_graph(G, input, output);
+	printf("step up dropped: %g .. %g, tier %d\n", output[0], output[BLOCK - 1], G->nodes[n].tier);
+	if(output[0] != 2.0 || output[BLOCK - 1] != 2.0 || G->nodes[n].tier != 1 || G->nodes[n].fade_to != -1) failed = 1;
+	reset_arena(&arena);
+
+
+	// latency along the path to the output: a lag on one branch of a mix, then another after it
+	G = init_graph(&arena, BLOCK, 48000);
+	a = graph_add_effect(G, &lag_node, &one, GRAPH_INPUT);
+	branches[0] = a;
+	branches[1] = graph_add_effect(G, &gain_node, &one, GRAPH_INPUT);
+	mix = graph_add_mix(G, 2, branches, gains);
+	n = graph_add_effect(G, &lag_node, &one, mix);
+	if(n < 0 || plan_graph(G, n)) failed = 1;
+	printf("latency: %d samples through two lags, %d to the first\n", G->latency, DELAY);
+	if(G->latency != 2 * DELAY) failed = 1;
+	if(plan_graph(G, a) || G->latency != DELAY) failed = 1;
+	reset_arena(&arena);
+
+
+	// tiers with history: a step down is primed on the input the graph kept, and a step back up
+	// after silence can't bring back what the better tier held when it was left
+	G = init_graph(&arena, BLOCK, 48000);
+	n = graph_add_tiers(G, lag_tiers, 2, &one, BLOCK, GRAPH_INPUT);
+	if(n < 0 || plan_graph(G, n) || G->latency != DELAY) failed = 1;
+	for(i = 0; i < BLOCK; i++) input[i] = 1.0;
+	for(i = 0; i < 4; i++) run_graph(G, input, output);
+	graph_set_quality(G, 1);
+	run_graph(G, input, output);
+	printf("tier with history: primed on %d blocks, cut to %g .. %g", G->nodes[n].history_blocks, output[0], output[BLOCK - 1]);
+	for(i = 0; i < BLOCK; i++) if(output[i] != 2.0) failed = 1;
+	if(G->nodes[n].history_blocks != 1 || G->nodes[n].tier != 1) failed = 1;
+	for(i = 0; i < BLOCK; i++) input[i] = 0.0;
+	run_graph(G, input, output);
+	graph_set_quality(G, 0);
+	float stale = 0;
+	for(i = 0; i < 4; i++) {
+		run_graph(G, input, output);
+		for(a = 0; a < BLOCK; a++) stale = fmaxf(stale, fabsf(output[a]));
+	}
+	printf(", back up after silence %g left over, tier %d\n", stale, G->nodes[n].tier);
+	if(stale != 0 || G->nodes[n].tier != 0) failed = 1;
+	reset_arena(&arena);
+
+
+	return failed;
+
+}
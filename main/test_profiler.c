@@ -0,0 +1,95 @@
+/**
+ * @file test_profiler.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the profiler statistics.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "arena.h"
+#include "profiler.h"
+
+// ---------------------------------------------------------------------
+
+
+
+
+static uint8_t pool[16 * 1024];
+static ARENA_T arena;
+
+static volatile float sink;		// keeps the timed loop from being optimized away
+
+
+static void print_line(const char * s) { fputs(s, stdout); }
+
+// percentiles come from 25% wide buckets, so they can be up to 25% over the true value
+static int near(uint32_t got, uint32_t want) {
+	return (got >= want) && (got <= want + (want / 4));
+}
+
+
+int main(int argc, char const *argv[]) {
+
+	int i, a, b;
+	int failed = 0;
+	PROFILE_STATS_T S;
+	PROFILER_T * P;
+
+	init_arena(&arena, pool, sizeof(pool));
+	P = init_profiler(&arena, 3);
+	a = profile_add_stage(P, "a");
+	b = profile_add_stage(P, "b");
+	if(P == NULL || a != 0 || b != 1 || profile_find_stage(P, "b") != b) failed = 1;
+	profile_add_stage(P, "c");
+	if(profile_add_stage(P, "d") != -1) failed = 1;		// out of stages
+
+
+	// 1000 to 1999 ticks once each, and one outlier
+	for(i = 1000; i < 2000; i++) profile_record(P, a, i);
+	profile_record(P, a, 100000);
+	profile_stats(P, a, &S);
+	printf("a: count %u min %u mean %u p50 %u p99 %u max %u\n", S.count, S.min, S.mean, S.p50, S.p99, S.max);
+	if(S.count != 1001 || S.min != 1000 || S.max != 100000) failed = 1;
+	if(S.mean != (1499500 + 100000) / 1001) failed = 1;
+	if(!near(S.p50, 1500) || !near(S.p99, 1990)) failed = 1;
+
+
+	// small times and a time recorded near the top of the counter, for the last bucket
+	reset_profiler(P);
+	for(i = 0; i < 4; i++) profile_record(P, a, i);
+	profile_record(P, a, 0xFFFFFFF0u);
+	profile_stats(P, a, &S);
+	printf("a after reset: count %u min %u p50 %u max 0x%08X\n", S.count, S.min, S.p50, S.max);
+	if(S.count != 5 || S.min != 0 || S.p50 != 2 || S.max != 0xFFFFFFF0u) failed = 1;
+
+
+	// a real timed stage
+	PROFILE_BEGIN(P, b);
+	for(i = 0; i < 100000; i++) sink += i;
+	PROFILE_END(P, b);
+	profile_stats(P, b, &S);
+	printf("b: count %u max %u load %.1f%%\n", S.count, S.max, S.load);
+	if(S.count != 1 || S.max == 0 || S.load <= 0 || S.load > 100) failed = 1;
+
+
+	// the load since a reset 10 s ago, longer than the 32 bit tick lasts, with 1 s in the stage
+	reset_profiler(P);
+	P->epoch -= 10ull * profile_ticks_per_sec();
+	profile_record(P, a, profile_ticks_per_sec());
+	profile_stats(P, a, &S);
+	printf("a over 10 s: load %.1f%%\n", S.load);
+	if(S.load < 9.5f || S.load > 10.0f) failed = 1;
+
+
+	report_profiler(P, print_line);
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
@@ -0,0 +1,96 @@
+/**
+ * @file test_quality.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the quality scheduler's hysteresis.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "arena.h"
+#include "quality.h"
+
+// ---------------------------------------------------------------------
+
+#define BLOCK 100
+#define FS 48000
+
+
+
+static uint8_t pool[1024];
+static ARENA_T arena;
+
+static void print_line(const char * s) { fputs(s, stdout); }
+
+
+// feed the same block time a number of times, count the level changes
+static int feed(QUALITY_T * Q, uint32_t ticks, int blocks) {
+	int i, changes = 0;
+	for(i = 0; i < blocks; i++) changes += quality_update(Q, ticks);
+	return changes;
+}
+
+
+int main(int argc, char const *argv[]) {
+
+	int failed = 0;
+	int second = FS / BLOCK;
+	uint32_t busy, mid, idle;
+	QUALITY_T * Q;
+
+	init_arena(&arena, pool, sizeof(pool));
+	Q = init_quality(&arena, 3, BLOCK, FS);
+	if(Q == NULL) { printf("could not initialize\n"); return 1; }
+
+	// over the high mark, between the marks, and under the low mark
+	busy = Q->high + 1;
+	mid = (Q->high + Q->low) / 2;
+	idle = Q->low - 1;
+
+
+	// one slow block on its own is not enough, two in a row step down
+	feed(Q, busy, 1);
+	feed(Q, idle, 1);
+	if(Q->level != 0) failed = 1;
+	if(feed(Q, busy, 2) != 1 || Q->level != 1) failed = 1;
+
+	// blocks while the new tier settles in are ignored, then it keeps stepping down to the last level and stays there
+	feed(Q, busy, QUALITY_SETTLE_BLOCKS + 2);
+	feed(Q, busy, QUALITY_SETTLE_BLOCKS + 10);
+	printf("under load: level %d\n", Q->level);
+	if(Q->level != 2 || Q->steps_down != 2) failed = 1;
+
+	// between the marks it holds, it only steps up after a full second with room
+	feed(Q, mid, 5 * second);
+	if(Q->level != 2) failed = 1;
+	feed(Q, idle, second - 1);
+	if(Q->level != 2) failed = 1;
+	if(feed(Q, idle, 1) != 1 || Q->level != 1) failed = 1;
+
+	// the step up didn't hold, so the next one waits twice as long
+	feed(Q, busy, QUALITY_SETTLE_BLOCKS + 2);
+	printf("after a failed step up: level %d, up wait %d blocks\n", Q->level, Q->up_wait);
+	if(Q->level != 2 || Q->up_wait != 2 * second) failed = 1;
+	feed(Q, idle, QUALITY_SETTLE_BLOCKS + second);
+	if(Q->level != 2) failed = 1;
+	feed(Q, idle, second);
+	if(Q->level != 1) failed = 1;
+
+	// once it holds at that level the wait goes back to one second
+	feed(Q, mid, QUALITY_SETTLE_BLOCKS + 2 * second);
+	feed(Q, idle, second);
+	printf("recovered: level %d, up wait %d blocks\n", Q->level, Q->up_wait);
+	if(Q->level != 0 || Q->up_wait != second) failed = 1;
+
+	report_quality(Q, print_line);
+
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
@@ -0,0 +1,239 @@
+/**
+ * @file test_render.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the WAV files and the renderer: every sample
+ * format written and read back, a file cut off before its header was written, extensible fmt chunks
+ * whole and cut short, and a tone burst rendered through a delay between rates, which has to come
+ * out where and as loud as the chain puts it.
+ *
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "arena.h"
+#include "dsp.h"
+#include "wav.h"
+#include "render.h"
+#include "effect_nodes.h"
+
+// ---------------------------------------------------------------------
+
+#define IN_FILE "test_render_in.wav"
+#define OUT_FILE "test_render_out.wav"
+#define FRAMES 1000			// frames in the format round trips
+#define RATE 44100			// rate of the rendered file, a second of it. the chain runs at 48kHz
+#define BURST_AT 0.1		// center of the tone burst in seconds
+#define BURST_LEN 0.02		// length of the burst in seconds
+#define TONE 1000.0			// inside the lowpass passband
+#define ECHO 0.25			// delay in seconds
+#define ECHO_GAIN 0.5
+#define MAX_ERROR 0.03		// the 48kHz lowpass table ripples about 0.5 dB through its passband, a sample late is 0.07
+#define MAX_BLOCK_ERROR 1e-5	// direct form or FFT filters at the two block sizes
+
+
+
+static uint8_t pool[RENDER_ARENA_BYTES];
+static ARENA_T arena;
+
+static float left[FRAMES], right[FRAMES], mono[FRAMES];
+static float input[RATE];
+static float output[2][2 * RATE];
+
+static void print_line(const char * s) { fputs(s, stdout); }
+
+
+// a mono float WAV_TAG_EXTENSIBLE file with fmt_size bytes of its 40 byte fmt chunk, and two samples.
+// the first sample's low bytes read as the float tag, where the subformat is in a full chunk
+static void write_extensible(const char * path, int fmt_size) {
+
+	uint8_t fmt[40] = { 0xFE, 0xFF, 1, 0, 0x80, 0xBB, 0, 0, 0, 0xEE, 2, 0, 4, 0, 32, 0,
+		22, 0, 32, 0, 4, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0x10, 0, 0x80, 0, 0, 0xAA, 0, 0x38, 0x9B, 0x71 };
+	uint8_t data[8] = { 3, 0, 0, 0, 0, 0, 0, 0 };
+	uint8_t word[4];
+	FILE * file = fopen(path, "wb");
+
+	fputs("RIFF", file);
+	word[0] = 4 + 8 + fmt_size + 8 + 8; word[1] = word[2] = word[3] = 0;
+	fwrite(word, 1, 4, file);
+	fputs("WAVEfmt ", file);
+	word[0] = fmt_size;
+	fwrite(word, 1, 4, file);
+	fwrite(fmt, 1, fmt_size, file);
+	fputs("data", file);
+	word[0] = 8;
+	fwrite(word, 1, 4, file);
+	fwrite(data, 1, 8, file);
+	fclose(file);
+
+}
+
+
+// hann windowed tone, 0.5 at its peak
+static double burst(double t) {
+	t -= BURST_AT - (BURST_LEN / 2);
+	if(t < 0 || t > BURST_LEN) return 0;
+	return 0.5 * sin(2.0 * M_PI * TONE * t) * 0.5 * (1 - cos(2.0 * M_PI * t / BURST_LEN));
+}
+
+
+// render the input file through an echo, and read the output back. returns the number of frames, 0 on error
+static int render(int block_size, int stereo, float * wet, float * dry, double * offset) {
+
+	WAV_T in, out;
+	RENDER_T * R;
+	RENDER_FX_T fx;
+	RENDER_OPTS_T opts = { 0, 0, block_size, WAV_FLOAT32, stereo };
+	int i, n;
+	char spec[64];
+
+	reset_arena(&arena);
+	snprintf(spec, sizeof(spec), "delay:%g,%g,1", ECHO, ECHO_GAIN);
+	if(render_parse_effect(spec, &fx) != 0 || open_wav(&in, IN_FILE) != 0) return 0;
+	R = init_render(&arena, &in, &fx, 1, &opts);
+	if(R == NULL || create_wav(&out, &arena, OUT_FILE, R->out_rate, stereo ? 2 : 1, opts.format) != 0) return 0;
+	if(run_render(R, &out) != 0 || close_wav(&out) != 0) return 0;
+	close_wav(&in);
+	report_render(R, print_line);
+
+	// the lowpass delay, and what was left over from rounding the converters' delays off
+	*offset = ((R->lowpass_taps - 1) / 2.0 + (R->up->delay - (int)(R->up->delay + 0.5f))) / R->FS
+		+ (R->down->delay - (int)(R->down->delay + 0.5f)) / R->out_rate;
+
+	if(open_wav(&in, OUT_FILE) != 0 || in.frames != R->total || in.channels != (stereo ? 2 : 1)) return 0;
+	n = (int)in.frames;
+	if(!stereo) {
+		read_wav(&in, 0, wet, n);
+	} else {
+		// the left channel is the average minus half the right, read the right on its own
+		read_wav(&in, 0, dry, n);
+		for(i = 0; i < n; i++) {
+			memcpy(&wet[i], in.data + (i * in.frame_bytes) + sizeof(float), sizeof(float));
+			dry[i] = (2 * dry[i]) - wet[i];
+		}
+	}
+	close_wav(&in);
+
+	return n;
+
+}
+
+
+int main(int argc, char const *argv[]) {
+
+	int i, f, n, n_small;
+	int failed = 0;
+	double err, want, offset, t;
+	float tol;
+	WAV_T W;
+	RENDER_FX_T fx;
+	FILE * file;
+	uint8_t all_ones[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+
+	init_arena(&arena, pool, sizeof(pool));
+	dsp_select(NULL);
+
+
+	// every format written in stereo, read back as the average of the two
+	for(i = 0; i < FRAMES; i++) {
+		left[i] = sinf(0.01f * i);
+		right[i] = 0.5f * cosf(0.003f * i) - 0.2f;
+	}
+	left[0] = 1.5f;		// clipped
+	right[0] = -1.5f;
+
+	for(f = 0; f < WAV_NUM_FORMATS; f++) {
+		reset_arena(&arena);
+		if(create_wav(&W, &arena, IN_FILE, 44100, 2, f) != 0) { printf("could not create %s\n", IN_FILE); return 1; }
+		if(write_wav(&W, left, right, FRAMES / 2) != 0 || write_wav(&W, left + FRAMES / 2, right + FRAMES / 2, FRAMES / 2) != 0) failed = 1;
+		if(close_wav(&W) != 0) failed = 1;
+
+		if(open_wav(&W, IN_FILE) != 0) { printf("could not read back %s\n", wav_format_names[f]); return 1; }
+		n = read_wav(&W, 0, mono, FRAMES + 10);
+		tol = (f == WAV_PCM16) ? 1.0f / 32768 : 1e-6f;	// half a code each channel
+		err = 0;
+		for(i = 0; i < n; i++) {
+			want = 0.5 * (fmax(-1, fmin(1, left[i])) + fmax(-1, fmin(1, right[i])));
+			err = fmax(err, fabs(mono[i] - want));
+		}
+		printf("%-7s %d Hz, %d channels, %d frames, max error %g\n", wav_format_names[f], W.FS, W.channels, n, err);
+		if(n != FRAMES || W.FS != 44100 || W.channels != 2 || W.format != f || err > tol) failed = 1;
+		close_wav(&W);
+	}
+
+	// a recording cut off before the sizes were written reads to the end of the file
+	file = fopen(IN_FILE, "r+b");
+	fseek(file, 40, SEEK_SET);
+	fwrite(all_ones, 1, 4, file);
+	fclose(file);
+	if(open_wav(&W, IN_FILE) != 0 || W.frames != FRAMES) failed = 1;
+	close_wav(&W);
+
+	// an extensible fmt chunk is read up to its subformat, one cut short of it isn't read past its end
+	write_extensible(IN_FILE, 40);
+	if(open_wav(&W, IN_FILE) != 0 || W.format != WAV_FLOAT32 || W.channels != 1 || W.FS != 48000 || W.frames != 2) failed = 1;
+	close_wav(&W);
+	write_extensible(IN_FILE, 16);
+	if(open_wav(&W, IN_FILE) == 0) failed = 1;
+	write_extensible(IN_FILE, 18);
+	if(open_wav(&W, IN_FILE) == 0) failed = 1;
+
+	// not a WAV file at all
+	file = fopen(IN_FILE, "wb");
+	fputs("RIFF0000WAVEdata", file);
+	fclose(file);
+	if(open_wav(&W, IN_FILE) == 0) failed = 1;
+
+
+	// RENDER ------------------------------------------------------------
+	// a tone burst at 44.1kHz through a quarter second echo at 48kHz, and back
+	for(i = 0; i < RATE; i++) input[i] = (float)burst((double)i / RATE);
+	reset_arena(&arena);
+	if(create_wav(&W, &arena, IN_FILE, RATE, 1, WAV_FLOAT32) != 0) { printf("could not create %s\n", IN_FILE); return 1; }
+	write_wav(&W, input, NULL, RATE);
+	close_wav(&W);
+
+	n = render(0, 0, output[0], NULL, &offset);
+	if(n == 0) { printf("could not render\n"); return 1; }
+
+	// the burst, then the echo, both as late as the lowpass delays them
+	err = 0;
+	for(i = 0; i < n; i++) {
+		t = ((double)i / RATE) - offset;
+		err = fmax(err, fabs(output[0][i] - (burst(t) + ECHO_GAIN * burst(t - ECHO))));
+	}
+	printf("%d frames out (%d in), burst and echo max error %g\n", n, RATE, err);
+	if(n <= RATE || err > MAX_ERROR) failed = 1;
+
+	// in small blocks it is the same, and in stereo the dry signal comes out the left
+	n_small = render(100, 1, output[1], output[0], &offset);
+	err = 0;
+	for(i = 0; i < n_small; i++) err = fmax(err, fabs(output[0][i] - burst(((double)i / RATE) - offset)));
+	printf("stereo, blocks of 100: %d frames, dry max error %g\n", n_small, err);
+	if(n_small != n || err > MAX_ERROR) failed = 1;
+
+	n = render(0, 0, output[0], NULL, &offset);
+	err = 0;
+	for(i = 0; i < n; i++) err = fmax(err, fabs(output[0][i] - output[1][i]));
+	printf("blocks of %d against 100: max difference %g\n", RENDER_BLOCK, err);
+	if(err > MAX_BLOCK_ERROR) failed = 1;
+
+	// an effect that isn't there, a parameter that isn't a number, too many parameters
+	if(render_parse_effect("reverb", &fx) == 0 || render_parse_effect("eq:3,x", &fx) == 0 || render_parse_effect("eq:1,2,3,4", &fx) == 0) failed = 1;
+	if(render_parse_effect("compressor:-6", &fx) != 0 || fx.params[0] != -6 || fx.params[1] != 2) failed = 1;
+	if(render_parse_effect("preset:4", &fx) != 0 || fx.ops != &compressor_node || fx.params[1] != 9) failed = 1;
+	if(render_parse_effect("preset:12", &fx) == 0 || render_parse_effect("preset", &fx) == 0) failed = 1;
+
+	remove(IN_FILE);
+	remove(OUT_FILE);
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
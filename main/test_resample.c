@@ -0,0 +1,154 @@
+/**
+ * @file test_resample.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the sample rate converter: a sine through each 
+ * pair of rates against the same sine at the output rate, a tone above the output Nyquist frequency,
+ * the same stream in blocks of different sizes, and the converter on each dsp backend.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "arena.h"
+#include "dsp.h"
+#include "profiler.h"
+#include "resample.h"
+
+// ---------------------------------------------------------------------
+
+#define SECONDS 0.25			// of signal through each converter
+#define MAX_IN 24000			// SECONDS at 96kHz
+#define MAX_OUT (MAX_IN * 3 + 16)
+#define TONE 1000.0				// Hz
+#define MIN_SNR 75.0			// dB, the prototype stops around 80
+#define MIN_REJECT 70.0			// dB a tone past the output Nyquist frequency comes out under
+
+
+
+static uint8_t pool[ARENA_BUDGET];
+static ARENA_T arena;
+
+static float input[MAX_IN];
+static float output[MAX_OUT], other[MAX_OUT];
+
+
+// run n inputs through a converter in blocks of block_size, or of varying size if 0, returns the outputs
+static int run(RESAMPLE_T * R, int n, int block_size, float * out) {
+
+	int i, m, count = 0;
+
+	for(i = 0; i < n; i += m) {
+		m = (block_size > 0) ? block_size : 1 + (rand() % R->block_size);
+		if(m > n - i) m = n - i;
+		count += calc_resample(R, input + i, out + count, m);
+	}
+
+	return count;
+
+}
+
+
+// snr of the output against the tone at the output rate, past the start up, in dB
+static double snr(const RESAMPLE_T * R, const float * out, int count, double f) {
+
+	int k;
+	double t, want, sig = 0, err = 0;
+
+	for(k = 2 * (int)R->delay; k < count - (int)R->delay; k++) {
+		// output k is input time k * in / out, the prototype delays it num_taps / 2 inputs
+		t = ((double)k * R->in_rate / R->out_rate) - (0.5 * R->num_taps);
+		want = 0.5 * sin(2.0 * M_PI * f * t / R->in_rate);
+		sig += want * want;
+		err += (out[k] - want) * (out[k] - want);
+	}
+
+	return 10.0 * log10(sig / err);
+
+}
+
+
+
+
+int main(int argc, char const *argv[]) {
+
+	int i, r, b, n, count, expect;
+	int failed = 0;
+	int rates[6][2] = { {44100, 48000}, {48000, 44100}, {32000, 44100}, {48000, 96000}, {96000, 32000}, {44100, 44100} };
+	double s, peak;
+	uint32_t t0;
+	RESAMPLE_T * R;
+	const DSP_BACKEND_T * B;
+
+	init_arena(&arena, pool, sizeof(pool));
+	profile_start_clock();
+	srand(1);
+
+
+	// a tone through every pair, in odd sized blocks
+	for(r = 0; r < 6; r++) {
+
+		reset_arena(&arena);
+		R = init_resample(&arena, rates[r][0], rates[r][1], 256);
+		if(R == NULL) { printf("%d to %d could not initialize\n", rates[r][0], rates[r][1]); return 1; }
+
+		n = (int)(SECONDS * R->in_rate);
+		for(i = 0; i < n; i++) input[i] = (float)(0.5 * sin(2.0 * M_PI * TONE * i / R->in_rate));
+		count = run(R, n, 0, output);
+		expect = (int)(((long long)n * R->out_rate + R->in_rate - 1) / R->in_rate);
+		s = snr(R, output, count, TONE);
+
+		printf("%5d to %5d: %d/%d, %d phases%s of %d taps, %d outputs (want %d), snr %.1f dB\n", R->in_rate, R->out_rate,
+			R->up, R->down, R->num_phases, (R->num_phases < R->up) ? " interpolated" : "", R->num_taps, count, expect, s);
+		if(count != expect || s < MIN_SNR) failed = 1;
+
+		// the same stream in fixed blocks comes out the same
+		reset_resample(R);
+		if(run(R, n, 100, other) != count || memcmp(output, other, sizeof(float) * count) != 0) failed = 1;
+
+	}
+
+
+	// down to 32kHz, a tone at 20kHz has nowhere to go but alias down to 12kHz
+	reset_arena(&arena);
+	R = init_resample(&arena, 48000, 32000, 256);
+	n = (int)(SECONDS * 48000);
+	for(i = 0; i < n; i++) input[i] = (float)(0.5 * sin(2.0 * M_PI * 20000.0 * i / 48000));
+	count = run(R, n, 256, output);
+	peak = 0;
+	for(i = 2 * (int)R->delay; i < count; i++) peak = fmax(peak, fabs(output[i]));
+	printf("20kHz into 32kHz: comes out %.1f dB down\n", 20.0 * log10(0.5 / peak));
+	if(20.0 * log10(0.5 / peak) < MIN_REJECT) failed = 1;
+
+
+	// every backend converts the same, timed per output
+	reset_arena(&arena);
+	R = init_resample(&arena, 44100, 48000, 256);
+	n = (int)(SECONDS * 44100);
+	for(i = 0; i < n; i++) input[i] = ((float)rand() / RAND_MAX) - 0.5f;
+	dsp_select("scalar");
+	count = run(R, n, 256, other);
+	for(b = 0; (B = dsp_get_backend(b)) != NULL; b++) {
+		dsp_select(B->name);
+		reset_resample(R);
+		t0 = profile_now();
+		run(R, n, 256, output);
+		t0 = profile_now() - t0;
+		peak = 0;
+		for(i = 0; i < count; i++) peak = fmax(peak, fabs(output[i] - other[i]));
+		printf("%-8s 44.1kHz to 48kHz: %.1f ns per output, max difference from scalar %g\n", B->name, (double)t0 / count, peak);
+		if(peak > 1e-5) failed = 1;
+	}
+	dsp_select(NULL);
+
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
@@ -11,7 +11,9 @@
 // include files -------------------------------------------------------
 #include <stdlib.h>
 #include <stdio.h>
+#include <math.h>
 
+#include "arena.h"
 #include "calc_rms.h"
 
 // ---------------------------------------------------------------------
@@ -19,33 +21,59 @@
 
 
 
+// all the test state comes out of this arena
+static uint8_t pool[ARENA_BUDGET];
+static ARENA_T arena;
+
 // this is a very minimal test, but I did the calculation by hand, 
  // the matlab test script, and this routine, and found the same answer of 
  // 0.5339
- // More extensive testing, for multiple blocks should probably be implemented.
+ // The blocks after it are checked against the rms worked out directly.
 
 int main(int argc, char const *argv[]) {
 
 
-	int block_size, i, j;
+	int block_size, i, b, k;
+	int failed = 0;
 	block_size = 10;
 	float input[10] = {0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9};
+	float signal[30];
+	double sum, err, max_err = 0.0;
 
 
-	// setup rms struct
-	RMS_T * V = init_rms(10, block_size);
+	float output[10];
+
 
-	calc_rms(V, input);
+	// setup rms struct
+	init_arena(&arena, pool, sizeof(pool));
+	RMS_T * V = init_rms(&arena, 10);
+	if(V == NULL) { printf("could not initialize\n"); return 1; }
 
-	// for(i = 0; i < block_size; i++) {
-	// 	printf("%f,", V->output[i]);
-	// }
+	calc_rms(V, input, output, block_size);
 
-	printf("%f", V->output[block_size - 1]);
+	printf("%f\n", output[block_size - 1]);
+	if(fabs(output[block_size - 1] - 0.5339) > 5e-5) failed = 1;
 
 
-}
+	// a few more blocks against the rms of the last 10 samples worked out directly,
+	// the samples before the start count as silence
+	for(i = 0; i < 10; i++) signal[i] = input[i];
+	for(i = 10; i < 30; i++) signal[i] = 0.5 * sin(0.7 * i);
 
+	for(b = 1; b < 3; b++) {
+		calc_rms(V, signal + (b * block_size), output, block_size);
+		for(i = 0; i < block_size; i++) {
+			sum = 0.0;
+			for(k = (b * block_size) + i - 9; k <= (b * block_size) + i; k++) sum += signal[k] * signal[k];
+			err = fabs(output[i] - sqrt(sum / 10));
+			if(err > max_err) max_err = err;
+		}
+	}
 
+	printf("max error over two more blocks: %g\n", max_err);
+	if(max_err > 1e-6) failed = 1;
 
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
 
+}
@@ -0,0 +1,267 @@
+/**
+ * @file test_rt.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the real-time engine: the ring hands blocks
+ * between two threads in order, a freewheeling file or pipe comes out as the renderer writes it, and
+ * a paced run keeps the clock.
+ *
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "arena.h"
+#include "dsp.h"
+#include "wav.h"
+#include "render.h"
+#include "ring.h"
+#include "rt_io.h"
+#include "rt.h"
+
+// ---------------------------------------------------------------------
+
+#define RATE 48000
+#define LENGTH (RATE / 2)
+#define BLOCK 128
+#define PREFILL 3
+#define RING_SLOTS 4
+#define RING_BLOCKS 200000
+#define PACED_SECONDS 0.2
+
+
+
+static uint8_t pool[RENDER_ARENA_BYTES];
+static ARENA_T arena;
+
+static float input[LENGTH];
+static float rendered[2 * LENGTH], engine_out[2 * LENGTH];
+
+static void print_line(const char * s) { fputs(s, stdout); }
+
+
+// the consumer side of the ring test, every slot has to hold the next number
+static void * ring_consumer(void * arg) {
+
+	RING_T * R = (RING_T *)arg;
+	uint32_t * slot;
+	uint32_t i;
+	long errors = 0;
+
+	for(i = 0; i < RING_BLOCKS; i++) {
+		while((slot = (uint32_t *)ring_read_slot(R)) == NULL) sched_yield();
+		if(slot[0] != i || slot[1] != ~i) errors++;
+		ring_release(R);
+	}
+
+	return (void *)errors;
+
+}
+
+
+// a file through the renderer at the engine's block size, returns the frames
+static int render_file(const char * in_path, const char * chain_text) {
+
+	WAV_T in, out;
+	RENDER_T * R;
+	RENDER_FX_T fx;
+	RENDER_OPTS_T opts = { RATE, 0, BLOCK, WAV_FLOAT32, 0 };
+	int n;
+
+	reset_arena(&arena);
+	if(render_parse_effect(chain_text, &fx) != 0 || open_wav(&in, in_path) != 0) return -1;
+	R = init_render(&arena, &in, &fx, 1, &opts);
+	if(R == NULL || create_wav(&out, &arena, "test_rt_render.wav", RATE, 1, WAV_FLOAT32) != 0) return -1;
+	run_render(R, &out);
+	close_wav(&out);
+	close_wav(&in);
+
+	if(open_wav(&in, "test_rt_render.wav") != 0) return -1;
+	n = read_wav(&in, 0, rendered, 2 * LENGTH);
+	close_wav(&in);
+	remove("test_rt_render.wav");
+
+	return n;
+
+}
+
+
+// a source through the engine into a sink, freewheeling or paced
+static RT_T * run_engine(const char * source_spec, const char * sink_spec, const char * chain_text, int freewheel, double seconds) {
+
+	RT_IO_T * source;
+	RT_IO_T * sink;
+	RT_T * R;
+	RENDER_FX_T fx;
+	RT_OPTS_T opts = { BLOCK, PREFILL, RT_PRIORITY, -1, -1, freewheel, seconds };
+
+	reset_arena(&arena);
+	if(render_parse_effect(chain_text, &fx) != 0) return NULL;
+	source = init_rt_io(&arena, source_spec, 0, RATE, 1, WAV_FLOAT32, BLOCK);
+	sink = init_rt_io(&arena, sink_spec, 1, RATE, 1, WAV_FLOAT32, BLOCK);
+	if(source == NULL || sink == NULL) return NULL;
+
+	R = init_rt(&arena, source, sink, &fx, 1, &opts);
+	if(R == NULL) return NULL;
+	if(run_rt(R) != 0) return NULL;
+	if(close_rt_io(source) != 0 || close_rt_io(sink) != 0) return NULL;
+
+	return R;
+
+}
+
+
+// read a file the engine wrote, -1 if it isn't there
+static int read_output(const char * path, int raw) {
+
+	WAV_T W;
+	FILE * file;
+	int n;
+
+	if(raw) {
+		file = fopen(path, "rb");
+		if(file == NULL) return -1;
+		n = (int)fread(engine_out, sizeof(float), 2 * LENGTH, file);
+		fclose(file);
+		return n;
+	}
+
+	if(open_wav(&W, path) != 0) return -1;
+	n = read_wav(&W, 0, engine_out, 2 * LENGTH);
+	close_wav(&W);
+	return n;
+
+}
+
+
+// the engine's output is prefill blocks of silence and then the render, to the bit
+static int check_output(const char * name, int n, int rendered_frames) {
+
+	int i, failed;
+	double err = 0;
+	int offset = PREFILL * BLOCK;
+
+	failed = (n != rendered_frames + offset);
+	for(i = 0; i < offset && i < n; i++) err = fmax(err, fabs(engine_out[i]));
+	for(i = offset; i < n && !failed; i++) err = fmax(err, fabs(engine_out[i] - rendered[i - offset]));
+	if(err != 0) failed = 1;
+
+	printf("%-28s %6d frames (%d rendered + %d queued ahead), difference %g %s\n", name, n, rendered_frames, offset, err, failed ? "FAILED" : "");
+	return failed;
+
+}
+
+
+int main(int argc, char const *argv[]) {
+
+	int i, n, rendered_frames;
+	int failed = 0;
+	long errors;
+	uint32_t * slot;
+	pthread_t consumer;
+	RING_T * ring;
+	RT_T * R;
+	RT_IO_T * source;
+	RT_IO_T * sink;
+	RENDER_FX_T fx;
+	RT_OPTS_T opts = { BLOCK, PREFILL, 0, -1, -1, 1, 0 };
+	WAV_T W;
+	FILE * file;
+	double expected;
+
+	init_arena(&arena, pool, sizeof(pool));
+	dsp_select(NULL);
+	srand(1);
+
+	// the ring, full and empty, then a stream of numbers through it from another thread
+	if(init_ring(&arena, 3, 16) != NULL) failed = 1;
+	ring = init_ring(&arena, RING_SLOTS, 2 * sizeof(uint32_t));
+	if(ring == NULL || ring_read_slot(ring) != NULL) failed = 1;
+	for(i = 0; ring != NULL && i < RING_SLOTS; i++) {
+		if(ring_write_slot(ring) == NULL) failed = 1;
+		ring_commit(ring);
+	}
+	if(ring == NULL || ring_write_slot(ring) != NULL || ring_count(ring) != RING_SLOTS) failed = 1;
+	for(i = 0; ring != NULL && i < RING_SLOTS; i++) {
+		if(ring_read_slot(ring) == NULL) failed = 1;
+		ring_release(ring);
+	}
+	if(ring == NULL || ring_read_slot(ring) != NULL) failed = 1;
+
+	errors = 1;
+	if(ring != NULL && pthread_create(&consumer, NULL, ring_consumer, ring) == 0) {
+		for(i = 0; i < RING_BLOCKS; i++) {
+			while((slot = (uint32_t *)ring_write_slot(ring)) == NULL) sched_yield();
+			slot[0] = (uint32_t)i;
+			slot[1] = ~(uint32_t)i;
+			ring_commit(ring);
+		}
+		pthread_join(consumer, (void **)&errors);
+	}
+	printf("ring: %d blocks through %d slots, %ld out of order\n", RING_BLOCKS, RING_SLOTS, errors);
+	if(errors != 0) failed = 1;
+
+	// noise in a file and as raw floats
+	for(i = 0; i < LENGTH; i++) input[i] = 0.5f * (((float)rand() / RAND_MAX) - 0.5f);
+	if(create_wav(&W, &arena, "test_rt_in.wav", RATE, 1, WAV_FLOAT32) != 0) { printf("could not create the input\n"); return 1; }
+	write_wav(&W, input, NULL, LENGTH);
+	close_wav(&W);
+	file = fopen("test_rt_in.raw", "wb");
+	if(file == NULL) { printf("could not create the raw input\n"); return 1; }
+	fwrite(input, sizeof(float), LENGTH, file);
+	fclose(file);
+
+	// freewheeling, a file and a pipe each come out as the renderer writes them
+	rendered_frames = render_file("test_rt_in.wav", "delay:0.01,0.5,1");
+	R = run_engine("test_rt_in.wav", "file:test_rt_out.wav", "delay:0.01,0.5,1", 1, 0);
+	if(R == NULL || rendered_frames < LENGTH) failed = 1;
+	else {
+		report_rt(R, print_line);
+		failed |= check_output("file to file, delay", read_output("test_rt_out.wav", 0), rendered_frames);
+		if(R->underruns + R->overruns + R->dropped != 0) failed = 1;
+	}
+
+	rendered_frames = render_file("test_rt_in.wav", "eq:6,-3,3");
+	R = run_engine("pipe:test_rt_in.raw", "pipe:test_rt_out.raw", "eq:6,-3,3", 1, 0);
+	if(R == NULL || rendered_frames < LENGTH) failed = 1;
+	else failed |= check_output("pipe to pipe, eq", read_output("test_rt_out.raw", 1), rendered_frames);
+
+	// paced, the null source for a fixed time has to take that long, a period at a time
+	R = run_engine("null", "null", "eq:0,0,0", 0, PACED_SECONDS);
+	if(R == NULL) failed = 1;
+	else {
+		report_rt(R, print_line);
+		n = (int)ceil(PACED_SECONDS * RATE / BLOCK);
+		expected = (double)(n + PREFILL) * BLOCK / RATE;		// until the input and then the queued blocks are out
+		if(R->blocks < (uint32_t)n || R->processed < (uint32_t)n) failed = 1;
+		if(R->frames != R->total || R->sink->frames != R->total) failed = 1;
+		if(R->late == 0 && R->seconds < 0.9 * expected) failed = 1;
+		printf("paced: %lu periods in %.3f s, %.3f s of audio\n", (unsigned long)R->blocks, R->seconds, expected);
+	}
+
+	// a path that isn't there, a pipe without a path, a sink at another rate
+	reset_arena(&arena);
+	if(init_rt_io(&arena, "file:test_rt_missing.wav", 0, RATE, 1, WAV_FLOAT32, BLOCK) != NULL) failed = 1;
+	if(init_rt_io(&arena, "pipe:", 0, RATE, 1, WAV_FLOAT32, BLOCK) != NULL) failed = 1;
+	source = init_rt_io(&arena, "null", 0, RATE, 1, WAV_FLOAT32, BLOCK);
+	sink = init_rt_io(&arena, "null", 1, RATE / 2, 1, WAV_FLOAT32, BLOCK);
+	render_parse_effect("eq", &fx);
+	if(source == NULL || sink == NULL || init_rt(&arena, source, sink, &fx, 1, &opts) != NULL) failed = 1;
+
+	remove("test_rt_in.wav");
+	remove("test_rt_in.raw");
+	remove("test_rt_out.wav");
+	remove("test_rt_out.raw");
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
@@ -0,0 +1,93 @@
+/**
+ * @file test_trace.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the main program to test the event trace ring and its Chrome trace export.
+ * 
+ */
+
+// include files -------------------------------------------------------
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "arena.h"
+#include "trace.h"
+
+// ---------------------------------------------------------------------
+
+#define RING 16
+#define JSON_FILE "test_trace.json"
+
+
+
+static uint8_t pool[4 * 1024];
+static ARENA_T arena;
+
+
+
+
+int main(int argc, char const *argv[]) {
+
+	int i, n;
+	int failed = 0;
+	char text[4096];
+	TRACE_EVENT_T events[2 * RING];
+	TRACE_T * T;
+	FILE * f;
+
+	init_arena(&arena, pool, sizeof(pool));
+	T = init_trace(&arena, RING + 3);		// rounds down to 16
+	if(T == NULL || T->size != RING) { printf("could not initialize\n"); return 1; }
+
+
+	// nothing is recorded until the trace is attached
+	TRACE_INSTANT("before attach", 0);
+	trace_attach(T);
+	TRACE_BEGIN("block");
+	TRACE_INSTANT("uart rx", 7);
+	TRACE_END("block");
+	n = trace_drain(T, events, 2 * RING);
+	printf("drained %d events, first %s %c\n", n, events[0].name, events[0].ph);
+	if(n != 3 || strcmp(events[0].name, "block") != 0 || events[1].arg != 7 || events[2].ph != TRACE_PH_END) failed = 1;
+	if(trace_drain(T, events, 2 * RING) != 0) failed = 1;
+
+
+	// 20 more events into a 16 event ring, the oldest 4 are lost
+	for(i = 0; i < 20; i++) TRACE_COUNTER("count", i);
+	n = trace_drain(T, events, 2 * RING);
+	printf("overflow: drained %d events, %u lost, first value %d\n", n, T->lost, events[0].arg);
+	if(n != RING || T->lost != 4 || events[0].arg != 4 || events[RING - 1].arg != 19) failed = 1;
+
+
+	// frozen, nothing more goes in
+	trace_freeze(T, 1);
+	TRACE_INSTANT("frozen", 0);
+	if(trace_drain(T, events, 2 * RING) != 0) failed = 1;
+	trace_freeze(T, 0);
+
+
+	// Chrome trace export
+	TRACE_BEGIN("lowpass");
+	TRACE_END("lowpass");
+	TRACE_INSTANT("deadline missed", -5);
+	n = trace_write_json(T, JSON_FILE);
+	f = fopen(JSON_FILE, "r");
+	if(f == NULL) { printf("no trace file\n"); return 1; }
+	text[fread(text, 1, sizeof(text) - 1, f)] = 0;
+	fclose(f);
+	remove(JSON_FILE);
+	printf("%s", text);
+	if(n != 3 || strncmp(text, "{\"traceEvents\":[", 16) != 0) failed = 1;
+	if(strstr(text, "\"name\":\"lowpass\",\"ph\":\"B\"") == NULL || strstr(text, "\"arg\":-5") == NULL) failed = 1;
+	if(strstr(text, "\"lost\":4") == NULL) failed = 1;
+
+
+	trace_attach(NULL);
+
+	printf(failed ? "FAILED\n" : "passed\n");
+	return failed;
+
+}
@@ -0,0 +1,351 @@
+/**
+ * @file profiler.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for the per-stage profiler.
+ * 
+ * @details [
+ * 		profile_now() - current tick of the cycle counter (or host clock)
+ * 		
+ * 		init_profiler() - allocate room for the stages
+ * 		
+ * 		profile_add_stage() - add a stage to time
+ * 		
+ * 		profile_begin(), profile_end() - time one run of a stage
+ * 		
+ * 		profile_stats() - min/mean/max, median, 99th percentile and load of a stage
+ * 		
+ * 		report_profiler() - print every stage
+ * ]
+ * 
+ * The DWT cycle counter runs at the core clock, 168 MHz, so a 100 sample block has about
+ * 350000 cycles. Timing a stage is two reads of the counter and a handful of adds and compares,
+ * a few dozen cycles, so profiling the 6 or so stages of the chain is well under 0.1% of the 
+ * block. Built without GAPE_PROFILE the PROFILE_BEGIN/PROFILE_END macros are empty and cost nothing.
+ * 
+ * The load of a stage is the time spent in it over the time since the last reset. Timing the 
+ * whole block as one stage gives the cpu load, the rest of the time is spent waiting for the adc.
+ * The 32 bit tick wraps every 25.6s on the board and every 4.3s on the host, which is fine for
+ * the time of one stage but not for the time since a reset, so that comes from a 64 bit clock:
+ * the full nanosecond count on the host, the 1ms hal tick in cycles on the board.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#ifdef ARM_MATH_CM4
+#include "stm32f4xx_hal.h"
+#else
+#include <time.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "profiler.h"
+
+// ----------------------------------------------------------
+
+
+
+
+// CLOCK ----------------------------------------------------------------------
+// cycles from the DWT cycle counter on the M4, nanoseconds on the host
+
+#ifdef ARM_MATH_CM4
+
+uint32_t profile_now(void) { return DWT->CYCCNT; }
+uint32_t profile_ticks_per_sec(void) { return SystemCoreClock; }
+static uint64_t profile_clock(void) { return (uint64_t)HAL_GetTick() * (SystemCoreClock / 1000u); }
+void profile_start_clock(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+#else
+
+static uint64_t profile_clock(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return ((uint64_t)t.tv_sec * 1000000000ull) + t.tv_nsec;
+}
+uint32_t profile_now(void) { return (uint32_t)profile_clock(); }
+uint32_t profile_ticks_per_sec(void) { return 1000000000u; }
+void profile_start_clock(void) { }
+
+#endif
+
+
+
+
+/**
+ * @brief [histogram bucket for a time]
+ * @details [0 to 3 get a bucket each, after that every power of 2 is split into 4 buckets
+ * by the 2 bits below the top bit]
+ * 
+ * @param t [time in ticks]
+ * @return [bucket, 0 to PROFILE_BUCKETS - 1]
+ */
+static int profile_bucket(uint32_t t) {
+
+	int e;
+
+	if(t < 4) return t;
+
+	e = 31 - __builtin_clz(t);		// top bit, 2 to 31
+	return (4 * (e - 1)) + ((t >> (e - 2)) & 3);
+
+}
+
+
+/**
+ * @brief [largest time that lands in a bucket]
+ * 
+ * @param b [bucket]
+ * @return [largest time in ticks]
+ */
+static uint32_t profile_bucket_top(int b) {
+
+	uint64_t next;
+
+	if(b < 4) return b;
+
+	// lowest time of the next bucket, minus one
+	b++;
+	next = (uint64_t)(4 + (b % 4)) << ((b / 4) - 1);
+	return (uint32_t)(next - 1);
+
+}
+
+
+/**
+ * @brief [initialize a profiler with room for max_stages stages]
+ * 
+ * @param A [arena the profiler is allocated from]
+ * @param max_stages [most stages that can be added]
+ * @return [pointer to the profiler struct, NULL if it doesn't fit in the arena]
+ */
+PROFILER_T * init_profiler(ARENA_T * A, int max_stages) {
+
+	// set up struct for the profiler ------------------------------------------
+	arena_set_tag(A, "profiler");
+	PROFILER_T * P = (PROFILER_T *)arena_alloc(A, sizeof(PROFILER_T));	// allocate struct
+	if(P == NULL) return NULL;											// errcheck alloc
+
+	P->stages = (PROFILE_STAGE_T *)arena_alloc(A, sizeof(PROFILE_STAGE_T) * max_stages);
+	if(P->stages == NULL) return NULL;
+
+	P->max_stages = max_stages;
+	P->num_stages = 0;
+
+	profile_start_clock();
+	P->epoch = profile_clock();
+
+	return P;
+
+}
+
+
+/**
+ * @brief [add a stage to time]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param name [name of the stage for reports, not copied]
+ * @return [stage id, -1 if there is no room]
+ */
+int profile_add_stage(PROFILER_T * P, const char * name) {
+
+	PROFILE_STAGE_T * S;
+
+	if(P->num_stages >= P->max_stages) return -1;
+
+	S = &(P->stages[P->num_stages]);
+	memset(S, 0, sizeof(PROFILE_STAGE_T));
+	S->name = name;
+	S->min = UINT32_MAX;
+
+	return P->num_stages++;
+
+}
+
+
+/**
+ * @brief [find a stage by name]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param name [name the stage was added with]
+ * @return [stage id, -1 if there is none]
+ */
+int profile_find_stage(const PROFILER_T * P, const char * name) {
+
+	int i;
+
+	for(i = 0; i < P->num_stages; i++) {
+		if(strcmp(P->stages[i].name, name) == 0) return i;
+	}
+
+	return -1;
+
+}
+
+
+/**
+ * @brief [start timing a stage]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param stage [stage id, ignored if it is -1]
+ */
+void profile_begin(PROFILER_T * P, int stage) {
+
+	if(stage < 0) return;
+	P->stages[stage].start = profile_now();
+
+}
+
+
+/**
+ * @brief [stop timing a stage and record the time]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param stage [stage id, ignored if it is -1]
+ */
+void profile_end(PROFILER_T * P, int stage) {
+
+	uint32_t t = profile_now();
+
+	if(stage < 0) return;
+	profile_record(P, stage, t - P->stages[stage].start);	// unsigned, so a wrap of the counter comes out right
+
+}
+
+
+/**
+ * @brief [record one time for a stage]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param stage [stage id]
+ * @param ticks [time the stage took]
+ */
+void profile_record(PROFILER_T * P, int stage, uint32_t ticks) {
+
+	PROFILE_STAGE_T * S = &(P->stages[stage]);
+
+	if(ticks < S->min) S->min = ticks;
+	if(ticks > S->max) S->max = ticks;
+	S->total += ticks;
+	S->count++;
+	S->hist[profile_bucket(ticks)]++;
+
+}
+
+
+/**
+ * @brief [clear the times of every stage and restart the load measurement]
+ * 
+ * @param P [pointer to the profiler struct]
+ */
+void reset_profiler(PROFILER_T * P) {
+
+	int i;
+	const char * name;
+
+	for(i = 0; i < P->num_stages; i++) {
+		name = P->stages[i].name;
+		memset(&(P->stages[i]), 0, sizeof(PROFILE_STAGE_T));
+		P->stages[i].name = name;
+		P->stages[i].min = UINT32_MAX;
+	}
+
+	P->epoch = profile_clock();
+
+}
+
+
+/**
+ * @brief [time below which a fraction of the recorded times fall]
+ * 
+ * @param S [pointer to the stage]
+ * @param permille [fraction in 1/1000]
+ * @return [top of the bucket the percentile falls in, no more than the max]
+ */
+static uint32_t profile_percentile(const PROFILE_STAGE_T * S, int permille) {
+
+	int b;
+	uint64_t want = (((uint64_t)S->count * permille) + 999) / 1000;	// rounded up, so it is at least 1
+	uint64_t seen = 0;
+	uint32_t top;
+
+	for(b = 0; b < PROFILE_BUCKETS; b++) {
+		seen += S->hist[b];
+		if(seen >= want) break;
+	}
+
+	top = profile_bucket_top(b);
+	return (top < S->max) ? top : S->max;
+
+}
+
+
+/**
+ * @brief [summarize the times of one stage]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param stage [stage id]
+ * @param S [filled in with the summary]
+ * @return [0 on success, 1 if there is no such stage]
+ */
+int profile_stats(const PROFILER_T * P, int stage, PROFILE_STATS_T * S) {
+
+	const PROFILE_STAGE_T * T;
+	uint64_t elapsed = profile_clock() - P->epoch;
+
+	if(stage < 0 || stage >= P->num_stages) return 1;
+	T = &(P->stages[stage]);
+
+	memset(S, 0, sizeof(PROFILE_STATS_T));
+	S->count = T->count;
+	if(T->count == 0) return 0;
+
+	S->min = T->min;
+	S->max = T->max;
+	S->mean = (uint32_t)(T->total / T->count);
+	S->p50 = profile_percentile(T, 500);
+	S->p99 = profile_percentile(T, 990);
+	S->load = (elapsed > 0) ? (100.0f * T->total) / elapsed : 0.0f;
+
+	return 0;
+
+}
+
+
+/**
+ * @brief [print the summary of every stage]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param print [prints one line, UART_putstr on the board]
+ */
+void report_profiler(const PROFILER_T * P, void (*print)(const char *)) {
+
+	int i;
+	char line[128];
+	PROFILE_STATS_T S;
+
+	snprintf(line, sizeof(line), "  %-12s %8s %8s %8s %8s %8s %8s %6s\r\n", 
+		"stage", "count", "min", "mean", "p50", "p99", "max", "load");
+	print(line);
+
+	for(i = 0; i < P->num_stages; i++) {
+		profile_stats(P, i, &S);
+		// load in hundredths of a percent, so it doesn't need printf float support
+		snprintf(line, sizeof(line), "  %-12s %8lu %8lu %8lu %8lu %8lu %8lu %3d.%02d%%\r\n", P->stages[i].name,
+			(unsigned long)S.count, (unsigned long)S.min, (unsigned long)S.mean, (unsigned long)S.p50,
+			(unsigned long)S.p99, (unsigned long)S.max, (int)(S.load * 100) / 100, (int)(S.load * 100) % 100);
+		print(line);
+	}
+
+}
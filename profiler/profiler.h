@@ -0,0 +1,241 @@
+/**
+ * @file profiler.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for 
+ * the per-stage profiler: cycles spent in each stage of the processing chain, and 
+ * the cpu load.
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define PROFILE_BUCKETS		124		// histogram buckets, 4 per power of 2 up to 2^32 ticks
+
+// PROFILE_BEGIN/PROFILE_END time a stage when built with GAPE_PROFILE (make PROFILE=1),
+// and compile to nothing otherwise. P can be NULL when profiling isn't set up
+#ifdef GAPE_PROFILE
+#define PROFILE_BEGIN(P, stage)		do { if((P) != NULL) profile_begin((P), (stage)); } while(0)
+#define PROFILE_END(P, stage)		do { if((P) != NULL) profile_end((P), (stage)); } while(0)
+#else
+#define PROFILE_BEGIN(P, stage)		do { } while(0)
+#define PROFILE_END(P, stage)		do { } while(0)
+#endif
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [times recorded for one stage]
+ * @details [the histogram buckets are 25% wide, so percentiles are within 25% and everything 
+ * fits in fixed memory no matter how long it runs]
+ * 
+ */
+typedef struct profile_stage_struct {
+	const char * name;					// name of the stage for reports
+	uint32_t start;						// tick profile_begin() was called
+	uint32_t count;						// number of times timed
+	uint32_t min;						// shortest time
+	uint32_t max;						// longest time
+	uint64_t total;						// sum of all times, for the mean and the load
+	uint32_t hist[PROFILE_BUCKETS];		// number of times in each bucket
+} PROFILE_STAGE_T;
+
+
+/**
+ * @brief [structure containing the stages being timed]
+ * 
+ */
+typedef struct profiler_struct {
+	int max_stages;				// stages allocated
+	int num_stages;				// stages added
+	uint64_t epoch;				// 64 bit clock when the stats were last reset, for the load
+	PROFILE_STAGE_T * stages;	// max_stages stages
+} PROFILER_T;
+
+
+/**
+ * @brief [summary of one stage, returned by profile_stats()]
+ * @details [all times are in ticks: cpu cycles on the board, nanoseconds on the host]
+ * 
+ */
+typedef struct profile_stats_struct {
+	uint32_t count;			// number of times timed
+	uint32_t min;			// shortest time
+	uint32_t mean;			// average time
+	uint32_t p50;			// median
+	uint32_t p99;			// 99th percentile
+	uint32_t max;			// longest time
+	float load;				// percent of the time since the reset spent in the stage
+} PROFILE_STATS_T;
+
+
+/**
+ * @brief [current tick: the DWT cycle counter on the board, a monotonic clock in ns on the host]
+ * @details [available with or without GAPE_PROFILE, it wraps so only differences are meaningful]
+ * 
+ * @return [current tick]
+ */
+uint32_t profile_now(
+	void
+);
+
+
+/**
+ * @brief [ticks per second of profile_now(), SystemCoreClock on the board]
+ * 
+ * @return [ticks per second]
+ */
+uint32_t profile_ticks_per_sec(
+	void
+);
+
+
+/**
+ * @brief [start the DWT cycle counter, nothing to do on the host]
+ */
+void profile_start_clock(
+	void
+);
+
+
+/**
+ * @brief [initialize a profiler with room for max_stages stages]
+ * @details [also starts the clock]
+ * 
+ * @param A [arena the profiler is allocated from]
+ * @param max_stages [most stages that can be added]
+ * @return [pointer to the profiler struct, NULL if it doesn't fit in the arena]
+ */
+PROFILER_T * init_profiler(
+	ARENA_T * A,		// arena to allocate from
+	int max_stages		// most stages that can be added
+);
+
+
+/**
+ * @brief [add a stage to time]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param name [name of the stage for reports, not copied]
+ * @return [stage id, -1 if there is no room]
+ */
+int profile_add_stage(
+	PROFILER_T * P,			// pointer to profiler struct
+	const char * name		// name of the stage
+);
+
+
+/**
+ * @brief [find a stage by name]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param name [name the stage was added with]
+ * @return [stage id, -1 if there is none]
+ */
+int profile_find_stage(
+	const PROFILER_T * P,	// pointer to profiler struct
+	const char * name		// name of the stage
+);
+
+
+/**
+ * @brief [start timing a stage, use PROFILE_BEGIN() so it compiles out]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param stage [stage id, ignored if it is -1]
+ */
+void profile_begin(
+	PROFILER_T * P,		// pointer to profiler struct
+	int stage			// stage id
+);
+
+
+/**
+ * @brief [stop timing a stage and record the time, use PROFILE_END() so it compiles out]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param stage [stage id, ignored if it is -1]
+ */
+void profile_end(
+	PROFILER_T * P,		// pointer to profiler struct
+	int stage			// stage id
+);
+
+
+/**
+ * @brief [record one time for a stage]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param stage [stage id]
+ * @param ticks [time the stage took]
+ */
+void profile_record(
+	PROFILER_T * P,		// pointer to profiler struct
+	int stage,			// stage id
+	uint32_t ticks		// time the stage took
+);
+
+
+/**
+ * @brief [clear the times of every stage and restart the load measurement]
+ * 
+ * @param P [pointer to the profiler struct]
+ */
+void reset_profiler(
+	PROFILER_T * P		// pointer to profiler struct
+);
+
+
+/**
+ * @brief [summarize the times of one stage]
+ * @details [can be called while the stages are being timed from an interrupt, the result
+ * can then be off by the time being recorded]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param stage [stage id]
+ * @param S [filled in with the summary]
+ * @return [0 on success, 1 if there is no such stage]
+ */
+int profile_stats(
+	const PROFILER_T * P,	// pointer to profiler struct
+	int stage,				// stage id
+	PROFILE_STATS_T * S		// summary of the stage
+);
+
+
+/**
+ * @brief [print the summary of every stage]
+ * 
+ * @param P [pointer to the profiler struct]
+ * @param print [prints one line, UART_putstr on the board]
+ */
+void report_profiler(
+	const PROFILER_T * P,			// pointer to profiler struct
+	void (*print)(const char *)		// prints one line
+);
+
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * @file quality.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for the quality scheduler.
+ * 
+ * @details [
+ * 		init_quality() - start at the best level
+ * 		
+ * 		quality_update() - step the level down or up from the time the last block took
+ * 		
+ * 		report_quality() - print the level
+ * ]
+ * 
+ * A missed deadline is a click: the dac plays the old half again (see deadline.c). The 
+ * effects with quality tiers (graph_add_tiers()) can instead be moved to a cheaper tier, a 
+ * shorter filter. This watches how long each block takes against the block period, steps down
+ * as soon as two blocks in a row get within 15% of the deadline, and only steps back up after 
+ * a full second with half the period to spare. Stepping down is fast and stepping up is slow, 
+ * so a chain that is just over the edge settles at the level it fits in instead of bouncing 
+ * between two. The caller moves the graph with graph_set_quality(). The graph cuts straight
+ * down to a primed cheaper tier, so the blocks that are already too slow never pay for both
+ * tiers, and only crossfades with both running on the way up, once there is room for it.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "profiler.h"
+#include "trace.h"
+#include "quality.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [initialize the quality scheduler at the best level]
+ * 
+ * @param A [arena the struct is allocated from]
+ * @param num_levels [number of quality levels, the most tiers of any effect]
+ * @param block_size [samples per block]
+ * @param FS [sampling frequency]
+ * @return [pointer to the quality struct, NULL if it doesn't fit in the arena]
+ */
+QUALITY_T * init_quality(ARENA_T * A, int num_levels, int block_size, int FS) {
+
+	uint32_t period;
+
+	// set up struct for the scheduler -----------------------------------------
+	QUALITY_T * Q = (QUALITY_T *)arena_alloc(A, sizeof(QUALITY_T));	// allocate struct
+	if(Q == NULL) return NULL;											// errcheck alloc
+
+	period = (uint32_t)(((uint64_t)profile_ticks_per_sec() * block_size) / FS);
+
+	Q->level = 0;
+	Q->num_levels = num_levels;
+	Q->high = (uint32_t)(((uint64_t)period * QUALITY_HIGH_PERCENT) / 100);
+	Q->low = (uint32_t)(((uint64_t)period * QUALITY_LOW_PERCENT) / 100);
+	Q->up_blocks = FS / block_size;
+	Q->up_wait = Q->up_blocks;
+
+	return Q;
+
+}
+
+
+/**
+ * @brief [feed the time the last block took, at the block boundary]
+ * 
+ * @param Q [pointer to the quality struct]
+ * @param ticks [time the last block took]
+ * @return [1 if the level changed, 0 if not]
+ */
+int quality_update(QUALITY_T * Q, uint32_t ticks) {
+
+	// the last step up held for a second, so the backoff starts over
+	if(Q->probation > 0 && --Q->probation == 0) Q->up_wait = Q->up_blocks;
+
+	// the blocks right after a step are running both tiers
+	if(Q->settle > 0) {
+		Q->settle--;
+		return 0;
+	}
+
+	Q->over = (ticks > Q->high) ? Q->over + 1 : 0;
+	Q->under = (ticks < Q->low) ? Q->under + 1 : 0;
+
+
+	// STEP DOWN ---------------------------------------------------------------
+	if(Q->over >= QUALITY_DOWN_BLOCKS && Q->level < Q->num_levels - 1) {
+
+		// the last step up didn't hold, wait longer before the next one
+		if(Q->probation > 0 && Q->up_wait < QUALITY_MAX_BACKOFF * Q->up_blocks) Q->up_wait *= 2;
+
+		Q->level++;
+		Q->steps_down++;
+		Q->over = 0;
+		Q->under = 0;
+		Q->settle = QUALITY_SETTLE_BLOCKS;
+		Q->probation = 0;
+		TRACE_COUNTER("quality", Q->level);
+		return 1;
+
+	}
+
+
+	// STEP UP -----------------------------------------------------------------
+	if(Q->under >= Q->up_wait && Q->level > 0) {
+
+		Q->level--;
+		Q->steps_up++;
+		Q->over = 0;
+		Q->under = 0;
+		Q->settle = QUALITY_SETTLE_BLOCKS;
+		Q->probation = Q->up_blocks + QUALITY_SETTLE_BLOCKS;
+		TRACE_COUNTER("quality", Q->level);
+		return 1;
+
+	}
+
+	return 0;
+
+}
+
+
+/**
+ * @brief [print the level and the number of steps]
+ * 
+ * @param Q [pointer to the quality struct]
+ * @param print [prints one line, UART_putstr on the board]
+ */
+void report_quality(const QUALITY_T * Q, void (*print)(const char *)) {
+
+	char line[96];
+
+	snprintf(line, sizeof(line), "quality: level %d of %d, %lu steps down, %lu up\r\n", Q->level, Q->num_levels,
+		(unsigned long)Q->steps_down, (unsigned long)Q->steps_up);
+	print(line);
+
+}
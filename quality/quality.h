@@ -0,0 +1,110 @@
+/**
+ * @file quality.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for 
+ * the quality scheduler, which steps the effects down to cheaper tiers when the blocks
+ * get close to their deadline, and back up once there is room again.
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef QUALITY_H
+#define QUALITY_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define QUALITY_HIGH_PERCENT	85		// a block over this much of the period is too close
+#define QUALITY_LOW_PERCENT		50		// a block under this much of the period has room to step up
+#define QUALITY_DOWN_BLOCKS		2		// blocks in a row over the high mark before stepping down
+#define QUALITY_SETTLE_BLOCKS	16		// blocks to ignore after a step, priming or crossfading the new tier
+#define QUALITY_MAX_BACKOFF		8		// most the wait to step up grows after a step up that didn't hold
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [structure containing the quality level and the state of the scheduler]
+ * @details [level 0 is the best quality. times are in ticks of profile_now()]
+ * 
+ */
+typedef struct quality_struct {
+	int level;					// level running, 0 is the best
+	int num_levels;				// levels there are
+	uint32_t high;				// block time over which it is too close to the deadline
+	uint32_t low;				// block time under which there is room
+	int up_blocks;				// blocks in a row under the low mark before stepping up (one second)
+	int up_wait;				// up_blocks, times the backoff after a step up didn't hold
+	int over;					// blocks in a row over the high mark
+	int under;					// blocks in a row under the low mark
+	int settle;					// blocks left to ignore after a step
+	int probation;				// blocks left in which a step down means the last step up failed
+	uint32_t steps_down;		// times stepped down
+	uint32_t steps_up;			// times stepped up
+} QUALITY_T;
+
+
+/**
+ * @brief [initialize the quality scheduler at the best level]
+ * 
+ * @param A [arena the struct is allocated from]
+ * @param num_levels [number of quality levels, the most tiers of any effect]
+ * @param block_size [samples per block]
+ * @param FS [sampling frequency]
+ * @return [pointer to the quality struct, NULL if it doesn't fit in the arena]
+ */
+QUALITY_T * init_quality(
+	ARENA_T * A,		// arena to allocate from
+	int num_levels,		// number of quality levels
+	int block_size,		// samples per block
+	int FS				// sampling frequency
+);
+
+
+/**
+ * @brief [feed the time the last block took, at the block boundary]
+ * @details [two blocks in a row over QUALITY_HIGH_PERCENT of the period step down a level. a
+ * second under QUALITY_LOW_PERCENT steps back up. a step up that is followed by a step down 
+ * within the next second doubles the wait before the next step up]
+ * 
+ * @param Q [pointer to the quality struct]
+ * @param ticks [time the last block took]
+ * @return [1 if the level changed, 0 if not]
+ */
+int quality_update(
+	QUALITY_T * Q,		// pointer to quality struct
+	uint32_t ticks		// time the last block took
+);
+
+
+/**
+ * @brief [print the level and the number of steps]
+ * 
+ * @param Q [pointer to the quality struct]
+ * @param print [prints one line, UART_putstr on the board]
+ */
+void report_quality(
+	const QUALITY_T * Q,			// pointer to quality struct
+	void (*print)(const char *)		// prints one line
+);
+
+
+#endif
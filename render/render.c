@@ -0,0 +1,379 @@
+/**
+ * @file render.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for rendering a WAV file through the effect chain on a host.
+ *
+ * @details [
+ * 		render_find_effect() - effect node by name
+ *
+ * 		render_parse_effect() - effect and parameters, or a gui preset, from the command line
+ *
+ * 		render_chain() - the effects in series on a planned graph
+ *
+ * 		init_render() - plan the converters, lowpass and chain for a file
+ *
+ * 		run_render() - stream the file through
+ *
+ * 		report_render() - length, time and real-time factor
+ * ]
+ *
+ * The chain is the one the board runs: the 10kHz input lowpass, then the effects added to an effect
+ * graph with the same init and calc routines, the same parameters and the same tails. The input is
+ * converted to the chain's rate first and the output back again (see resample.c), so a recording at
+ * 44.1kHz is heard the way the board would play it at 48kHz. It replaces running the effects through
+ * matlab_design/delay.m and universal_comb_filter.m: the delay with the input mixed in is the FIR
+ * comb, and the output is what the board's code does to the signal, not a model of it.
+ *
+ * Everything is allocated from the arena at init, the file is read straight out of its mapping and
+ * written through one buffer (see wav.c), so a file of any length runs in the same memory. The blocks
+ * are large, RENDER_BLOCK, which is where the FFT filters pay off. Nothing runs in real time here,
+ * so the quality scheduler and the bypass through silence are left out, every block is full quality.
+ *
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "arena.h"
+#include "fir.h"
+#include "design.h"
+#include "resample.h"
+#include "effect_graph.h"
+#include "effect_nodes.h"
+#include "wav.h"
+#include "render.h"
+
+// ----------------------------------------------------------
+
+
+// every effect node, with the parameters an effect left bare on the command line gets
+static const RENDER_FX_T render_effects[] = {
+	{ &delay_node,		{ 0.5f, 0.5f, 1 } },		// half a second, half as loud, input mixed in
+	{ &compressor_node,	{ 0, 2, RENDER_RMS_WINDOW } },	// 2:1 over 1VRMS
+	{ &eq_node,			{ 0, 0, 0 } },
+	{ &eq_151_node,		{ 0, 0, 0 } },
+	{ &eq_75_node,		{ 0, 0, 0 } },
+	{ &delay_q15_node,	{ 0.5f, 0.5f, 1 } },
+	{ &eq_q15_node,		{ 0, 0, 0 } },
+};
+
+#define RENDER_NUM_EFFECTS	((int)(sizeof(render_effects) / sizeof(render_effects[0])))
+
+
+// the gui presets as read_effect() decodes them. it keeps the parameters in ints, which takes the
+// delay times down to 0, and the board plays both delays as 0.5 seconds of just the echo. these are
+// the times and gains the gui means, with the input mixed in so the echo is heard against it
+const RENDER_PRESET_T render_presets[RENDER_NUM_PRESETS] = {
+	{ 1,	"large room",			{ &delay_node,		{ 0.5f, 0.5f, 1 } } },
+	{ 2,	"small room",			{ &delay_node,		{ 0.25f, 1, 1 } } },
+	{ 3,	"coffee shop",			{ &compressor_node,	{ -7, 2, RENDER_RMS_WINDOW } } },
+	{ 4,	"celestial immolation",	{ &compressor_node,	{ -2, 9, RENDER_RMS_WINDOW } } },
+	{ 5,	"bass boost",			{ &eq_node,			{ 10, 0, 0 } } },
+	{ 6,	"mid boost",			{ &eq_node,			{ 0, 10, 0 } } },
+	{ 7,	"treble boost",			{ &eq_node,			{ 0, 0, 10 } } },
+	{ 8,	"bass attenuation",		{ &eq_node,			{ -10, 0, 0 } } },
+	{ 9,	"mid attenuation",		{ &eq_node,			{ 0, -10, 0 } } },
+	{ 10,	"treble attenuation",	{ &eq_node,			{ 0, 0, -10 } } },
+	{ 11,	"flat response",		{ &eq_node,			{ 0, 0, 0 } } },
+};
+
+
+
+
+/**
+ * @brief [find an effect node by name]
+ *
+ * @param name [ops->name of the node, "delay", "compressor", "eq", "eq/151", ...]
+ * @return [pointer to the node, NULL if there is none by that name]
+ */
+const EFFECT_OPS_T * render_find_effect(const char * name) {
+
+	int i;
+
+	for(i = 0; i < RENDER_NUM_EFFECTS; i++) {
+		if(strcmp(render_effects[i].ops->name, name) == 0) return render_effects[i].ops;
+	}
+
+	return NULL;
+
+}
+
+
+/**
+ * @brief [read an effect from the command line]
+ *
+ * @param text [effect and parameters]
+ * @param fx [filled in]
+ * @return [0 on success, 1 for an unknown effect or preset, or a parameter that isn't a number]
+ */
+int render_parse_effect(const char * text, RENDER_FX_T * fx) {
+
+	int i, len;
+	char name[32];
+	const char * p;
+	char * end;
+
+	p = strchr(text, ':');
+	len = (p == NULL) ? (int)strlen(text) : (int)(p - text);
+	if(len >= (int)sizeof(name)) return 1;
+	memcpy(name, text, len);
+	name[len] = '\0';
+
+	// a gui preset by number
+	if(strcmp(name, "preset") == 0) {
+		i = (p == NULL) ? 0 : (int)strtol(p + 1, &end, 10);
+		if(i < 1 || i > RENDER_NUM_PRESETS || *end != '\0') return 1;
+		*fx = render_presets[i - 1].fx;
+		return 0;
+	}
+
+	for(i = 0; i < RENDER_NUM_EFFECTS; i++) {
+		if(strcmp(render_effects[i].ops->name, name) == 0) break;
+	}
+	if(i == RENDER_NUM_EFFECTS) return 1;
+	*fx = render_effects[i];
+
+	// as many parameters as are given, separated by commas
+	for(i = 0; p != NULL && i < RENDER_NUM_PARAMS; i++) {
+		fx->params[i] = strtof(p + 1, &end);
+		if(end == p + 1 || (*end != ',' && *end != '\0')) return 1;
+		p = (*end == ',') ? end : NULL;
+	}
+
+	return (p != NULL);
+
+}
+
+
+/**
+ * @brief [the effects in series on an effect graph]
+ *
+ * @param A [arena the graph is allocated from]
+ * @param chain [effects to run, in order]
+ * @param num_fx [number of effects, 1 to RENDER_MAX_EFFECTS]
+ * @param block_size [samples the graph runs on at once]
+ * @param FS [sampling frequency]
+ * @return [pointer to the planned graph, NULL if an effect won't initialize or it doesn't fit]
+ */
+GRAPH_T * render_chain(ARENA_T * A, const RENDER_FX_T * chain, int num_fx, int block_size, int FS) {
+
+	int i, node;
+	GRAPH_T * G;
+
+	if(num_fx < 1 || num_fx > RENDER_MAX_EFFECTS) return NULL;
+
+	G = init_graph(A, block_size, FS);
+	if(G == NULL) return NULL;
+	node = GRAPH_INPUT;
+	for(i = 0; i < num_fx; i++) {
+		if(chain[i].ops == NULL) return NULL;
+		node = graph_add_effect(G, chain[i].ops, chain[i].params, node);
+		if(node < 0) return NULL;
+	}
+	if(plan_graph(G, node)) return NULL;
+
+	return G;
+
+}
+
+
+/**
+ * @brief [plan the chain for a file]
+ *
+ * @param A [arena everything is allocated from]
+ * @param in [file opened with open_wav()]
+ * @param chain [effects to run, in order]
+ * @param num_fx [number of effects, 1 to RENDER_MAX_EFFECTS]
+ * @param opts [how to render]
+ * @return [pointer to the render struct, NULL if an effect won't initialize or it doesn't fit]
+ */
+RENDER_T * init_render(ARENA_T * A, WAV_T * in, const RENDER_FX_T * chain, int num_fx, const RENDER_OPTS_T * opts) {
+
+	int tail, max_up, max_down;
+	const float * coefs;
+	int64_t length;
+
+	if(num_fx < 1 || num_fx > RENDER_MAX_EFFECTS) return NULL;
+
+	RENDER_T * R = (RENDER_T *)arena_alloc(A, sizeof(RENDER_T));
+	if(R == NULL) return NULL;
+
+	R->in = in;
+	R->FS = (opts->FS > 0) ? opts->FS : RENDER_FS;
+	R->out_rate = (opts->out_rate > 0) ? opts->out_rate : in->FS;
+	R->block_size = (opts->block_size > 0) ? opts->block_size : RENDER_BLOCK;
+	R->stereo = opts->stereo;
+
+	// the input lowpass, then the effects in series
+	arena_set_tag(A, "lowpass");
+	coefs = design_input_lowpass(A, R->FS, &(R->lowpass_taps));
+	if(coefs == NULL) return NULL;
+	R->lowpass = init_fir(A, coefs, R->lowpass_taps, R->block_size, FIR_PLAN);
+	if(R->lowpass == NULL) return NULL;
+
+	R->G = render_chain(A, chain, num_fx, R->block_size, R->FS);
+	if(R->G == NULL) return NULL;
+
+	// the converters, when the rates differ. their delay is dropped from the front of what they put out
+	arena_set_tag(A, "resample");
+	max_up = max_down = R->block_size;
+	if(in->FS != R->FS) {
+		R->up = init_resample(A, in->FS, R->FS, R->block_size);
+		if(R->up == NULL) return NULL;
+		R->skip_in = (int)(R->up->delay + 0.5f);
+		max_up = resample_max_out(R->up, R->block_size);
+		R->chunk = (float *)arena_alloc(A, sizeof(float) * R->block_size);
+		if(R->chunk == NULL) return NULL;
+	}
+	if(R->out_rate != R->FS) {
+		R->down = init_resample(A, R->FS, R->out_rate, R->block_size);
+		if(R->down == NULL) return NULL;
+		R->skip_out = (int)(R->down->delay + 0.5f);
+		max_down = resample_max_out(R->down, R->block_size);
+		R->out_wet = (float *)arena_alloc(A, sizeof(float) * max_down);
+		if(R->out_wet == NULL) return NULL;
+		if(R->stereo) {
+			R->down_dry = init_resample(A, R->FS, R->out_rate, R->block_size);
+			R->out_dry = (float *)arena_alloc(A, sizeof(float) * max_down);
+			if(R->down_dry == NULL || R->out_dry == NULL) return NULL;
+		}
+	}
+
+	// a block waiting to run, plus whatever the last conversion put past it
+	arena_set_tag(A, "render");
+	R->queue = (float *)arena_alloc(A, sizeof(float) * (R->block_size + max_up));
+	R->dry = (float *)arena_alloc(A, sizeof(float) * R->block_size);
+	R->wet = (float *)arena_alloc(A, sizeof(float) * R->block_size);
+	if(R->queue == NULL || R->dry == NULL || R->wet == NULL) return NULL;
+
+	// the input at the chain's rate, then the lowpass and the effects ringing on, at the output rate
+	tail = (R->lowpass_taps - 1) + ((R->G->tail < 0) ? 0 : R->G->tail);
+	length = ((in->frames * R->FS) + in->FS - 1) / in->FS + tail;
+	R->total = ((length * R->out_rate) + R->FS - 1) / R->FS;
+
+	return R;
+
+}
+
+
+/**
+ * @brief [put more of the file into the queue at the chain's rate]
+ * @details [past the end of the file it is silence]
+ *
+ * @param R [pointer to the render struct]
+ */
+static void render_fill(RENDER_T * R) {
+
+	int n, got, drop;
+	float * buf;
+
+	n = R->block_size - R->queued;
+	buf = R->queue + R->queued;
+	if(R->up != NULL) {
+		n = R->block_size;
+		buf = R->chunk;
+	}
+
+	got = read_wav(R->in, R->read, buf, n);
+	memset(buf + got, 0, sizeof(float) * (n - got));
+	R->read += n;
+
+	if(R->up == NULL) {
+		R->queued += n;
+		return;
+	}
+
+	n = calc_resample(R->up, R->chunk, R->queue + R->queued, R->block_size);
+	drop = (R->skip_in < n) ? R->skip_in : n;
+	if(drop > 0) memmove(R->queue + R->queued, R->queue + R->queued + drop, sizeof(float) * (n - drop));
+	R->skip_in -= drop;
+	R->queued += n - drop;
+
+}
+
+
+/**
+ * @brief [run the whole file through the chain]
+ *
+ * @param R [pointer to the render struct]
+ * @param out [file opened with create_wav() at R->out_rate with 1 channel, or 2 for stereo]
+ * @return [0 on success, 1 if a write failed]
+ */
+int run_render(RENDER_T * R, WAV_T * out) {
+
+	int n, drop;
+	float * dry;
+	float * wet;
+	struct timespec start, stop;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	while(R->frames < R->total && !out->failed) {
+
+		while(R->queued < R->block_size) render_fill(R);
+
+		// the chain, as the board runs it
+		calc_fir(R->lowpass, R->queue, R->dry, R->block_size);
+		run_graph(R->G, R->dry, R->wet);
+		R->queued -= R->block_size;
+		memmove(R->queue, R->queue + R->block_size, sizeof(float) * R->queued);
+
+		// back to the output rate, both channels through converters in step
+		dry = R->dry;
+		wet = R->wet;
+		n = R->block_size;
+		if(R->down != NULL) {
+			n = calc_resample(R->down, R->wet, R->out_wet, R->block_size);
+			wet = R->out_wet;
+			if(R->stereo) {
+				calc_resample(R->down_dry, R->dry, R->out_dry, R->block_size);
+				dry = R->out_dry;
+			}
+		}
+
+		drop = (R->skip_out < n) ? R->skip_out : n;
+		R->skip_out -= drop;
+		n -= drop;
+		if(n > R->total - R->frames) n = (int)(R->total - R->frames);
+
+		if(R->stereo) write_wav(out, dry + drop, wet + drop, n);
+		else write_wav(out, wet + drop, NULL, n);
+		R->frames += n;
+
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	R->seconds = (stop.tv_sec - start.tv_sec) + 1e-9 * (stop.tv_nsec - start.tv_nsec);
+
+	return out->failed;
+
+}
+
+
+/**
+ * @brief [print the length rendered, the time it took and the real-time factor]
+ *
+ * @param R [pointer to the render struct]
+ * @param print [prints one line]
+ */
+void report_render(const RENDER_T * R, void (*print)(const char *)) {
+
+	char line[128];
+	double audio = (double)R->frames / R->out_rate;
+
+	snprintf(line, sizeof(line), "%d Hz in, chain at %d Hz in blocks of %d after a %d tap lowpass, %d Hz out\r\n",
+		R->in->FS, R->FS, R->block_size, R->lowpass_taps, R->out_rate);
+	print(line);
+	snprintf(line, sizeof(line), "%.2f s of audio in %.3f s, %.1fx real time\r\n",
+		audio, R->seconds, (R->seconds > 0) ? audio / R->seconds : 0.0);
+	print(line);
+
+}
@@ -0,0 +1,215 @@
+/**
+ * @file render.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for rendering a WAV
+ * file through the effect chain on a host.
+ *
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef RENDER_H
+#define RENDER_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "fir.h"
+#include "resample.h"
+#include "effect_graph.h"
+#include "wav.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define RENDER_ARENA_BYTES	(8 * 1024 * 1024)	// host arena, there is no board budget to keep to
+#define RENDER_BLOCK		4096		// samples the chain runs on at once unless asked otherwise
+#define RENDER_FS			48000		// rate the chain runs at unless asked otherwise
+#define RENDER_MAX_EFFECTS	8			// longest chain
+#define RENDER_NUM_PARAMS	3			// parameters of each effect, as the gui sends them
+#define RENDER_NUM_PRESETS	11			// gui presets, numbered from 1
+#define RENDER_RMS_WINDOW	0.208f		// compressor rms window in seconds, the board's RMS_WINDOW_MS
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [one effect of the chain and its parameters]
+ * @details [the parameters are the ones handed to the node's init (see effect_nodes.h)]
+ *
+ */
+typedef struct render_fx_struct {
+	const EFFECT_OPS_T * ops;				// effect node
+	float params[RENDER_NUM_PARAMS];		// parameters handed to ops->init
+} RENDER_FX_T;
+
+
+/**
+ * @brief [one of the presets the gui sends (see read_effect.c)]
+ *
+ */
+typedef struct render_preset_struct {
+	int number;				// preset number on the gui
+	const char * name;		// name on the gui
+	RENDER_FX_T fx;			// effect and parameters
+} RENDER_PRESET_T;
+
+
+extern const RENDER_PRESET_T render_presets[RENDER_NUM_PRESETS];
+
+
+/**
+ * @brief [how to render, zeros pick the defaults]
+ *
+ */
+typedef struct render_opts_struct {
+	int FS;					// rate the chain runs at, RENDER_FS if 0
+	int out_rate;			// rate of the output file, the input's if 0
+	int block_size;			// samples the chain runs on at once, RENDER_BLOCK if 0
+	int format;				// sample format of the output file, the input's if < 0
+	int stereo;				// lowpass filtered input left and the effect right, like the dac
+} RENDER_OPTS_T;
+
+
+/**
+ * @brief [structure containing the fields for rendering one file]
+ * @details [the file is converted to the chain's rate, lowpass filtered and run through the
+ * effect graph a block at a time, then converted to the output rate. the delay of the two
+ * converters is dropped, so the output lines up with the input the way the board's would, and
+ * the output runs on past the end of the input for the tail of the lowpass and the chain]
+ *
+ */
+typedef struct render_struct {
+	WAV_T * in;					// file being read
+	int FS;						// rate the chain runs at
+	int out_rate;				// rate of the output
+	int block_size;				// samples the chain runs on at once
+	int stereo;					// 2 output channels
+
+	FIR_T * lowpass;			// input lowpass
+	int lowpass_taps;			// its length
+	GRAPH_T * G;				// effect chain
+	RESAMPLE_T * up;			// input rate to chain rate, NULL if they are the same
+	RESAMPLE_T * down;			// chain rate to output rate, NULL if they are the same
+	RESAMPLE_T * down_dry;		// the same for the left channel in stereo
+
+	float * queue;				// chain rate input waiting for a block
+	int queued;					// samples in the queue
+	float * chunk;				// input frames read from the file
+	float * dry;				// lowpass filtered block
+	float * wet;				// effect output block
+	float * out_dry;			// left channel at the output rate
+	float * out_wet;			// effect channel at the output rate
+
+	int64_t read;				// input frames read
+	int skip_in;				// converted input still to drop for the input converter's delay
+	int skip_out;				// output still to drop for the output converter's delay
+	int64_t frames;				// output frames written
+	int64_t total;				// output frames to write
+	double seconds;				// wall clock time run_render() took
+} RENDER_T;
+
+
+/**
+ * @brief [find an effect node by name]
+ *
+ * @param name [ops->name of the node, "delay", "compressor", "eq", "eq/151", ...]
+ * @return [pointer to the node, NULL if there is none by that name]
+ */
+const EFFECT_OPS_T * render_find_effect(
+	const char * name		// node name
+);
+
+
+/**
+ * @brief [read an effect from the command line]
+ * @details [name:p0,p1,p2, parameters left off take the effect's defaults. preset:N is gui preset N]
+ *
+ * @param text [effect and parameters]
+ * @param fx [filled in]
+ * @return [0 on success, 1 for an unknown effect or preset, or a parameter that isn't a number]
+ */
+int render_parse_effect(
+	const char * text,		// effect and parameters
+	RENDER_FX_T * fx		// effect to fill in
+);
+
+
+/**
+ * @brief [the effects in series on an effect graph]
+ *
+ * @param A [arena the graph is allocated from]
+ * @param chain [effects to run, in order]
+ * @param num_fx [number of effects, 1 to RENDER_MAX_EFFECTS]
+ * @param block_size [samples the graph runs on at once]
+ * @param FS [sampling frequency]
+ * @return [pointer to the planned graph, NULL if an effect won't initialize or it doesn't fit]
+ */
+GRAPH_T * render_chain(
+	ARENA_T * A,					// arena to allocate from
+	const RENDER_FX_T * chain,		// effects to run
+	int num_fx,						// number of effects
+	int block_size,					// samples at once
+	int FS							// sampling frequency
+);
+
+
+/**
+ * @brief [plan the chain for a file]
+ *
+ * @param A [arena everything is allocated from]
+ * @param in [file opened with open_wav()]
+ * @param chain [effects to run, in order]
+ * @param num_fx [number of effects, 1 to RENDER_MAX_EFFECTS]
+ * @param opts [how to render]
+ * @return [pointer to the render struct, NULL if an effect won't initialize or it doesn't fit]
+ */
+RENDER_T * init_render(
+	ARENA_T * A,					// arena to allocate from
+	WAV_T * in,						// file to read
+	const RENDER_FX_T * chain,		// effects to run
+	int num_fx,						// number of effects
+	const RENDER_OPTS_T * opts		// how to render
+);
+
+
+/**
+ * @brief [run the whole file through the chain]
+ * @details [nothing is allocated while it runs]
+ *
+ * @param R [pointer to the render struct]
+ * @param out [file opened with create_wav() at R->out_rate with 1 channel, or 2 for stereo]
+ * @return [0 on success, 1 if a write failed]
+ */
+int run_render(
+	RENDER_T * R,			// pointer to render struct
+	WAV_T * out				// file to write
+);
+
+
+/**
+ * @brief [print the length rendered, the time it took and the real-time factor]
+ *
+ * @param R [pointer to the render struct]
+ * @param print [prints one line]
+ */
+void report_render(
+	const RENDER_T * R,				// pointer to render struct
+	void (*print)(const char *)		// prints one line
+);
+
+
+#endif
@@ -0,0 +1,367 @@
+/**
+ * @file wav.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for reading and writing WAV files on a host.
+ *
+ * @details [
+ * 		open_wav() - map a file and find its format and data
+ *
+ * 		read_wav() - decode frames to mono floats
+ *
+ * 		create_wav() - start a file with a placeholder header
+ *
+ * 		write_wav() - encode and buffer frames
+ *
+ * 		close_wav() - flush, fill in the header and unmap
+ * ]
+ *
+ * Session recordings run to gigabytes, so nothing reads a file into memory: the file is mapped
+ * read only and the samples are decoded straight out of the page cache, with MADV_SEQUENTIAL so the
+ * kernel reads ahead. Every WAV_DROP_BYTES the pages behind the reads are dropped with MADV_DONTNEED,
+ * which for a read only mapping of a file just lets them go, so the resident size stays flat however
+ * long the file is. Writes go through one buffer allocated when the file is created, nothing is
+ * allocated per block. The sizes aren't known until the end, so the header is written last.
+ *
+ * Host only, it needs mmap.
+ *
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "arena.h"
+#include "wav.h"
+
+// ----------------------------------------------------------
+
+
+// DEFINES --------------------------------------------------
+
+#define WAV_TAG_PCM			1		// format tags in the fmt chunk
+#define WAV_TAG_FLOAT		3
+#define WAV_TAG_EXTENSIBLE	0xFFFE	// the real tag is the first 2 bytes of the subformat GUID
+
+// ----------------------------------------------------------
+
+
+const char * const wav_format_names[WAV_NUM_FORMATS] = { "16 bit", "24 bit", "32 bit", "float" };
+
+static const int wav_sample_bytes[WAV_NUM_FORMATS] = { 2, 3, 4, 4 };
+
+
+
+
+/**
+ * @brief [little endian fields of the headers]
+ */
+static uint32_t get16(const uint8_t * p) { return p[0] | (p[1] << 8); }
+static uint32_t get32(const uint8_t * p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static void put16(uint8_t * p, uint32_t v) { p[0] = v; p[1] = v >> 8; }
+static void put32(uint8_t * p, uint32_t v) { p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24; }
+
+
+/**
+ * @brief [open a WAV file to read]
+ *
+ * @param W [struct to fill in]
+ * @param path [file name]
+ * @return [0 on success, 1 if the file is missing or not a WAV file this can read]
+ */
+int open_wav(WAV_T * W, const char * path) {
+
+	struct stat st;
+	const uint8_t * p;
+	const uint8_t * end;
+	const uint8_t * fmt = NULL;
+	uint32_t size, tag, bits;
+	uint32_t fmt_size = 0;
+
+	memset(W, 0, sizeof(WAV_T));
+	W->fd = open(path, O_RDONLY);
+	if(W->fd < 0) return 1;
+
+	if(fstat(W->fd, &st) != 0 || st.st_size < 12) { close_wav(W); return 1; }
+	W->map_bytes = st.st_size;
+	W->map = (const uint8_t *)mmap(NULL, W->map_bytes, PROT_READ, MAP_PRIVATE, W->fd, 0);
+	if(W->map == MAP_FAILED) { W->map = NULL; close_wav(W); return 1; }
+	madvise((void *)W->map, W->map_bytes, MADV_SEQUENTIAL);
+
+	p = W->map;
+	end = W->map + W->map_bytes;
+	if(memcmp(p, "RIFF", 4) != 0 || memcmp(p + 8, "WAVE", 4) != 0) { close_wav(W); return 1; }
+
+	// walk the chunks up to the data, chunks are padded to an even length
+	for(p += 12; end - p >= 8; p += 8 + size + (size & 1)) {
+		size = get32(p + 4);
+		if(memcmp(p, "data", 4) == 0) break;
+		if(size > (size_t)(end - p - 8)) { p = end; break; }
+		if(memcmp(p, "fmt ", 4) == 0 && size >= 16) {
+			fmt = p + 8;
+			fmt_size = size;
+		}
+	}
+	if(fmt == NULL || end - p < 8) { close_wav(W); return 1; }
+
+	// an extensible format is only known from its subformat, cbSize at 16 and the guid at 24 have to
+	// be inside the chunk, past its end is the next chunk
+	tag = get16(fmt);
+	if(tag == WAV_TAG_EXTENSIBLE) {
+		if(fmt_size < 40 || get16(fmt + 16) < 22) { close_wav(W); return 1; }
+		tag = get16(fmt + 24);
+	}
+	bits = get16(fmt + 14);
+	W->channels = get16(fmt + 2);
+	W->FS = get32(fmt + 4);
+
+	if(tag == WAV_TAG_PCM && bits == 16) W->format = WAV_PCM16;
+	else if(tag == WAV_TAG_PCM && bits == 24) W->format = WAV_PCM24;
+	else if(tag == WAV_TAG_PCM && bits == 32) W->format = WAV_PCM32;
+	else if(tag == WAV_TAG_FLOAT && bits == 32) W->format = WAV_FLOAT32;
+	else { close_wav(W); return 1; }
+	if(W->channels < 1 || W->FS <= 0) { close_wav(W); return 1; }
+
+	// a recorder that never came back to fill in the size leaves it 0 or all ones
+	W->frame_bytes = W->channels * wav_sample_bytes[W->format];
+	W->data = p + 8;
+	size = get32(p + 4);
+	if(size == 0 || size > (size_t)(end - W->data)) W->frames = (end - W->data) / W->frame_bytes;
+	else W->frames = size / W->frame_bytes;
+
+	return 0;
+
+}
+
+
+/**
+ * @brief [read frames as one channel of floats]
+ *
+ * @param W [pointer to a file opened with open_wav()]
+ * @param start [first frame to read]
+ * @param output [room for n samples]
+ * @param n [number of frames]
+ * @return [number of frames read, less than n at the end of the file]
+ */
+int read_wav(WAV_T * W, int64_t start, float * output, int n) {
+
+	int i, c;
+	int32_t v;
+	float f, sum;
+	float scale = 1.0f / W->channels;
+	const uint8_t * p;
+	size_t offset, page;
+
+	if(start >= W->frames) return 0;
+	if(n > W->frames - start) n = (int)(W->frames - start);
+
+	p = W->data + (start * W->frame_bytes);
+	for(i = 0; i < n; i++) {
+		sum = 0;
+		for(c = 0; c < W->channels; c++) {
+			switch(W->format) {
+				case WAV_PCM16:
+					sum += (int16_t)get16(p) * (1.0f / 32768.0f);
+					p += 2;
+					break;
+				case WAV_PCM24:
+					v = (int32_t)((p[0] << 8) | (p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8;
+					sum += v * (1.0f / 8388608.0f);
+					p += 3;
+					break;
+				case WAV_PCM32:
+					sum += (int32_t)get32(p) * (1.0f / 2147483648.0f);
+					p += 4;
+					break;
+				default:
+					memcpy(&f, p, sizeof(float));
+					sum += f;
+					p += 4;
+					break;
+			}
+		}
+		output[i] = sum * scale;
+	}
+
+	// let go of the pages well behind this read
+	offset = W->data - W->map + (start * W->frame_bytes);
+	if(offset > W->dropped + 2 * WAV_DROP_BYTES) {
+		page = (size_t)sysconf(_SC_PAGESIZE);
+		offset = ((offset - WAV_DROP_BYTES) / page) * page;
+		madvise((void *)(W->map + W->dropped), offset - W->dropped, MADV_DONTNEED);
+		W->dropped = offset;
+	}
+
+	return n;
+
+}
+
+
+/**
+ * @brief [write out the buffer]
+ */
+static void wav_flush(WAV_T * W) {
+
+	if(W->buffered > 0 && write(W->fd, W->buffer, W->buffered) != W->buffered) W->failed = 1;
+	W->buffered = 0;
+
+}
+
+
+/**
+ * @brief [create a WAV file to write]
+ *
+ * @param W [struct to fill in]
+ * @param A [arena the write buffer is allocated from]
+ * @param path [file name, replaced if it exists]
+ * @param FS [sampling frequency]
+ * @param channels [1 or 2]
+ * @param format [WAV_PCM16, WAV_PCM24, WAV_PCM32 or WAV_FLOAT32]
+ * @return [0 on success, 1 if the file can't be created or the buffer doesn't fit]
+ */
+int create_wav(WAV_T * W, ARENA_T * A, const char * path, int FS, int channels, int format) {
+
+	memset(W, 0, sizeof(WAV_T));
+	W->fd = -1;
+	if(FS <= 0 || channels < 1 || channels > 2 || format < 0 || format >= WAV_NUM_FORMATS) return 1;
+
+	W->writing = 1;
+	W->FS = FS;
+	W->channels = channels;
+	W->format = format;
+	W->frame_bytes = channels * wav_sample_bytes[format];
+
+	W->buffer = (uint8_t *)arena_alloc(A, WAV_WRITE_BYTES);
+	if(W->buffer == NULL) return 1;
+
+	W->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if(W->fd < 0) return 1;
+
+	// room for the header, filled in by close_wav()
+	W->buffered = WAV_HEADER_BYTES;
+
+	return 0;
+
+}
+
+
+/**
+ * @brief [append frames to a file being written]
+ *
+ * @param W [pointer to a file opened with create_wav()]
+ * @param left [n samples of the first channel]
+ * @param right [n samples of the second channel, NULL for a mono file]
+ * @param n [number of frames]
+ * @return [0 on success, 1 if a write failed]
+ */
+int write_wav(WAV_T * W, const float * left, const float * right, int n) {
+
+	int i, c;
+	float x;
+	int32_t v;
+	uint8_t * p;
+
+	for(i = 0; i < n; i++) {
+
+		if(W->buffered + W->frame_bytes > WAV_WRITE_BYTES) wav_flush(W);
+		p = W->buffer + W->buffered;
+
+		for(c = 0; c < W->channels; c++) {
+			x = (c == 0) ? left[i] : right[i];
+			x = (x < -1.0f) ? -1.0f : ((x > 1.0f) ? 1.0f : x);
+			switch(W->format) {
+				case WAV_PCM16:
+					v = (int32_t)lrintf(x * 32768.0f);
+					v = (v > 32767) ? 32767 : v;
+					put16(p, (uint32_t)v);
+					p += 2;
+					break;
+				case WAV_PCM24:
+					v = (int32_t)lrintf(x * 8388608.0f);
+					v = (v > 8388607) ? 8388607 : v;
+					p[0] = v; p[1] = v >> 8; p[2] = v >> 16;
+					p += 3;
+					break;
+				case WAV_PCM32:
+					// 2^31 - 1 isn't a float, stop one float step short of it
+					v = (x >= 1.0f) ? 2147483647 : (int32_t)llrintf(x * 2147483648.0f);
+					put32(p, (uint32_t)v);
+					p += 4;
+					break;
+				default:
+					memcpy(p, &x, sizeof(float));
+					p += 4;
+					break;
+			}
+		}
+
+		W->buffered += W->frame_bytes;
+
+	}
+
+	W->frames += n;
+	return W->failed;
+
+}
+
+
+/**
+ * @brief [close a file, read or written]
+ *
+ * @param W [pointer to wav struct]
+ * @return [0 on success, 1 if a write to the file failed at any point]
+ */
+int close_wav(WAV_T * W) {
+
+	uint8_t header[WAV_HEADER_BYTES];
+	uint64_t data_bytes;
+	uint32_t data_size;
+	int bits, sample_bytes;
+
+	if(W->map != NULL) munmap((void *)W->map, W->map_bytes);
+	W->map = NULL;
+
+	if(W->writing && W->fd >= 0) {
+
+		wav_flush(W);
+
+		// past 4GB the sizes stay all ones, which readers take as running to the end of the file
+		sample_bytes = wav_sample_bytes[W->format];
+		bits = 8 * sample_bytes;
+		data_bytes = (uint64_t)W->frames * W->frame_bytes;
+		data_size = (data_bytes > 0xFFFFFFFFu - (WAV_HEADER_BYTES - 8)) ? 0xFFFFFFFFu : (uint32_t)data_bytes;
+
+		memcpy(header, "RIFF", 4);
+		put32(header + 4, (data_size == 0xFFFFFFFFu) ? data_size : data_size + (WAV_HEADER_BYTES - 8));
+		memcpy(header + 8, "WAVEfmt ", 8);
+		put32(header + 16, 16);
+		put16(header + 20, (W->format == WAV_FLOAT32) ? WAV_TAG_FLOAT : WAV_TAG_PCM);
+		put16(header + 22, W->channels);
+		put32(header + 24, W->FS);
+		put32(header + 28, W->FS * W->frame_bytes);
+		put16(header + 32, W->frame_bytes);
+		put16(header + 34, bits);
+		memcpy(header + 36, "data", 4);
+		put32(header + 40, data_size);
+
+		// an odd length data chunk gets its pad byte
+		if((data_bytes & 1) && write(W->fd, "", 1) != 1) W->failed = 1;
+		if(pwrite(W->fd, header, WAV_HEADER_BYTES, 0) != WAV_HEADER_BYTES) W->failed = 1;
+
+	}
+
+	if(W->fd >= 0 && close(W->fd) != 0) W->failed = 1;
+	W->fd = -1;
+
+	return W->failed;
+
+}
@@ -0,0 +1,169 @@
+/**
+ * @file wav.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for reading and writing
+ * WAV files on a host, for rendering recordings through the effect chain.
+ *
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef WAV_H
+#define WAV_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "arena.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+// sample formats
+#define WAV_PCM16			0		// 16 bit integer
+#define WAV_PCM24			1		// 24 bit integer, packed in 3 bytes
+#define WAV_PCM32			2		// 32 bit integer
+#define WAV_FLOAT32			3		// 32 bit float
+#define WAV_NUM_FORMATS		4
+
+#define WAV_HEADER_BYTES	44				// RIFF, fmt and data chunk headers of a written file
+#define WAV_WRITE_BYTES		(1024 * 1024)	// written samples are gathered into a buffer this big
+#define WAV_DROP_BYTES		(16 * 1024 * 1024)	// read pages this far behind are handed back to the kernel
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [structure containing the fields for one open WAV file]
+ * @details [a file read is memory mapped whole and decoded straight out of the mapping, so a
+ * recording of any length takes no memory beyond the pages the kernel keeps cached, and the
+ * pages already read are dropped as the reads move on. a file written goes out through one
+ * buffer from the arena, and the sizes in the header are filled in when it is closed]
+ *
+ */
+typedef struct wav_struct {
+	int fd;						// file descriptor, -1 once closed
+	int writing;				// 1 for a file being written
+	int FS;						// sampling frequency
+	int channels;				// interleaved channels in a frame
+	int format;					// WAV_PCM16, WAV_PCM24, WAV_PCM32 or WAV_FLOAT32
+	int frame_bytes;			// bytes in one frame of every channel
+	int64_t frames;				// frames in the file, or written so far
+
+	// reading --------------------------
+	const uint8_t * map;		// the whole file
+	size_t map_bytes;			// length of the mapping
+	const uint8_t * data;		// first frame, inside the mapping
+	size_t dropped;				// bytes from the start of the mapping handed back to the kernel
+
+	// writing --------------------------
+	uint8_t * buffer;			// WAV_WRITE_BYTES of samples waiting to be written
+	int buffered;				// bytes in the buffer
+	int failed;					// a write failed
+} WAV_T;
+
+
+extern const char * const wav_format_names[WAV_NUM_FORMATS];
+
+
+/**
+ * @brief [open a WAV file to read]
+ * @details [16, 24 and 32 bit integer and 32 bit float, plain or WAVE_FORMAT_EXTENSIBLE. a data
+ * chunk that claims to run past the end of the file, like a recording that was cut off before
+ * its header was written, is read up to the end of the file]
+ *
+ * @param W [struct to fill in]
+ * @param path [file name]
+ * @return [0 on success, 1 if the file is missing or not a WAV file this can read]
+ */
+int open_wav(
+	WAV_T * W,				// pointer to wav struct
+	const char * path		// file name
+);
+
+
+/**
+ * @brief [read frames as one channel of floats]
+ * @details [the channels are averaged, the guitar is mono. full scale is +-1.0, the range the
+ * adc is converted to on the board]
+ *
+ * @param W [pointer to a file opened with open_wav()]
+ * @param start [first frame to read]
+ * @param output [room for n samples]
+ * @param n [number of frames]
+ * @return [number of frames read, less than n at the end of the file]
+ */
+int read_wav(
+	WAV_T * W,				// pointer to wav struct
+	int64_t start,			// first frame
+	float * output,			// buffer for the samples
+	int n					// number of frames
+);
+
+
+/**
+ * @brief [create a WAV file to write]
+ *
+ * @param W [struct to fill in]
+ * @param A [arena the write buffer is allocated from]
+ * @param path [file name, replaced if it exists]
+ * @param FS [sampling frequency]
+ * @param channels [1 or 2]
+ * @param format [WAV_PCM16, WAV_PCM24, WAV_PCM32 or WAV_FLOAT32]
+ * @return [0 on success, 1 if the file can't be created or the buffer doesn't fit]
+ */
+int create_wav(
+	WAV_T * W,				// pointer to wav struct
+	ARENA_T * A,			// arena to allocate from
+	const char * path,		// file name
+	int FS,					// sampling frequency
+	int channels,			// 1 or 2
+	int format				// sample format
+);
+
+
+/**
+ * @brief [append frames to a file being written]
+ * @details [floats outside +-1.0 are clipped. integer formats have 2^(bits - 1) codes to 1.0, the same as read_wav(),
+ * rounded to the nearest code and +1.0 kept to the top one]
+ *
+ * @param W [pointer to a file opened with create_wav()]
+ * @param left [n samples of the first channel]
+ * @param right [n samples of the second channel, NULL for a mono file]
+ * @param n [number of frames]
+ * @return [0 on success, 1 if a write failed]
+ */
+int write_wav(
+	WAV_T * W,				// pointer to wav struct
+	const float * left,		// first channel
+	const float * right,	// second channel
+	int n					// number of frames
+);
+
+
+/**
+ * @brief [close a file, read or written]
+ * @details [a file being written has the rest of its buffer written and its header filled in]
+ *
+ * @param W [pointer to wav struct]
+ * @return [0 on success, 1 if a write to the file failed at any point]
+ */
+int close_wav(
+	WAV_T * W				// pointer to wav struct
+);
+
+
+#endif
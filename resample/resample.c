@@ -0,0 +1,198 @@
+/**
+ * @file resample.c
+ * 
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ * 
+ * @brief This file contains the functions for converting a stream from one sampling frequency to another.
+ * 
+ * @details [
+ * 		init_resample() - reduce the ratio and design the phases
+ * 
+ * 		calc_resample() - convert a block
+ * 
+ * 		resample_max_out() - output buffer size for a block
+ * 
+ * 		reset_resample() - clear the history
+ * ]
+ * 
+ * The converter is the textbook polyphase one: upsample by up, lowpass at the lower of the two rates,
+ * keep every down-th sample, with only the products that survive worked out. Each output is a dot
+ * product of one phase with the input history, which runs on the dsp backend (AVX2 or NEON on a host).
+ * 44.1kHz to 48kHz is 160 / 147, every phase is in the table and nothing is approximated. Ratios with
+ * a bigger up, 32kHz to 44.1kHz is 441 / 320, interpolate linearly between RESAMPLE_MAX_PHASES phases,
+ * which is well under the 80 dB the prototype stops at. Going down in rate the cutoff moves down with
+ * the output rate, and the phases get longer so the transition stays as sharp.
+ * 
+ * It is for the host tools, to run recordings at any rate through the engine at the rate its filters
+ * are for. The phase table is 40 to 70KB, which the board has no use for.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+
+#include "arena.h"
+#include "dsp.h"
+#include "design.h"
+#include "resample.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [greatest common divisor]
+ */
+static int gcd(int a, int b) {
+
+	int t;
+
+	while(b != 0) {
+		t = a % b;
+		a = b;
+		b = t;
+	}
+
+	return a;
+
+}
+
+
+/**
+ * @brief [initialize a converter between two rates]
+ * 
+ * @param A [arena the struct, phase table and history are allocated from]
+ * @param in_rate [input sampling frequency]
+ * @param out_rate [output sampling frequency]
+ * @param block_size [most input samples handed to calc_resample() at once]
+ * @return [pointer to the converter, NULL if it doesn't fit in the arena]
+ */
+RESAMPLE_T * init_resample(ARENA_T * A, int in_rate, int out_rate, int block_size) {
+
+	int g;
+	float cutoff;
+
+	if(in_rate <= 0 || out_rate <= 0 || block_size <= 0) return NULL;
+
+	RESAMPLE_T * R = (RESAMPLE_T *)arena_alloc(A, sizeof(RESAMPLE_T));
+	if(R == NULL) return NULL;
+
+	g = gcd(in_rate, out_rate);
+	R->in_rate = in_rate;
+	R->out_rate = out_rate;
+	R->up = out_rate / g;
+	R->down = in_rate / g;
+	R->num_phases = (R->up <= RESAMPLE_MAX_PHASES) ? R->up : RESAMPLE_MAX_PHASES;
+	R->block_size = block_size;
+
+	// going down, the cutoff is a fraction of the output rate and the phases are longer by the ratio.
+	// a multiple of 8 taps keeps the dot product in whole vectors
+	R->num_taps = RESAMPLE_TAPS;
+	cutoff = RESAMPLE_CUTOFF;
+	if(R->down > R->up) {
+		R->num_taps = (int)(((int64_t)RESAMPLE_TAPS * R->down + R->up - 1) / R->up);
+		cutoff = RESAMPLE_CUTOFF * R->up / R->down;
+	}
+	R->num_taps = (R->num_taps + 7) & ~7;
+
+	// the prototype is centered num_taps / 2 inputs back
+	R->delay = (0.5f * R->num_taps * out_rate) / in_rate;
+
+	R->phases = (float *)arena_alloc(A, sizeof(float) * (R->num_phases + 1) * R->num_taps);
+	if(R->phases == NULL) return NULL;
+	design_polyphase(R->phases, R->num_phases, R->num_taps, cutoff, RESAMPLE_BETA);
+
+	// zeroed by the arena, the stream starts from silence
+	R->history = (float *)arena_alloc(A, sizeof(float) * (R->num_taps - 1 + block_size));
+	if(R->history == NULL) return NULL;
+	R->pos = 0;
+	R->phase = 0;
+
+	return R;
+
+}
+
+
+/**
+ * @brief [convert a block of input]
+ * @details [output k is at input time pos + phase / up. its phase is dotted with the num_taps
+ * inputs ending at pos, which start at history[pos] once the block is behind the old inputs]
+ * 
+ * @param R [pointer to the converter]
+ * @param input [n input samples]
+ * @param output [room for resample_max_out(R, n) output samples]
+ * @param n [number of input samples, at most block_size]
+ * @return [number of output samples written]
+ */
+int calc_resample(RESAMPLE_T * R, const float * input, float * output, int n) {
+
+	int count = 0;
+	int j, K = R->num_taps;
+	int64_t x;
+	float mu, y0, y1;
+	const float * h;
+
+	memcpy(R->history + (K - 1), input, sizeof(float) * n);
+
+	while(R->pos < n) {
+
+		if(R->num_phases == R->up) {
+			// exact, the phase is in the table
+			output[count++] = dsp->dot(R->phases + (R->phase * K), R->history + R->pos, K);
+		} else {
+			// between table phases j and j + 1
+			x = (int64_t)R->phase * R->num_phases;
+			j = (int)(x / R->up);
+			mu = (float)(x % R->up) / R->up;
+			h = R->phases + (j * K);
+			y0 = dsp->dot(h, R->history + R->pos, K);
+			y1 = dsp->dot(h + K, R->history + R->pos, K);
+			output[count++] = y0 + mu * (y1 - y0);
+		}
+
+		R->phase += R->down;
+		R->pos += R->phase / R->up;
+		R->phase %= R->up;
+
+	}
+
+	// the next block starts n inputs on
+	R->pos -= n;
+	memmove(R->history, R->history + n, sizeof(float) * (K - 1));
+
+	return count;
+
+}
+
+
+/**
+ * @brief [most outputs n inputs can make]
+ * 
+ * @param R [pointer to the converter]
+ * @param n [number of input samples]
+ * @return [size the output buffer needs]
+ */
+int resample_max_out(const RESAMPLE_T * R, int n) {
+
+	return (int)((((int64_t)n * R->up) + R->down - 1) / R->down) + 1;
+
+}
+
+
+/**
+ * @brief [clear the history back to silence and start at the first phase]
+ * 
+ * @param R [pointer to the converter]
+ */
+void reset_resample(RESAMPLE_T * R) {
+
+	memset(R->history, 0, sizeof(float) * (R->num_taps - 1 + R->block_size));
+	R->pos = 0;
+	R->phase = 0;
+
+}
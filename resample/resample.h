@@ -0,0 +1,124 @@
+/**
+ * @file resample.h
+ * 
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ * 
+ * @brief This file contains subroutine and data-type declarations necessary for the polyphase
+ * sample rate converter that takes recordings to and from the rate the engine runs at.
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef RESAMPLE_H
+#define RESAMPLE_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+#include "arena.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define RESAMPLE_TAPS		64		// taps per phase, more when going down in rate so the cutoff is as sharp
+#define RESAMPLE_BETA		8.0f	// Kaiser window of the prototype, about 80 dB
+#define RESAMPLE_CUTOFF		0.46f	// -6 dB point as a fraction of the lower rate, the stopband starts at half
+#define RESAMPLE_MAX_PHASES	256		// ratios that need more phases interpolate between two of these
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [structure containing the fields for one channel of rate conversion]
+ * @details [the rates reduce to out / in = up / down. every output is one phase of the prototype
+ * lowpass dotted with the last num_taps inputs. when up is at most RESAMPLE_MAX_PHASES every phase
+ * is in the table and the conversion is exact, otherwise the output is interpolated between the
+ * two table phases either side of it]
+ * 
+ */
+typedef struct resample_struct {
+	int in_rate;				// input sampling frequency
+	int out_rate;				// output sampling frequency
+	int up;						// out_rate / gcd
+	int down;					// in_rate / gcd
+	int num_phases;				// phases in the table, up or RESAMPLE_MAX_PHASES
+	int num_taps;				// taps per phase, a multiple of 8
+	int block_size;				// most input samples per call
+	float * phases;				// (num_phases + 1) * num_taps, see design_polyphase()
+	float * history;			// last num_taps - 1 inputs followed by the current block
+	int pos;					// input in the current block the next output is at
+	int phase;					// and how far past it, in 1 / up of an input
+	float delay;				// group delay in output samples
+} RESAMPLE_T;
+
+
+/**
+ * @brief [initialize a converter between two rates]
+ * 
+ * @param A [arena the struct, phase table and history are allocated from]
+ * @param in_rate [input sampling frequency]
+ * @param out_rate [output sampling frequency]
+ * @param block_size [most input samples handed to calc_resample() at once]
+ * @return [pointer to the converter, NULL if it doesn't fit in the arena]
+ */
+RESAMPLE_T * init_resample(
+	ARENA_T * A,		// arena to allocate from
+	int in_rate,		// input sampling frequency
+	int out_rate,		// output sampling frequency
+	int block_size		// most input samples per call
+);
+
+
+/**
+ * @brief [convert a block of input]
+ * @details [every input is used, the number of outputs varies from call to call. the state carries
+ * over so a stream can be converted in blocks of any size up to block_size]
+ * 
+ * @param R [pointer to the converter]
+ * @param input [n input samples]
+ * @param output [room for resample_max_out(R, n) output samples]
+ * @param n [number of input samples, at most block_size]
+ * @return [number of output samples written]
+ */
+int calc_resample(
+	RESAMPLE_T * R,			// pointer to converter
+	const float * input,	// input buffer
+	float * output,			// output buffer
+	int n					// number of input samples
+);
+
+
+/**
+ * @brief [most outputs n inputs can make]
+ * 
+ * @param R [pointer to the converter]
+ * @param n [number of input samples]
+ * @return [size the output buffer needs]
+ */
+int resample_max_out(
+	const RESAMPLE_T * R,	// pointer to converter
+	int n					// number of input samples
+);
+
+
+/**
+ * @brief [clear the history back to silence and start at the first phase]
+ * 
+ * @param R [pointer to the converter]
+ */
+void reset_resample(
+	RESAMPLE_T * R			// pointer to converter
+);
+
+
+#endif
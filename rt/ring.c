@@ -0,0 +1,135 @@
+/**
+ * @file ring.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for the lock-free ring of blocks between two threads.
+ *
+ * @details [
+ * 		init_ring() - an empty ring of fixed size slots
+ *
+ * 		ring_write_slot(), ring_commit() - fill the next slot and hand it over
+ *
+ * 		ring_read_slot(), ring_release() - read the oldest slot and give it back
+ *
+ * 		ring_count() - slots waiting
+ * ]
+ *
+ * The producer only stores head and the consumer only stores tail, so neither needs a lock or a
+ * compare and swap. The commit is a release store of head after the slot is filled, and the reader
+ * loads head with acquire, so a slot it sees is a slot that is all there. The same the other way:
+ * the release of tail is what lets the producer write over the slot. Both sides keep to plain loads
+ * and stores with the ordering the GCC atomics give them, the same as the trace ring (see trace.c).
+ *
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "arena.h"
+#include "ring.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [initialize an empty ring]
+ *
+ * @param A [arena the ring is allocated from]
+ * @param slots [slots in the ring, a power of 2]
+ * @param slot_bytes [size of a slot]
+ * @return [pointer to the ring struct, NULL if slots isn't a power of 2 or it doesn't fit in the arena]
+ */
+RING_T * init_ring(ARENA_T * A, int slots, int slot_bytes) {
+
+	if(slots < 1 || (slots & (slots - 1)) != 0 || slot_bytes < 1) return NULL;
+
+	RING_T * R = (RING_T *)arena_alloc_aligned(A, sizeof(RING_T), RING_LINE);
+	if(R == NULL) return NULL;
+
+	R->slots = (uint32_t)slots;
+	R->slot_bytes = (uint32_t)((slot_bytes + RING_LINE - 1) & ~(RING_LINE - 1));
+	R->data = (uint8_t *)arena_alloc_aligned(A, (size_t)R->slots * R->slot_bytes, RING_LINE);
+	if(R->data == NULL) return NULL;
+
+	return R;
+
+}
+
+
+/**
+ * @brief [the next slot to write, producer only]
+ *
+ * @param R [pointer to the ring struct]
+ * @return [pointer to the slot, NULL if the ring is full]
+ */
+void * ring_write_slot(RING_T * R) {
+
+	uint32_t tail = __atomic_load_n(&(R->tail), __ATOMIC_ACQUIRE);
+
+	if(R->head - tail == R->slots) return NULL;
+	return R->data + (size_t)(R->head & (R->slots - 1)) * R->slot_bytes;
+
+}
+
+
+/**
+ * @brief [hand the slot from ring_write_slot() to the consumer, producer only]
+ *
+ * @param R [pointer to the ring struct]
+ */
+void ring_commit(RING_T * R) {
+
+	__atomic_store_n(&(R->head), R->head + 1, __ATOMIC_RELEASE);
+
+}
+
+
+/**
+ * @brief [the oldest slot written, consumer only]
+ *
+ * @param R [pointer to the ring struct]
+ * @return [pointer to the slot, NULL if the ring is empty]
+ */
+void * ring_read_slot(RING_T * R) {
+
+	uint32_t head = __atomic_load_n(&(R->head), __ATOMIC_ACQUIRE);
+
+	if(head == R->tail) return NULL;
+	return R->data + (size_t)(R->tail & (R->slots - 1)) * R->slot_bytes;
+
+}
+
+
+/**
+ * @brief [give the slot from ring_read_slot() back to the producer, consumer only]
+ *
+ * @param R [pointer to the ring struct]
+ */
+void ring_release(RING_T * R) {
+
+	__atomic_store_n(&(R->tail), R->tail + 1, __ATOMIC_RELEASE);
+
+}
+
+
+/**
+ * @brief [slots written and not yet read]
+ *
+ * @param R [pointer to the ring struct]
+ * @return [number of slots]
+ */
+int ring_count(const RING_T * R) {
+
+	uint32_t tail = __atomic_load_n(&(R->tail), __ATOMIC_ACQUIRE);
+	uint32_t head = __atomic_load_n(&(R->head), __ATOMIC_ACQUIRE);
+
+	return (int)(head - tail);
+
+}
@@ -0,0 +1,127 @@
+/**
+ * @file ring.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for the lock-free
+ * single producer, single consumer ring of blocks between the real-time engine's threads.
+ *
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef RING_H
+#define RING_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define RING_LINE	64		// cache line, the two indices and every slot start on one
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [structure containing the slots and the two indices]
+ * @details [one thread writes slots and moves head, one other thread reads them and moves tail.
+ * the indices only grow, a slot is index & (slots - 1), and each is on its own cache line so the
+ * two threads don't pass the line back and forth on every block. nothing is locked and nothing
+ * is copied, a thread gets a pointer to the slot and fills or reads it in place]
+ *
+ */
+typedef struct ring_struct {
+	uint32_t head;				// slots written, only the producer stores it
+	uint8_t pad_head[RING_LINE - sizeof(uint32_t)];
+	uint32_t tail;				// slots read, only the consumer stores it
+	uint8_t pad_tail[RING_LINE - sizeof(uint32_t)];
+	uint32_t slots;				// slots in the ring, a power of 2
+	uint32_t slot_bytes;		// size of a slot, rounded up to a cache line
+	uint8_t * data;				// slots * slot_bytes
+} RING_T;
+
+
+/**
+ * @brief [initialize an empty ring]
+ *
+ * @param A [arena the ring is allocated from]
+ * @param slots [slots in the ring, a power of 2]
+ * @param slot_bytes [size of a slot]
+ * @return [pointer to the ring struct, NULL if slots isn't a power of 2 or it doesn't fit in the arena]
+ */
+RING_T * init_ring(
+	ARENA_T * A,			// arena to allocate from
+	int slots,				// slots in the ring
+	int slot_bytes			// size of a slot
+);
+
+
+/**
+ * @brief [the next slot to write, producer only]
+ *
+ * @param R [pointer to the ring struct]
+ * @return [pointer to the slot, NULL if the ring is full]
+ */
+void * ring_write_slot(
+	RING_T * R				// pointer to ring struct
+);
+
+
+/**
+ * @brief [hand the slot from ring_write_slot() to the consumer, producer only]
+ *
+ * @param R [pointer to the ring struct]
+ */
+void ring_commit(
+	RING_T * R				// pointer to ring struct
+);
+
+
+/**
+ * @brief [the oldest slot written, consumer only]
+ *
+ * @param R [pointer to the ring struct]
+ * @return [pointer to the slot, NULL if the ring is empty]
+ */
+void * ring_read_slot(
+	RING_T * R				// pointer to ring struct
+);
+
+
+/**
+ * @brief [give the slot from ring_read_slot() back to the producer, consumer only]
+ *
+ * @param R [pointer to the ring struct]
+ */
+void ring_release(
+	RING_T * R				// pointer to ring struct
+);
+
+
+/**
+ * @brief [slots written and not yet read]
+ * @details [either thread, it can be out of date by the time it is used]
+ *
+ * @param R [pointer to the ring struct]
+ * @return [number of slots]
+ */
+int ring_count(
+	const RING_T * R		// pointer to ring struct
+);
+
+
+#endif
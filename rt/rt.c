@@ -0,0 +1,495 @@
+/**
+ * @file rt.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for running the effect chain in real time on a Linux host.
+ *
+ * @details [
+ * 		init_rt() - plan the lowpass, the chain and the rings for a source and a sink
+ *
+ * 		run_rt() - lock memory, start the io and dsp threads and wait for them
+ *
+ * 		rt_stop() - stop at the end of the period, from a signal handler
+ *
+ * 		report_rt() - setup, xruns, dsp time and latency
+ * ]
+ *
+ * The board splits the work between the DMA, which moves a block every period whatever happens, and
+ * the loop that runs the chain (see dma_io.c). Here that is two threads. The io thread is the DMA: once
+ * a period it reads a block from the source into the input ring, takes a finished block out of the
+ * output ring, writes it to the sink and sleeps to the next period on the monotonic clock. The dsp thread
+ * is the loop: it waits on the input ring, runs the board's input lowpass and the chain, the same as the
+ * renderer does (see render.c), and puts the block in the output ring. The output ring starts with
+ * prefill blocks of silence, so the dsp thread has prefill periods to get each block through, and the
+ * deadline monitor checks every block against that (see deadline.c).
+ *
+ * The rings are lock-free (see ring.c), and the only other thing the threads share is a semaphore to
+ * wake the dsp thread, so neither can be held up by the other taking a lock. Everything is allocated
+ * from the arena before the threads start, the memory is locked, the threads get SCHED_FIFO with the io
+ * thread one priority above the dsp thread, and each can be pinned to a cpu of its own. A desktop kernel
+ * or a user without the rtprio limit refuses some of that, and the engine runs anyway and says so in the
+ * report, since the xrun counts are what tell whether it was enough.
+ *
+ * When the dsp thread misses a period the sink gets a block of silence (an underrun). The block it was
+ * late with is thrown away once the one after it is ready, so the latency goes back to prefill blocks
+ * instead of growing by a block with every underrun. If it falls a whole ring behind the input is lost
+ * (an overrun). Freewheeling there is no clock, the io thread waits for each block, so a file goes
+ * through as fast as the chain can run it with no xruns, and comes out as the renderer would write it
+ * at the same block size, after prefill blocks of silence.
+ *
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+
+#include "arena.h"
+#include "fir.h"
+#include "design.h"
+#include "effect_graph.h"
+#include "profiler.h"
+#include "deadline.h"
+#include "render.h"
+#include "ring.h"
+#include "rt_io.h"
+#include "rt.h"
+
+// ----------------------------------------------------------
+
+
+
+
+/**
+ * @brief [nanoseconds on the monotonic clock]
+ */
+static int64_t rt_ns(void) {
+
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (int64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+
+}
+
+
+/**
+ * @brief [wait on a semaphore through signals]
+ */
+static void rt_wait(sem_t * s) {
+
+	while(sem_wait(s) != 0 && errno == EINTR);
+
+}
+
+
+/**
+ * @brief [plan the chain and the rings for a source and a sink]
+ *
+ * @param A [arena everything is allocated from]
+ * @param source [opened with init_rt_io(), at most block_size frames at once]
+ * @param sink [opened with init_rt_io() at the source's rate]
+ * @param chain [effects to run, in order]
+ * @param num_fx [number of effects, 1 to RENDER_MAX_EFFECTS]
+ * @param opts [how to run]
+ * @return [pointer to the engine, NULL if the rates differ, an effect won't initialize or it doesn't fit]
+ */
+RT_T * init_rt(ARENA_T * A, RT_IO_T * source, RT_IO_T * sink, const RENDER_FX_T * chain, int num_fx, const RT_OPTS_T * opts) {
+
+	int slots;
+	const float * coefs;
+
+	if(source->output || !sink->output || source->FS != sink->FS) return NULL;
+
+	RT_T * R = (RT_T *)arena_alloc(A, sizeof(RT_T));
+	if(R == NULL) return NULL;
+
+	R->source = source;
+	R->sink = sink;
+	R->FS = source->FS;
+	R->block_size = (opts->block_size > 0) ? opts->block_size : RT_BLOCK;
+	R->prefill = (opts->prefill > 0) ? opts->prefill : RT_PREFILL;
+	R->freewheel = opts->freewheel;
+	R->max_frames = (int64_t)(opts->seconds * R->FS);
+	R->priority = opts->priority;
+	R->io_cpu = opts->io_cpu;
+	R->dsp_cpu = opts->dsp_cpu;
+	R->total = -1;
+	if(R->prefill > RT_MAX_PREFILL) return NULL;
+	if(source->max_frames < R->block_size || sink->max_frames < R->block_size) return NULL;
+
+	// the input lowpass, then the effects in series, the same as a render
+	arena_set_tag(A, "lowpass");
+	coefs = design_input_lowpass(A, R->FS, &(R->lowpass_taps));
+	if(coefs == NULL) return NULL;
+	R->lowpass = init_fir(A, coefs, R->lowpass_taps, R->block_size, FIR_PLAN);
+	if(R->lowpass == NULL) return NULL;
+
+	R->G = render_chain(A, chain, num_fx, R->block_size, R->FS);
+	if(R->G == NULL) return NULL;
+	R->tail = (R->lowpass_taps - 1) + ((R->G->tail < 0) ? 0 : R->G->tail);
+
+	// room for the blocks queued ahead, the one being filled and the one being read
+	arena_set_tag(A, "rt");
+	for(slots = 4; slots < R->prefill + 2; slots *= 2);
+	R->in_ring = init_ring(A, slots, sizeof(RT_BLOCK_T) + sizeof(float) * R->block_size);
+	R->out_ring = init_ring(A, slots, sizeof(RT_BLOCK_T) + sizeof(float) * 2 * R->block_size);
+	R->scratch = (float *)arena_alloc(A, sizeof(float) * 3 * R->block_size);
+	R->silence = (float *)arena_alloc(A, sizeof(float) * R->block_size);
+	if(R->in_ring == NULL || R->out_ring == NULL || R->scratch == NULL || R->silence == NULL) return NULL;
+
+	R->P = init_profiler(A, 2);
+	if(R->P == NULL) return NULL;
+	R->dsp_stage = profile_add_stage(R->P, "dsp");
+	R->latency_stage = profile_add_stage(R->P, "latency");
+	R->D = init_deadline(A, NULL, R->prefill * R->block_size, R->FS);
+	if(R->D == NULL) return NULL;
+
+	if(sem_init(&(R->in_ready), 0, 0) != 0 || sem_init(&(R->out_ready), 0, 0) != 0) return NULL;
+
+	return R;
+
+}
+
+
+/**
+ * @brief [the io thread: a block in and a block out every period]
+ */
+static void * rt_io_main(void * arg) {
+
+	RT_T * R = (RT_T *)arg;
+	RT_BLOCK_T * in;
+	RT_BLOCK_T * out;
+	float * input;
+	float * dry;
+	float * wet;
+	int n, got;
+	int owed = 0;				// underruns whose late block hasn't been thrown away yet
+	int64_t read = 0;			// input frames read
+	int64_t origin, last, next, now;
+	uint32_t periods = 0;		// periods since origin
+	uint32_t release;
+	struct timespec wake;
+
+	origin = next = rt_ns();
+
+	while(__atomic_load_n(&(R->running), __ATOMIC_ACQUIRE)) {
+
+		// the input block, into the ring, or nowhere if the dsp thread is a whole ring behind
+		release = profile_now();
+		in = (RT_BLOCK_T *)ring_write_slot(R->in_ring);
+		input = (in != NULL) ? in->samples : R->scratch;
+		n = R->block_size;
+		if(R->max_frames > 0 && R->max_frames - read < n) n = (int)(R->max_frames - read);
+		got = (R->total < 0 && n > 0) ? R->source->ops->read(R->source, input, n) : 0;
+		memset(input + got, 0, sizeof(float) * (R->block_size - got));
+		read += got;
+
+		// once the source ends, what's left is what is queued ahead and the tail
+		if(R->total < 0 && got < R->block_size) R->total = (int64_t)R->prefill * R->block_size + read + R->tail;
+
+		if(in != NULL) {
+			in->seq = R->blocks;
+			in->release = release;
+			ring_commit(R->in_ring);
+			sem_post(&(R->in_ready));
+		} else {
+			R->overruns++;
+		}
+
+		// the output block from prefill periods ago
+		if(R->freewheel) rt_wait(&(R->out_ready));
+		out = (RT_BLOCK_T *)ring_read_slot(R->out_ring);
+		while(out != NULL && owed > 0 && ring_count(R->out_ring) > 1) {
+			ring_release(R->out_ring);
+			R->skipped++;
+			owed--;
+			out = (RT_BLOCK_T *)ring_read_slot(R->out_ring);
+		}
+
+		dry = wet = R->silence;
+		if(out != NULL) {
+			dry = out->samples;
+			wet = out->samples + R->block_size;
+		} else {
+			R->underruns++;
+			owed++;
+		}
+
+		n = R->block_size;
+		if(R->total >= 0 && R->total - R->frames < n) n = (int)(R->total - R->frames);
+		if(R->sink->channels == 2) got = R->sink->ops->write(R->sink, dry, wet, n);
+		else got = R->sink->ops->write(R->sink, wet, NULL, n);
+
+		if(out != NULL) {
+			if(out->seq != RT_SILENCE) profile_record(R->P, R->latency_stage, profile_now() - out->release);
+			ring_release(R->out_ring);
+		}
+
+		R->blocks++;
+		if(got != 0 || R->source->failed) break;
+		R->frames += n;
+		if(R->total >= 0 && R->frames >= R->total) break;
+
+		// sleep to the next period, counted from the origin so the periods don't drift
+		if(!R->freewheel) {
+			periods++;
+			last = next;
+			next = origin + ((int64_t)periods * R->block_size * 1000000000) / R->FS;
+			now = rt_ns();
+			if(now - next > next - last) {
+				// more than a period late, the lost time is gone, start counting again from now
+				R->late++;
+				origin = next = now;
+				periods = 0;
+			} else if(now < next) {
+				wake.tv_sec = next / 1000000000;
+				wake.tv_nsec = next % 1000000000;
+				while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL) == EINTR);
+			}
+		}
+
+	}
+
+	// wake the dsp thread to find the ring empty
+	__atomic_store_n(&(R->running), 0, __ATOMIC_RELEASE);
+	sem_post(&(R->in_ready));
+
+	return NULL;
+
+}
+
+
+/**
+ * @brief [the dsp thread: the lowpass and the chain on every block in the input ring]
+ */
+static void * rt_dsp_main(void * arg) {
+
+	RT_T * R = (RT_T *)arg;
+	RT_BLOCK_T * in;
+	RT_BLOCK_T * out;
+	float * dry;
+	uint32_t seq, release, begin, finish;
+
+	for(;;) {
+
+		// every block is posted, so an empty ring is the io thread's post at the end
+		rt_wait(&(R->in_ready));
+		in = (RT_BLOCK_T *)ring_read_slot(R->in_ring);
+		if(in == NULL) break;
+
+		begin = profile_now();
+		seq = in->seq;
+		release = in->release;
+
+		// straight into the output slot, or the scratch if there's no room so the chain still runs on
+		out = (RT_BLOCK_T *)ring_write_slot(R->out_ring);
+		dry = (out != NULL) ? out->samples : R->scratch + R->block_size;
+		calc_fir(R->lowpass, in->samples, dry, R->block_size);
+		ring_release(R->in_ring);
+		run_graph(R->G, dry, dry + R->block_size);
+
+		finish = profile_now();
+		if(out != NULL) {
+			out->seq = seq;
+			out->release = release;
+			ring_commit(R->out_ring);
+			if(R->freewheel) sem_post(&(R->out_ready));
+		} else {
+			R->dropped++;
+		}
+
+		R->processed++;
+		profile_record(R->P, R->dsp_stage, finish - begin);
+		deadline_record(R->D, release, finish);
+
+	}
+
+	return NULL;
+
+}
+
+
+/**
+ * @brief [start a thread with SCHED_FIFO and a cpu, or without them if they are refused]
+ *
+ * @param R [pointer to the engine, fifo and pinned are cleared for what was refused]
+ * @param thread [set to the thread]
+ * @param main [thread function]
+ * @param priority [SCHED_FIFO priority, 0 for the normal scheduler]
+ * @param cpu [cpu to pin to, -1 for any]
+ * @param name [thread name for top and gdb]
+ * @return [0 on success, 1 if it wouldn't start at all]
+ */
+static int rt_start(RT_T * R, pthread_t * thread, void * (*main)(void *), int priority, int cpu, const char * name) {
+
+	int err;
+	int fifo = (priority > 0);
+	int pin = (cpu >= 0 && cpu < CPU_SETSIZE);
+	pthread_attr_t attr;
+	struct sched_param param;
+	cpu_set_t cpus;
+
+	for(;;) {
+
+		pthread_attr_init(&attr);
+		pthread_attr_setstacksize(&attr, RT_STACK_BYTES);
+		if(fifo) {
+			memset(&param, 0, sizeof(param));
+			param.sched_priority = priority;
+			pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+			pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+			pthread_attr_setschedparam(&attr, &param);
+		}
+		if(pin) {
+			CPU_ZERO(&cpus);
+			CPU_SET(cpu, &cpus);
+			pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+		}
+
+		err = pthread_create(thread, &attr, main, R);
+		pthread_attr_destroy(&attr);
+		if(err == 0) break;
+
+		// EPERM without the rtprio limit, EINVAL for a cpu that isn't there
+		if(fifo) fifo = 0;
+		else if(pin) pin = 0;
+		else return 1;
+
+	}
+
+	if(priority > 0 && !fifo) R->fifo = 0;
+	if(cpu >= 0 && !pin) R->pinned = 0;
+	pthread_setname_np(*thread, name);
+
+	return 0;
+
+}
+
+
+/**
+ * @brief [lock memory, start the two threads and wait until the source and the tail are done]
+ *
+ * @param R [pointer to the engine]
+ * @return [0 on success, 1 if a thread wouldn't start or the source or sink failed]
+ */
+int run_rt(RT_T * R) {
+
+	int i, failed = 0;
+	int64_t start;
+	RT_BLOCK_T * out;
+
+	// silence queued ahead, the dsp thread has this many periods for every block
+	for(i = 0; i < R->prefill; i++) {
+		out = (RT_BLOCK_T *)ring_write_slot(R->out_ring);
+		out->seq = RT_SILENCE;
+		memset(out->samples, 0, sizeof(float) * 2 * R->block_size);
+		ring_commit(R->out_ring);
+		if(R->freewheel) sem_post(&(R->out_ready));
+	}
+
+	// the arena is already written through, so locking it faults nothing in, and the thread stacks
+	// are locked as they are mapped
+	R->locked = (mlockall(MCL_CURRENT | MCL_FUTURE) == 0);
+	R->fifo = (R->priority > 0);
+	R->pinned = (R->io_cpu >= 0 || R->dsp_cpu >= 0);
+	reset_profiler(R->P);
+	reset_deadline(R->D);
+
+	start = rt_ns();
+	__atomic_store_n(&(R->running), 1, __ATOMIC_RELEASE);
+
+	if(rt_start(R, &(R->dsp_thread), rt_dsp_main, R->priority, R->dsp_cpu, "gape-dsp") != 0) {
+		failed = 1;
+	} else {
+		if(rt_start(R, &(R->io_thread), rt_io_main, (R->priority > 0) ? R->priority + 1 : 0, R->io_cpu, "gape-io") != 0) {
+			__atomic_store_n(&(R->running), 0, __ATOMIC_RELEASE);
+			sem_post(&(R->in_ready));
+			failed = 1;
+		} else {
+			pthread_join(R->io_thread, NULL);
+		}
+		pthread_join(R->dsp_thread, NULL);
+	}
+
+	R->seconds = (rt_ns() - start) * 1e-9;
+	if(R->locked) munlockall();
+
+	return failed || R->source->failed || R->sink->failed;
+
+}
+
+
+/**
+ * @brief [stop at the end of the current period]
+ *
+ * @param R [pointer to the engine]
+ */
+void rt_stop(RT_T * R) {
+
+	__atomic_store_n(&(R->running), 0, __ATOMIC_RELEASE);
+
+}
+
+
+/**
+ * @brief [print the setup, the xruns, the dsp time and the latency]
+ *
+ * @param R [pointer to the engine]
+ * @param print [prints one line]
+ */
+void report_rt(const RT_T * R, void (*print)(const char *)) {
+
+	char line[192];
+	char sched[40], pin[48];
+	double period = 1e3 * R->block_size / R->FS;		// ms
+	double ms = 1e3 / profile_ticks_per_sec();			// ms per tick
+	PROFILE_STATS_T S;
+
+	snprintf(line, sizeof(line), "rt: %d Hz in blocks of %d (%.2f ms), %d queued ahead (%.2f ms), %d tap lowpass, %s\r\n",
+		R->FS, R->block_size, period, R->prefill, R->prefill * period, R->lowpass_taps, R->freewheel ? "freewheeling" : "paced");
+	print(line);
+
+	if(R->fifo) snprintf(sched, sizeof(sched), "SCHED_FIFO %d/%d", R->priority + 1, R->priority);
+	else snprintf(sched, sizeof(sched), "%s", (R->priority > 0) ? "SCHED_FIFO refused" : "normal scheduler");
+	if(R->pinned) snprintf(pin, sizeof(pin), "io on cpu %d, dsp on cpu %d", R->io_cpu, R->dsp_cpu);
+	else snprintf(pin, sizeof(pin), "%s", (R->io_cpu >= 0 || R->dsp_cpu >= 0) ? "pinning refused" : "not pinned");
+	snprintf(line, sizeof(line), "  %s to %s, memory %s, %s, %s\r\n", R->source->ops->name, R->sink->ops->name,
+		R->locked ? "locked" : "not locked", sched, pin);
+	print(line);
+
+	snprintf(line, sizeof(line), "  %lu periods in %.2f s, %lu xruns: %lu underruns, %lu overruns, %lu dropped, %lu late wakeups, %lu late blocks skipped\r\n",
+		(unsigned long)R->blocks, R->seconds, (unsigned long)(R->underruns + R->overruns + R->dropped),
+		(unsigned long)R->underruns, (unsigned long)R->overruns, (unsigned long)R->dropped,
+		(unsigned long)R->late, (unsigned long)R->skipped);
+	print(line);
+
+	profile_stats(R->P, R->dsp_stage, &S);
+	if(S.count > 0) {
+		snprintf(line, sizeof(line), "  dsp %lu blocks: mean %.3f ms, p99 %.3f ms, max %.3f ms of a %.2f ms period, %.1f%% load\r\n",
+			(unsigned long)S.count, S.mean * ms, S.p99 * ms, S.max * ms, period,
+			(R->seconds > 0) ? (100.0 * S.mean * S.count * ms) / (R->seconds * 1e3) : 0.0);
+		print(line);
+	}
+
+	profile_stats(R->P, R->latency_stage, &S);
+	if(S.count > 0) {
+		snprintf(line, sizeof(line), "  latency source to sink: min %.2f ms, p50 %.2f ms, p99 %.2f ms, max %.2f ms\r\n",
+			S.min * ms, S.p50 * ms, S.p99 * ms, S.max * ms);
+		print(line);
+	}
+
+	report_deadline(R->D, print);
+
+}
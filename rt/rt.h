@@ -0,0 +1,201 @@
+/**
+ * @file rt.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for running the effect
+ * chain in real time on a Linux host.
+ *
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef RT_H
+#define RT_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "arena.h"
+#include "fir.h"
+#include "effect_graph.h"
+#include "profiler.h"
+#include "deadline.h"
+#include "render.h"
+#include "ring.h"
+#include "rt_io.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define RT_BLOCK			256					// samples in a block unless asked otherwise, 5.3ms at 48kHz
+#define RT_PREFILL			2					// blocks of output queued ahead of the io thread unless asked otherwise
+#define RT_MAX_PREFILL		62					// most blocks queued, the rings are at most 64 slots
+#define RT_PRIORITY			80					// SCHED_FIFO priority of the dsp thread, the io thread runs one above
+#define RT_STACK_BYTES		(256 * 1024)		// stack of each thread, locked with the rest
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [how to run, zeros pick the defaults]
+ *
+ */
+typedef struct rt_opts_struct {
+	int block_size;			// samples in a block, RT_BLOCK if 0
+	int prefill;			// blocks of output queued ahead, the latency, RT_PREFILL if 0
+	int priority;			// SCHED_FIFO priority of the dsp thread, 0 for the normal scheduler
+	int io_cpu;				// cpu the io thread is pinned to, -1 for any
+	int dsp_cpu;			// cpu the dsp thread is pinned to, -1 for any
+	int freewheel;			// 1 to run as fast as the chain goes, the io thread waits for the dsp instead of an xrun
+	double seconds;			// stop after this much input, 0 to run until the source ends or rt_stop()
+} RT_OPTS_T;
+
+
+/**
+ * @brief [one block in a ring]
+ * @details [an input block is block_size samples, an output block the lowpass filtered input and
+ * then the effect, block_size each]
+ *
+ */
+typedef struct rt_block_struct {
+	uint32_t seq;			// block number, RT_SILENCE for the blocks queued ahead at the start
+	uint32_t release;		// profile_now() when the io thread read it from the source
+	float samples[];		// the audio
+} RT_BLOCK_T;
+
+#define RT_SILENCE			UINT32_MAX			// seq of a block queued ahead at the start
+
+
+/**
+ * @brief [structure containing the engine, its two threads and their counters]
+ * @details [the io thread reads a block from the source into the input ring, takes the block
+ * prefill periods older out of the output ring and writes it to the sink, then sleeps to the
+ * next period. the dsp thread waits on the input ring, runs the board's lowpass and the chain
+ * and puts the result in the output ring. a block that isn't in the output ring when the io
+ * thread wants it is an underrun and the sink gets silence, a block that doesn't fit in the
+ * input ring is an overrun and is lost. counters are written by one thread each and read once
+ * they have stopped]
+ *
+ */
+typedef struct rt_struct {
+	RT_IO_T * source;			// where the input comes from
+	RT_IO_T * sink;				// where the output goes, 1 channel or 2 for the dac's dry and wet
+	int FS;						// sampling frequency of both
+	int block_size;				// samples in a block
+	int prefill;				// blocks of output queued ahead
+	int freewheel;				// no clock, the io thread waits for the dsp thread
+	int64_t max_frames;			// input frames to read, 0 for all of them
+	int io_cpu;					// cpu the io thread asked for
+	int dsp_cpu;				// cpu the dsp thread asked for
+	int priority;				// SCHED_FIFO priority asked for
+
+	FIR_T * lowpass;			// input lowpass
+	int lowpass_taps;			// its length
+	GRAPH_T * G;				// effect chain
+	int tail;					// frames of output after the input ends, for the lowpass and the chain
+	RING_T * in_ring;			// io thread to dsp thread
+	RING_T * out_ring;			// dsp thread to io thread
+	sem_t in_ready;				// posted for every block committed to in_ring, and once at the end
+	sem_t out_ready;			// posted for every block committed to out_ring
+	float * scratch;			// a block of input with no slot for the io thread, then dry and wet with no slot for the dsp thread
+	float * silence;			// a block of zeros
+
+	int running;				// 1 until the io thread is done or rt_stop()
+	int locked;					// memory was locked
+	int fifo;					// both threads got SCHED_FIFO
+	int pinned;					// both threads got the cpus asked for
+	pthread_t io_thread;		// reads and writes
+	pthread_t dsp_thread;		// runs the chain
+
+	// io thread
+	uint32_t blocks;			// periods run
+	uint32_t overruns;			// input blocks lost, the input ring was full
+	uint32_t underruns;			// output blocks of silence, the dsp thread hadn't finished
+	uint32_t late;				// periods the io thread woke up more than a period late
+	uint32_t skipped;			// late output blocks thrown away to get back to prefill blocks of latency
+	int64_t frames;				// output frames written
+	int64_t total;				// output frames to write, -1 until the source ends
+	double seconds;				// wall clock time of run_rt()
+
+	// dsp thread
+	uint32_t processed;			// blocks through the chain
+	uint32_t dropped;			// output blocks with no room in the output ring
+
+	PROFILER_T * P;				// "dsp" time in the chain, "latency" from the source read to the sink write
+	int dsp_stage;				// stage ids
+	int latency_stage;
+	DEADLINE_T * D;				// release to finish of every block, against prefill block periods
+} RT_T;
+
+
+/**
+ * @brief [plan the chain and the rings for a source and a sink]
+ *
+ * @param A [arena everything is allocated from]
+ * @param source [opened with init_rt_io(), at most block_size frames at once]
+ * @param sink [opened with init_rt_io() at the source's rate]
+ * @param chain [effects to run, in order]
+ * @param num_fx [number of effects, 1 to RENDER_MAX_EFFECTS]
+ * @param opts [how to run]
+ * @return [pointer to the engine, NULL if the rates differ, an effect won't initialize or it doesn't fit]
+ */
+RT_T * init_rt(
+	ARENA_T * A,					// arena to allocate from
+	RT_IO_T * source,				// input
+	RT_IO_T * sink,					// output
+	const RENDER_FX_T * chain,		// effects to run
+	int num_fx,						// number of effects
+	const RT_OPTS_T * opts			// how to run
+);
+
+
+/**
+ * @brief [lock memory, start the two threads and wait until the source and the tail are done]
+ * @details [locking, SCHED_FIFO and pinning are asked for and run without if they are refused,
+ * R->locked, R->fifo and R->pinned say what was granted. nothing is allocated while it runs]
+ *
+ * @param R [pointer to the engine]
+ * @return [0 on success, 1 if a thread wouldn't start or the source or sink failed]
+ */
+int run_rt(
+	RT_T * R				// pointer to engine
+);
+
+
+/**
+ * @brief [stop at the end of the current period]
+ * @details [safe from a signal handler]
+ *
+ * @param R [pointer to the engine]
+ */
+void rt_stop(
+	RT_T * R				// pointer to engine
+);
+
+
+/**
+ * @brief [print the setup, the xruns, the dsp time and the latency]
+ *
+ * @param R [pointer to the engine]
+ * @param print [prints one line]
+ */
+void report_rt(
+	const RT_T * R,					// pointer to engine
+	void (*print)(const char *)		// prints one line
+);
+
+
+#endif
@@ -0,0 +1,270 @@
+/**
+ * @file rt_io.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the sources and sinks of the real-time engine.
+ *
+ * @details [
+ * 		init_rt_io() - open a source or sink from backend:path
+ *
+ * 		close_rt_io() - flush and close it
+ *
+ * 		rt_io_file - WAV files through wav.c
+ *
+ * 		rt_io_pipe - raw float frames through a file descriptor
+ *
+ * 		rt_io_null - silence in, nothing out
+ * ]
+ *
+ * A backend is a table of callbacks, the same way an effect is (see effect_graph.h), so a sound card
+ * backend is one more table here and nothing in the engine changes. The three here don't need one:
+ * the file backend takes a recording through the engine exactly as the renderer would, the pipe
+ * backend puts it on either end of a shell pipeline (sox, aplay -f FLOAT_LE, another gape_rt), and
+ * the null backend keeps the engine's clock running with nothing attached, for timing the chain and
+ * counting xruns. None of them block for the hardware, so the engine keeps the time (see rt.c).
+ *
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "arena.h"
+#include "wav.h"
+#include "rt_io.h"
+
+// ----------------------------------------------------------
+
+
+
+
+// file ------------------------------------------------------
+
+static int file_open(RT_IO_T * IO, ARENA_T * A, const char * path) {
+
+	if(IO->output) return create_wav(&(IO->wav), A, path, IO->FS, IO->channels, IO->format);
+
+	if(open_wav(&(IO->wav), path) != 0) return 1;
+	IO->FS = IO->wav.FS;
+	IO->channels = IO->wav.channels;
+	return 0;
+
+}
+
+static int file_read(RT_IO_T * IO, float * input, int n) {
+
+	n = read_wav(&(IO->wav), IO->frames, input, n);
+	IO->frames += n;
+	return n;
+
+}
+
+static int file_write(RT_IO_T * IO, const float * left, const float * right, int n) {
+
+	write_wav(&(IO->wav), left, right, n);
+	IO->frames += n;
+	return IO->wav.failed;
+
+}
+
+static void file_close(RT_IO_T * IO) {
+
+	if(close_wav(&(IO->wav)) != 0) IO->failed = 1;
+
+}
+
+const RT_IO_OPS_T rt_io_file = { "file", file_open, file_read, file_write, file_close };
+
+
+// pipe ------------------------------------------------------
+
+static int pipe_open(RT_IO_T * IO, ARENA_T * A, const char * path) {
+
+	IO->buffer = (float *)arena_alloc(A, sizeof(float) * IO->max_frames * IO->channels);
+	if(IO->buffer == NULL) return 1;
+
+	if(strcmp(path, "-") == 0) {
+		IO->fd = IO->output ? STDOUT_FILENO : STDIN_FILENO;
+		return 0;
+	}
+
+	IO->fd = IO->output ? open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644) : open(path, O_RDONLY);
+	IO->own_fd = 1;
+	return (IO->fd < 0);
+
+}
+
+static int pipe_read(RT_IO_T * IO, float * input, int n) {
+
+	int i, c;
+	ssize_t got;
+	size_t want = sizeof(float) * n * IO->channels;
+	size_t have = 0;
+	float sum;
+
+	// a pipe hands over what the writer has written so far, keep reading until the block is full
+	while(have < want && IO->fd >= 0) {
+		got = read(IO->fd, (uint8_t *)IO->buffer + have, want - have);
+		if(got < 0 && errno == EINTR) continue;
+		if(got < 0) IO->failed = 1;
+		if(got <= 0) break;
+		have += got;
+	}
+
+	n = (int)(have / (sizeof(float) * IO->channels));
+	for(i = 0; i < n; i++) {
+		sum = 0;
+		for(c = 0; c < IO->channels; c++) sum += IO->buffer[i * IO->channels + c];
+		input[i] = sum / IO->channels;
+	}
+	IO->frames += n;
+	return n;
+
+}
+
+static int pipe_write(RT_IO_T * IO, const float * left, const float * right, int n) {
+
+	int i;
+	ssize_t put;
+	size_t want = sizeof(float) * n * IO->channels;
+	size_t done = 0;
+
+	if(IO->failed) return 1;
+
+	if(IO->channels == 1) {
+		memcpy(IO->buffer, left, sizeof(float) * n);
+	} else {
+		for(i = 0; i < n; i++) {
+			IO->buffer[2 * i] = left[i];
+			IO->buffer[2 * i + 1] = (right != NULL) ? right[i] : left[i];
+		}
+	}
+
+	while(done < want) {
+		put = write(IO->fd, (const uint8_t *)IO->buffer + done, want - done);
+		if(put < 0 && errno == EINTR) continue;
+		if(put <= 0) {
+			IO->failed = 1;
+			return 1;
+		}
+		done += put;
+	}
+
+	IO->frames += n;
+	return 0;
+
+}
+
+static void pipe_close(RT_IO_T * IO) {
+
+	if(IO->own_fd && IO->fd >= 0 && close(IO->fd) != 0) IO->failed = 1;
+	IO->fd = -1;
+
+}
+
+const RT_IO_OPS_T rt_io_pipe = { "pipe", pipe_open, pipe_read, pipe_write, pipe_close };
+
+
+// null ------------------------------------------------------
+
+static int null_open(RT_IO_T * IO, ARENA_T * A, const char * path) { return 0; }
+
+static int null_read(RT_IO_T * IO, float * input, int n) {
+
+	memset(input, 0, sizeof(float) * n);
+	IO->frames += n;
+	return n;
+
+}
+
+static int null_write(RT_IO_T * IO, const float * left, const float * right, int n) {
+
+	IO->frames += n;
+	return 0;
+
+}
+
+static void null_close(RT_IO_T * IO) { }
+
+const RT_IO_OPS_T rt_io_null = { "null", null_open, null_read, null_write, null_close };
+
+
+// ----------------------------------------------------------
+
+
+static const RT_IO_OPS_T * const rt_io_backends[] = { &rt_io_file, &rt_io_pipe, &rt_io_null };
+
+#define RT_IO_NUM_BACKENDS	((int)(sizeof(rt_io_backends) / sizeof(rt_io_backends[0])))
+
+
+
+
+/**
+ * @brief [open a source or a sink]
+ *
+ * @param A [arena the struct and its buffers are allocated from]
+ * @param spec [backend and path]
+ * @param output [1 to open a sink, 0 for a source]
+ * @param FS [sampling frequency, a file source has its own]
+ * @param channels [channels of a sink, or of a pipe source]
+ * @param format [sample format of a file sink]
+ * @param max_frames [most frames in one read or write]
+ * @return [pointer to the io struct, NULL for an unknown backend, a file that won't open, or if it doesn't fit]
+ */
+RT_IO_T * init_rt_io(ARENA_T * A, const char * spec, int output, int FS, int channels, int format, int max_frames) {
+
+	int i, len;
+	const char * path = spec;
+	const RT_IO_OPS_T * ops = &rt_io_file;
+	const char * colon = strchr(spec, ':');
+
+	if(channels < 1 || channels > 2 || max_frames < 1) return NULL;
+
+	// backend:path, or just a file name
+	len = (colon == NULL) ? (int)strlen(spec) : (int)(colon - spec);
+	for(i = 0; i < RT_IO_NUM_BACKENDS; i++) {
+		if((int)strlen(rt_io_backends[i]->name) == len && strncmp(spec, rt_io_backends[i]->name, len) == 0) {
+			ops = rt_io_backends[i];
+			path = (colon == NULL) ? "" : colon + 1;
+			break;
+		}
+	}
+	if(ops != &rt_io_null && *path == '\0') return NULL;
+
+	RT_IO_T * IO = (RT_IO_T *)arena_alloc(A, sizeof(RT_IO_T));
+	if(IO == NULL) return NULL;
+
+	IO->ops = ops;
+	IO->output = output;
+	IO->FS = FS;
+	IO->channels = channels;
+	IO->format = format;
+	IO->max_frames = max_frames;
+	IO->fd = -1;
+
+	if(ops->open(IO, A, path) != 0) return NULL;
+
+	return IO;
+
+}
+
+
+/**
+ * @brief [flush a sink and close the file or pipe]
+ *
+ * @param IO [pointer to the io struct]
+ * @return [0 on success, 1 if anything it read or wrote failed]
+ */
+int close_rt_io(RT_IO_T * IO) {
+
+	IO->ops->close(IO);
+	return IO->failed;
+
+}
@@ -0,0 +1,121 @@
+/**
+ * @file rt_io.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for the audio sources
+ * and sinks the real-time engine reads and writes.
+ *
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef RT_IO_H
+#define RT_IO_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "wav.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#define RT_IO_SPEC		512		// longest backend:path
+
+// ---------------------------------------------------------
+
+
+
+
+struct rt_io_struct;
+
+
+/**
+ * @brief [callbacks a backend registers]
+ * @details [read and write are called from the engine's io thread once a block period, with at
+ * most the max_frames the backend was opened for. a source that runs out reads fewer frames, and
+ * every read after that reads none. a backend that fails sets failed and stops moving audio]
+ *
+ */
+typedef struct rt_io_ops {
+	const char * name;																		// name in the spec, "file", "pipe", "null"
+	int (*open)(struct rt_io_struct * IO, ARENA_T * A, const char * path);					// 0 on success, 1 on failure
+	int (*read)(struct rt_io_struct * IO, float * input, int n);							// frames read
+	int (*write)(struct rt_io_struct * IO, const float * left, const float * right, int n);	// 0 on success, 1 on failure
+	void (*close)(struct rt_io_struct * IO);												// flush and let go of the file
+} RT_IO_OPS_T;
+
+
+/**
+ * @brief [structure containing one opened source or sink]
+ *
+ */
+typedef struct rt_io_struct {
+	const RT_IO_OPS_T * ops;	// backend
+	int output;					// 1 for a sink
+	int FS;						// sampling frequency, a file source's own
+	int channels;				// interleaved channels, a source is mixed down to mono as it is read
+	int format;					// sample format of a file sink (WAV_PCM16, ...)
+	int max_frames;				// most frames in one read or write
+	int64_t frames;				// frames read or written
+	int failed;					// a read or write failed
+
+	WAV_T wav;					// file backend
+	int fd;						// pipe backend, -1 if not open
+	int own_fd;					// the pipe was opened by path and is closed with it
+	float * buffer;				// pipe backend, max_frames interleaved frames
+} RT_IO_T;
+
+
+extern const RT_IO_OPS_T rt_io_file;		// WAV file, read or written through wav.c
+extern const RT_IO_OPS_T rt_io_pipe;		// raw interleaved native float, stdin/stdout for "-"
+extern const RT_IO_OPS_T rt_io_null;		// silence in, nothing out
+
+
+/**
+ * @brief [open a source or a sink]
+ * @details [spec is backend:path, "file:take.wav", "pipe:-", "pipe:/tmp/fifo" or "null". a spec
+ * without a backend is a file]
+ *
+ * @param A [arena the struct and its buffers are allocated from]
+ * @param spec [backend and path]
+ * @param output [1 to open a sink, 0 for a source]
+ * @param FS [sampling frequency, a file source has its own]
+ * @param channels [channels of a sink, or of a pipe source]
+ * @param format [sample format of a file sink]
+ * @param max_frames [most frames in one read or write]
+ * @return [pointer to the io struct, NULL for an unknown backend, a file that won't open, or if it doesn't fit]
+ */
+RT_IO_T * init_rt_io(
+	ARENA_T * A,			// arena to allocate from
+	const char * spec,		// backend:path
+	int output,				// sink or source
+	int FS,					// sampling frequency
+	int channels,			// channels
+	int format,				// file sink sample format
+	int max_frames			// most frames at once
+);
+
+
+/**
+ * @brief [flush a sink and close the file or pipe]
+ *
+ * @param IO [pointer to the io struct]
+ * @return [0 on success, 1 if anything it read or wrote failed]
+ */
+int close_rt_io(
+	RT_IO_T * IO			// pointer to io struct
+);
+
+
+#endif
@@ -0,0 +1,292 @@
+/**
+ * @file trace.c
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains the functions for the event trace.
+ * 
+ * @details [
+ * 		init_trace() - allocate the ring
+ * 		
+ * 		trace_attach() - pick the trace the TRACE_* macros record into
+ * 		
+ * 		trace_event() - record one event
+ * 		
+ * 		trace_drain() - read the oldest events out
+ * 		
+ * 		trace_export_json() - drain the ring as a Chrome trace
+ * ]
+ * 
+ * The counters in profiler.c and deadline.c say that a block ran late, the trace says why: 
+ * which stage ran long, or which interrupt landed in the middle of it. Recording an event is
+ * an atomic increment to claim a slot, a read of the cycle counter and a few stores, about 
+ * 20 cycles, so the 16 or so events per block are well under 0.1% of a 100 sample block.
+ * 
+ * A writer marks its slot unfinished (seq = 0) before filling it, and finished (seq = index + 1)
+ * after, so the reader can tell an event that was overwritten or is still being written from a
+ * good one, without ever locking out the writers. On the board the ring is drained over the
+ * uart when a deadline is missed, on the host it is written to a file. Chrome's trace viewer or
+ * Perfetto then show the stages and interrupts on a timeline, one row per interrupt.
+ * 
+ */
+
+
+// INCLUDE --------------------------------------------------
+
+#ifdef ARM_MATH_CM4
+#include "stm32f4xx_hal.h"
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "profiler.h"
+#include "trace.h"
+
+// ----------------------------------------------------------
+
+
+
+
+// GLOBAL VARIABLES TO THIS FILE ------------------------- 
+
+static TRACE_T * volatile trace = NULL;		// trace the macros record into
+
+#ifndef ARM_MATH_CM4
+static FILE * trace_file = NULL;			// file trace_write_json() is writing
+#endif
+
+// -------------------------------------------------------
+
+
+// exception number of the running interrupt, 0 in the main loop
+#ifdef ARM_MATH_CM4
+static uint8_t trace_context(void) { return (uint8_t)(__get_IPSR() & 0xFF); }
+#else
+static uint8_t trace_context(void) { return 0; }
+#endif
+
+
+
+
+/**
+ * @brief [initialize an empty trace]
+ * 
+ * @param A [arena the ring is allocated from]
+ * @param size [events in the ring, rounded down to a power of 2]
+ * @return [pointer to the trace struct, NULL if it doesn't fit in the arena]
+ */
+TRACE_T * init_trace(ARENA_T * A, int size) {
+
+	uint32_t n = 1;
+
+	// set up struct for the trace -----------------------------------------------
+	arena_set_tag(A, "trace");
+	TRACE_T * T = (TRACE_T *)arena_alloc(A, sizeof(TRACE_T));	// allocate struct
+	if(T == NULL) return NULL;									// errcheck alloc
+
+	while((int)(n << 1) <= size) n <<= 1;
+
+	// arena memory is zeroed, so every slot starts out unfinished
+	T->events = (TRACE_EVENT_T *)arena_alloc(A, sizeof(TRACE_EVENT_T) * n);
+	if(T->events == NULL) return NULL;
+
+	T->size = n;
+	profile_start_clock();
+
+	return T;
+
+}
+
+
+/**
+ * @brief [make T the trace every TRACE_* macro records into]
+ * 
+ * @param T [pointer to the trace struct, or NULL]
+ */
+void trace_attach(TRACE_T * T) {
+
+	trace = T;
+
+}
+
+
+/**
+ * @brief [record an event in the attached trace]
+ * 
+ * @param ph [TRACE_PH_*]
+ * @param name [name of the stage or event, a string constant]
+ * @param arg [argument of an instant, value of a counter]
+ */
+void trace_event(int ph, const char * name, int32_t arg) {
+
+	TRACE_T * T = trace;
+	TRACE_EVENT_T * E;
+	uint32_t i;
+
+	if(T == NULL || T->frozen) return;
+
+	// claim a slot, an interrupt between here and the store below just takes the next one
+	i = __atomic_fetch_add(&(T->head), 1, __ATOMIC_RELAXED);
+	E = &(T->events[i & (T->size - 1)]);
+
+	E->seq = 0;
+	E->time = profile_now();
+	E->name = name;
+	E->arg = arg;
+	E->ph = (uint8_t)ph;
+	E->context = trace_context();
+	__atomic_store_n(&(E->seq), i + 1, __ATOMIC_RELEASE);
+
+}
+
+
+/**
+ * @brief [stop or restart recording]
+ * 
+ * @param T [pointer to the trace struct]
+ * @param frozen [1 to stop recording, 0 to restart]
+ */
+void trace_freeze(TRACE_T * T, int frozen) {
+
+	T->frozen = frozen;
+
+}
+
+
+/**
+ * @brief [read the oldest events out of the ring]
+ * 
+ * @param T [pointer to the trace struct]
+ * @param out [buffer for up to max events]
+ * @param max [size of out]
+ * @return [number of events read, 0 once the ring is empty]
+ */
+int trace_drain(TRACE_T * T, TRACE_EVENT_T * out, int max) {
+
+	int n = 0;
+	uint32_t seq;
+	uint32_t head = __atomic_load_n(&(T->head), __ATOMIC_ACQUIRE);
+	TRACE_EVENT_T * E;
+
+	// skip whatever has been written over since the last read
+	if(head - T->tail > T->size) {
+		T->lost += (head - T->tail) - T->size;
+		T->tail = head - T->size;
+	}
+
+	while(T->tail != head && n < max) {
+
+		E = &(T->events[T->tail & (T->size - 1)]);
+
+		// copy it out, and keep it only if nobody was writing the slot before or during the copy
+		seq = __atomic_load_n(&(E->seq), __ATOMIC_ACQUIRE);
+		out[n] = *E;
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if(seq == T->tail + 1 && E->seq == seq) {
+			n++;
+		} else {
+			T->lost++;
+		}
+
+		T->tail++;
+
+	}
+
+	return n;
+
+}
+
+
+/**
+ * @brief [drain the ring as a Chrome trace (chrome://tracing, ui.perfetto.dev)]
+ * 
+ * @param T [pointer to the trace struct]
+ * @param print [prints one line]
+ * @return [number of events exported]
+ */
+int trace_export_json(TRACE_T * T, void (*print)(const char *)) {
+
+	int i, n;
+	int total = 0;
+	char line[160];
+	uint64_t us1000;
+	TRACE_EVENT_T events[16];
+	TRACE_EVENT_T * E;
+
+	print("{\"traceEvents\":[\n");
+
+	while((n = trace_drain(T, events, 16)) > 0) {
+		for(i = 0; i < n; i++) {
+
+			E = &(events[i]);
+
+			// unwrap the 32 bit counter, events can be a little out of order when an interrupt
+			// took its slot after the event it preempted
+			if(!T->started) {
+				T->started = 1;
+				T->last = E->time;
+			}
+			T->time64 += (int32_t)(E->time - T->last);
+			T->last = E->time;
+
+			// Chrome wants microseconds, in integer ns so it doesn't need printf float support
+			us1000 = (T->time64 * 1000000ull) / (profile_ticks_per_sec() / 1000);
+
+			snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lu.%03lu,\"pid\":1,\"tid\":%d",
+				(total > 0) ? ",\n" : "", E->name, E->ph, (unsigned long)(us1000 / 1000), 
+				(unsigned long)(us1000 % 1000), E->context);
+			print(line);
+
+			if(E->ph == TRACE_PH_INSTANT) {
+				snprintf(line, sizeof(line), ",\"s\":\"t\",\"args\":{\"arg\":%ld}}", (long)E->arg);
+			} else if(E->ph == TRACE_PH_COUNTER) {
+				snprintf(line, sizeof(line), ",\"args\":{\"value\":%ld}}", (long)E->arg);
+			} else {
+				snprintf(line, sizeof(line), "}");
+			}
+			print(line);
+
+			total++;
+
+		}
+	}
+
+	snprintf(line, sizeof(line), "\n],\"otherData\":{\"lost\":%lu}}\n", (unsigned long)T->lost);
+	print(line);
+
+	return total;
+
+}
+
+
+#ifndef ARM_MATH_CM4
+
+static void trace_print_file(const char * s) { fputs(s, trace_file); }
+
+/**
+ * @brief [drain the ring into a Chrome trace file]
+ * 
+ * @param T [pointer to the trace struct]
+ * @param path [file to write]
+ * @return [number of events exported, -1 if the file can't be opened]
+ */
+int trace_write_json(TRACE_T * T, const char * path) {
+
+	int n;
+
+	trace_file = fopen(path, "w");
+	if(trace_file == NULL) return -1;
+
+	n = trace_export_json(T, trace_print_file);
+
+	fclose(trace_file);
+	trace_file = NULL;
+	return n;
+
+}
+
+#endif
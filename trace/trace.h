@@ -0,0 +1,191 @@
+/**
+ * @file trace.h
+ *
+ * @author Jacob Allenwood
+ * @date October 19, 2026
+ *
+ * @brief This file contains subroutine and data-type declarations necessary for 
+ * the event trace: a fixed ring of timestamped begin/end and instant events from the
+ * processing stages, the interrupts and parameter changes, exported as a Chrome trace.
+ * 
+ */
+
+
+// HEADER DEFINITION ---------------------------------------
+
+#ifndef TRACE_H
+#define TRACE_H
+
+// ---------------------------------------------------------
+
+
+// INCLUDE -------------------------------------------------
+
+#include <stdint.h>
+
+#include "arena.h"
+
+// ---------------------------------------------------------
+
+
+// DEFINES -------------------------------------------------
+
+#ifndef TRACE_EVENTS
+#define TRACE_EVENTS		512		// events in the ring, a power of 2 (about 30 blocks of the chain)
+#endif
+
+#define TRACE_PH_BEGIN		'B'		// start of a stage
+#define TRACE_PH_END		'E'		// end of a stage
+#define TRACE_PH_INSTANT	'i'		// something happened, with an argument
+#define TRACE_PH_COUNTER	'C'		// a value changed
+
+// the trace is cheap enough to leave on, GAPE_NO_TRACE compiles it out. 
+// events go to the trace attached with trace_attach(), nowhere if there is none
+#ifndef GAPE_NO_TRACE
+#define TRACE_BEGIN(name)			trace_event(TRACE_PH_BEGIN, (name), 0)
+#define TRACE_END(name)				trace_event(TRACE_PH_END, (name), 0)
+#define TRACE_INSTANT(name, arg)	trace_event(TRACE_PH_INSTANT, (name), (arg))
+#define TRACE_COUNTER(name, value)	trace_event(TRACE_PH_COUNTER, (name), (value))
+#else
+#define TRACE_BEGIN(name)			do { } while(0)
+#define TRACE_END(name)				do { } while(0)
+#define TRACE_INSTANT(name, arg)	do { } while(0)
+#define TRACE_COUNTER(name, value)	do { } while(0)
+#endif
+
+// ---------------------------------------------------------
+
+
+
+
+/**
+ * @brief [one event in the ring]
+ * 
+ */
+typedef struct trace_event_struct {
+	volatile uint32_t seq;		// index + 1 once the event is written, 0 while it is being written
+	uint32_t time;				// profile_now() when it happened
+	const char * name;			// name of the stage or event, has to be a string constant
+	int32_t arg;				// argument of an instant, value of a counter
+	uint8_t ph;					// TRACE_PH_*
+	uint8_t context;			// 0 for the main loop, the exception number in an interrupt
+} TRACE_EVENT_T;
+
+
+/**
+ * @brief [structure containing the ring and the reader's position]
+ * @details [any number of writers, in the loop or in interrupts, each claim a slot with an atomic 
+ * increment of head, so nothing is locked and interrupts are never disabled. there is one reader.
+ * when the ring is full the oldest events are overwritten, the reader counts them as lost]
+ * 
+ */
+typedef struct trace_struct {
+	uint32_t size;				// events in the ring, a power of 2
+	uint32_t head;				// index of the next event to write, only grows
+	uint32_t tail;				// index of the next event to read
+	uint32_t lost;				// events overwritten before they were read
+	volatile int frozen;		// 1 to stop recording, so the ring can be read as it was
+	int started;				// 1 once an event has been read, time64 counts from it
+	uint32_t last;				// time of the last event read
+	uint64_t time64;			// time of the last event read, unwrapped, in ticks from the first
+	TRACE_EVENT_T * events;		// the ring
+} TRACE_T;
+
+
+/**
+ * @brief [initialize an empty trace]
+ * 
+ * @param A [arena the ring is allocated from]
+ * @param size [events in the ring, rounded down to a power of 2]
+ * @return [pointer to the trace struct, NULL if it doesn't fit in the arena]
+ */
+TRACE_T * init_trace(
+	ARENA_T * A,		// arena to allocate from
+	int size			// events in the ring
+);
+
+
+/**
+ * @brief [make T the trace every TRACE_* macro records into]
+ * @details [NULL stops recording, do that before the arena under the trace is reset]
+ * 
+ * @param T [pointer to the trace struct, or NULL]
+ */
+void trace_attach(
+	TRACE_T * T		// pointer to trace struct
+);
+
+
+/**
+ * @brief [record an event in the attached trace, use the TRACE_* macros]
+ * 
+ * @param ph [TRACE_PH_*]
+ * @param name [name of the stage or event, a string constant]
+ * @param arg [argument of an instant, value of a counter]
+ */
+void trace_event(
+	int ph,					// kind of event
+	const char * name,		// name of the stage or event
+	int32_t arg				// argument or value
+);
+
+
+/**
+ * @brief [stop or restart recording]
+ * @details [freeze when something goes wrong, so the events leading up to it aren't overwritten
+ * while they are read out]
+ * 
+ * @param T [pointer to the trace struct]
+ * @param frozen [1 to stop recording, 0 to restart]
+ */
+void trace_freeze(
+	TRACE_T * T,		// pointer to trace struct
+	int frozen			// 1 to stop, 0 to restart
+);
+
+
+/**
+ * @brief [read the oldest events out of the ring]
+ * 
+ * @param T [pointer to the trace struct]
+ * @param out [buffer for up to max events]
+ * @param max [size of out]
+ * @return [number of events read, 0 once the ring is empty]
+ */
+int trace_drain(
+	TRACE_T * T,			// pointer to trace struct
+	TRACE_EVENT_T * out,	// buffer for the events
+	int max					// size of out
+);
+
+
+/**
+ * @brief [drain the ring as a Chrome trace (chrome://tracing, ui.perfetto.dev)]
+ * @details [one event per line. on the board print is UART_putstr, the debug link]
+ * 
+ * @param T [pointer to the trace struct]
+ * @param print [prints one line]
+ * @return [number of events exported]
+ */
+int trace_export_json(
+	TRACE_T * T,					// pointer to trace struct
+	void (*print)(const char *)		// prints one line
+);
+
+
+#ifndef ARM_MATH_CM4
+/**
+ * @brief [drain the ring into a Chrome trace file]
+ * 
+ * @param T [pointer to the trace struct]
+ * @param path [file to write]
+ * @return [number of events exported, -1 if the file can't be opened]
+ */
+int trace_write_json(
+	TRACE_T * T,			// pointer to trace struct
+	const char * path		// file to write
+);
+#endif
+
+
+#endif
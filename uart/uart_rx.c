@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <math.h>
 
+#include "trace.h"
 #include "uart_rx.h"
 
 // -------------------------------------------------------
@@ -177,11 +178,15 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef * huart) {
 void DMA1_Stream4_IRQHandler(void) {
 
     // handle the dma interrupt request
+    TRACE_BEGIN("uart tx dma irq");
     HAL_DMA_IRQHandler(huart1.hdmatx);
+    TRACE_END("uart tx dma irq");
 }
 
 void DMA1_Stream2_IRQHandler(void) {
+	TRACE_BEGIN("uart rx dma irq");
 	HAL_DMA_IRQHandler(huart1.hdmarx);
+	TRACE_END("uart rx dma irq");
 }
 
 /**
@@ -190,7 +195,9 @@ void DMA1_Stream2_IRQHandler(void) {
   * @retval None
   */
 void UART4_IRQHandler(void) {
+ 	TRACE_BEGIN("uart irq");
  	HAL_UART_IRQHandler(&huart1);
+ 	TRACE_END("uart irq");
 }
 
 
@@ -198,6 +205,7 @@ void UART4_IRQHandler(void) {
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef * huart) {
 	// UART_putstr("im in receive callback");
     // set receive complete flag for usart_read
+    TRACE_INSTANT("uart rx", 0);
     RX_Complete = SET;
     // UartReady = SET;
 }
@@ -356,6 +364,10 @@ void UART_putstr(const char *s) {
 				// below will change the flag to SET
   len = mystrlen(s);
   if(HAL_UART_Transmit_DMA(&huart1, (uint8_t*)s, len) != HAL_OK) Error_Handler();
+
+  // the DMA reads straight out of s, so don't hand it back until it has all been sent
+  // (the reports reuse one line buffer for every line)
+  while (UartReady != SET) {}
   return;
 }
 